@@ -4,6 +4,9 @@
 #include <stan/math/matrix/Eigen.hpp>
 #include <stan/agrad/rev.hpp>
 #include <stan/agrad/fwd.hpp>
+#include <stan/agrad/fwd/fvar_k.hpp>
+#include <stan/agrad/fwd/fvar_k_functions.hpp>
+#include <stan/agrad/fwd/fvar_k_matrix.hpp>
 
 namespace stan {
   
@@ -245,6 +248,143 @@ namespace stan {
     }
 
 
+    /**
+     * Calculate the value and the gradient of the specified function
+     * at the specified argument in forward mode, propagating
+     * <code>K</code> directions per evaluation of the function.
+     *
+     * <p>The functor must be templated on its scalar type so that it
+     * can be applied to <code>fvar_k&lt;T,K&gt;</code>.  The function
+     * is evaluated <code>ceil(N / K)</code> times for an argument of
+     * size <code>N</code>.
+     *
+     * @tparam K Number of directions per evaluation.
+     * @tparam T Argument type
+     * @tparam F Function type
+     * @param[in] f Function
+     * @param[in] x Argument to function
+     * @param[out] fx Function applied to argument
+     * @param[out] grad_fx Gradient of function at argument
+     */
+    template <int K, typename T, typename F>
+    void
+    gradient(const F& f,
+             const Eigen::Matrix<T,Eigen::Dynamic,1>& x,
+             T& fx,
+             Eigen::Matrix<T,Eigen::Dynamic,1>& grad_fx) {
+      Eigen::Matrix<fvar_k<T,K>,Eigen::Dynamic,1> x_fvar(x.size());
+      grad_fx.resize(x.size());
+      for (int i = 0; i == 0 || i < x.size(); i += K) {
+        for (int j = 0; j < x.size(); ++j) {
+          x_fvar(j) = fvar_k<T,K>(x(j));
+          if (j >= i && j < i + K)
+            x_fvar(j).d_[j - i] = 1.0;
+        }
+        fvar_k<T,K> fx_fvar = f(x_fvar);
+        if (i == 0) fx = fx_fvar.val_;
+        for (int k = 0; k < K && i + k < x.size(); ++k)
+          grad_fx(i + k) = fx_fvar.d_[k];
+      }
+    }
+
+    /**
+     * Calculate the value and the Jacobian of the specified function
+     * at the specified argument in forward mode, propagating
+     * <code>K</code> directions per evaluation of the function.
+     *
+     * <p>As for the <code>fvar</code> version, entry
+     * <code>J(i,k)</code> is the derivative of result
+     * <code>k</code> with respect to argument <code>i</code>.
+     *
+     * @tparam K Number of directions per evaluation.
+     * @tparam T Argument type
+     * @tparam F Function type
+     * @param[in] f Function
+     * @param[in] x Argument to function
+     * @param[out] fx Function applied to argument
+     * @param[out] J Jacobian of function at argument
+     */
+    template <int K, typename T, typename F>
+    void
+    jacobian(const F& f,
+             const Eigen::Matrix<T,Eigen::Dynamic,1>& x,
+             Eigen::Matrix<T,Eigen::Dynamic,1>& fx,
+             Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic>& J) {
+      using Eigen::Matrix;  using Eigen::Dynamic;
+      Matrix<fvar_k<T,K>,Dynamic,1> x_fvar(x.size());
+      for (int i = 0; i == 0 || i < x.size(); i += K) {
+        for (int j = 0; j < x.size(); ++j) {
+          x_fvar(j) = fvar_k<T,K>(x(j));
+          if (j >= i && j < i + K)
+            x_fvar(j).d_[j - i] = 1.0;
+        }
+        Matrix<fvar_k<T,K>,Dynamic,1> fx_fvar = f(x_fvar);
+        if (i == 0) {
+          J.resize(x.size(), fx_fvar.size());
+          fx.resize(fx_fvar.size());
+          for (int m = 0; m < fx_fvar.size(); ++m)
+            fx(m) = fx_fvar(m).val_;
+        }
+        for (int k = 0; k < K && i + k < x.size(); ++k)
+          for (int m = 0; m < fx_fvar.size(); ++m)
+            J(i + k, m) = fx_fvar(m).d_[k];
+      }
+    }
+
+    /**
+     * Calculate the value, the gradient and the Hessian of the
+     * specified function at the specified argument with
+     * forward-over-reverse autodiff, propagating <code>K</code>
+     * directions per evaluation of the function.
+     *
+     * <p>Each evaluation records one expression graph for all
+     * <code>K</code> directions; the rows of the Hessian are then
+     * read off by <code>K</code> reverse sweeps over that graph.
+     *
+     * @tparam K Number of directions per evaluation.
+     * @tparam F Function type
+     * @param[in] f Function
+     * @param[in] x Argument to function
+     * @param[out] fx Function applied to argument
+     * @param[out] grad Gradient of function at argument
+     * @param[out] H Hessian of function at argument
+     */
+    template <int K, typename F>
+    void
+    hessian(const F& f,
+            const Eigen::Matrix<double,Eigen::Dynamic,1>& x,
+            double& fx,
+            Eigen::Matrix<double,Eigen::Dynamic,1>& grad,
+            Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic>& H) {
+      H.resize(x.size(), x.size());
+      grad.resize(x.size());
+      for (int i = 0; i == 0 || i < x.size(); i += K) {
+        start_nested();
+        try {
+          Eigen::Matrix<fvar_k<var,K>,Eigen::Dynamic,1> x_fvar(x.size());
+          for (int j = 0; j < x.size(); ++j) {
+            x_fvar(j) = fvar_k<var,K>(x(j));
+            if (j >= i && j < i + K)
+              x_fvar(j).d_[j - i] = 1.0;
+          }
+          fvar_k<var,K> fx_fvar = f(x_fvar);
+          if (i == 0) fx = fx_fvar.val_.val();
+          for (int k = 0; k < K && i + k < x.size(); ++k) {
+            grad(i + k) = fx_fvar.d_[k].val();
+            if (k > 0)
+              set_zero_all_adjoints_nested();
+            stan::agrad::grad(fx_fvar.d_[k].vi_);
+            for (int j = 0; j < x.size(); ++j)
+              H(i + k, j) = x_fvar(j).val_.adj();
+          }
+        } catch (const std::exception& e) {
+          stan::agrad::recover_memory_nested();
+          throw;
+        }
+        stan::agrad::recover_memory_nested();
+      }
+    }
+
     // aka directional derivative (not length normalized)
     // T2 must be assignable to T1
     template <typename T1, typename T2, typename F>
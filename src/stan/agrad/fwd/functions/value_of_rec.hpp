@@ -0,0 +1,26 @@
+#ifndef STAN__AGRAD__FWD__FUNCTIONS__VALUE_OF_REC_HPP
+#define STAN__AGRAD__FWD__FUNCTIONS__VALUE_OF_REC_HPP
+
+#include <stan/agrad/fwd/fvar.hpp>
+#include <stan/math/functions/value_of_rec.hpp>
+
+namespace stan {
+  namespace agrad {
+
+    /**
+     * Return the <code>double</code> value of the specified
+     * variable, recursing through nested auto-dif types.
+     *
+     * @tparam T Inner type of the fvar.
+     * @param v Variable.
+     * @return Value of variable.
+     */
+    template<typename T>
+    inline double value_of_rec(const fvar<T>& v) {
+      using stan::math::value_of_rec;
+      return value_of_rec(v.val_);
+    }
+    
+  }
+}
+#endif
@@ -0,0 +1,316 @@
+#ifndef STAN__AGRAD__FWD__FVAR_K_HPP
+#define STAN__AGRAD__FWD__FVAR_K_HPP
+
+#include <ostream>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/meta/likely.hpp>
+#include <stan/meta/traits.hpp>
+
+namespace stan {
+
+  namespace agrad {
+
+    /**
+     * Forward-mode autodiff variable carrying <code>K</code> tangents,
+     * so a single evaluation of a function propagates <code>K</code>
+     * directional derivatives.
+     *
+     * <p>The tangents are packed in a fixed-size Eigen array and the
+     * arithmetic operators update all of them with one array
+     * expression, which Eigen vectorizes.  The array is not aligned,
+     * so <code>fvar_k</code> can be stored in standard containers and
+     * Eigen matrices without an aligned allocator.  The functions in
+     * <code>agrad/fwd/functions</code> are lifted to this type in
+     * <code>agrad/fwd/fvar_k_functions.hpp</code>.
+     *
+     * @tparam T Type of value and tangents.
+     * @tparam K Number of tangents.
+     */
+    template <typename T, int K>
+    struct fvar_k {
+
+      typedef Eigen::Array<T,K,1,Eigen::DontAlign> tangent_type;
+
+      T val_;             // value
+      tangent_type d_;    // tangents
+
+      T val() const { return val_; }
+      T tangent(int k) const { return d_[k]; }
+
+      typedef fvar_k value_type;
+
+      // TV must be assignable to T
+      template <typename TV>
+      fvar_k(const TV& val) : val_(val) {
+        d_.setZero();
+        if (unlikely(boost::math::isnan(val)))
+          d_.setConstant(val_);
+      }
+
+      fvar_k() : val_(0.0) {
+        d_.setZero();
+      }
+
+      inline
+      fvar_k<T,K>&
+      operator+=(const fvar_k<T,K>& x2) {
+        val_ += x2.val_;
+        d_ += x2.d_;
+        return *this;
+      }
+
+      inline
+      fvar_k<T,K>&
+      operator+=(const double x2) {
+        val_ += x2;
+        return *this;
+      }
+
+      inline
+      fvar_k<T,K>&
+      operator-=(const fvar_k<T,K>& x2) {
+        val_ -= x2.val_;
+        d_ -= x2.d_;
+        return *this;
+      }
+
+      inline
+      fvar_k<T,K>&
+      operator-=(const double x2) {
+        val_ -= x2;
+        return *this;
+      }
+
+      inline
+      fvar_k<T,K>&
+      operator*=(const fvar_k<T,K>& x2) {
+        d_ = d_ * x2.val_ + val_ * x2.d_;
+        val_ *= x2.val_;
+        return *this;
+      }
+
+      inline
+      fvar_k<T,K>&
+      operator*=(const double x2) {
+        val_ *= x2;
+        d_ *= x2;
+        return *this;
+      }
+
+      inline
+      fvar_k<T,K>&
+      operator/=(const fvar_k<T,K>& x2) {
+        T inv_x2 = 1 / x2.val_;
+        val_ *= inv_x2;
+        d_ = (d_ - val_ * x2.d_) * inv_x2;
+        return *this;
+      }
+
+      inline
+      fvar_k<T,K>&
+      operator/=(const double x2) {
+        val_ /= x2;
+        d_ /= x2;
+        return *this;
+      }
+
+      inline
+      fvar_k<T,K>&
+      operator++() {
+        ++val_;
+        return *this;
+      }
+
+      inline
+      fvar_k<T,K>
+      operator++(int /*dummy*/) {
+        fvar_k<T,K> result(*this);
+        ++val_;
+        return result;
+      }
+
+      inline
+      fvar_k<T,K>&
+      operator--() {
+        --val_;
+        return *this;
+      }
+
+      inline
+      fvar_k<T,K>
+      operator--(int /*dummy*/) {
+        fvar_k<T,K> result(*this);
+        --val_;
+        return result;
+      }
+
+      friend
+      std::ostream&
+      operator<<(std::ostream& os, const fvar_k<T,K>& v) {
+        os << v.val_ << ':';
+        for (int k = 0; k < K; ++k)
+          os << (k > 0 ? "," : "") << v.d_[k];
+        return os;
+      }
+    };
+
+    template <typename T, int K>
+    inline
+    fvar_k<T,K>
+    operator+(const fvar_k<T,K>& x1, const fvar_k<T,K>& x2) {
+      fvar_k<T,K> y(x1);
+      return y += x2;
+    }
+
+    template <typename T, int K>
+    inline
+    fvar_k<T,K>
+    operator+(const fvar_k<T,K>& x1, const double x2) {
+      fvar_k<T,K> y(x1);
+      return y += x2;
+    }
+
+    template <typename T, int K>
+    inline
+    fvar_k<T,K>
+    operator+(const double x1, const fvar_k<T,K>& x2) {
+      fvar_k<T,K> y(x2);
+      return y += x1;
+    }
+
+    template <typename T, int K>
+    inline
+    fvar_k<T,K>
+    operator-(const fvar_k<T,K>& x1, const fvar_k<T,K>& x2) {
+      fvar_k<T,K> y(x1);
+      return y -= x2;
+    }
+
+    template <typename T, int K>
+    inline
+    fvar_k<T,K>
+    operator-(const fvar_k<T,K>& x1, const double x2) {
+      fvar_k<T,K> y(x1);
+      return y -= x2;
+    }
+
+    template <typename T, int K>
+    inline
+    fvar_k<T,K>
+    operator-(const double x1, const fvar_k<T,K>& x2) {
+      fvar_k<T,K> y;
+      y.val_ = x1 - x2.val_;
+      y.d_ = -x2.d_;
+      return y;
+    }
+
+    template <typename T, int K>
+    inline
+    fvar_k<T,K>
+    operator-(const fvar_k<T,K>& x) {
+      fvar_k<T,K> y;
+      y.val_ = -x.val_;
+      y.d_ = -x.d_;
+      return y;
+    }
+
+    template <typename T, int K>
+    inline
+    fvar_k<T,K>
+    operator+(const fvar_k<T,K>& x) {
+      return x;
+    }
+
+    template <typename T, int K>
+    inline
+    fvar_k<T,K>
+    operator*(const fvar_k<T,K>& x1, const fvar_k<T,K>& x2) {
+      fvar_k<T,K> y(x1);
+      return y *= x2;
+    }
+
+    template <typename T, int K>
+    inline
+    fvar_k<T,K>
+    operator*(const fvar_k<T,K>& x1, const double x2) {
+      fvar_k<T,K> y(x1);
+      return y *= x2;
+    }
+
+    template <typename T, int K>
+    inline
+    fvar_k<T,K>
+    operator*(const double x1, const fvar_k<T,K>& x2) {
+      fvar_k<T,K> y(x2);
+      return y *= x1;
+    }
+
+    template <typename T, int K>
+    inline
+    fvar_k<T,K>
+    operator/(const fvar_k<T,K>& x1, const fvar_k<T,K>& x2) {
+      fvar_k<T,K> y(x1);
+      return y /= x2;
+    }
+
+    template <typename T, int K>
+    inline
+    fvar_k<T,K>
+    operator/(const fvar_k<T,K>& x1, const double x2) {
+      fvar_k<T,K> y(x1);
+      return y /= x2;
+    }
+
+    template <typename T, int K>
+    inline
+    fvar_k<T,K>
+    operator/(const double x1, const fvar_k<T,K>& x2) {
+      fvar_k<T,K> y;
+      y.val_ = x1 / x2.val_;
+      T d = -y.val_ / x2.val_;
+      y.d_ = d * x2.d_;
+      return y;
+    }
+
+#define STAN__AGRAD__FWD__FVAR_K_COMPARISON(OP)                         \
+    template <typename T, int K>                                        \
+    inline bool                                                         \
+    operator OP(const fvar_k<T,K>& x1, const fvar_k<T,K>& x2) {         \
+      return x1.val_ OP x2.val_;                                        \
+    }                                                                   \
+    template <typename T, int K>                                        \
+    inline bool                                                         \
+    operator OP(const fvar_k<T,K>& x1, const double x2) {               \
+      return x1.val_ OP x2;                                             \
+    }                                                                   \
+    template <typename T, int K>                                        \
+    inline bool                                                         \
+    operator OP(const double x1, const fvar_k<T,K>& x2) {               \
+      return x1 OP x2.val_;                                             \
+    }
+
+    STAN__AGRAD__FWD__FVAR_K_COMPARISON(==)
+    STAN__AGRAD__FWD__FVAR_K_COMPARISON(!=)
+    STAN__AGRAD__FWD__FVAR_K_COMPARISON(<)
+    STAN__AGRAD__FWD__FVAR_K_COMPARISON(<=)
+    STAN__AGRAD__FWD__FVAR_K_COMPARISON(>)
+    STAN__AGRAD__FWD__FVAR_K_COMPARISON(>=)
+
+#undef STAN__AGRAD__FWD__FVAR_K_COMPARISON
+
+  }
+
+  template <typename T, int K>
+  struct is_fvar<stan::agrad::fvar_k<T,K> > {
+    enum { value = true };
+  };
+
+  template <typename T, int K>
+  struct partials_type<stan::agrad::fvar_k<T,K> > {
+    typedef T type;
+  };
+
+}
+
+#endif
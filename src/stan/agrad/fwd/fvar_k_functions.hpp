@@ -0,0 +1,273 @@
+#ifndef STAN__AGRAD__FWD__FVAR_K_FUNCTIONS_HPP
+#define STAN__AGRAD__FWD__FVAR_K_FUNCTIONS_HPP
+
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <stan/agrad/fwd.hpp>
+#include <stan/agrad/fwd/fvar_k.hpp>
+#include <stan/math/functions/is_inf.hpp>
+#include <stan/math/functions/is_nan.hpp>
+#include <stan/math/functions/value_of.hpp>
+#include <stan/math/functions/value_of_rec.hpp>
+
+namespace stan {
+
+  namespace agrad {
+
+    // The functions in agrad/fwd/functions are lifted to fvar_k by
+    // evaluating the fvar version once per fvar_k argument, seeded
+    // with a unit tangent for that argument, which gives the partial
+    // with respect to that argument.  The partial then scales all K
+    // tangents of the argument in one array expression, so the number
+    // of scalar evaluations does not depend on K.
+
+    namespace {
+
+      template <typename T, int K>
+      inline fvar<T> fvar_k_seed(const fvar_k<T,K>& x, double d) {
+        return fvar<T>(x.val_, d);
+      }
+
+      inline double fvar_k_seed(double x, double /* d */) {
+        return x;
+      }
+
+      template <typename T, int K>
+      inline bool fvar_k_has_tangents(const fvar_k<T,K>& /* x */) {
+        return true;
+      }
+
+      inline bool fvar_k_has_tangents(double /* x */) {
+        return false;
+      }
+
+      template <typename T, int K>
+      inline void fvar_k_add_tangents(fvar_k<T,K>& y,
+                                      const fvar_k<T,K>& x,
+                                      const T& partial) {
+        y.d_ += partial * x.d_;
+      }
+
+      template <typename T, int K>
+      inline void fvar_k_add_tangents(fvar_k<T,K>& /* y */,
+                                      double /* x */,
+                                      const T& /* partial */) { }
+
+    }
+
+#define STAN__AGRAD__FWD__FVAR_K_UNARY(F)                               \
+    template <typename T, int K>                                        \
+    inline fvar_k<T,K> F(const fvar_k<T,K>& x) {                        \
+      fvar<T> f = F(fvar<T>(x.val_, 1.0));                              \
+      fvar_k<T,K> y;                                                    \
+      y.val_ = f.val_;                                                  \
+      fvar_k_add_tangents(y, x, f.d_);                                  \
+      return y;                                                         \
+    }
+
+#define STAN__AGRAD__FWD__FVAR_K_INT_UNARY(F)                           \
+    template <typename T, int K>                                        \
+    inline fvar_k<T,K> F(int n, const fvar_k<T,K>& x) {                 \
+      fvar<T> f = F(n, fvar<T>(x.val_, 1.0));                           \
+      fvar_k<T,K> y;                                                    \
+      y.val_ = f.val_;                                                  \
+      fvar_k_add_tangents(y, x, f.d_);                                  \
+      return y;                                                         \
+    }
+
+#define STAN__AGRAD__FWD__FVAR_K_BINARY_ARGS(F, A1, A2)                 \
+    template <typename T, int K>                                        \
+    inline fvar_k<T,K> F(A1 x1, A2 x2) {                                \
+      fvar_k<T,K> y;                                                    \
+      if (fvar_k_has_tangents(x1)) {                                    \
+        fvar<T> f = F(fvar_k_seed(x1, 1.0), fvar_k_seed(x2, 0.0));      \
+        y.val_ = f.val_;                                                \
+        fvar_k_add_tangents(y, x1, f.d_);                               \
+      }                                                                 \
+      if (fvar_k_has_tangents(x2)) {                                    \
+        fvar<T> f = F(fvar_k_seed(x1, 0.0), fvar_k_seed(x2, 1.0));      \
+        y.val_ = f.val_;                                                \
+        fvar_k_add_tangents(y, x2, f.d_);                               \
+      }                                                                 \
+      return y;                                                         \
+    }
+
+#define STAN__AGRAD__FWD__FVAR_K_BINARY(F)                              \
+    STAN__AGRAD__FWD__FVAR_K_BINARY_ARGS(F,                             \
+      STAN__AGRAD__FWD__FVAR_K_ARG,                                     \
+      STAN__AGRAD__FWD__FVAR_K_ARG)                                     \
+    STAN__AGRAD__FWD__FVAR_K_BINARY_ARGS(F,                             \
+      STAN__AGRAD__FWD__FVAR_K_ARG,                                     \
+      double)                                                           \
+    STAN__AGRAD__FWD__FVAR_K_BINARY_ARGS(F,                             \
+      double,                                                           \
+      STAN__AGRAD__FWD__FVAR_K_ARG)
+
+#define STAN__AGRAD__FWD__FVAR_K_TERNARY_ARGS(F, A1, A2, A3)            \
+    template <typename T, int K>                                        \
+    inline fvar_k<T,K> F(A1 x1, A2 x2, A3 x3) {                         \
+      fvar_k<T,K> y;                                                    \
+      if (fvar_k_has_tangents(x1)) {                                    \
+        fvar<T> f = F(fvar_k_seed(x1, 1.0), fvar_k_seed(x2, 0.0),       \
+                      fvar_k_seed(x3, 0.0));                            \
+        y.val_ = f.val_;                                                \
+        fvar_k_add_tangents(y, x1, f.d_);                               \
+      }                                                                 \
+      if (fvar_k_has_tangents(x2)) {                                    \
+        fvar<T> f = F(fvar_k_seed(x1, 0.0), fvar_k_seed(x2, 1.0),       \
+                      fvar_k_seed(x3, 0.0));                            \
+        y.val_ = f.val_;                                                \
+        fvar_k_add_tangents(y, x2, f.d_);                               \
+      }                                                                 \
+      if (fvar_k_has_tangents(x3)) {                                    \
+        fvar<T> f = F(fvar_k_seed(x1, 0.0), fvar_k_seed(x2, 0.0),       \
+                      fvar_k_seed(x3, 1.0));                            \
+        y.val_ = f.val_;                                                \
+        fvar_k_add_tangents(y, x3, f.d_);                               \
+      }                                                                 \
+      return y;                                                         \
+    }
+
+#define STAN__AGRAD__FWD__FVAR_K_TERNARY(F)                             \
+    STAN__AGRAD__FWD__FVAR_K_TERNARY_ARGS(F,                            \
+      STAN__AGRAD__FWD__FVAR_K_ARG,                                     \
+      STAN__AGRAD__FWD__FVAR_K_ARG,                                     \
+      STAN__AGRAD__FWD__FVAR_K_ARG)                                     \
+    STAN__AGRAD__FWD__FVAR_K_TERNARY_ARGS(F,                            \
+      STAN__AGRAD__FWD__FVAR_K_ARG,                                     \
+      STAN__AGRAD__FWD__FVAR_K_ARG,                                     \
+      double)                                                           \
+    STAN__AGRAD__FWD__FVAR_K_TERNARY_ARGS(F,                            \
+      STAN__AGRAD__FWD__FVAR_K_ARG,                                     \
+      double,                                                           \
+      STAN__AGRAD__FWD__FVAR_K_ARG)                                     \
+    STAN__AGRAD__FWD__FVAR_K_TERNARY_ARGS(F,                            \
+      double,                                                           \
+      STAN__AGRAD__FWD__FVAR_K_ARG,                                     \
+      STAN__AGRAD__FWD__FVAR_K_ARG)                                     \
+    STAN__AGRAD__FWD__FVAR_K_TERNARY_ARGS(F,                            \
+      STAN__AGRAD__FWD__FVAR_K_ARG,                                     \
+      double,                                                           \
+      double)                                                           \
+    STAN__AGRAD__FWD__FVAR_K_TERNARY_ARGS(F,                            \
+      double,                                                           \
+      STAN__AGRAD__FWD__FVAR_K_ARG,                                     \
+      double)                                                           \
+    STAN__AGRAD__FWD__FVAR_K_TERNARY_ARGS(F,                            \
+      double,                                                           \
+      double,                                                           \
+      STAN__AGRAD__FWD__FVAR_K_ARG)
+
+#define STAN__AGRAD__FWD__FVAR_K_ARG const fvar_k<T,K>&
+
+    STAN__AGRAD__FWD__FVAR_K_UNARY(abs)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(acos)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(acosh)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(asin)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(asinh)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(atan)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(atanh)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(cbrt)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(ceil)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(cos)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(cosh)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(digamma)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(erf)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(erfc)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(exp)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(exp2)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(expm1)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(fabs)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(floor)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(inv)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(inv_cloglog)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(inv_logit)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(inv_sqrt)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(inv_square)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(lgamma)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(log)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(log10)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(log1m)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(log1m_exp)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(log1m_inv_logit)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(log1p)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(log1p_exp)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(log2)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(log_inv_logit)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(logit)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(Phi)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(round)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(sin)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(sinh)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(sqrt)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(square)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(tan)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(tanh)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(tgamma)
+    STAN__AGRAD__FWD__FVAR_K_UNARY(trunc)
+
+    STAN__AGRAD__FWD__FVAR_K_INT_UNARY(bessel_first_kind)
+    STAN__AGRAD__FWD__FVAR_K_INT_UNARY(bessel_second_kind)
+    STAN__AGRAD__FWD__FVAR_K_INT_UNARY(binary_log_loss)
+    STAN__AGRAD__FWD__FVAR_K_INT_UNARY(lmgamma)
+    STAN__AGRAD__FWD__FVAR_K_INT_UNARY(modified_bessel_first_kind)
+    STAN__AGRAD__FWD__FVAR_K_INT_UNARY(modified_bessel_second_kind)
+
+    STAN__AGRAD__FWD__FVAR_K_BINARY(atan2)
+    STAN__AGRAD__FWD__FVAR_K_BINARY(binomial_coefficient_log)
+    STAN__AGRAD__FWD__FVAR_K_BINARY(falling_factorial)
+    STAN__AGRAD__FWD__FVAR_K_BINARY(fdim)
+    STAN__AGRAD__FWD__FVAR_K_BINARY(fmax)
+    STAN__AGRAD__FWD__FVAR_K_BINARY(fmin)
+    STAN__AGRAD__FWD__FVAR_K_BINARY(fmod)
+    STAN__AGRAD__FWD__FVAR_K_BINARY(gamma_p)
+    STAN__AGRAD__FWD__FVAR_K_BINARY(gamma_q)
+    STAN__AGRAD__FWD__FVAR_K_BINARY(hypot)
+    STAN__AGRAD__FWD__FVAR_K_BINARY(lbeta)
+    STAN__AGRAD__FWD__FVAR_K_BINARY(log_diff_exp)
+    STAN__AGRAD__FWD__FVAR_K_BINARY(log_falling_factorial)
+    STAN__AGRAD__FWD__FVAR_K_BINARY(log_rising_factorial)
+    STAN__AGRAD__FWD__FVAR_K_BINARY(log_sum_exp)
+    STAN__AGRAD__FWD__FVAR_K_BINARY(multiply_log)
+    STAN__AGRAD__FWD__FVAR_K_BINARY(owens_t)
+    STAN__AGRAD__FWD__FVAR_K_BINARY(pow)
+    STAN__AGRAD__FWD__FVAR_K_BINARY(rising_factorial)
+
+    STAN__AGRAD__FWD__FVAR_K_TERNARY(fma)
+    STAN__AGRAD__FWD__FVAR_K_TERNARY(log_mix)
+
+#undef STAN__AGRAD__FWD__FVAR_K_ARG
+#undef STAN__AGRAD__FWD__FVAR_K_TERNARY
+#undef STAN__AGRAD__FWD__FVAR_K_TERNARY_ARGS
+#undef STAN__AGRAD__FWD__FVAR_K_BINARY
+#undef STAN__AGRAD__FWD__FVAR_K_BINARY_ARGS
+#undef STAN__AGRAD__FWD__FVAR_K_INT_UNARY
+#undef STAN__AGRAD__FWD__FVAR_K_UNARY
+
+    template <typename T, int K>
+    inline int is_nan(const fvar_k<T,K>& x) {
+      using stan::math::is_nan;
+      return is_nan(x.val_);
+    }
+
+    template <typename T, int K>
+    inline int is_inf(const fvar_k<T,K>& x) {
+      using stan::math::is_inf;
+      return is_inf(x.val_);
+    }
+
+    template <typename T, int K>
+    inline T value_of(const fvar_k<T,K>& x) {
+      return x.val_;
+    }
+
+    template <typename T, int K>
+    inline double value_of_rec(const fvar_k<T,K>& x) {
+      using stan::math::value_of_rec;
+      return value_of_rec(x.val_);
+    }
+
+  }
+
+}
+
+#endif
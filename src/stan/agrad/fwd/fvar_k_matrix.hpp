@@ -0,0 +1,149 @@
+#ifndef STAN__AGRAD__FWD__FVAR_K_MATRIX_HPP
+#define STAN__AGRAD__FWD__FVAR_K_MATRIX_HPP
+
+#include <cmath>
+#include <limits>
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/error_handling/matrix/check_matching_sizes.hpp>
+#include <stan/error_handling/matrix/check_multiplicable.hpp>
+#include <stan/error_handling/matrix/check_vector.hpp>
+#include <stan/agrad/fwd/fvar_k.hpp>
+#include <stan/agrad/fwd/fvar_k_functions.hpp>
+
+namespace stan {
+
+  namespace agrad {
+
+    // Matrix functions from agrad/fwd/matrix whose fvar versions
+    // are written against fvar directly.  The templated functions in
+    // stan/math/matrix only need the scalar operations and apply to
+    // fvar_k as they are.
+
+    template <typename T, int K, typename T2, int R1, int C1, int R2, int C2>
+    inline
+    fvar_k<T,K>
+    dot_product(const Eigen::Matrix<fvar_k<T,K>,R1,C1>& v1,
+                const Eigen::Matrix<T2,R2,C2>& v2) {
+      stan::error_handling::check_vector("dot_product", "v1", v1);
+      stan::error_handling::check_vector("dot_product", "v2", v2);
+      stan::error_handling::check_matching_sizes("dot_product",
+                                                 "v1", v1,
+                                                 "v2", v2);
+      fvar_k<T,K> ret(0.0);
+      for (int i = 0; i < v1.size(); i++)
+        ret += v1(i) * v2(i);
+      return ret;
+    }
+
+    template <typename T, int K, int R1, int C1, int R2, int C2>
+    inline
+    fvar_k<T,K>
+    dot_product(const Eigen::Matrix<double,R1,C1>& v1,
+                const Eigen::Matrix<fvar_k<T,K>,R2,C2>& v2) {
+      return dot_product(v2, v1);
+    }
+
+    template <typename T, int K, int R, int C>
+    inline
+    fvar_k<T,K>
+    dot_self(const Eigen::Matrix<fvar_k<T,K>,R,C>& v) {
+      stan::error_handling::check_vector("dot_self", "v", v);
+      return dot_product(v, v);
+    }
+
+    template <typename T, int K, int R, int C>
+    inline
+    fvar_k<T,K>
+    sum(const Eigen::Matrix<fvar_k<T,K>,R,C>& m) {
+      fvar_k<T,K> sum(0.0);
+      for (int i = 0; i < m.size(); ++i)
+        sum += m(i);
+      return sum;
+    }
+
+    template <typename T, int K, int R, int C>
+    inline
+    Eigen::Matrix<fvar_k<T,K>,R,C>
+    multiply(const Eigen::Matrix<fvar_k<T,K>,R,C>& m, const double c) {
+      Eigen::Matrix<fvar_k<T,K>,R,C> res(m.rows(), m.cols());
+      for (int i = 0; i < m.size(); ++i)
+        res(i) = c * m(i);
+      return res;
+    }
+
+    template <typename T, int K, int R, int C>
+    inline
+    Eigen::Matrix<fvar_k<T,K>,R,C>
+    multiply(const double c, const Eigen::Matrix<fvar_k<T,K>,R,C>& m) {
+      return multiply(m, c);
+    }
+
+    template <typename T, int K, typename T2, int R1, int C1, int R2, int C2>
+    inline
+    Eigen::Matrix<fvar_k<T,K>,R1,C2>
+    multiply(const Eigen::Matrix<fvar_k<T,K>,R1,C1>& m1,
+             const Eigen::Matrix<T2,R2,C2>& m2) {
+      stan::error_handling::check_multiplicable("multiply",
+                                                "m1", m1,
+                                                "m2", m2);
+      Eigen::Matrix<fvar_k<T,K>,R1,C2> result(m1.rows(), m2.cols());
+      for (int i = 0; i < m1.rows(); i++) {
+        Eigen::Matrix<fvar_k<T,K>,1,C1> crow = m1.row(i);
+        for (int j = 0; j < m2.cols(); j++) {
+          Eigen::Matrix<T2,R2,1> ccol = m2.col(j);
+          result(i,j) = dot_product(crow, ccol);
+        }
+      }
+      return result;
+    }
+
+    template <typename T, int K, int R1, int C1, int R2, int C2>
+    inline
+    Eigen::Matrix<fvar_k<T,K>,R1,C2>
+    multiply(const Eigen::Matrix<double,R1,C1>& m1,
+             const Eigen::Matrix<fvar_k<T,K>,R2,C2>& m2) {
+      stan::error_handling::check_multiplicable("multiply",
+                                                "m1", m1,
+                                                "m2", m2);
+      Eigen::Matrix<fvar_k<T,K>,R1,C2> result(m1.rows(), m2.cols());
+      for (int i = 0; i < m1.rows(); i++) {
+        Eigen::Matrix<double,1,C1> crow = m1.row(i);
+        for (int j = 0; j < m2.cols(); j++) {
+          Eigen::Matrix<fvar_k<T,K>,R2,1> ccol = m2.col(j);
+          result(i,j) = dot_product(ccol, crow);
+        }
+      }
+      return result;
+    }
+
+    template <typename T, int K, int R, int C>
+    inline
+    fvar_k<T,K>
+    log_sum_exp(const Eigen::Matrix<fvar_k<T,K>,R,C>& v) {
+      using std::exp;
+      using std::log;
+      fvar_k<T,K> y;
+      if (v.size() == 0) {
+        y.val_ = -std::numeric_limits<double>::infinity();
+        return y;
+      }
+      T max = v(0).val_;
+      for (int i = 1; i < v.size(); ++i)
+        if (v(i).val_ > max)
+          max = v(i).val_;
+      T denominator(0.0);
+      for (int i = 0; i < v.size(); ++i) {
+        T exp_vi = exp(v(i).val_ - max);
+        denominator += exp_vi;
+        y.d_ += v(i).d_ * exp_vi;
+      }
+      y.val_ = max + log(denominator);
+      y.d_ /= denominator;
+      return y;
+    }
+
+  }
+
+}
+
+#endif
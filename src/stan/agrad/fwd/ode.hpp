@@ -0,0 +1,251 @@
+#ifndef STAN__AGRAD__FWD__ODE_HPP
+#define STAN__AGRAD__FWD__ODE_HPP
+
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <stan/agrad/fwd/fvar.hpp>
+#include <stan/agrad/fwd/fvar_k.hpp>
+#include <stan/meta/traits.hpp>
+
+namespace stan {
+
+  namespace agrad {
+
+    /**
+     * Exception thrown when a function without forward-mode
+     * sensitivities, such as an ODE solver, is evaluated with
+     * <code>fvar</code> arguments.
+     */
+    class fvar_not_supported : public std::domain_error {
+    public:
+      explicit fvar_not_supported(const std::string& what)
+        : std::domain_error(what) { }
+    };
+
+    namespace {
+
+      template <typename T>
+      std::vector<std::vector<T> >
+      ode_fvar_not_supported(const char* function) {
+        std::string msg(function);
+        msg += ": forward-mode autodiff is not supported for ODE states"
+          " or parameters";
+        throw fvar_not_supported(msg);
+      }
+
+    }
+
+    /**
+     * The ODE solvers have no forward-mode sensitivities, so models
+     * that solve an ODE in their log density can be instantiated with
+     * <code>fvar</code> scalars, as needed for exact Hessians, but
+     * throw <code>fvar_not_supported</code> when evaluated.
+     *
+     * <p>There are overloads for <code>fvar</code> initial states,
+     * <code>fvar</code> parameters, and both, and the same three for
+     * <code>fvar_k</code>.
+     */
+    template <typename F, typename T1, typename T2>
+    std::vector<std::vector<typename stan::return_type<fvar<T1>,T2>::type> >
+    integrate_ode(const F& /* f */,
+                  const std::vector<fvar<T1> > /* y0 */,
+                  const double /* t0 */,
+                  const std::vector<double>& /* ts */,
+                  const std::vector<T2>& /* theta */,
+                  const std::vector<double>& /* x */,
+                  const std::vector<int>& /* x_int */,
+                  std::ostream* /* msgs */) {
+      return ode_fvar_not_supported
+        <typename stan::return_type<fvar<T1>,T2>::type>("integrate_ode");
+    }
+
+    template <typename F, typename T1, typename T2>
+    std::vector<std::vector<typename stan::return_type<T1,fvar<T2> >::type> >
+    integrate_ode(const F& /* f */,
+                  const std::vector<T1> /* y0 */,
+                  const double /* t0 */,
+                  const std::vector<double>& /* ts */,
+                  const std::vector<fvar<T2> >& /* theta */,
+                  const std::vector<double>& /* x */,
+                  const std::vector<int>& /* x_int */,
+                  std::ostream* /* msgs */) {
+      return ode_fvar_not_supported
+        <typename stan::return_type<T1,fvar<T2> >::type>("integrate_ode");
+    }
+
+    template <typename F, typename T1, typename T2>
+    std::vector<std::vector<typename stan::return_type<fvar<T1>,
+                                                       fvar<T2> >::type> >
+    integrate_ode(const F& /* f */,
+                  const std::vector<fvar<T1> > /* y0 */,
+                  const double /* t0 */,
+                  const std::vector<double>& /* ts */,
+                  const std::vector<fvar<T2> >& /* theta */,
+                  const std::vector<double>& /* x */,
+                  const std::vector<int>& /* x_int */,
+                  std::ostream* /* msgs */) {
+      return ode_fvar_not_supported
+        <typename stan::return_type<fvar<T1>,fvar<T2> >::type>("integrate_ode");
+    }
+
+    template <typename F, typename T1, typename T2>
+    std::vector<std::vector<typename stan::return_type<fvar<T1>,T2>::type> >
+    integrate_ode_stiff(const F& /* f */,
+                        const std::vector<fvar<T1> > /* y0 */,
+                        const double /* t0 */,
+                        const std::vector<double>& /* ts */,
+                        const std::vector<T2>& /* theta */,
+                        const std::vector<double>& /* x */,
+                        const std::vector<int>& /* x_int */,
+                        std::ostream* /* msgs */,
+                        const double /* relative_tolerance */ = 1e-6,
+                        const double /* absolute_tolerance */ = 1e-6,
+                        const int /* max_num_steps */ = 100000) {
+      return ode_fvar_not_supported
+        <typename stan::return_type<fvar<T1>,T2>::type>("integrate_ode_stiff");
+    }
+
+    template <typename F, typename T1, typename T2>
+    std::vector<std::vector<typename stan::return_type<T1,fvar<T2> >::type> >
+    integrate_ode_stiff(const F& /* f */,
+                        const std::vector<T1> /* y0 */,
+                        const double /* t0 */,
+                        const std::vector<double>& /* ts */,
+                        const std::vector<fvar<T2> >& /* theta */,
+                        const std::vector<double>& /* x */,
+                        const std::vector<int>& /* x_int */,
+                        std::ostream* /* msgs */,
+                        const double /* relative_tolerance */ = 1e-6,
+                        const double /* absolute_tolerance */ = 1e-6,
+                        const int /* max_num_steps */ = 100000) {
+      return ode_fvar_not_supported
+        <typename stan::return_type<T1,fvar<T2> >::type>("integrate_ode_stiff");
+    }
+
+    template <typename F, typename T1, typename T2>
+    std::vector<std::vector<typename stan::return_type<fvar<T1>,
+                                                       fvar<T2> >::type> >
+    integrate_ode_stiff(const F& /* f */,
+                        const std::vector<fvar<T1> > /* y0 */,
+                        const double /* t0 */,
+                        const std::vector<double>& /* ts */,
+                        const std::vector<fvar<T2> >& /* theta */,
+                        const std::vector<double>& /* x */,
+                        const std::vector<int>& /* x_int */,
+                        std::ostream* /* msgs */,
+                        const double /* relative_tolerance */ = 1e-6,
+                        const double /* absolute_tolerance */ = 1e-6,
+                        const int /* max_num_steps */ = 100000) {
+      return ode_fvar_not_supported
+        <typename stan::return_type<fvar<T1>,fvar<T2> >::type>
+        ("integrate_ode_stiff");
+    }
+
+    template <typename F, typename T1, typename T2, int K>
+    std::vector<std::vector<typename stan::return_type<fvar_k<T1,K>,T2>::type> >
+    integrate_ode(const F& /* f */,
+                  const std::vector<fvar_k<T1,K> > /* y0 */,
+                  const double /* t0 */,
+                  const std::vector<double>& /* ts */,
+                  const std::vector<T2>& /* theta */,
+                  const std::vector<double>& /* x */,
+                  const std::vector<int>& /* x_int */,
+                  std::ostream* /* msgs */) {
+      return ode_fvar_not_supported
+        <typename stan::return_type<fvar_k<T1,K>,T2>::type>
+        ("integrate_ode");
+    }
+
+    template <typename F, typename T1, typename T2, int K>
+    std::vector<std::vector<typename stan::return_type<T1,fvar_k<T2,K> >::type> >
+    integrate_ode(const F& /* f */,
+                  const std::vector<T1> /* y0 */,
+                  const double /* t0 */,
+                  const std::vector<double>& /* ts */,
+                  const std::vector<fvar_k<T2,K> >& /* theta */,
+                  const std::vector<double>& /* x */,
+                  const std::vector<int>& /* x_int */,
+                  std::ostream* /* msgs */) {
+      return ode_fvar_not_supported
+        <typename stan::return_type<T1,fvar_k<T2,K> >::type>
+        ("integrate_ode");
+    }
+
+    template <typename F, typename T1, typename T2, int K>
+    std::vector<std::vector<typename stan::return_type<fvar_k<T1,K>,
+                                                       fvar_k<T2,K> >::type> >
+    integrate_ode(const F& /* f */,
+                  const std::vector<fvar_k<T1,K> > /* y0 */,
+                  const double /* t0 */,
+                  const std::vector<double>& /* ts */,
+                  const std::vector<fvar_k<T2,K> >& /* theta */,
+                  const std::vector<double>& /* x */,
+                  const std::vector<int>& /* x_int */,
+                  std::ostream* /* msgs */) {
+      return ode_fvar_not_supported
+        <typename stan::return_type<fvar_k<T1,K>,fvar_k<T2,K> >::type>
+        ("integrate_ode");
+    }
+
+    template <typename F, typename T1, typename T2, int K>
+    std::vector<std::vector<typename stan::return_type<fvar_k<T1,K>,T2>::type> >
+    integrate_ode_stiff(const F& /* f */,
+                        const std::vector<fvar_k<T1,K> > /* y0 */,
+                        const double /* t0 */,
+                        const std::vector<double>& /* ts */,
+                        const std::vector<T2>& /* theta */,
+                        const std::vector<double>& /* x */,
+                        const std::vector<int>& /* x_int */,
+                        std::ostream* /* msgs */,
+                        const double /* relative_tolerance */ = 1e-6,
+                        const double /* absolute_tolerance */ = 1e-6,
+                        const int /* max_num_steps */ = 100000) {
+      return ode_fvar_not_supported
+        <typename stan::return_type<fvar_k<T1,K>,T2>::type>
+        ("integrate_ode_stiff");
+    }
+
+    template <typename F, typename T1, typename T2, int K>
+    std::vector<std::vector<typename stan::return_type<T1,fvar_k<T2,K> >::type> >
+    integrate_ode_stiff(const F& /* f */,
+                        const std::vector<T1> /* y0 */,
+                        const double /* t0 */,
+                        const std::vector<double>& /* ts */,
+                        const std::vector<fvar_k<T2,K> >& /* theta */,
+                        const std::vector<double>& /* x */,
+                        const std::vector<int>& /* x_int */,
+                        std::ostream* /* msgs */,
+                        const double /* relative_tolerance */ = 1e-6,
+                        const double /* absolute_tolerance */ = 1e-6,
+                        const int /* max_num_steps */ = 100000) {
+      return ode_fvar_not_supported
+        <typename stan::return_type<T1,fvar_k<T2,K> >::type>
+        ("integrate_ode_stiff");
+    }
+
+    template <typename F, typename T1, typename T2, int K>
+    std::vector<std::vector<typename stan::return_type<fvar_k<T1,K>,
+                                                       fvar_k<T2,K> >::type> >
+    integrate_ode_stiff(const F& /* f */,
+                        const std::vector<fvar_k<T1,K> > /* y0 */,
+                        const double /* t0 */,
+                        const std::vector<double>& /* ts */,
+                        const std::vector<fvar_k<T2,K> >& /* theta */,
+                        const std::vector<double>& /* x */,
+                        const std::vector<int>& /* x_int */,
+                        std::ostream* /* msgs */,
+                        const double /* relative_tolerance */ = 1e-6,
+                        const double /* absolute_tolerance */ = 1e-6,
+                        const int /* max_num_steps */ = 100000) {
+      return ode_fvar_not_supported
+        <typename stan::return_type<fvar_k<T1,K>,fvar_k<T2,K> >::type>
+        ("integrate_ode_stiff");
+    }
+
+  }
+
+}
+
+#endif
@@ -1,7 +1,10 @@
 #ifndef STAN__AGRAD__PARTIALS_VARI_HPP
 #define STAN__AGRAD__PARTIALS_VARI_HPP
 
+#include <algorithm>
 #include <stan/meta/traits.hpp>
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/math/matrix/value_array.hpp>
 #include <stan/agrad/rev/var.hpp>
 #include <stan/agrad/rev/vari.hpp>
 #include <stan/agrad/fwd/fvar.hpp>
@@ -21,9 +24,23 @@ namespace stan {
           N_(N),
           operands_(operands),
           partials_(partials) { }
+      /**
+       * Scale the partials by the adjoint as arrays, a block at a
+       * time, and add them to the operands' adjoints.  The scatter
+       * into the adjoints is done one operand at a time, because an
+       * operand may appear more than once.
+       */
       void chain() {
-        for (size_t n = 0; n < N_; ++n)
-          operands_[n]->adj_ += adj_ * partials_[n];
+        using stan::math::VALUE_ARRAY_MAX_SIZE;
+        Eigen::Map<const Eigen::ArrayXd> partials(partials_, N_);
+        for (size_t start = 0; start < N_; start += VALUE_ARRAY_MAX_SIZE) {
+          size_t size = std::min<size_t>(VALUE_ARRAY_MAX_SIZE, N_ - start);
+          stan::math::value_array_type<double>::type d
+            = adj_ * partials.segment(start, size);
+          vari** operands = operands_ + start;
+          for (size_t n = 0; n < size; ++n)
+            operands[n]->adj_ += d(n);
+        }
       }
     };
 
@@ -32,23 +49,20 @@ namespace stan {
                bool is_vec = is_vector<T2>::value, 
                bool is_const = is_constant_struct<T2>::value>
       struct incr_deriv {
-        inline T3 incr(T1 d_x, const T2& x_d ) {
-          return 0;
+        inline void incr(T3& /* result */, T1 /* d_x */, const T2& /* x_d */) {
         }
       };
       template<typename T1, typename T2, typename T3>
       struct incr_deriv<T1,T2,T3,false,false> {
-        inline T3 incr(T1 d_x, const T2& x_d) {
-          return d_x[0]*x_d.d_;
+        inline void incr(T3& result, T1 d_x, const T2& x_d) {
+          result.d_ += d_x[0]*x_d.d_;
         }
       };
       template<typename T1, typename T2, typename T3>
       struct incr_deriv<T1,T2,T3,true,false> {
-        inline T3 incr(T1 d_x, const T2& x_d) {
-          T3 temp = 0;
+        inline void incr(T3& result, T1 d_x, const T2& x_d) {
           for (size_t n = 0; n < length(x_d); n++)
-            temp += d_x[n] * x_d[n].d_;
-          return temp;
+            result.d_ += d_x[n] * x_d[n].d_;
         }
       };
 
@@ -146,32 +160,34 @@ namespace stan {
                                       VectorView<T_partials_return,
                                                  is_vector<T6>::value, 
                                                  is_constant_struct<T6>::value> d_x6) {
-        T_partials_return temp_deriv = 0;
-        temp_deriv += incr_deriv<VectorView<T_partials_return,
-                                            is_vector<T1>::value,
-                                            is_constant_struct<T1>::value>,
-                                 T1,T_partials_return>().incr(d_x1,x1);
-        temp_deriv += incr_deriv<VectorView<T_partials_return,
-                                            is_vector<T2>::value,
-                                            is_constant_struct<T2>::value>,
-                                 T2,T_partials_return>().incr(d_x2,x2);
-        temp_deriv += incr_deriv<VectorView<T_partials_return,
-                                            is_vector<T3>::value,
-                                            is_constant_struct<T3>::value>,
-                                 T3,T_partials_return>().incr(d_x3,x3);
-        temp_deriv += incr_deriv<VectorView<T_partials_return,
-                                            is_vector<T4>::value,
-                                            is_constant_struct<T4>::value>,
-                                 T4,T_partials_return>().incr(d_x4,x4);
-        temp_deriv += incr_deriv<VectorView<T_partials_return,
-                                            is_vector<T5>::value,
-                                            is_constant_struct<T5>::value>,
-                                 T5,T_partials_return>().incr(d_x5,x5);
-        temp_deriv += incr_deriv<VectorView<T_partials_return,
-                                            is_vector<T6>::value,
-                                            is_constant_struct<T6>::value>,
-                                 T6,T_partials_return>().incr(d_x6,x6);
-        return stan::agrad::fvar<T_partials_return>(logp,temp_deriv);
+        // the tangents of fvar and fvar_k results are accumulated in
+        // place, one per operand
+        T_return_type result(logp);
+        incr_deriv<VectorView<T_partials_return,
+                              is_vector<T1>::value,
+                              is_constant_struct<T1>::value>,
+                   T1,T_return_type>().incr(result,d_x1,x1);
+        incr_deriv<VectorView<T_partials_return,
+                              is_vector<T2>::value,
+                              is_constant_struct<T2>::value>,
+                   T2,T_return_type>().incr(result,d_x2,x2);
+        incr_deriv<VectorView<T_partials_return,
+                              is_vector<T3>::value,
+                              is_constant_struct<T3>::value>,
+                   T3,T_return_type>().incr(result,d_x3,x3);
+        incr_deriv<VectorView<T_partials_return,
+                              is_vector<T4>::value,
+                              is_constant_struct<T4>::value>,
+                   T4,T_return_type>().incr(result,d_x4,x4);
+        incr_deriv<VectorView<T_partials_return,
+                              is_vector<T5>::value,
+                              is_constant_struct<T5>::value>,
+                   T5,T_return_type>().incr(result,d_x5,x5);
+        incr_deriv<VectorView<T_partials_return,
+                              is_vector<T6>::value,
+                              is_constant_struct<T6>::value>,
+                   T6,T_return_type>().incr(result,d_x6,x6);
+        return result;
           }
         };
 
@@ -207,11 +223,61 @@ namespace stan {
           return (1);
         }
       };
+
+      template<typename T, bool is_vec, bool is_const>
+      struct add_partials_array {
+        template <typename Derived>
+        inline void add(VectorView<T,is_vec,is_const>& /* d_x */,
+                        size_t /* start */,
+                        const Eigen::ArrayBase<Derived>& /* x */) { }
+      };
+      template<typename T>
+      struct add_partials_array<T,false,false> {
+        template <typename Derived>
+        inline void add(VectorView<T,false,false>& d_x, size_t /* start */,
+                        const Eigen::ArrayBase<Derived>& x) {
+          d_x[0] += x.sum();
+        }
+      };
+      template<typename T>
+      struct add_partials_array<T,true,false> {
+        template <typename Derived>
+        inline void add(VectorView<T,true,false>& d_x, size_t start,
+                        const Eigen::ArrayBase<Derived>& x) {
+          Eigen::Map<Eigen::Array<T,Eigen::Dynamic,1> >(&d_x[start], x.size())
+            += x;
+        }
+      };
+    }
+
+    /**
+     * Add the specified array of partials, one per term of a block of
+     * terms of a vectorized density, to the partials of an operand.
+     *
+     * <p>The partials of a vector operand are updated in place as a
+     * contiguous array, and those of a scalar operand are incremented
+     * by the sum.  Nothing is evaluated for a constant operand, so
+     * <code>x</code> can be an expression that is only computed when
+     * it is needed.
+     *
+     * @param d_x Partials of an operand of
+     *   <code>OperandsAndPartials</code>.
+     * @param start Index of the first term of the block.
+     * @param x Array of partials, one per term of the block.
+     */
+    template<typename T, bool is_vec, bool is_const, typename Derived>
+    inline void add_partials(VectorView<T,is_vec,is_const>& d_x, size_t start,
+                             const Eigen::ArrayBase<Derived>& x) {
+      add_partials_array<T,is_vec,is_const>().add(d_x, start, x);
     }
 
     /**
      * A variable implementation that stores operands and
      * derivatives with respect to the variable.
+     *
+     * <p>The partials of all operands are stored in one contiguous
+     * block, so that they can be updated as arrays with
+     * <code>add_partials()</code>.
      */
     template<typename T1=double, typename T2=double, typename T3=double, 
              typename T4=double, typename T5=double, typename T6=double>
@@ -0,0 +1,149 @@
+#ifndef STAN__AGRAD__PARTIALS_VARI_MVT_HPP
+#define STAN__AGRAD__PARTIALS_VARI_MVT_HPP
+
+#include <algorithm>
+#include <vector>
+#include <stan/meta/traits.hpp>
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/agrad/rev/var.hpp>
+#include <stan/agrad/rev/vari.hpp>
+#include <stan/agrad/rev/internal/precomputed_gradients.hpp>
+
+namespace stan {
+  namespace agrad {
+
+    namespace {
+      inline vari* operand_vari(const var& x) {
+        return x.vi_;
+      }
+
+      inline vari* operand_vari(double /* x */) {
+        return 0;
+      }
+    }
+
+    /**
+     * Operands and partials of a multivariate density whose value
+     * and partials are computed on doubles.
+     *
+     * <p>Operands are added with their partials one argument at a
+     * time, and <code>to_var()</code> returns the log density.  This
+     * is the version for a <code>double</code> return, which ignores
+     * the partials.
+     *
+     * @tparam T_return Return type of the density.
+     */
+    template <typename T_return>
+    class OperandsAndPartialsMvt {
+    public:
+      template <typename T>
+      void add(const T& /* x */, double /* d_x */) { }
+
+      template <typename T>
+      void add(const T& /* x */, const Eigen::MatrixXd& /* d_x */) { }
+
+      template <typename T>
+      void add_lower(const T& /* x */, const Eigen::MatrixXd& /* d_x */) { }
+
+      template <typename T>
+      void add_mvt(const T& /* x */, const Eigen::MatrixXd& /* d_x */) { }
+
+      double to_var(double logp) const {
+        return logp;
+      }
+    };
+
+    /**
+     * Operands and partials of a multivariate density in reverse
+     * mode.  <code>to_var()</code> puts a single node with all of
+     * the operands and partials on the autodiff stack.
+     *
+     * <p>Constant operands are skipped, so the partials of an
+     * argument only need to be computed when the argument is not
+     * constant.
+     */
+    template <>
+    class OperandsAndPartialsMvt<var> {
+    private:
+      std::vector<vari*> varis_;
+      std::vector<double> partials_;
+
+    public:
+      void add(double /* x */, double /* d_x */) { }
+
+      void add(const var& x, double d_x) {
+        varis_.push_back(x.vi_);
+        partials_.push_back(d_x);
+      }
+
+      /**
+       * Add every element of a matrix, with the partials in a
+       * matrix of the same size.
+       */
+      template <typename T, int R, int C>
+      void add(const Eigen::Matrix<T,R,C>& x, const Eigen::MatrixXd& d_x) {
+        if (is_constant<T>::value)
+          return;
+        for (int i = 0; i < x.size(); ++i) {
+          varis_.push_back(operand_vari(x(i)));
+          partials_.push_back(d_x(i));
+        }
+      }
+
+      /**
+       * Add the lower triangle of a square matrix, for densities
+       * that never read its upper triangle.
+       */
+      template <typename T, int R, int C>
+      void add_lower(const Eigen::Matrix<T,R,C>& x,
+                     const Eigen::MatrixXd& d_x) {
+        if (is_constant<T>::value)
+          return;
+        for (int n = 0; n < x.cols(); ++n)
+          for (int m = n; m < x.rows(); ++m) {
+            varis_.push_back(operand_vari(x(m,n)));
+            partials_.push_back(d_x(m,n));
+          }
+      }
+
+      /**
+       * Add a vector or an array of vectors argument of a density
+       * over <code>d_x.cols()</code> observations.  Column
+       * <code>i</code> of <code>d_x</code> holds the partials for
+       * observation <code>i</code>; they are summed when a single
+       * vector is broadcast across the observations.
+       */
+      template <typename T_x>
+      void add_mvt(const T_x& x, const Eigen::MatrixXd& d_x) {
+        if (is_constant_struct<T_x>::value)
+          return;
+        VectorViewMvt<const T_x> x_vec(x);
+        size_t size_x = length_mvt(x);
+        int K = d_x.rows();
+        size_t pos = varis_.size();
+        for (size_t i = 0; i < size_x; ++i)
+          for (int k = 0; k < K; ++k)
+            varis_.push_back(operand_vari(x_vec[i](k)));
+        partials_.resize(varis_.size(), 0.0);
+        for (int i = 0; i < d_x.cols(); ++i) {
+          size_t start = pos + (size_x == 1 ? 0 : i * K);
+          for (int k = 0; k < K; ++k)
+            partials_[start + k] += d_x(k,i);
+        }
+      }
+
+      var to_var(double logp) const {
+        size_t size = varis_.size();
+        vari** varis = ChainableStack::memalloc_.alloc_array<vari*>(size);
+        double* partials = ChainableStack::memalloc_.alloc_array<double>(size);
+        std::copy(varis_.begin(), varis_.end(), varis);
+        std::copy(partials_.begin(), partials_.end(), partials);
+        return var(new precomputed_gradients_vari(logp, size,
+                                                  varis, partials));
+      }
+    };
+
+  }
+}
+
+#endif
@@ -13,5 +13,6 @@
 #include <stan/agrad/rev/operators.hpp>
 #include <stan/agrad/rev/functions.hpp>
 #include <stan/agrad/rev/ode.hpp>
+#include <stan/agrad/rev/accumulator.hpp>
 
 #endif
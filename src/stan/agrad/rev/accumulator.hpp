@@ -0,0 +1,158 @@
+#ifndef STAN__AGRAD__REV__ACCUMULATOR_HPP
+#define STAN__AGRAD__REV__ACCUMULATOR_HPP
+
+#include <algorithm>
+#include <vector>
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/math/matrix/accumulator.hpp>
+#include <stan/agrad/rev/chainable.hpp>
+#include <stan/agrad/rev/var.hpp>
+#include <stan/agrad/rev/vari.hpp>
+
+namespace stan {
+
+  namespace agrad {
+
+    namespace {
+      class accumulate_vari : public vari {
+      protected:
+        vari** terms_;
+        size_t size_;
+
+        inline static double sum_values(double x, vari** terms,
+                                        size_t size) {
+          for (size_t i = 0; i < size; ++i)
+            x += terms[i]->val_;
+          return x;
+        }
+
+      public:
+        accumulate_vari(double x, vari** terms, size_t size)
+          : vari(sum_values(x, terms, size)),
+            terms_(terms), size_(size) {
+        }
+
+        virtual void chain() {
+          for (size_t i = 0; i < size_; ++i)
+            terms_[i]->adj_ += adj_;
+        }
+      };
+    }
+
+  }
+
+  namespace math {
+
+    /**
+     * Accumulator for reverse-mode autodiff variables, as used for
+     * the log density in generated models.
+     *
+     * <p>The buffer of terms is allocated in the autodiff arena, so
+     * it costs no heap allocation and its memory is recycled by
+     * <code>recover_memory()</code> along with the rest of the
+     * expression graph for the next evaluation.  Arithmetic terms are
+     * summed eagerly into a single <code>double</code>, and
+     * <code>sum()</code> puts a single node on the stack, whatever
+     * the number of terms.
+     */
+    template <>
+    class accumulator<stan::agrad::var> {
+    private:
+      stan::agrad::vari** terms_;
+      size_t size_;
+      size_t capacity_;
+      double constant_;
+
+      void push_back(stan::agrad::vari* vi) {
+        if (size_ == capacity_) {
+          capacity_ = capacity_ == 0 ? 16 : 2 * capacity_;
+          stan::agrad::vari** terms
+            = stan::agrad::ChainableStack::memalloc_
+            .alloc_array<stan::agrad::vari*>(capacity_);
+          std::copy(terms_, terms_ + size_, terms);
+          terms_ = terms;
+        }
+        terms_[size_++] = vi;
+      }
+
+    public:
+      /**
+       * Construct an accumulator.
+       */
+      accumulator()
+        : terms_(0), size_(0), capacity_(0), constant_(0.0) {
+      }
+
+      /**
+       * Add the specified arithmetic type value to the constant part
+       * of the sum.
+       *
+       * @tparam S Type of argument
+       * @param x Value to add
+       */
+      template <typename S>
+      typename boost::enable_if<boost::is_arithmetic<S>, void>::type
+      add(S x) {
+        constant_ += x;
+      }
+
+      /**
+       * Add the specified variable to the buffer.
+       *
+       * @param x Variable to add
+       */
+      void add(const stan::agrad::var& x) {
+        push_back(x.vi_);
+      }
+
+      /**
+       * Add each entry in the specified matrix, vector, or row vector
+       * of values.
+       *
+       * @tparam S type of values in matrix
+       * @tparam R number of rows in matrix
+       * @tparam C number of columns in matrix
+       * @param m Matrix of values to add
+       */
+      template <typename S, int R, int C>
+      void add(const Eigen::Matrix<S,R,C>& m) {
+        for (int i = 0; i < m.size(); ++i)
+          add(m(i));
+      }
+
+      /**
+       * Recursively add each entry in the specified standard vector.
+       *
+       * @tparam S Type of value to recursively add.
+       * @param xs Vector of entries to add
+       */
+      template <typename S>
+      void add(const std::vector<S>& xs) {
+        for (size_t i = 0; i < xs.size(); ++i)
+          add(xs[i]);
+      }
+
+      /**
+       * Return the sum of the accumulated values.
+       *
+       * @return Sum of accumulated values.
+       */
+      stan::agrad::var sum() const {
+        if (size_ == 0)
+          return constant_;
+        if (size_ == 1 && constant_ == 0.0)
+          return stan::agrad::var(terms_[0]);
+        return stan::agrad::var(new stan::agrad::accumulate_vari(constant_,
+                                                                 terms_,
+                                                                 size_));
+      }
+
+    };
+
+  }
+
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef STAN__AGRAD__REV__CHAINABLE_HPP
 #define STAN__AGRAD__REV__CHAINABLE_HPP
 
+#include <stdexcept>
 #include <vector>
 #include <stan/agrad/rev/var_stack.hpp>
 
@@ -91,6 +92,27 @@ namespace stan {
         ChainableStack::var_nochain_stack_[i]->set_zero_adjoint();
     }
 
+    /**
+     * Reset the adjoint values of the variables in the top nested
+     * portion of the stack to zero, leaving the outer variables
+     * untouched.  This allows several gradients to be computed from
+     * a single nested expression.
+     *
+     * @throw std::logic_error if <code>empty_nested()</code> returns
+     * <code>true</code>
+     */
+    static inline void set_zero_all_adjoints_nested() {
+      if (empty_nested())
+        throw std::logic_error("empty_nested() must be false"
+                               " before calling set_zero_all_adjoints_nested()");
+      for (size_t i = ChainableStack::nested_var_stack_sizes_.back();
+           i < ChainableStack::var_stack_.size(); ++i)
+        ChainableStack::var_stack_[i]->set_zero_adjoint();
+      for (size_t i = ChainableStack::nested_var_nochain_stack_sizes_.back();
+           i < ChainableStack::var_nochain_stack_.size(); ++i)
+        ChainableStack::var_nochain_stack_[i]->set_zero_adjoint();
+    }
+
     /**
      * Compute the gradient for all variables starting from the
      * specified root variable implementation.  Does not recover
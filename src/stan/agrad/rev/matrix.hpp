@@ -4,7 +4,9 @@
 #include <stan/agrad/rev/matrix/Eigen_NumTraits.hpp>
 #include <stan/agrad/rev/matrix/LDLT_alloc.hpp>
 #include <stan/agrad/rev/matrix/LDLT_factor.hpp>
+#include <stan/agrad/rev/matrix/cholesky_decompose.hpp>
 #include <stan/agrad/rev/matrix/crossprod.hpp>
+#include <stan/agrad/rev/matrix/csr_matrix_times_vector.hpp>
 #include <stan/agrad/rev/matrix/determinant.hpp>
 #include <stan/agrad/rev/matrix/divide.hpp>
 #include <stan/agrad/rev/matrix/dot_product.hpp>
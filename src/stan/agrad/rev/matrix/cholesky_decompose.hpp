@@ -0,0 +1,188 @@
+#ifndef STAN__AGRAD__REV__MATRIX__CHOLESKY_DECOMPOSE_HPP
+#define STAN__AGRAD__REV__MATRIX__CHOLESKY_DECOMPOSE_HPP
+
+#include <algorithm>
+#include <stan/agrad/rev/var.hpp>
+#include <stan/agrad/rev/matrix/Eigen_NumTraits.hpp>
+#include <stan/agrad/rev/matrix/typedefs.hpp>
+#include <stan/agrad/rev/functions/value_of_rec.hpp>
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/math/matrix/typedefs.hpp>
+#include <stan/error_handling/matrix/check_square.hpp>
+#include <stan/error_handling/matrix/check_symmetric.hpp>
+
+namespace stan {
+  namespace agrad {
+
+    namespace {
+
+      /**
+       * A single vari for the lower-triangular Cholesky factor
+       * <code>L</code> of a symmetric matrix <code>A</code>.
+       *
+       * The factorization is done on <code>double</code> values and
+       * the lower triangle of <code>L</code> is kept packed by column
+       * in the arena.  Every element of the result is a non-chaining
+       * vari, so the decomposition puts one node on the stack, and
+       * <code>chain()</code> runs the blocked reverse-mode algorithm
+       * of Murray (2016), <i>Differentiation of the Cholesky
+       * decomposition</i>, which works on blocks of columns with
+       * matrix products and triangular solves.
+       *
+       * As with <code>Eigen::LLT</code>, only the lower triangle of
+       * <code>A</code> is read, so only it receives adjoints.
+       */
+      class cholesky_decompose_vari : public vari {
+      public:
+        int M_;           // A.rows() = A.cols()
+        int block_size_;
+        double* L_;       // lower triangle of L, packed by column
+        vari** variRefA_; // lower triangle of A, packed by column
+        vari** variRefL_; // lower triangle of L, packed by column
+
+        explicit cholesky_decompose_vari(const matrix_v& A)
+          : vari(0.0),
+            M_(A.rows()),
+            block_size_(std::min(128, std::max(8, M_ / 8 / 8 * 8))),
+            L_(ChainableStack::memalloc_
+               .alloc_array<double>(M_ * (M_ + 1) / 2)),
+            variRefA_(ChainableStack::memalloc_
+                      .alloc_array<vari*>(M_ * (M_ + 1) / 2)),
+            variRefL_(ChainableStack::memalloc_
+                      .alloc_array<vari*>(M_ * (M_ + 1) / 2)) {
+          using stan::math::matrix_d;
+
+          matrix_d A_d(M_, M_);
+          int pos = 0;
+          for (int j = 0; j < M_; ++j) {
+            for (int i = j; i < M_; ++i) {
+              variRefA_[pos] = A(i, j).vi_;
+              A_d(i, j) = A(i, j).vi_->val_;
+              ++pos;
+            }
+          }
+
+          Eigen::LLT<matrix_d> llt(M_);
+          llt.compute(A_d);
+          const matrix_d& LLT_matrix = llt.matrixLLT();
+          pos = 0;
+          for (int j = 0; j < M_; ++j) {
+            for (int i = j; i < M_; ++i) {
+              L_[pos] = LLT_matrix(i, j);
+              variRefL_[pos] = new vari(L_[pos], false);
+              ++pos;
+            }
+          }
+        }
+
+        /**
+         * Replace the adjoint of a diagonal block <code>D</code> of
+         * <code>L</code> with the corresponding adjoint of the
+         * symmetric input, as the unblocked algorithm would,
+         * <code>Dbar = D^{-T} Phi(D^T Dbar) D^{-1}</code>, where
+         * <code>Phi</code> symmetrizes the lower triangle.  The full
+         * symmetric result is left in <code>Dbar</code>.
+         */
+        static void
+        diagonal_block_adjoint(const Eigen::Block<stan::math::matrix_d>& D,
+                               Eigen::Block<stan::math::matrix_d> Dbar) {
+          using stan::math::matrix_d;
+          using Eigen::Lower;
+          using Eigen::StrictlyUpper;
+
+          matrix_d P = D.transpose() * Dbar.triangularView<Lower>();
+          P.triangularView<StrictlyUpper>()
+            = P.transpose().triangularView<StrictlyUpper>();
+          D.transpose().triangularView<Eigen::Upper>().solveInPlace(P);
+          D.triangularView<Lower>().solveInPlace<Eigen::OnTheRight>(P);
+          Dbar = P;
+        }
+
+        virtual void chain() {
+          using stan::math::matrix_d;
+          using Eigen::Lower;
+          typedef Eigen::Block<matrix_d> block_t;
+
+          matrix_d L = matrix_d::Zero(M_, M_);
+          matrix_d Lbar = matrix_d::Zero(M_, M_);
+          int pos = 0;
+          for (int j = 0; j < M_; ++j) {
+            for (int i = j; i < M_; ++i) {
+              L(i, j) = L_[pos];
+              Lbar(i, j) = variRefL_[pos]->adj_;
+              ++pos;
+            }
+          }
+
+          // blocks of columns from the last to the first; with
+          // D = L[j:k,j:k], R = L[j:k,0:j], C = L[k:M,j:k] and
+          // B = L[k:M,0:j]
+          for (int k = M_; k > 0; k -= block_size_) {
+            int j = std::max(0, k - block_size_);
+            block_t R = L.block(j, 0, k - j, j);
+            block_t D = L.block(j, j, k - j, k - j);
+            block_t B = L.block(k, 0, M_ - k, j);
+            block_t C = L.block(k, j, M_ - k, k - j);
+            block_t Rbar = Lbar.block(j, 0, k - j, j);
+            block_t Dbar = Lbar.block(j, j, k - j, k - j);
+            block_t Bbar = Lbar.block(k, 0, M_ - k, j);
+            block_t Cbar = Lbar.block(k, j, M_ - k, k - j);
+            if (Cbar.size() > 0) {
+              // Cbar = Cbar * D^{-1}
+              D.triangularView<Lower>().solveInPlace<Eigen::OnTheRight>(Cbar);
+              Bbar.noalias() -= Cbar * R;
+              Dbar.noalias() -= Cbar.transpose() * C;
+            }
+            diagonal_block_adjoint(D, Dbar);
+            Rbar.noalias() -= Cbar.transpose() * B;
+            Rbar.noalias() -= Dbar.selfadjointView<Lower>() * R;
+            Dbar.diagonal() *= 0.5;
+            Dbar.triangularView<Eigen::StrictlyUpper>().setZero();
+          }
+
+          pos = 0;
+          for (int j = 0; j < M_; ++j)
+            for (int i = j; i < M_; ++i)
+              variRefA_[pos++]->adj_ += Lbar(i, j);
+        }
+      };
+
+    }
+
+    /**
+     * Return the lower-triangular Cholesky factor (i.e., matrix
+     * square root) of the specified square, symmetric matrix.  The
+     * return value \f$L\f$ will be a lower-triangular matrix such
+     * that the original matrix \f$A\f$ is given by
+     * <p>\f$A = L \times L^T\f$.
+     *
+     * <p>The whole decomposition is recorded as a single vari; see
+     * <code>cholesky_decompose_vari</code>.
+     *
+     * @param A Symmetric matrix.
+     * @return Square root of matrix.
+     * @throw std::domain_error if A is not a symmetric matrix.
+     */
+    inline matrix_v
+    cholesky_decompose(const matrix_v& A) {
+      stan::error_handling::check_square("cholesky_decompose", "A", A);
+      stan::error_handling::check_symmetric("cholesky_decompose", "A", A);
+
+      matrix_v L(A.rows(), A.cols());
+      if (A.size() == 0)
+        return L;
+      cholesky_decompose_vari* baseVari = new cholesky_decompose_vari(A);
+      vari* zero = new vari(0.0, false);
+      int pos = 0;
+      for (int j = 0; j < L.cols(); ++j) {
+        for (int i = 0; i < j; ++i)
+          L(i, j).vi_ = zero;
+        for (int i = j; i < L.rows(); ++i)
+          L(i, j).vi_ = baseVari->variRefL_[pos++];
+      }
+      return L;
+    }
+
+  }
+}
+#endif
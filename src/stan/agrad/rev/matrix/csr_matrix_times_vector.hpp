@@ -0,0 +1,69 @@
+#ifndef STAN__AGRAD__REV__MATRIX__CSR_MATRIX_TIMES_VECTOR_HPP
+#define STAN__AGRAD__REV__MATRIX__CSR_MATRIX_TIMES_VECTOR_HPP
+
+#include <vector>
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/math/matrix/csr_matrix_times_vector.hpp>
+#include <stan/error_handling/matrix/check_size_match.hpp>
+#include <stan/agrad/rev/var.hpp>
+#include <stan/agrad/rev/vari.hpp>
+#include <stan/agrad/rev/matrix/dot_product.hpp>
+
+namespace stan {
+  namespace agrad {
+
+    /**
+     * Return the product of the m by n sparse matrix of data in
+     * compressed sparse row form and the specified vector of
+     * variables.
+     *
+     * <p>The non-zero values and the entries of <code>b</code> they
+     * multiply are copied once into the arena, and each row of the
+     * result is a single <code>dot_product_vari</code> over its
+     * segment, so the expression graph has one node per row rather
+     * than one per non-zero.
+     *
+     * @param m Number of rows.
+     * @param n Number of columns.
+     * @param w Non-zero values.
+     * @param v Column index of each non-zero value.
+     * @param u Index in <code>w</code> of the first non-zero value of
+     * each row, followed by one past the last non-zero value.
+     * @param b Vector of size n.
+     * @return Vector of size m.
+     * @throw std::domain_error if the arrays do not describe an m by
+     * n matrix or if b is not of size n.
+     */
+    inline Eigen::Matrix<var,Eigen::Dynamic,1>
+    csr_matrix_times_vector(int m, int n,
+                            const Eigen::Matrix<double,Eigen::Dynamic,1>& w,
+                            const std::vector<int>& v,
+                            const std::vector<int>& u,
+                            const Eigen::Matrix<var,Eigen::Dynamic,1>& b) {
+      stan::math::check_csr("csr_matrix_times_vector", m, n, w.size(), v, u);
+      stan::error_handling::check_size_match("csr_matrix_times_vector",
+                                             "b", b.size(), "n", n);
+      size_t nnz = w.size();
+      double* w_mem = ChainableStack::memalloc_.alloc_array<double>(nnz);
+      vari** b_mem = ChainableStack::memalloc_.alloc_array<vari*>(nnz);
+      for (size_t k = 0; k < nnz; ++k) {
+        w_mem[k] = w(k);
+        b_mem[k] = b(v[k] - 1).vi_;
+      }
+      Eigen::Matrix<var,Eigen::Dynamic,1> result(m);
+      for (int i = 0; i < m; ++i) {
+        size_t start = u[i] - 1;
+        size_t length = u[i + 1] - u[i];
+        if (length == 0)
+          result(i) = 0.0;
+        else
+          result(i) = var(new dot_product_vari<double,var>(w_mem + start,
+                                                           b_mem + start,
+                                                           length));
+      }
+      return result;
+    }
+
+  }
+}
+#endif
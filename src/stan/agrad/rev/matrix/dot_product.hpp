@@ -48,6 +48,19 @@ namespace stan {
           return vd1.dot(vd2);
         }
 
+        inline static double var_dot(double* v1, vari** v2,
+                                     size_t length) {
+          double sum = 0.0;
+          for (size_t i = 0; i < length; i++)
+            sum += v1[i] * v2[i]->val_;
+          return sum;
+        }
+
+        inline static double var_dot(vari** v1, double* v2,
+                                     size_t length) {
+          return var_dot(v2, v1, length);
+        }
+
         inline static double var_dot(const T1* v1, const T2* v2,
                                      size_t length) {
           using stan::math::value_of;
@@ -58,6 +58,102 @@ namespace stan {
       return to_var(m) * to_var(c);
     }
     
+    namespace {
+
+      /**
+       * Copy the values of a matrix into column-major storage,
+       * recording its varis if it holds <code>var</code>.
+       */
+      template <int R, int C>
+      void store_multiply_operand(const Eigen::Matrix<var,R,C>& x,
+                                  double* vals, vari**& refs) {
+        refs = ChainableStack::memalloc_.alloc_array<vari*>(x.size());
+        for (int i = 0; i < x.size(); ++i) {
+          refs[i] = x(i).vi_;
+          vals[i] = x(i).vi_->val_;
+        }
+      }
+
+      template <int R, int C>
+      void store_multiply_operand(const Eigen::Matrix<double,R,C>& x,
+                                  double* vals, vari**& refs) {
+        refs = 0;
+        for (int i = 0; i < x.size(); ++i)
+          vals[i] = x(i);
+      }
+
+      /**
+       * A single vari for the product <code>C = A * B</code> of two
+       * matrices, at least one of which holds <code>var</code>.
+       *
+       * The values of both operands are kept contiguously in the
+       * arena and every element of the result is a non-chaining
+       * vari, so the whole product puts one node on the stack.  The
+       * reverse pass is two matrix products, <code>adjA += adjC *
+       * B'</code> and <code>adjB += A' * adjC</code>.
+       */
+      template <typename T1,int R1,int C1,typename T2,int R2,int C2>
+      class multiply_mat_vari : public vari {
+      public:
+        int M_; // A.rows() = C.rows()
+        int K_; // A.cols() = B.rows()
+        int N_; // B.cols() = C.cols()
+        double* A_;
+        double* B_;
+        vari** variRefA_;
+        vari** variRefB_;
+        vari** variRefC_;
+
+        multiply_mat_vari(const Eigen::Matrix<T1,R1,C1>& A,
+                          const Eigen::Matrix<T2,R2,C2>& B)
+          : vari(0.0),
+            M_(A.rows()),
+            K_(A.cols()),
+            N_(B.cols()),
+            A_(ChainableStack::memalloc_.alloc_array<double>(A.size())),
+            B_(ChainableStack::memalloc_.alloc_array<double>(B.size())),
+            variRefC_(ChainableStack::memalloc_.alloc_array<vari*>(M_ * N_)) {
+          using Eigen::Map;
+          using Eigen::Matrix;
+
+          store_multiply_operand(A, A_, variRefA_);
+          store_multiply_operand(B, B_, variRefB_);
+
+          Matrix<double,R1,C2> C(M_, N_);
+          C.noalias() = Map<Matrix<double,R1,C1> >(A_, M_, K_)
+            * Map<Matrix<double,R2,C2> >(B_, K_, N_);
+          for (int i = 0; i < C.size(); ++i)
+            variRefC_[i] = new vari(C(i), false);
+        }
+
+        virtual void chain() {
+          using Eigen::Map;
+          using Eigen::Matrix;
+
+          Matrix<double,R1,C2> adjC(M_, N_);
+          for (int i = 0; i < adjC.size(); ++i)
+            adjC(i) = variRefC_[i]->adj_;
+
+          if (variRefA_) {
+            Matrix<double,R1,C1> adjA(M_, K_);
+            adjA.noalias() = adjC
+              * Map<Matrix<double,R2,C2> >(B_, K_, N_).transpose();
+            for (int i = 0; i < adjA.size(); ++i)
+              variRefA_[i]->adj_ += adjA(i);
+          }
+
+          if (variRefB_) {
+            Matrix<double,R2,C2> adjB(K_, N_);
+            adjB.noalias() = Map<Matrix<double,R1,C1> >(A_, M_, K_).transpose()
+              * adjC;
+            for (int i = 0; i < adjB.size(); ++i)
+              variRefB_[i]->adj_ += adjB(i);
+          }
+        }
+      };
+
+    }
+
     /**
      * Return the product of the specified matrices.  The number of
      * columns in the first matrix must be the same as the number of rows
@@ -78,33 +174,11 @@ namespace stan {
       stan::error_handling::check_multiplicable("multiply",
                                                 "m1", m1,
                                                 "m2", m2);
-      Eigen::Matrix<var,R1,C2> result(m1.rows(),m2.cols());
-      for (int i = 0; i < m1.rows(); i++) {
-        typename Eigen::Matrix<T1,R1,C1>::ConstRowXpr crow(m1.row(i));
-        for (int j = 0; j < m2.cols(); j++) {
-          typename Eigen::Matrix<T2,R2,C2>::ConstColXpr ccol(m2.col(j));
-          if (j == 0) {
-            if (i == 0) {
-              result(i,j) = var(new dot_product_vari<T1,T2>(crow,ccol));
-            }
-            else {
-              dot_product_vari<T1,T2> *v2 = static_cast<dot_product_vari<T1,T2>*>(result(0,j).vi_);
-              result(i,j) = var(new dot_product_vari<T1,T2>(crow,ccol,NULL,v2));
-            }
-          }
-          else { 
-            if (i == 0) {
-              dot_product_vari<T1,T2> *v1 = static_cast<dot_product_vari<T1,T2>*>(result(i,0).vi_);
-              result(i,j) = var(new dot_product_vari<T1,T2>(crow,ccol,v1,NULL));
-            }
-            else /* if (i != 0 && j != 0) */ {
-              dot_product_vari<T1,T2> *v1 = static_cast<dot_product_vari<T1,T2>*>(result(i,0).vi_);
-              dot_product_vari<T1,T2> *v2 = static_cast<dot_product_vari<T1,T2>*>(result(0,j).vi_);
-              result(i,j) = var(new dot_product_vari<T1,T2>(crow,ccol,v1,v2));
-            }
-          }
-        }
-      }
+      multiply_mat_vari<T1,R1,C1,T2,R2,C2>* baseVari
+        = new multiply_mat_vari<T1,R1,C1,T2,R2,C2>(m1, m2);
+      Eigen::Matrix<var,R1,C2> result(m1.rows(), m2.cols());
+      for (int i = 0; i < result.size(); ++i)
+        result(i).vi_ = baseVari->variRefC_[i];
       return result;
     }
 
@@ -2,5 +2,6 @@
 #define STAN__AGRAD__REV__ODE_HPP
 
 #include <stan/agrad/rev/ode/coupled_ode_system.hpp>
+#include <stan/agrad/rev/ode/integrate_ode_stiff.hpp>
 
 #endif
@@ -8,6 +8,7 @@
 #include <stan/agrad/rev/operators/operator_plus_equal.hpp>
 #include <stan/error_handling/scalar/check_equal.hpp>
 #include <stan/error_handling/matrix/check_matching_sizes.hpp>
+#include <stan/math/matrix/Eigen.hpp>
 #include <stan/math/ode/coupled_ode_system.hpp>
 #include <stan/meta/traits.hpp>
 
@@ -38,6 +39,90 @@ namespace stan {
           y[n][m] += y0[m];
     }
     
+    namespace {
+      inline double ode_adjoint(const stan::agrad::var& x) {
+        return x.adj();
+      }
+
+      inline double ode_adjoint(double /* x */) {
+        return 0;
+      }
+    }
+
+    /**
+     * Return the derivatives of the base ODE system at the specified
+     * time, state and parameters, and assign its Jacobian.
+     *
+     * <p>The first N columns of the Jacobian hold the partials with
+     * respect to the N states.  If <code>T_theta</code> is
+     * <code>stan::agrad::var</code>, the M columns after them hold
+     * the partials with respect to the parameters.
+     *
+     * <p>The system is recorded once on a nested autodiff stack, and
+     * each row of the Jacobian is read off that stack with one
+     * reverse sweep.
+     *
+     * @tparam T_theta type of parameters passed to the system.
+     * @tparam F type of functor for the base ODE system.
+     * @param[in] f functor for the base ODE system.
+     * @param[in] t time.
+     * @param[in] y state of the base system.
+     * @param[in] theta parameters.
+     * @param[in] x real data.
+     * @param[in] x_int integer data.
+     * @param[in,out] msgs stream to which messages are printed.
+     * @param[out] jacobian Jacobian of the base system.
+     * @return derivatives of the base system.
+     * @throw exception if the system function does not return the
+     * same number of derivatives as the state vector size.
+     */
+    template <typename T_theta, typename F>
+    std::vector<double>
+    ode_system_jacobian(const F& f,
+                        double t,
+                        const std::vector<double>& y,
+                        const std::vector<double>& theta,
+                        const std::vector<double>& x,
+                        const std::vector<int>& x_int,
+                        std::ostream* msgs,
+                        Eigen::MatrixXd& jacobian) {
+      using std::vector;
+      using stan::agrad::var;
+
+      const int N = y.size();
+      const int M = stan::is_constant<T_theta>::value ? 0 : theta.size();
+      vector<double> dy_dt(N);
+      jacobian.resize(N, N + M);
+
+      try {
+        stan::agrad::start_nested();
+
+        vector<var> y_temp(y.begin(), y.end());
+        vector<T_theta> theta_temp(theta.begin(), theta.end());
+        vector<var> dy_dt_temp = f(t,y_temp,theta_temp,x,x_int,msgs);
+        stan::error_handling::check_equal("coupled_ode_system",
+                                          "dy_dt", dy_dt_temp.size(), N);
+
+        for (int i = 0; i < N; i++) {
+          dy_dt[i] = dy_dt_temp[i].val();
+          if (i > 0)
+            stan::agrad::set_zero_all_adjoints_nested();
+          stan::agrad::grad(dy_dt_temp[i].vi_);
+
+          for (int j = 0; j < N; j++)
+            jacobian(i,j) = y_temp[j].adj();
+          for (int j = 0; j < M; j++)
+            jacobian(i,N + j) = ode_adjoint(theta_temp[j]);
+        }
+      } catch (const std::exception& e) {
+        stan::agrad::recover_memory_nested();
+        throw;
+      }
+      stan::agrad::recover_memory_nested();
+
+      return dy_dt;
+    }
+
     /**
      * The coupled ODE system for known initial values and unknown
      * parameters. 
@@ -126,53 +211,23 @@ namespace stan {
         using std::vector;
         using stan::agrad::var;
 
-        vector<double> y_base(y.begin(), y.begin()+N_);
-        dy_dt = f_(t,y_base,theta_dbl_,x_,x_int_,msgs_);
-        stan::error_handling::check_equal("coupled_ode_system",
-                                          "dy_dt", dy_dt.size(), N_);
+        vector<double> y_base(y.begin(), y.begin() + N_);
+        Eigen::MatrixXd jacobian;
+        dy_dt = ode_system_jacobian<var>(f_,t,y_base,theta_dbl_,x_,x_int_,msgs_,
+                                         jacobian);
 
         vector<double> coupled_sys(N_ * M_);
-        vector<var> theta_temp;
-        vector<var> y_temp;
-        vector<var> dy_dt_temp;
-        vector<double> grad;
-        vector<var> vars;
-
         for (int i = 0; i < N_; i++) {
-          theta_temp.clear();
-          y_temp.clear();
-          dy_dt_temp.clear();
-          grad.clear();
-          vars.clear();
-          try {
-            stan::agrad::start_nested();
-            for (int j = 0; j < N_; j++) {
-              y_temp.push_back(y[j]);
-              vars.push_back(y_temp[j]);
-            }
-
-            for (int j = 0; j < M_; j++) {
-              theta_temp.push_back(theta_dbl_[j]);
-              vars.push_back(theta_temp[j]);
-            }
-            dy_dt_temp = f_(t,y_temp,theta_temp,x_,x_int_,msgs_);
-            dy_dt_temp[i].grad(vars, grad);
-          
-            for (int j = 0; j < M_; j++) { 
-              // orders derivatives by equation (i.e. if there are 2 eqns 
-              // (y1, y2) and 2 parameters (a, b), dy_dt will be ordered as: 
-              // dy1_dt, dy2_dt, dy1_da, dy2_da, dy1_db, dy2_db
-              double temp_deriv = grad[y_temp.size() + j];
-              for (int k = 0; k < N_; k++)
-                temp_deriv += y[N_ + N_ * j + k] * grad[k];
-
-              coupled_sys[i + j * N_] = temp_deriv;
-            }
-          } catch (const std::exception& e) {
-            stan::agrad::recover_memory_nested();
-            throw;
+          for (int j = 0; j < M_; j++) { 
+            // orders derivatives by equation (i.e. if there are 2 eqns 
+            // (y1, y2) and 2 parameters (a, b), dy_dt will be ordered as: 
+            // dy1_dt, dy2_dt, dy1_da, dy2_da, dy1_db, dy2_db
+            double temp_deriv = jacobian(i,N_ + j);
+            for (int k = 0; k < N_; k++)
+              temp_deriv += y[N_ + N_ * j + k] * jacobian(i,k);
+
+            coupled_sys[i + j * N_] = temp_deriv;
           }
-          stan::agrad::recover_memory_nested();
         }
 
         dy_dt.insert(dy_dt.end(), coupled_sys.begin(), coupled_sys.end());
@@ -340,51 +395,28 @@ namespace stan {
       void operator()(const std::vector<double>& y,
                       std::vector<double>& dy_dt,
                       double t) {
-        std::vector<double> y_base(y.begin(), y.begin() + N_);
+        using std::vector;
+        using stan::agrad::var;
+
+        vector<double> y_base(y.begin(), y.begin() + N_);
         for (int n = 0; n < N_; n++)
           y_base[n] += y0_dbl_[n];
+        Eigen::MatrixXd jacobian;
+        dy_dt = ode_system_jacobian<double>(f_,t,y_base,theta_dbl_,x_,x_int_,
+                                            msgs_,jacobian);
 
-        dy_dt = f_(t,y_base,theta_dbl_,x_,x_int_,msgs_);
-        stan::error_handling::check_equal("coupled_ode_system",
-                                          "dy_dt", dy_dt.size(), N_);
-
-        std::vector<double> coupled_sys(N_ * N_);
-
-        std::vector<stan::agrad::var> y_temp;
-        std::vector<stan::agrad::var> dy_dt_temp;
-        std::vector<double> grad;
-        std::vector<stan::agrad::var> vars;
-
+        vector<double> coupled_sys(N_ * N_);
         for (int i = 0; i < N_; i++) {
-          y_temp.clear();
-          dy_dt_temp.clear();
-          grad.clear();
-          vars.clear();
-          try {
-            stan::agrad::start_nested();
-            for (int j = 0; j < N_; j++) {
-              y_temp.push_back(y[j] + y0_dbl_[j]);
-              vars.push_back(y_temp[j]);
-            }
-
-            dy_dt_temp = f_(t,y_temp,theta_dbl_,x_,x_int_,msgs_);
-            dy_dt_temp[i].grad(vars, grad);
-
-            for (int j = 0; j < N_; j++) { 
-              // orders derivatives by equation (i.e. if there are 2 eqns 
-              // (y1, y2) and 2 parameters (a, b), dy_dt will be ordered as: 
-              // dy1_dt, dy2_dt, dy1_da, dy2_da, dy1_db, dy2_db
-              double temp_deriv = grad[j];
-              for (int k = 0; k < N_; k++)
-                temp_deriv += y[N_ + N_ * j + k] * grad[k];
-
-              coupled_sys[i+j*N_] = temp_deriv;
-            }
-          } catch (const std::exception& e) {
-            stan::agrad::recover_memory_nested();
-            throw;
+          for (int j = 0; j < N_; j++) { 
+            // orders derivatives by equation (i.e. if there are 2 eqns 
+            // (y1, y2) and 2 parameters (a, b), dy_dt will be ordered as: 
+            // dy1_dt, dy2_dt, dy1_da, dy2_da, dy1_db, dy2_db
+            double temp_deriv = jacobian(i,j);
+            for (int k = 0; k < N_; k++)
+              temp_deriv += y[N_ + N_ * j + k] * jacobian(i,k);
+
+            coupled_sys[i + j * N_] = temp_deriv;
           }
-          stan::agrad::recover_memory_nested();
         }
 
         dy_dt.insert(dy_dt.end(), coupled_sys.begin(), coupled_sys.end());
@@ -570,60 +602,28 @@ namespace stan {
                       double t) {
         using std::vector;
         using stan::agrad::var;
-          
-        vector<double> y_base(y.begin(), y.begin()+N_);
+
+        vector<double> y_base(y.begin(), y.begin() + N_);
         for (int n = 0; n < N_; n++)
           y_base[n] += y0_dbl_[n];
-
-        dy_dt = f_(t,y_base,theta_dbl_,x_,x_int_,msgs_);
-        stan::error_handling::check_equal("coupled_ode_system",
-                                          "dy_dt", dy_dt.size(), N_);
+        Eigen::MatrixXd jacobian;
+        dy_dt = ode_system_jacobian<var>(f_,t,y_base,theta_dbl_,x_,x_int_,msgs_,
+                                         jacobian);
 
         vector<double> coupled_sys(N_ * (N_ + M_));
-        vector<var> theta_temp;
-        vector<var> y_temp;
-        vector<var> dy_dt_temp;
-        vector<double> grad;
-        vector<var> vars;
-
         for (int i = 0; i < N_; i++) {
-          theta_temp.clear();
-          y_temp.clear();
-          dy_dt_temp.clear();
-          grad.clear();
-          vars.clear();
-          try {
-            stan::agrad::start_nested();
-
-            for (int j = 0; j < N_; j++) {
-              y_temp.push_back(y[j] + y0_dbl_[j]);
-              vars.push_back(y_temp[j]);
-            }
-
-            for (int j = 0; j < M_; j++) {
-              theta_temp.push_back(theta_dbl_[j]);
-              vars.push_back(theta_temp[j]);
-            }
-
-            dy_dt_temp = f_(t,y_temp,theta_temp,x_,x_int_,msgs_);
-            dy_dt_temp[i].grad(vars, grad);
-
-            for (int j = 0; j < N_+M_; j++) { 
-              // orders derivatives by equation (i.e. if there are 2 eqns 
-              // (y1, y2) and 2 parameters (a, b), dy_dt will be ordered as: 
-              // dy1_dt, dy2_dt, dy1_da, dy2_da, dy1_db, dy2_db
-              double temp_deriv = grad[j];
-              for (int k = 0; k < N_; k++)
-                temp_deriv += y[N_ + N_ * j + k] * grad[k];
-
-              coupled_sys[i + j * N_] = temp_deriv;
-            }
-          } catch (const std::exception& e) {
-            stan::agrad::recover_memory_nested();
-            throw;
+          for (int j = 0; j < N_ + M_; j++) { 
+            // orders derivatives by equation (i.e. if there are 2 eqns 
+            // (y1, y2) and 2 parameters (a, b), dy_dt will be ordered as: 
+            // dy1_dt, dy2_dt, dy1_da, dy2_da, dy1_db, dy2_db
+            double temp_deriv = jacobian(i,j);
+            for (int k = 0; k < N_; k++)
+              temp_deriv += y[N_ + N_ * j + k] * jacobian(i,k);
+
+            coupled_sys[i + j * N_] = temp_deriv;
           }
-          stan::agrad::recover_memory_nested();
         }
+
         dy_dt.insert(dy_dt.end(), coupled_sys.begin(), coupled_sys.end());
       }
 
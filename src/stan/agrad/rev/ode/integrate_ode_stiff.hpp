@@ -0,0 +1,320 @@
+#ifndef STAN__AGRAD__REV__ODE__INTEGRATE_ODE_STIFF_HPP
+#define STAN__AGRAD__REV__ODE__INTEGRATE_ODE_STIFF_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+#include <vector>
+#include <boost/numeric/odeint.hpp>
+#include <stan/agrad/fwd.hpp>
+#include <stan/agrad/rev.hpp>
+#include <stan/agrad/rev/functions/value_of.hpp>
+#include <stan/agrad/rev/ode/coupled_ode_system.hpp>
+#include <stan/error_handling/scalar/check_equal.hpp>
+#include <stan/error_handling/scalar/check_finite.hpp>
+#include <stan/error_handling/scalar/check_less.hpp>
+#include <stan/error_handling/scalar/check_positive.hpp>
+#include <stan/error_handling/scalar/dom_err.hpp>
+#include <stan/error_handling/matrix/check_nonzero_size.hpp>
+#include <stan/error_handling/matrix/check_ordered.hpp>
+#include <stan/math/functions/value_of.hpp>
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/meta/traits.hpp>
+
+namespace stan {
+
+  namespace math {
+
+    // This code is in this directory because it includes agrad::var
+    // through the coupled system's Jacobian.
+
+    /**
+     * Right-hand side of a coupled ODE system in the form required
+     * by the implicit <code>boost::numeric::odeint</code> steppers,
+     * which store states in uBLAS vectors.
+     *
+     * @tparam F type of functor for the base ODE system.
+     * @tparam T1 type of scalars for initial values.
+     * @tparam T2 type of scalars for parameters.
+     */
+    template <typename F, typename T1, typename T2>
+    struct stiff_ode_system {
+      coupled_ode_system<F, T1, T2>& coupled_system_;
+
+      explicit stiff_ode_system(coupled_ode_system<F, T1, T2>& coupled_system)
+        : coupled_system_(coupled_system) { }
+
+      void operator()(const boost::numeric::ublas::vector<double>& y,
+                      boost::numeric::ublas::vector<double>& dy_dt,
+                      double t) const {
+        std::vector<double> y_vec(y.begin(), y.end());
+        std::vector<double> dy_dt_vec;
+        coupled_system_(y_vec, dy_dt_vec, t);
+        std::copy(dy_dt_vec.begin(), dy_dt_vec.end(), dy_dt.begin());
+      }
+    };
+
+    /**
+     * Jacobian of a coupled ODE system with respect to its state, in
+     * the form required by the implicit
+     * <code>boost::numeric::odeint</code> steppers.
+     *
+     * <p>The coupled system holds the N base states followed by one
+     * block of N sensitivities for each of the P unknowns.  Block j
+     * evolves as the derivative of the base system in the direction
+     * of its sensitivities and unknown j, so the base system is
+     * recorded on a nested stack with <code>fvar&lt;var&gt;</code>
+     * scalars whose tangents are that direction.  Reverse sweeps from
+     * the values of the derivatives give the Jacobian of the base
+     * system, which is the top-left block and every diagonal
+     * sensitivity block, and their derivative with respect to time.
+     * Reverse sweeps from the tangents give the exact derivatives of
+     * block j with respect to the base states and time.  One
+     * recording is made per unknown.
+     *
+     * @tparam F type of functor for the base ODE system.
+     * @tparam T1 type of scalars for initial values.
+     * @tparam T2 type of scalars for parameters.
+     */
+    template <typename F, typename T1, typename T2>
+    struct stiff_ode_jacobian {
+      const F& f_;
+      std::vector<double> y0_dbl_;
+      std::vector<double> theta_dbl_;
+      const std::vector<double>& x_;
+      const std::vector<int>& x_int_;
+      std::ostream* msgs_;
+      const int N_;
+      const int P_;
+      const int offset_;
+
+      /**
+       * Construct the Jacobian of the coupled system for the
+       * specified base system, initial state, parameters and data.
+       *
+       * @param[in] f functor for the base ODE system.
+       * @param[in] y0 initial state of the base system.
+       * @param[in] theta parameters of the base system.
+       * @param[in] x real data.
+       * @param[in] x_int integer data.
+       * @param[in,out] msgs stream to which messages are printed.
+       */
+      stiff_ode_jacobian(const F& f,
+                         const std::vector<T1>& y0,
+                         const std::vector<T2>& theta,
+                         const std::vector<double>& x,
+                         const std::vector<int>& x_int,
+                         std::ostream* msgs)
+        : f_(f),
+          y0_dbl_(y0.size(), 0.0),
+          theta_dbl_(theta.size()),
+          x_(x),
+          x_int_(x_int),
+          msgs_(msgs),
+          N_(y0.size()),
+          P_((stan::is_constant<T1>::value ? 0 : y0.size())
+             + (stan::is_constant<T2>::value ? 0 : theta.size())),
+          offset_(stan::is_constant<T1>::value ? y0.size() : 0) {
+        using stan::agrad::value_of;
+        using stan::math::value_of;
+        // the coupled system subtracts out an unknown initial state
+        if (!stan::is_constant<T1>::value)
+          for (int n = 0; n < N_; n++)
+            y0_dbl_[n] = value_of(y0[n]);
+        for (size_t m = 0; m < theta.size(); m++)
+          theta_dbl_[m] = value_of(theta[m]);
+      }
+
+      void operator()(const boost::numeric::ublas::vector<double>& y,
+                      boost::numeric::ublas::matrix<double>& J,
+                      double t,
+                      boost::numeric::ublas::vector<double>& dfdt) const {
+        using std::vector;
+        using stan::agrad::fvar;
+        using stan::agrad::var;
+
+        for (size_t i = 0; i < J.size1(); i++)
+          for (size_t k = 0; k < J.size2(); k++)
+            J(i,k) = 0;
+
+        // the base system alone still needs one recording
+        for (int j = 0; j < std::max(P_, 1); j++) {
+          try {
+            stan::agrad::start_nested();
+
+            fvar<var> t_fvar(t, 0.0);
+            vector<fvar<var> > y_fvar;
+            for (int n = 0; n < N_; n++)
+              y_fvar.push_back(fvar<var>(y[n] + y0_dbl_[n],
+                                         P_ > 0 ? y[N_ + N_ * j + n] : 0.0));
+            vector<fvar<var> > theta_fvar;
+            for (size_t m = 0; m < theta_dbl_.size(); m++)
+              theta_fvar.push_back(fvar<var>(theta_dbl_[m], 0.0));
+            if (P_ > 0) {
+              if (offset_ + j < N_)
+                y_fvar[offset_ + j].d_ += 1;
+              else
+                theta_fvar[offset_ + j - N_].d_ += 1;
+            }
+
+            vector<fvar<var> > dy_dt
+              = f_(t_fvar, y_fvar, theta_fvar, x_, x_int_, msgs_);
+            stan::error_handling::check_equal("integrate_ode_stiff", "dy_dt",
+                                              static_cast<int>(dy_dt.size()),
+                                              N_);
+
+            for (int i = 0; i < N_; i++) {
+              if (j == 0) {
+                stan::agrad::set_zero_all_adjoints_nested();
+                stan::agrad::grad(dy_dt[i].val_.vi_);
+                for (int b = 0; b <= P_; b++)
+                  for (int k = 0; k < N_; k++)
+                    J(N_ * b + i, N_ * b + k) = y_fvar[k].val_.adj();
+                dfdt[i] = t_fvar.val_.adj();
+              }
+              if (P_ > 0) {
+                stan::agrad::set_zero_all_adjoints_nested();
+                stan::agrad::grad(dy_dt[i].d_.vi_);
+                for (int k = 0; k < N_; k++)
+                  J(N_ + N_ * j + i, k) = y_fvar[k].val_.adj();
+                dfdt[N_ + N_ * j + i] = t_fvar.val_.adj();
+              }
+            }
+          } catch (const std::exception& e) {
+            stan::agrad::recover_memory_nested();
+            throw;
+          }
+          stan::agrad::recover_memory_nested();
+        }
+      }
+    };
+
+    /**
+     * Return the solutions for the specified system of stiff
+     * ordinary differential equations given the specified initial
+     * state, initial time, times of desired solution, and parameters
+     * and data, writing error and warning messages to the specified
+     * stream.
+     *
+     * <p>This function has the same arguments and return value as
+     * <code>integrate_ode()</code>, but uses the implicit fourth-order
+     * Rosenbrock method implemented by Boost's
+     * <code>boost::numeric::odeint::rosenbrock4</code> integrator,
+     * which takes far fewer steps when the system has widely varying
+     * time scales.  The Jacobian it requires is computed exactly from
+     * the coupled sensitivity system with forward-over-reverse
+     * automatic differentiation, so the system function must accept
+     * <code>fvar&lt;var&gt;</code> arguments.
+     *
+     * @tparam F type of ODE system function.
+     * @tparam T1 type of scalars for initial values.
+     * @tparam T2 type of scalars for parameters.
+     * @param[in] f functor for the base ordinary differential equation.
+     * @param[in] y0 initial state.
+     * @param[in] t0 initial time.
+     * @param[in] ts times of the desired solutions, in strictly
+     * increasing order, all greater than the initial time.
+     * @param[in] theta parameter vector for the ODE.
+     * @param[in] x continuous data vector for the ODE.
+     * @param[in] x_int integer data vector for the ODE.
+     * @param[in,out] msgs the print stream for warning messages.
+     * @param[in] relative_tolerance relative error tolerance of each
+     * step.
+     * @param[in] absolute_tolerance absolute error tolerance of each
+     * step.
+     * @param[in] max_num_steps maximum number of steps taken before
+     * an exception is thrown.
+     * @return a vector of states, each state being a vector of the
+     * same size as the state variable, corresponding to a time in ts.
+     * @throw std::domain_error if the solution is not reached within
+     * the maximum number of steps.
+     */
+    template <typename F, typename T1, typename T2>
+    std::vector<std::vector<typename stan::return_type<T1,T2>::type> >
+    integrate_ode_stiff(const F& f,
+                        const std::vector<T1> y0,
+                        const double t0,
+                        const std::vector<double>& ts,
+                        const std::vector<T2>& theta,
+                        const std::vector<double>& x,
+                        const std::vector<int>& x_int,
+                        std::ostream* msgs,
+                        const double relative_tolerance = 1e-6,
+                        const double absolute_tolerance = 1e-6,
+                        const int max_num_steps = 100000) {
+      using boost::numeric::odeint::make_dense_output;
+      using boost::numeric::odeint::rosenbrock4;
+      using boost::numeric::odeint::rosenbrock4_controller;
+      using boost::numeric::odeint::rosenbrock4_dense_output;
+      typedef boost::numeric::ublas::vector<double> state_t;
+
+      const char* function = "integrate_ode_stiff";
+      stan::error_handling::check_finite(function, "initial state", y0);
+      stan::error_handling::check_finite(function, "initial time", t0);
+      stan::error_handling::check_finite(function, "times", ts);
+      stan::error_handling::check_finite(function, "parameter vector", theta);
+      stan::error_handling::check_finite(function, "continuous data", x);
+      stan::error_handling::check_positive(function, "relative tolerance",
+                                           relative_tolerance);
+      stan::error_handling::check_positive(function, "absolute tolerance",
+                                           absolute_tolerance);
+      stan::error_handling::check_positive(function, "max_num_steps",
+                                           max_num_steps);
+
+      stan::error_handling::check_nonzero_size(function, "times", ts);
+      stan::error_handling::check_nonzero_size(function, "initial state", y0);
+      stan::error_handling::check_ordered(function, "times", ts);
+      stan::error_handling::check_less(function, "initial time", t0, ts[0]);
+
+      // a trial step for the fourth-order method that is small
+      // relative to the first output interval at tight tolerances;
+      // the step size controller adapts it from there
+      const double initial_step_size
+        = (ts[0] - t0)
+        * std::pow(std::min(relative_tolerance, absolute_tolerance), 0.25);
+
+      // creates basic or coupled system by template specializations
+      coupled_ode_system<F, T1, T2>
+        coupled_system(f, y0, theta, x, x_int, msgs);
+      stiff_ode_system<F, T1, T2> system(coupled_system);
+      stiff_ode_jacobian<F, T1, T2> jacobian(f, y0, theta, x, x_int, msgs);
+
+      std::vector<double> initial_coupled_state
+        = coupled_system.initial_state();
+      state_t state(initial_coupled_state.size());
+      std::copy(initial_coupled_state.begin(), initial_coupled_state.end(),
+                state.begin());
+
+      rosenbrock4_dense_output<rosenbrock4_controller<rosenbrock4<double> > >
+        stepper = make_dense_output(absolute_tolerance, relative_tolerance,
+                                    rosenbrock4<double>());
+      stepper.initialize(state, t0, initial_step_size);
+
+      // steps past each output time and interpolates back to it
+      std::vector<std::vector<double> > y_coupled(ts.size());
+      int num_steps = 0;
+      for (size_t n = 0; n < ts.size(); ) {
+        if (ts[n] <= stepper.current_time()) {
+          stepper.calc_state(ts[n], state);
+          y_coupled[n].assign(state.begin(), state.end());
+          n++;
+        } else {
+          if (num_steps == max_num_steps)
+            stan::error_handling::dom_err(function, "max_num_steps",
+                                          max_num_steps, "is ",
+                                          ", but the output times were not"
+                                          " reached");
+          stepper.do_step(std::make_pair(system, jacobian));
+          num_steps++;
+        }
+      }
+
+      // the coupled system also encapsulates the decoupling operation
+      return coupled_system.decouple_states(y_coupled);
+    }
+
+  }
+
+}
+
+#endif
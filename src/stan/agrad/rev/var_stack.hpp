@@ -5,37 +5,52 @@
 #include <vector>
 #include <stan/memory/stack_alloc.hpp>
 
+/**
+ * When <code>STAN_THREADS</code> is defined, every thread gets its
+ * own autodiff stack and arena, so that gradients may be evaluated
+ * concurrently on separate threads.  Expressions may not be shared
+ * across threads.  Requires C++11 <code>thread_local</code>.
+ */
+#ifdef STAN_THREADS
+#if __cplusplus < 201103L && !defined(_MSC_VER)
+#error "STAN_THREADS requires C++11 thread_local support"
+#endif
+#define STAN_THREADS_DEF thread_local
+#else
+#define STAN_THREADS_DEF
+#endif
+
 namespace stan {
   namespace agrad {
 
     template<typename ChainableT,
              typename ChainableAllocT>
     struct AutodiffStackStorage {
-      static std::vector<ChainableT*> var_stack_;
-      static std::vector<ChainableT*> var_nochain_stack_;
-      static std::vector<ChainableAllocT*> var_alloc_stack_;
-      static memory::stack_alloc memalloc_;
+      static STAN_THREADS_DEF std::vector<ChainableT*> var_stack_;
+      static STAN_THREADS_DEF std::vector<ChainableT*> var_nochain_stack_;
+      static STAN_THREADS_DEF std::vector<ChainableAllocT*> var_alloc_stack_;
+      static STAN_THREADS_DEF memory::stack_alloc memalloc_;
 
       // nested positions
-      static std::vector<size_t> nested_var_stack_sizes_;
-      static std::vector<size_t> nested_var_nochain_stack_sizes_;
-      static std::vector<size_t> nested_var_alloc_stack_starts_;
+      static STAN_THREADS_DEF std::vector<size_t> nested_var_stack_sizes_;
+      static STAN_THREADS_DEF std::vector<size_t> nested_var_nochain_stack_sizes_;
+      static STAN_THREADS_DEF std::vector<size_t> nested_var_alloc_stack_starts_;
     };
 
     template<typename ChainableT, typename ChainableAllocT>
-    std::vector<ChainableT*> AutodiffStackStorage<ChainableT,ChainableAllocT>::var_stack_;
+    STAN_THREADS_DEF std::vector<ChainableT*> AutodiffStackStorage<ChainableT,ChainableAllocT>::var_stack_;
     template<typename ChainableT, typename ChainableAllocT>
-    std::vector<ChainableT*> AutodiffStackStorage<ChainableT,ChainableAllocT>::var_nochain_stack_;
+    STAN_THREADS_DEF std::vector<ChainableT*> AutodiffStackStorage<ChainableT,ChainableAllocT>::var_nochain_stack_;
     template<typename ChainableT, typename ChainableAllocT>
-    std::vector<ChainableAllocT*> AutodiffStackStorage<ChainableT,ChainableAllocT>::var_alloc_stack_;
+    STAN_THREADS_DEF std::vector<ChainableAllocT*> AutodiffStackStorage<ChainableT,ChainableAllocT>::var_alloc_stack_;
     template<typename ChainableT, typename ChainableAllocT>
-    memory::stack_alloc AutodiffStackStorage<ChainableT,ChainableAllocT>::memalloc_;
+    STAN_THREADS_DEF memory::stack_alloc AutodiffStackStorage<ChainableT,ChainableAllocT>::memalloc_;
     template<typename ChainableT, typename ChainableAllocT>
-    std::vector<size_t> AutodiffStackStorage<ChainableT,ChainableAllocT>::nested_var_stack_sizes_;
+    STAN_THREADS_DEF std::vector<size_t> AutodiffStackStorage<ChainableT,ChainableAllocT>::nested_var_stack_sizes_;
     template<typename ChainableT, typename ChainableAllocT>
-    std::vector<size_t> AutodiffStackStorage<ChainableT,ChainableAllocT>::nested_var_nochain_stack_sizes_;
+    STAN_THREADS_DEF std::vector<size_t> AutodiffStackStorage<ChainableT,ChainableAllocT>::nested_var_nochain_stack_sizes_;
     template<typename ChainableT, typename ChainableAllocT>
-    std::vector<size_t> AutodiffStackStorage<ChainableT,ChainableAllocT>::nested_var_alloc_stack_starts_;
+    STAN_THREADS_DEF std::vector<size_t> AutodiffStackStorage<ChainableT,ChainableAllocT>::nested_var_alloc_stack_starts_;
 
     // forward declaration of chainable
     class chainable;
@@ -1,8 +1,11 @@
 #ifndef STAN__COMMON__COMMAND_HPP
 #define STAN__COMMON__COMMAND_HPP
 
+#include <algorithm>
 #include <fstream>
+#include <sstream>
 #include <stdexcept>
+#include <vector>
 
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
@@ -11,9 +14,11 @@
 
 #include <stan/version.hpp>
 #include <stan/io/cmd_line.hpp>
+#include <stan/io/csv_writer.hpp>
 #include <stan/io/dump.hpp>
 #include <stan/io/json.hpp>
 #include <stan/io/mcmc_writer.hpp>
+#include <stan/io/stan_csv_reader.hpp>
 
 #include <stan/gm/arguments/argument_parser.hpp>
 #include <stan/gm/arguments/arg_id.hpp>
@@ -23,14 +28,10 @@
 #include <stan/gm/arguments/arg_output.hpp>
 
 #include <stan/mcmc/fixed_param_sampler.hpp>
-#include <stan/mcmc/hmc/static/adapt_unit_e_static_hmc.hpp>
-#include <stan/mcmc/hmc/static/adapt_diag_e_static_hmc.hpp>
-#include <stan/mcmc/hmc/static/adapt_dense_e_static_hmc.hpp>
-#include <stan/mcmc/hmc/nuts/adapt_unit_e_nuts.hpp>
-#include <stan/mcmc/hmc/nuts/adapt_diag_e_nuts.hpp>
-#include <stan/mcmc/hmc/nuts/adapt_dense_e_nuts.hpp>
 
 #include <stan/model/util.hpp>
+#include <stan/model/log_prob_batch.hpp>
+#include <stan/model/write_array_batch.hpp>
 
 #include <stan/optimization/newton.hpp>
 #include <stan/optimization/bfgs.hpp>
@@ -42,6 +43,7 @@
 #include <stan/common/write_error_msg.hpp>
 #include <stan/common/do_print.hpp>
 #include <stan/common/do_bfgs_optimize.hpp>
+#include <stan/common/do_bfgs_multistart.hpp>
 #include <stan/common/print_progress.hpp>
 #include <stan/common/run_markov_chain.hpp>
 #include <stan/common/warmup.hpp>
@@ -50,10 +52,16 @@
 #include <stan/common/init_nuts.hpp>
 #include <stan/common/init_adapt.hpp>
 #include <stan/common/init_windowed_adapt.hpp>
+#include <stan/common/init_sampler.hpp>
+#include <stan/common/run_sampler.hpp>
+#include <stan/common/run_chains.hpp>
+#include <stan/common/write_chains_summary.hpp>
+#include <stan/common/recorder/binary.hpp>
 #include <stan/common/recorder/csv.hpp>
 #include <stan/common/recorder/messages.hpp>
 #include <stan/common/initialize_state.hpp>
 #include <stan/common/context_factory.hpp>
+#include <stan/common/unconstrain_draws.hpp>
 
 namespace stan {
 
@@ -63,6 +71,57 @@ namespace stan {
       void operator()() { }
     };
 
+    /**
+     * The files written by each chain.  They are closed and deleted,
+     * after the binary recorders have written any draws they still
+     * buffer, when the owner goes out of scope, so every return from
+     * <code>command()</code> releases them.
+     */
+    struct chain_output_files {
+      std::vector<std::fstream*> output_streams;
+      std::vector<std::fstream*> diagnostic_streams;
+      std::vector<stan::common::recorder::binary*> binary_recorders;
+
+      explicit chain_output_files(int num_chains)
+        : output_streams(num_chains, static_cast<std::fstream*>(0)),
+          diagnostic_streams(num_chains, static_cast<std::fstream*>(0)),
+          binary_recorders(num_chains,
+                           static_cast<stan::common::recorder::binary*>(0)) { }
+
+      ~chain_output_files() {
+        for (size_t chain = 0; chain < output_streams.size(); ++chain) {
+          delete binary_recorders[chain];
+          
+          if (output_streams[chain]) {
+            output_streams[chain]->close();
+            delete output_streams[chain];
+          }
+          
+          if (diagnostic_streams[chain]) {
+            diagnostic_streams[chain]->close();
+            delete diagnostic_streams[chain];
+          }
+        }
+      }
+    };
+
+    /**
+     * Objects allocated for each chain, which are deleted when this
+     * goes out of scope, so they are released even if a chain throws.
+     */
+    template <typename T>
+    struct chain_objects {
+      std::vector<T*> objects;
+
+      explicit chain_objects(int num_chains)
+        : objects(num_chains, static_cast<T*>(0)) { }
+
+      ~chain_objects() {
+        for (size_t chain = 0; chain < objects.size(); ++chain)
+          delete objects[chain];
+      }
+    };
+
     template <class Model>
     int command(int argc, const char* argv[]) {
 
@@ -126,24 +185,63 @@ namespace stan {
       stan::io::dump data_var_context(data_stream);
       data_stream.close();
       
+      // Chains sampled in this process share the model and data
+      int num_chains = 1;
+      if (parser.arg("method")->arg("sample"))
+        num_chains = dynamic_cast<stan::gm::int_argument*>(
+                     parser.arg("method")->arg("sample")->arg("num_chains"))->value();
+      
       // Sample output
       std::string output_file = dynamic_cast<stan::gm::string_argument*>(
                                 parser.arg("output")->arg("file"))->value();
-      std::fstream* output_stream = 0;
+      
+      // Only samples can be written in binary; other methods write text
+      stan::gm::argument* binary_arg
+        = parser.arg("output")->arg("format")->arg("binary");
+      if (binary_arg && !parser.arg("method")->arg("sample")) {
+        std::cout << "output format=binary is only supported by method=sample"
+                  << std::endl;
+        return stan::gm::error_codes::USAGE;
+      }
+      
+      chain_output_files files(num_chains);
+      std::vector<std::fstream*>& output_streams = files.output_streams;
+      std::vector<stan::common::recorder::binary*>& binary_recorders
+        = files.binary_recorders;
       if (output_file != "") {
-        output_stream = new std::fstream(output_file.c_str(),
-                                         std::fstream::out);
+        for (int chain = 0; chain < num_chains; ++chain)
+          output_streams[chain] 
+            = new std::fstream(chain_file_name(output_file, chain, 
+                                               num_chains).c_str(),
+                               binary_arg 
+                               ? std::fstream::out | std::fstream::binary
+                               : std::fstream::out);
+      }
+      if (binary_arg) {
+        std::string layout = dynamic_cast<stan::gm::string_argument*>(
+                             binary_arg->arg("layout"))->value();
+        for (int chain = 0; chain < num_chains; ++chain)
+          binary_recorders[chain] 
+            = new stan::common::recorder::binary(output_streams[chain],
+                layout == "column"
+                ? stan::common::recorder::binary::by_column
+                : stan::common::recorder::binary::by_iteration);
       }
+      std::fstream* output_stream = output_streams[0];
       
       // Diagnostic output
       std::string diagnostic_file = dynamic_cast<stan::gm::string_argument*>(
                                     parser.arg("output")->arg("diagnostic_file"))->value();
       
-      std::fstream* diagnostic_stream = 0;
+      std::vector<std::fstream*>& diagnostic_streams = files.diagnostic_streams;
       if (diagnostic_file != "") {
-        diagnostic_stream = new std::fstream(diagnostic_file.c_str(),
-                                             std::fstream::out);
+        for (int chain = 0; chain < num_chains; ++chain)
+          diagnostic_streams[chain]
+            = new std::fstream(chain_file_name(diagnostic_file, chain,
+                                               num_chains).c_str(),
+                               std::fstream::out);
       }
+      std::fstream* diagnostic_stream = diagnostic_streams[0];
       
       // Refresh rate
       int refresh = dynamic_cast<stan::gm::int_argument*>(
@@ -160,16 +258,158 @@ namespace stan {
       parser.print(&std::cout);
       std::cout << std::endl;
       
-      if (output_stream) {
-        write_stan(output_stream, "#");
-        write_model(output_stream, model.model_name(), "#");
-        parser.print(output_stream, "#");
+      // Each chain's files record the id that chain would have had
+      // if it had been run as a separate process
+      stan::gm::int_argument* id_arg 
+        = dynamic_cast<stan::gm::int_argument*>(parser.arg("id"));
+      for (int chain = 0; chain < num_chains; ++chain) {
+        if (num_chains > 1)
+          id_arg->set_value(id + chain);
+        
+        if (binary_recorders[chain]) {
+          // the binary format keeps the comment lines without "# "
+          std::stringstream preamble;
+          write_stan(&preamble, "#");
+          write_model(&preamble, model.model_name(), "#");
+          parser.print(&preamble, "#");
+          std::string line;
+          while (std::getline(preamble, line)) {
+            size_t start = line.compare(0, 2, "# ") == 0 ? 2 : 1;
+            (*binary_recorders[chain])(line.substr(std::min(start, 
+                                                            line.size())));
+          }
+        } else if (output_streams[chain]) {
+          write_stan(output_streams[chain], "#");
+          write_model(output_streams[chain], model.model_name(), "#");
+          parser.print(output_streams[chain], "#");
+        }
+        
+        if (diagnostic_streams[chain]) {
+          write_stan(diagnostic_streams[chain], "#");
+          write_model(diagnostic_streams[chain], model.model_name(), "#");
+          parser.print(diagnostic_streams[chain], "#");
+        }
+      }
+      id_arg->set_value(id);
+      
+      // log_prob and generate_quantities evaluate the model at draws
+      // read from a file, so they run before the initialization
+      
+      //////////////////////////////////////////////////
+      //            Log Density at Draws              //
+      //////////////////////////////////////////////////
+      
+      if (parser.arg("method")->arg("log_prob")) {
+        stan::gm::argument* log_prob_arg = parser.arg("method")->arg("log_prob");
+        std::string draws_file = dynamic_cast<stan::gm::string_argument*>(
+                                 log_prob_arg->arg("file"))->value();
+        bool jacobian = dynamic_cast<stan::gm::bool_argument*>(
+                        log_prob_arg->arg("jacobian"))->value();
+        bool gradient = dynamic_cast<stan::gm::bool_argument*>(
+                        log_prob_arg->arg("gradient"))->value();
+        
+        std::fstream draws_stream(draws_file.c_str(), std::fstream::in);
+        if (!draws_stream) {
+          std::cout << "Cannot read draws from " << draws_file << std::endl;
+          return stan::gm::error_codes::NOINPUT;
+        }
+        stan::io::stan_csv draws = stan::io::stan_csv_reader::parse(draws_stream);
+        draws_stream.close();
+        
+        Eigen::MatrixXd params_r;
+        if (!unconstrain_draws(model, draws.header, draws.samples, params_r,
+                               &std::cout))
+          return stan::gm::error_codes::DATAERR;
+        
+        Eigen::VectorXd lp;
+        Eigen::MatrixXd gradients;
+        if (gradient && jacobian)
+          stan::model::log_prob_grad_batch<false, true>(model, params_r,
+                                                        lp, gradients);
+        else if (gradient)
+          stan::model::log_prob_grad_batch<false, false>(model, params_r,
+                                                         lp, gradients);
+        else if (jacobian)
+          stan::model::log_prob_batch<false, true>(model, params_r, lp);
+        else
+          stan::model::log_prob_batch<false, false>(model, params_r, lp);
+        
+        std::cout << "Evaluated the log density at " << lp.size()
+                  << " draws" << std::endl;
+        
+        if (output_stream) {
+          std::vector<std::string> names;
+          if (gradient)
+            model.unconstrained_param_names(names, false, false);
+          (*output_stream) << "lp__";
+          for (size_t i = 0; i < names.size(); ++i)
+            (*output_stream) << ",grad_" << names[i];
+          (*output_stream) << std::endl;
+          
+          stan::io::csv_writer writer(*output_stream);
+          for (int n = 0; n < lp.size(); ++n) {
+            writer.write(lp(n));
+            for (int i = 0; i < gradients.rows(); ++i)
+              writer.write(gradients(i, n));
+            writer.newline();
+          }
+        }
+        return stan::gm::error_codes::OK;
       }
       
-      if (diagnostic_stream) {
-        write_stan(diagnostic_stream, "#");
-        write_model(diagnostic_stream, model.model_name(), "#");
-        parser.print(diagnostic_stream, "#");
+      //////////////////////////////////////////////////
+      //        Generated Quantities at Draws         //
+      //////////////////////////////////////////////////
+      
+      if (parser.arg("method")->arg("generate_quantities")) {
+        std::string draws_file = dynamic_cast<stan::gm::string_argument*>(
+                                 parser.arg("method")->arg("generate_quantities")
+                                 ->arg("file"))->value();
+        
+        std::fstream draws_stream(draws_file.c_str(), std::fstream::in);
+        if (!draws_stream) {
+          std::cout << "Cannot read draws from " << draws_file << std::endl;
+          return stan::gm::error_codes::NOINPUT;
+        }
+        stan::io::stan_csv draws = stan::io::stan_csv_reader::parse(draws_stream);
+        draws_stream.close();
+        
+        Eigen::MatrixXd params_r;
+        if (!unconstrain_draws(model, draws.header, draws.samples, params_r,
+                               &std::cout))
+          return stan::gm::error_codes::DATAERR;
+        
+        // Each draw gets its own stretch of this process's substream
+        static const boost::uintmax_t DRAW_STRIDE = static_cast<boost::uintmax_t>(1) << 20;
+        Eigen::MatrixXd values;
+        std::vector<int> failed
+          = stan::model::write_array_batch(model, base_rng, DRAW_STRIDE,
+                                           params_r, values, &std::cout);
+        
+        std::cout << "Generated quantities at " << values.cols() << " draws ("
+                  << failed.size() << " failed)" << std::endl;
+        if (!failed.empty()) {
+          std::cout << "Failed draws:";
+          for (size_t k = 0; k < failed.size(); ++k)
+            std::cout << " " << (failed[k] + 1);
+          std::cout << std::endl;
+        }
+        
+        if (output_stream) {
+          std::vector<std::string> names;
+          model.constrained_param_names(names, true, true);
+          for (size_t i = 0; i < names.size(); ++i)
+            (*output_stream) << (i > 0 ? "," : "") << names[i];
+          (*output_stream) << std::endl;
+          
+          stan::io::csv_writer writer(*output_stream);
+          for (int n = 0; n < values.cols(); ++n) {
+            for (int i = 0; i < values.rows(); ++i)
+              writer.write(values(i, n));
+            writer.newline();
+          }
+        }
+        return stan::gm::error_codes::OK;
       }
       
       std::string init = dynamic_cast<stan::gm::string_argument*>(
@@ -247,6 +487,20 @@ namespace stan {
           = dynamic_cast<stan::gm::bool_argument*>(parser.arg("method")
                                          ->arg("optimize")
                                          ->arg("save_iterations"))->value();
+
+        int num_starts = dynamic_cast<stan::gm::int_argument*>(
+                         parser.arg("method")->arg("optimize")->arg("num_starts"))->value();
+        if (num_starts > 1 && algo->value() == "newton") {
+          std::cout << "num_starts > 1 is only supported by algorithm=bfgs"
+                    << " and algorithm=lbfgs" << std::endl;
+          return stan::gm::error_codes::USAGE;
+        }
+        if (num_starts > 1 && save_iterations) {
+          std::cout << "save_iterations=1 is only supported with num_starts=1"
+                    << std::endl;
+          return stan::gm::error_codes::USAGE;
+        }
+
         if (output_stream) {
           std::vector<std::string> names;
           names.push_back("lp__");
@@ -259,6 +513,21 @@ namespace stan {
           (*output_stream) << std::endl;
         }
 
+        // With several starts, every bfgs or lbfgs run after the first
+        // starts from a random init drawn with the RNG substream of a
+        // separate process with id + start
+        std::vector<rng_t> start_rngs(1, base_rng);
+        for (int start = 1; start < num_starts; ++start) {
+          start_rngs.push_back(rng_t(random_seed));
+          start_rngs.back().discard(DISCARD_STRIDE * (id - 1 + start));
+        }
+        double init_radius;
+        if (!get_double_from_string(init, init_radius) || init_radius <= 0)
+          init_radius = 2;
+        double mode_tol = dynamic_cast<stan::gm::real_argument*>(
+                          parser.arg("method")->arg("optimize")->arg("mode_tol"))->value();
+        std::vector<local_optimum> optima;
+
         double lp(0);
         int return_code = stan::gm::error_codes::CONFIG;
         if (algo->value() == "newton") {
@@ -282,6 +551,8 @@ namespace stan {
           while ((lp - lastlp) / fabs(lp) > 1e-8) {
             
             lastlp = lp;
+            // with STAN_NEWTON_EXACT_HESSIAN, newton_step() evaluates
+            // log_prob() with fvar_k<var,K> scalars for exact Hessians
             lp = stan::optimization::newton_step(model, cont_vector, disc_vector);
             std::cout << "Iteration ";
             std::cout << std::setw(2) << (m + 1) << ". ";
@@ -317,11 +588,16 @@ namespace stan {
                          algo->arg("bfgs")->arg("tol_param"))->value();
           bfgs._conv_opts.maxIts = num_iterations;
           
-          return_code = do_bfgs_optimize(model,bfgs, base_rng,
-                                         lp, cont_vector, disc_vector,
-                                         output_stream, &std::cout, 
-                                         save_iterations, refresh,
-                                         callback);
+          if (num_starts > 1)
+            return_code = do_bfgs_multistart(model, bfgs, cont_params,
+                                             init_radius, start_rngs,
+                                             mode_tol, optima, &std::cout);
+          else
+            return_code = do_bfgs_optimize(model,bfgs, base_rng,
+                                           lp, cont_vector, disc_vector,
+                                           output_stream, &std::cout, 
+                                           save_iterations, refresh,
+                                           callback);
         } else if (algo->value() == "lbfgs") {
           NoOpFunctor callback;
           typedef stan::optimization::BFGSLineSearch<Model,stan::optimization::LBFGSUpdate<> > Optimizer;
@@ -343,20 +619,29 @@ namespace stan {
                          algo->arg("lbfgs")->arg("tol_param"))->value();
           bfgs._conv_opts.maxIts = num_iterations;
 
-          return_code = do_bfgs_optimize(model,bfgs, base_rng,
-                                         lp, cont_vector, disc_vector,
-                                         output_stream, &std::cout, 
-                                         save_iterations, refresh,
-                                         callback);
+          if (num_starts > 1)
+            return_code = do_bfgs_multistart(model, bfgs, cont_params,
+                                             init_radius, start_rngs,
+                                             mode_tol, optima, &std::cout);
+          else
+            return_code = do_bfgs_optimize(model,bfgs, base_rng,
+                                           lp, cont_vector, disc_vector,
+                                           output_stream, &std::cout, 
+                                           save_iterations, refresh,
+                                           callback);
         } else {
           return_code = stan::gm::error_codes::CONFIG;
         }
 
         if (output_stream) {
-          write_iteration(*output_stream, model, base_rng,
-                          lp, cont_vector, disc_vector);
-          output_stream->close();
-          delete output_stream;
+          if (num_starts > 1) {
+            for (size_t k = 0; k < optima.size(); ++k)
+              write_iteration(*output_stream, model, base_rng,
+                              optima[k].lp, optima[k].params_r, disc_vector);
+          } else {
+            write_iteration(*output_stream, model, base_rng,
+                            lp, cont_vector, disc_vector);
+          }
         }
         return return_code;
       }
@@ -385,15 +670,6 @@ namespace stan {
         std::cout << "Adjust your expectations accordingly!" << std::endl << std::endl;
         std::cout << std::endl;
         
-        stan::common::recorder::csv sample_recorder(output_stream, "# ");
-        stan::common::recorder::csv diagnostic_recorder(diagnostic_stream, "# ");
-        stan::common::recorder::messages message_recorder(&std::cout, "# ");
-        
-        stan::io::mcmc_writer<Model, 
-                              stan::common::recorder::csv, stan::common::recorder::csv,
-                              stan::common::recorder::messages> 
-          writer(sample_recorder, diagnostic_recorder, message_recorder, &std::cout);
-        
         // Sampling parameters
         int num_warmup = dynamic_cast<stan::gm::int_argument*>(
                           parser.arg("method")->arg("sample")->arg("num_warmup"))->value();
@@ -407,14 +683,6 @@ namespace stan {
         bool save_warmup = dynamic_cast<stan::gm::bool_argument*>(
                            parser.arg("method")->arg("sample")->arg("save_warmup"))->value();
         
-        stan::mcmc::sample s(cont_params, 0, 0);
-        
-        double warmDeltaT;
-        double sampleDeltaT;
-        
-        // Sampler
-        stan::mcmc::base_mcmc* sampler_ptr = 0;
-        
         stan::gm::list_argument* algo = dynamic_cast<stan::gm::list_argument*>
                               (parser.arg("method")->arg("sample")->arg("algorithm"));
         
@@ -431,8 +699,6 @@ namespace stan {
 
         if (algo->value() == "fixed_param") {
           
-          sampler_ptr = new stan::mcmc::fixed_param_sampler();
-          
           adapt_engaged = false;
           
           if (num_warmup != 0) {
@@ -445,188 +711,94 @@ namespace stan {
           std::cout << algo->arg("rwm")->description() << std::endl;
           return 0;
         
-        } else if (algo->value() == "hmc") {
-          
-          int engine_index = 0;
-          stan::gm::list_argument* engine 
-            = dynamic_cast<stan::gm::list_argument*>(algo->arg("hmc")->arg("engine"));
-          if (engine->value() == "static") {
-            engine_index = 0;
-          } else if (engine->value() == "nuts") {
-            engine_index = 1;
-          }
-          
-          int metric_index = 0;
-          stan::gm::list_argument* metric 
-            = dynamic_cast<stan::gm::list_argument*>(algo->arg("hmc")->arg("metric"));
-          if (metric->value() == "unit_e") {
-            metric_index = 0;
-          } else if (metric->value() == "diag_e") {
-            metric_index = 1;
-          } else if (metric->value() == "dense_e") {
-            metric_index = 2;
-          }
-          
-          int sampler_select = engine_index 
-            + 10 * metric_index 
-            + 100 * static_cast<int>(adapt_engaged);
-          
-          switch (sampler_select) {
-              
-            case 0: {
-              typedef stan::mcmc::unit_e_static_hmc<Model, rng_t> sampler;
-              sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
-              if (!init_static_hmc<sampler>(sampler_ptr, algo)) return 0;
-              break;
-            }
-              
-            case 1: {        
-              typedef stan::mcmc::unit_e_nuts<Model, rng_t> sampler;
-              sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
-              if (!init_nuts<sampler>(sampler_ptr, algo)) return 0;
-              break;
-            }
-              
-            case 10: {
-              typedef stan::mcmc::diag_e_static_hmc<Model, rng_t> sampler;
-              sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
-              if (!init_static_hmc<sampler>(sampler_ptr, algo)) return 0;
-              break;
-            }
-            
-            case 11: {
-              typedef stan::mcmc::diag_e_nuts<Model, rng_t> sampler;
-              sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
-              if (!init_nuts<sampler>(sampler_ptr, algo)) return 0;
-              break;
-            }
-            
-            case 20: {
-              typedef stan::mcmc::dense_e_static_hmc<Model, rng_t> sampler;
-              sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
-              if (!init_static_hmc<sampler>(sampler_ptr, algo)) return 0;
-              break;
-            }
-            
-            case 21: {
-              typedef stan::mcmc::dense_e_nuts<Model, rng_t> sampler;
-              sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
-              if (!init_nuts<sampler>(sampler_ptr, algo)) return 0;
-              break;
-            }
-            
-            case 100: {
-              typedef stan::mcmc::adapt_unit_e_static_hmc<Model, rng_t> sampler;
-              sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
-              if (!init_static_hmc<sampler>(sampler_ptr, algo)) return 0;
-              if (!init_adapt<sampler>(sampler_ptr, adapt, cont_params)) return 0;
-              break;
-            }
-            
-            case 101: {
-              typedef stan::mcmc::adapt_unit_e_nuts<Model, rng_t> sampler;
-              sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
-              if (!init_nuts<sampler>(sampler_ptr, algo)) return 0;
-              if (!init_adapt<sampler>(sampler_ptr, adapt, cont_params)) return 0;
-              break;
-            }
-            
-            case 110: {
-              typedef stan::mcmc::adapt_diag_e_static_hmc<Model, rng_t> sampler;
-              sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
-              if (!init_static_hmc<sampler>(sampler_ptr, algo)) return 0;
-              if (!init_windowed_adapt<sampler>(sampler_ptr, adapt, num_warmup, cont_params)) 
-                return 0;
-              break;
-            }
-            
-            case 111: {
-              typedef stan::mcmc::adapt_diag_e_nuts<Model, rng_t> sampler;
-              sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
-              if (!init_nuts<sampler>(sampler_ptr, algo)) return 0;
-              if (!init_windowed_adapt<sampler>(sampler_ptr, adapt, num_warmup, cont_params)) 
-                return 0;
-              break;
-            }
-            
-            case 120: {
-              typedef stan::mcmc::adapt_dense_e_static_hmc<Model, rng_t> sampler;
-              sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
-              if (!init_static_hmc<sampler>(sampler_ptr, algo)) return 0;
-              if (!init_windowed_adapt<sampler>(sampler_ptr, adapt, num_warmup, cont_params)) 
-                return 0;
-              break;
-            }
-            
-            case 121: {
-              typedef stan::mcmc::adapt_dense_e_nuts<Model, rng_t> sampler;
-              sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
-              if (!init_nuts<sampler>(sampler_ptr, algo)) return 0;
-              if (!init_windowed_adapt<sampler>(sampler_ptr, adapt, num_warmup, cont_params))
-                return 0;
-              break;
-            }
-            
-            default:
-              std::cout << "No sampler matching HMC specification!" << std::endl;
-              return 0;
-          }
-          
         }
         
-        // Headers
-        writer.write_sample_names(s, sampler_ptr, model);
-        writer.write_diagnostic_names(s, sampler_ptr, model);
-        
-        std::string prefix = "";
-        std::string suffix = "\n";
-        NoOpFunctor startTransitionCallback;
-
-        // Warm-Up
-        clock_t start = clock();
-        
-        warmup<Model, rng_t>(sampler_ptr, num_warmup, num_samples, num_thin,
-                             refresh, save_warmup,
-                             writer,
-                             s, model, base_rng,
-                             prefix, suffix, std::cout,
-                             startTransitionCallback);
-        
-        clock_t end = clock();
-        warmDeltaT = (double)(end - start) / CLOCKS_PER_SEC;
-        
-        if (adapt_engaged) {
-          dynamic_cast<mcmc::base_adapter*>(sampler_ptr)->disengage_adaptation();
-          writer.write_adapt_finish(sampler_ptr);
+        // Each chain gets its own stream of random numbers, offset
+        // exactly as if it had been run as a separate process.  The
+        // vector is filled before any sampler takes a reference to
+        // its elements.
+        std::vector<rng_t> chain_rngs(1, base_rng);
+        for (int chain = 1; chain < num_chains; ++chain) {
+          chain_rngs.push_back(rng_t(random_seed));
+          chain_rngs.back().discard(DISCARD_STRIDE * (id - 1 + chain));
         }
         
-        // Sampling
-        start = clock();
-        
-        stan::common::sample<Model, rng_t>(sampler_ptr, num_warmup, num_samples, num_thin,
-                             refresh, true,
-                             writer,
-                             s, model, base_rng,
-                             prefix, suffix, std::cout,
-                             startTransitionCallback);
+        std::vector<Eigen::VectorXd> chain_params(1, cont_params);
+        for (int chain = 1; chain < num_chains; ++chain) {
+          chain_params.push_back(Eigen::VectorXd::Zero(model.num_params_r()));
+          if (!initialize_state<dump_factory>
+              (init, chain_params.back(), model, chain_rngs[chain], &std::cout,
+               var_context_factory))
+            return stan::gm::error_codes::SOFTWARE;
+        }
         
-        end = clock();
-        sampleDeltaT = (double)(end - start) / CLOCKS_PER_SEC;
+        // Sampler
+        chain_objects<stan::mcmc::base_mcmc> chain_samplers(num_chains);
+        std::vector<stan::mcmc::base_mcmc*>& samplers = chain_samplers.objects;
+        for (int chain = 0; chain < num_chains; ++chain) {
+          if (algo->value() == "fixed_param")
+            samplers[chain] = new stan::mcmc::fixed_param_sampler();
+          else
+            samplers[chain] = init_sampler<Model, rng_t>(model, chain_rngs[chain],
+                                                         algo, adapt, adapt_engaged,
+                                                         num_warmup,
+                                                         chain_params[chain]);
+          if (!samplers[chain])
+            return 0;
+        }
         
-        writer.write_timing(warmDeltaT, sampleDeltaT);
+        std::vector<stan::mcmc::sample> chain_samples;
+        for (int chain = 0; chain < num_chains; ++chain)
+          chain_samples.push_back(stan::mcmc::sample(chain_params[chain], 0, 0));
+        
+        // Kept draws are summarized as they arrive, so nothing is
+        // stored to summarize several chains
+        std::vector<std::string> names;
+        chain_samples[0].get_sample_param_names(names);
+        samplers[0]->get_sampler_param_names(names);
+        model.constrained_param_names(names, true, true);
+        
+        int num_kept = (num_samples + num_thin - 1) / num_thin;
+        chain_objects<stan::mcmc::online_summary> chain_summaries(num_chains);
+        std::vector<stan::mcmc::online_summary*>& summaries
+          = chain_summaries.objects;
+        for (int chain = 0; chain < num_chains; ++chain)
+          summaries[chain] = new stan::mcmc::online_summary(num_kept);
+        
+        std::vector<std::string> prefixes(num_chains, "");
+        if (num_chains > 1) {
+          for (int chain = 0; chain < num_chains; ++chain) {
+            std::stringstream prefix;
+            prefix << "Chain [" << chain + 1 << "] ";
+            prefixes[chain] = prefix.str();
+          }
+        }
         
-        if (sampler_ptr) delete sampler_ptr;
+        if (binary_arg) {
+          run_chains<Model, rng_t>(samplers, adapt_engaged,
+                                   num_warmup, num_samples, num_thin,
+                                   refresh, save_warmup,
+                                   model, chain_rngs, chain_samples,
+                                   binary_recorders, diagnostic_streams,
+                                   summaries, prefixes, std::cout);
+        } else {
+          chain_objects<stan::common::recorder::csv> chain_recorders(num_chains);
+          std::vector<stan::common::recorder::csv*>& csv_recorders
+            = chain_recorders.objects;
+          for (int chain = 0; chain < num_chains; ++chain)
+            csv_recorders[chain] = new stan::common::recorder::csv
+              (output_streams[chain], "# ");
+          run_chains<Model, rng_t>(samplers, adapt_engaged,
+                                   num_warmup, num_samples, num_thin,
+                                   refresh, save_warmup,
+                                   model, chain_rngs, chain_samples,
+                                   csv_recorders, diagnostic_streams,
+                                   summaries, prefixes, std::cout);
+        }
         
-      }
-      
-      if (output_stream) {
-        output_stream->close();
-        delete output_stream;
-      }
+        if (num_chains > 1)
+          write_chains_summary(std::cout, names, summaries);
         
-      if (diagnostic_stream) {
-        diagnostic_stream->close();
-        delete diagnostic_stream;
       }
       
       for (size_t i = 0; i < valid_arguments.size(); ++i)
@@ -0,0 +1,270 @@
+#ifndef STAN__COMMON__DO_BFGS_MULTISTART_HPP
+#define STAN__COMMON__DO_BFGS_MULTISTART_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#ifdef STAN_THREADS
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#endif
+
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/gm/error_codes.hpp>
+#include <stan/common/initialize_state.hpp>
+
+namespace stan {
+
+  namespace common {
+
+    /**
+     * A local optimum found by <code>do_bfgs_multistart</code>, with
+     * the number of runs that reached it.
+     */
+    struct local_optimum {
+      double lp;
+      std::vector<double> params_r;
+      int num_runs;
+
+      local_optimum(double lp, const std::vector<double>& params_r)
+        : lp(lp), params_r(params_r), num_runs(1) { }
+
+      /**
+       * Return <code>true</code> if every coordinate of the specified
+       * unconstrained parameters is within the relative tolerance of
+       * this optimum.
+       */
+      template <typename Vector>
+      bool near(const Vector& x, double tol) const {
+        for (size_t i = 0; i < params_r.size(); ++i)
+          if (std::fabs(x[i] - params_r[i])
+              > tol * (1.0 + std::fabs(params_r[i])))
+            return false;
+        return true;
+      }
+
+      bool operator<(const local_optimum& y) const {
+        return lp > y.lp;
+      }
+    };
+
+    namespace {
+
+      /**
+       * Optima registered by the runs of a multi-start optimization.
+       * With <code>STAN_THREADS</code> every access is serialized.
+       */
+      class multistart_optima {
+      private:
+        std::vector<local_optimum>& optima_;
+        double tol_;
+        int num_failed_;
+#ifdef STAN_THREADS
+        std::mutex mutex_;
+#endif
+
+        template <typename Vector>
+        int find(const Vector& x) const {
+          for (size_t k = 0; k < optima_.size(); ++k)
+            if (optima_[k].near(x, tol_))
+              return k;
+          return -1;
+        }
+
+      public:
+        multistart_optima(std::vector<local_optimum>& optima, double tol)
+          : optima_(optima), tol_(tol), num_failed_(0) { }
+
+        /**
+         * Count the run as having reached a registered optimum and
+         * return <code>true</code> if the specified point is near one.
+         */
+        bool visit(const Eigen::VectorXd& x) {
+#ifdef STAN_THREADS
+          std::lock_guard<std::mutex> lock(mutex_);
+#endif
+          int k = find(x);
+          if (k < 0)
+            return false;
+          ++optima_[k].num_runs;
+          return true;
+        }
+
+        /**
+         * Register the point at which a run converged, keeping the
+         * better of the two points if it is near a registered optimum.
+         */
+        void add(double lp, const std::vector<double>& params_r) {
+#ifdef STAN_THREADS
+          std::lock_guard<std::mutex> lock(mutex_);
+#endif
+          int k = find(params_r);
+          if (k < 0) {
+            optima_.push_back(local_optimum(lp, params_r));
+            return;
+          }
+          ++optima_[k].num_runs;
+          if (lp > optima_[k].lp) {
+            optima_[k].lp = lp;
+            optima_[k].params_r = params_r;
+          }
+        }
+
+        void fail() {
+#ifdef STAN_THREADS
+          std::lock_guard<std::mutex> lock(mutex_);
+#endif
+          ++num_failed_;
+        }
+
+        int num_failed() const {
+          return num_failed_;
+        }
+      };
+
+      template <class Model, class Optimizer, class RNG>
+      void run_bfgs_start(Model& model,
+                          const Optimizer& options,
+                          Eigen::VectorXd cont_params,
+                          bool random_init,
+                          double init_radius,
+                          RNG& rng,
+                          multistart_optima& optima) {
+        if (random_init
+            && !initialize_state_random(init_radius, cont_params, model,
+                                        rng, 0)) {
+          optima.fail();
+          return;
+        }
+        std::vector<double> cont_vector(cont_params.data(),
+                                        cont_params.data()
+                                        + cont_params.size());
+        std::vector<int> disc_vector;
+        try {
+          Optimizer bfgs(model, cont_vector, disc_vector, 0);
+          bfgs._ls_opts = options._ls_opts;
+          bfgs._conv_opts = options._conv_opts;
+          bfgs.get_qnupdate() = options.get_qnupdate();
+
+          int ret = 0;
+          while (ret == 0) {
+            ret = bfgs.step();
+            // stop following a run into an optimum already found
+            if (ret == 0 && optima.visit(bfgs.curr_x()))
+              return;
+          }
+          if (ret < 0) {
+            optima.fail();
+            return;
+          }
+          bfgs.params_r(cont_vector);
+          optima.add(bfgs.logp(), cont_vector);
+        } catch (const std::exception&) {
+          optima.fail();
+        }
+      }
+
+    }
+
+    /**
+     * Run one BFGS optimization from each of the specified random
+     * number generators' starting points and collect the distinct
+     * local optima they converge to.
+     *
+     * <p>The first run starts from <code>cont_params</code>; every
+     * other run starts from a random initialization within
+     * <code>init_radius</code> drawn with its own generator.  Each
+     * run is configured with the line search, convergence and
+     * quasi-Newton update options of <code>options</code>.  A run
+     * stops as soon as an iterate is within <code>tol</code> (relative
+     * in each coordinate) of an optimum already found and is counted
+     * as reaching that optimum.
+     *
+     * <p>Runs go one after another unless <code>STAN_THREADS</code>
+     * is defined, in which case they are pulled off a shared counter
+     * by a pool of at most one thread per core.  All runs share the
+     * model.
+     *
+     * @param model model
+     * @param options optimizer whose options every run uses
+     * @param cont_params starting point of the first run
+     * @param init_radius radius of the random initializations
+     * @param start_rngs random number generator for each run
+     * @param tol relative tolerance within which two points are the
+     *   same optimum
+     * @param[out] optima distinct optima found, in decreasing order of
+     *   log density
+     * @param notice_stream stream for the summary; may be 0
+     * @return <code>OK</code> if any run converged,
+     *   <code>SOFTWARE</code> otherwise
+     */
+    template <class Model, class Optimizer, class RNG>
+    int do_bfgs_multistart(Model& model,
+                           const Optimizer& options,
+                           const Eigen::VectorXd& cont_params,
+                           double init_radius,
+                           std::vector<RNG>& start_rngs,
+                           double tol,
+                           std::vector<local_optimum>& optima,
+                           std::ostream* notice_stream) {
+      int num_starts = start_rngs.size();
+      optima.clear();
+      multistart_optima registry(optima, tol);
+#ifdef STAN_THREADS
+      if (num_starts > 1) {
+        int num_threads
+          = std::min<int>(num_starts,
+                          std::max(1U, std::thread::hardware_concurrency()));
+        std::atomic<int> next_start(0);
+        std::vector<std::exception_ptr> errors(num_starts);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+          threads.push_back(std::thread([&]() {
+            for (int start = next_start++; start < num_starts;
+                 start = next_start++) {
+              try {
+                run_bfgs_start(model, options, cont_params, start > 0,
+                               init_radius, start_rngs[start], registry);
+              } catch (...) {
+                errors[start] = std::current_exception();
+              }
+            }
+          }));
+        }
+        for (size_t t = 0; t < threads.size(); ++t)
+          threads[t].join();
+        for (int start = 0; start < num_starts; ++start)
+          if (errors[start])
+            std::rethrow_exception(errors[start]);
+      } else
+#endif
+      for (int start = 0; start < num_starts; ++start)
+        run_bfgs_start(model, options, cont_params, start > 0,
+                       init_radius, start_rngs[start], registry);
+
+      std::stable_sort(optima.begin(), optima.end());
+
+      if (notice_stream) {
+        (*notice_stream) << "Found " << optima.size() << " local optima from "
+                         << num_starts << " starts ("
+                         << registry.num_failed() << " failed)"
+                         << std::endl;
+        for (size_t k = 0; k < optima.size(); ++k)
+          (*notice_stream) << "  log joint probability = " << optima[k].lp
+                           << ", reached by " << optima[k].num_runs
+                           << (optima[k].num_runs == 1 ? " run" : " runs")
+                           << std::endl;
+      }
+
+      return optima.empty() ? stan::gm::error_codes::SOFTWARE
+                            : stan::gm::error_codes::OK;
+    }
+
+  }
+
+}
+#endif
@@ -0,0 +1,184 @@
+#ifndef STAN__COMMON__INIT_SAMPLER_HPP
+#define STAN__COMMON__INIT_SAMPLER_HPP
+
+#include <iostream>
+
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/mcmc/base_mcmc.hpp>
+#include <stan/mcmc/hmc/static/adapt_unit_e_static_hmc.hpp>
+#include <stan/mcmc/hmc/static/adapt_diag_e_static_hmc.hpp>
+#include <stan/mcmc/hmc/static/adapt_dense_e_static_hmc.hpp>
+#include <stan/mcmc/hmc/nuts/adapt_unit_e_nuts.hpp>
+#include <stan/mcmc/hmc/nuts/adapt_diag_e_nuts.hpp>
+#include <stan/mcmc/hmc/nuts/adapt_dense_e_nuts.hpp>
+#include <stan/gm/arguments/categorical_argument.hpp>
+#include <stan/gm/arguments/list_argument.hpp>
+#include <stan/common/init_static_hmc.hpp>
+#include <stan/common/init_nuts.hpp>
+#include <stan/common/init_adapt.hpp>
+#include <stan/common/init_windowed_adapt.hpp>
+
+namespace stan {
+  namespace common {
+
+    /**
+     * Construct and configure the HMC sampler selected by the
+     * <code>algorithm=hmc</code> arguments.
+     *
+     * @param model model; shared by every sampler built from it
+     * @param base_rng random number generator owned by the sampler's chain
+     * @param algo <code>algorithm</code> argument of <code>sample</code>
+     * @param adapt <code>adapt</code> argument of <code>sample</code>
+     * @param adapt_engaged true if adaptation is engaged
+     * @param num_warmup number of warmup iterations
+     * @param cont_params initial unconstrained parameters
+     * @return new sampler, or 0 if no sampler matches the arguments
+     *   or configuring it failed
+     */
+    template <class Model, class RNG>
+    stan::mcmc::base_mcmc* init_sampler(Model& model,
+                                        RNG& base_rng,
+                                        stan::gm::list_argument* algo,
+                                        stan::gm::categorical_argument* adapt,
+                                        bool adapt_engaged,
+                                        int num_warmup,
+                                        const Eigen::VectorXd& cont_params) {
+      stan::mcmc::base_mcmc* sampler_ptr = 0;
+      bool ok = true;
+
+      int engine_index = 0;
+      stan::gm::list_argument* engine
+        = dynamic_cast<stan::gm::list_argument*>(algo->arg("hmc")->arg("engine"));
+      if (engine->value() == "static") {
+        engine_index = 0;
+      } else if (engine->value() == "nuts") {
+        engine_index = 1;
+      }
+
+      int metric_index = 0;
+      stan::gm::list_argument* metric
+        = dynamic_cast<stan::gm::list_argument*>(algo->arg("hmc")->arg("metric"));
+      if (metric->value() == "unit_e") {
+        metric_index = 0;
+      } else if (metric->value() == "diag_e") {
+        metric_index = 1;
+      } else if (metric->value() == "dense_e") {
+        metric_index = 2;
+      }
+
+      int sampler_select = engine_index
+        + 10 * metric_index
+        + 100 * static_cast<int>(adapt_engaged);
+
+      switch (sampler_select) {
+
+        case 0: {
+          typedef stan::mcmc::unit_e_static_hmc<Model, RNG> sampler;
+          sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
+          ok = init_static_hmc<sampler>(sampler_ptr, algo);
+          break;
+        }
+
+        case 1: {
+          typedef stan::mcmc::unit_e_nuts<Model, RNG> sampler;
+          sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
+          ok = init_nuts<sampler>(sampler_ptr, algo);
+          break;
+        }
+
+        case 10: {
+          typedef stan::mcmc::diag_e_static_hmc<Model, RNG> sampler;
+          sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
+          ok = init_static_hmc<sampler>(sampler_ptr, algo);
+          break;
+        }
+
+        case 11: {
+          typedef stan::mcmc::diag_e_nuts<Model, RNG> sampler;
+          sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
+          ok = init_nuts<sampler>(sampler_ptr, algo);
+          break;
+        }
+
+        case 20: {
+          typedef stan::mcmc::dense_e_static_hmc<Model, RNG> sampler;
+          sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
+          ok = init_static_hmc<sampler>(sampler_ptr, algo);
+          break;
+        }
+
+        case 21: {
+          typedef stan::mcmc::dense_e_nuts<Model, RNG> sampler;
+          sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
+          ok = init_nuts<sampler>(sampler_ptr, algo);
+          break;
+        }
+
+        case 100: {
+          typedef stan::mcmc::adapt_unit_e_static_hmc<Model, RNG> sampler;
+          sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
+          ok = init_static_hmc<sampler>(sampler_ptr, algo)
+            && init_adapt<sampler>(sampler_ptr, adapt, cont_params);
+          break;
+        }
+
+        case 101: {
+          typedef stan::mcmc::adapt_unit_e_nuts<Model, RNG> sampler;
+          sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
+          ok = init_nuts<sampler>(sampler_ptr, algo)
+            && init_adapt<sampler>(sampler_ptr, adapt, cont_params);
+          break;
+        }
+
+        case 110: {
+          typedef stan::mcmc::adapt_diag_e_static_hmc<Model, RNG> sampler;
+          sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
+          ok = init_static_hmc<sampler>(sampler_ptr, algo)
+            && init_windowed_adapt<sampler>(sampler_ptr, adapt, num_warmup,
+                                            cont_params);
+          break;
+        }
+
+        case 111: {
+          typedef stan::mcmc::adapt_diag_e_nuts<Model, RNG> sampler;
+          sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
+          ok = init_nuts<sampler>(sampler_ptr, algo)
+            && init_windowed_adapt<sampler>(sampler_ptr, adapt, num_warmup,
+                                            cont_params);
+          break;
+        }
+
+        case 120: {
+          typedef stan::mcmc::adapt_dense_e_static_hmc<Model, RNG> sampler;
+          sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
+          ok = init_static_hmc<sampler>(sampler_ptr, algo)
+            && init_windowed_adapt<sampler>(sampler_ptr, adapt, num_warmup,
+                                            cont_params);
+          break;
+        }
+
+        case 121: {
+          typedef stan::mcmc::adapt_dense_e_nuts<Model, RNG> sampler;
+          sampler_ptr = new sampler(model, base_rng, &std::cout, &std::cout);
+          ok = init_nuts<sampler>(sampler_ptr, algo)
+            && init_windowed_adapt<sampler>(sampler_ptr, adapt, num_warmup,
+                                            cont_params);
+          break;
+        }
+
+        default:
+          std::cout << "No sampler matching HMC specification!" << std::endl;
+          return 0;
+      }
+
+      if (!ok) {
+        delete sampler_ptr;
+        return 0;
+      }
+      return sampler_ptr;
+    }
+
+  }
+}
+
+#endif
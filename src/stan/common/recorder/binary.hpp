@@ -0,0 +1,300 @@
+#ifndef STAN__COMMON__RECORDER__BINARY_HPP
+#define STAN__COMMON__RECORDER__BINARY_HPP
+
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/detail/endian.hpp>
+
+namespace stan {
+
+  namespace common {
+
+    namespace recorder {
+
+      /**
+       * Writes draws in a compact binary format instead of text.
+       *
+       * <p>A file starts with the seven bytes <code>STANBIN</code>
+       * and a one byte format version, followed by a sequence of
+       * records.  Each record is a one byte tag and the size of its
+       * payload in bytes as an unsigned 64-bit integer, so readers
+       * can skip records they do not know.  All integers and doubles
+       * are little endian.
+       *
+       * <ul>
+       * <li><code>N</code>: the column names, each as a 32-bit length
+       * followed by its characters, then the variables they index,
+       * each as its name, its number of dimensions and its
+       * dimensions, all as 32-bit integers.</li>
+       * <li><code>C</code>: a comment, without its prefix.</li>
+       * <li><code>D</code>: a block of draws, as a one byte layout,
+       * the number of rows and columns as 32-bit integers, and the
+       * values, either row after row (<code>by_iteration</code>) or
+       * column after column (<code>by_column</code>).</li>
+       * </ul>
+       *
+       * <p>With the <code>by_iteration</code> layout every draw is
+       * written as its own block when it is recorded.  With the
+       * <code>by_column</code> layout draws are buffered and written
+       * in blocks of up to <code>chunk_size</code> draws, so that each
+       * variable's draws are contiguous within a block.
+       */
+      class binary {
+      public:
+        enum layout_t { by_iteration = 0, by_column = 1 };
+
+      private:
+        std::ostream *o_;
+        const bool has_stream_;
+        const layout_t layout_;
+        const size_t chunk_size_;
+        size_t num_cols_;
+        size_t num_rows_;
+        std::vector<double> chunk_;
+
+        void write_bytes(const void* x, size_t size) {
+          o_->write(static_cast<const char*>(x), size);
+        }
+
+        void write_uint8(boost::uint8_t x) {
+          write_bytes(&x, 1);
+        }
+
+        void write_uint32(boost::uint32_t x) {
+          char bytes[4];
+          for (int i = 0; i < 4; ++i)
+            bytes[i] = static_cast<char>((x >> (8 * i)) & 0xFF);
+          write_bytes(bytes, 4);
+        }
+
+        void write_uint64(boost::uint64_t x) {
+          char bytes[8];
+          for (int i = 0; i < 8; ++i)
+            bytes[i] = static_cast<char>((x >> (8 * i)) & 0xFF);
+          write_bytes(bytes, 8);
+        }
+
+        void write_string(const std::string& x) {
+          write_uint32(x.size());
+          write_bytes(x.data(), x.size());
+        }
+
+        void write_doubles(const double* x, size_t size) {
+#ifdef BOOST_LITTLE_ENDIAN
+          write_bytes(x, size * sizeof(double));
+#else
+          for (size_t n = 0; n < size; ++n) {
+            boost::uint64_t bits;
+            std::memcpy(&bits, &x[n], sizeof(double));
+            write_uint64(bits);
+          }
+#endif
+        }
+
+        void write_record_header(char tag, boost::uint64_t size) {
+          write_uint8(tag);
+          write_uint64(size);
+        }
+
+        void write_draws(const double* x, size_t num_rows, layout_t layout) {
+          write_record_header('D', 9 + 8 * num_rows * num_cols_);
+          write_uint8(layout);
+          write_uint32(num_rows);
+          write_uint32(num_cols_);
+          if (layout == by_iteration || num_rows == chunk_size_) {
+            write_doubles(x, num_rows * num_cols_);
+          } else {
+            for (size_t col = 0; col < num_cols_; ++col)
+              write_doubles(x + col * chunk_size_, num_rows);
+          }
+        }
+
+      public:
+        /**
+         * Construct a recorder writing to the specified stream, which
+         * should be opened in binary mode, and write the format
+         * identifier to it.
+         *
+         * @param o pointer to stream. Will accept 0.
+         * @param layout order of the values within blocks of draws
+         * @param chunk_size maximum number of draws in a block for the
+         *   <code>by_column</code> layout
+         */
+        binary(std::ostream *o, layout_t layout = by_iteration,
+               size_t chunk_size = 1024)
+          : o_(o), has_stream_(o != 0), layout_(layout),
+            chunk_size_(chunk_size > 0 ? chunk_size : 1),
+            num_cols_(0), num_rows_(0) {
+          if (!has_stream_)
+            return;
+          write_bytes("STANBIN", 7);
+          write_uint8(1);
+        }
+
+        /**
+         * Write out any buffered draws.
+         */
+        ~binary() {
+          flush();
+        }
+
+        /**
+         * Split names of the form <code>theta.2.3</code> into the
+         * variables they index and the dimensions of each variable,
+         * taken as the largest index in each position.  Names of
+         * consecutive columns with the same variable name are
+         * assumed to index the same variable.
+         *
+         * @param[in] names column names
+         * @param[out] var_names variable names
+         * @param[out] var_dims dimensions of each variable
+         */
+        static void variable_dims(const std::vector<std::string>& names,
+                                  std::vector<std::string>& var_names,
+                                  std::vector<std::vector<size_t> >& var_dims) {
+          var_names.clear();
+          var_dims.clear();
+          for (size_t n = 0; n < names.size(); ++n) {
+            std::stringstream ss(names[n]);
+            std::string token;
+            std::getline(ss, token, '.');
+            std::vector<size_t> idxs;
+            std::string idx;
+            while (std::getline(ss, idx, '.'))
+              idxs.push_back(std::atoi(idx.c_str()));
+
+            if (var_names.empty() || var_names.back() != token
+                || var_dims.back().size() != idxs.size()) {
+              var_names.push_back(token);
+              var_dims.push_back(std::vector<size_t>(idxs.size(), 0));
+            }
+            for (size_t i = 0; i < idxs.size(); ++i)
+              if (idxs[i] > var_dims.back()[i])
+                var_dims.back()[i] = idxs[i];
+          }
+        }
+
+        /**
+         * Write the column names and the variables they index.
+         *
+         * @param x column names
+         */
+        void operator()(const std::vector<std::string>& x) {
+          if (!has_stream_)
+            return;
+          flush();
+          num_cols_ = x.size();
+          chunk_.assign(layout_ == by_column ? chunk_size_ * num_cols_
+                        : num_cols_, 0);
+
+          std::vector<std::string> var_names;
+          std::vector<std::vector<size_t> > var_dims;
+          variable_dims(x, var_names, var_dims);
+
+          boost::uint64_t size = 8;
+          for (size_t n = 0; n < x.size(); ++n)
+            size += 4 + x[n].size();
+          for (size_t n = 0; n < var_names.size(); ++n)
+            size += 8 + var_names[n].size() + 4 * var_dims[n].size();
+
+          write_record_header('N', size);
+          write_uint32(x.size());
+          for (size_t n = 0; n < x.size(); ++n)
+            write_string(x[n]);
+          write_uint32(var_names.size());
+          for (size_t n = 0; n < var_names.size(); ++n) {
+            write_string(var_names[n]);
+            write_uint32(var_dims[n].size());
+            for (size_t i = 0; i < var_dims[n].size(); ++i)
+              write_uint32(var_dims[n][i]);
+          }
+        }
+
+        /**
+         * Write a draw, or buffer it for the <code>by_column</code>
+         * layout.
+         *
+         * @tparam T type of element
+         * @param x values of the draw, one for each column
+         */
+        template <class T>
+        void operator()(const std::vector<T>& x) {
+          if (!has_stream_)
+            return;
+          if (num_cols_ == 0)
+            num_cols_ = x.size();
+          if (x.size() != num_cols_)
+            throw std::length_error("vector provided does not match the"
+                                    " number of columns");
+
+          if (chunk_.empty())
+            chunk_.assign(layout_ == by_column ? chunk_size_ * num_cols_
+                          : num_cols_, 0);
+
+          if (layout_ == by_iteration) {
+            if (num_cols_ == 0)
+              return;
+            for (size_t col = 0; col < num_cols_; ++col)
+              chunk_[col] = x[col];
+            write_draws(&chunk_[0], 1, by_iteration);
+            return;
+          }
+
+          for (size_t col = 0; col < num_cols_; ++col)
+            chunk_[col * chunk_size_ + num_rows_] = x[col];
+          if (++num_rows_ == chunk_size_)
+            flush();
+        }
+
+        /**
+         * Write a comment.
+         *
+         * @param x comment, without a prefix
+         */
+        void operator()(const std::string x) {
+          if (!has_stream_)
+            return;
+          flush();
+          write_record_header('C', x.size());
+          write_bytes(x.data(), x.size());
+        }
+
+        /**
+         * Blank lines are not recorded.
+         */
+        void operator()() { }
+
+        /**
+         * Write out buffered draws and flush the stream.
+         */
+        void flush() {
+          if (!has_stream_)
+            return;
+          if (num_rows_ > 0 && num_cols_ > 0)
+            write_draws(&chunk_[0], num_rows_, by_column);
+          num_rows_ = 0;
+          o_->flush();
+        }
+
+        /**
+         * Indicator function for whether the instance is recording.
+         *
+         * For this class, returns true if it has a stream.
+         */
+        bool is_recording() const {
+          return has_stream_;
+        }
+      };
+
+    }
+  }
+}
+
+#endif
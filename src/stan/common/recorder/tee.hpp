@@ -0,0 +1,56 @@
+#ifndef STAN__COMMON__RECORDER__TEE_HPP
+#define STAN__COMMON__RECORDER__TEE_HPP
+
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace common {
+    namespace recorder {
+
+      /**
+       * Forwards everything it records to two recorders.  Each
+       * recorder only receives vectors while it is recording, so a
+       * full <code>values</code> recorder is simply skipped.
+       *
+       * @tparam Recorder1 type of first recorder
+       * @tparam Recorder2 type of second recorder
+       */
+      template <class Recorder1, class Recorder2>
+      class tee {
+      private:
+        Recorder1& recorder1_;
+        Recorder2& recorder2_;
+
+      public:
+        tee(Recorder1& recorder1, Recorder2& recorder2)
+          : recorder1_(recorder1), recorder2_(recorder2) { }
+
+        template <class T>
+        void operator()(const std::vector<T>& x) {
+          if (recorder1_.is_recording())
+            recorder1_(x);
+          if (recorder2_.is_recording())
+            recorder2_(x);
+        }
+
+        void operator()(const std::string x) {
+          recorder1_(x);
+          recorder2_(x);
+        }
+
+        void operator()() {
+          recorder1_();
+          recorder2_();
+        }
+
+        bool is_recording() const {
+          return recorder1_.is_recording() || recorder2_.is_recording();
+        }
+      };
+
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef STAN__COMMON__RUN_CHAINS_HPP
+#define STAN__COMMON__RUN_CHAINS_HPP
+
+#include <algorithm>
+#include <ostream>
+#include <string>
+#include <vector>
+#ifdef STAN_THREADS
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#endif
+
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/mcmc/base_mcmc.hpp>
+#include <stan/mcmc/sample.hpp>
+#include <stan/common/run_sampler.hpp>
+#include <stan/mcmc/chains_summary.hpp>
+
+namespace stan {
+  namespace common {
+
+#ifdef STAN_THREADS
+    /**
+     * Stream buffer that passes only whole lines on to a shared
+     * stream, holding the mutex while it writes them, so that the
+     * progress messages of concurrent chains do not interleave.
+     */
+    class line_buffer : public std::stringbuf {
+    private:
+      std::ostream& o_;
+      std::mutex& mutex_;
+
+    public:
+      line_buffer(std::ostream& o, std::mutex& mutex)
+        : std::stringbuf(std::ios_base::out | std::ios_base::ate),
+          o_(o), mutex_(mutex) { }
+
+      ~line_buffer() {
+        std::string rest = str();
+        if (!rest.empty()) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          o_ << rest << std::flush;
+        }
+      }
+
+      int sync() {
+        std::string text = str();
+        size_t end = text.find_last_of('\n');
+        if (end == std::string::npos)
+          return 0;
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          o_ << text.substr(0, end + 1) << std::flush;
+        }
+        str(text.substr(end + 1));
+        return 0;
+      }
+    };
+#endif
+
+    /**
+     * Run every chain with <code>run_sampler</code>.  Chains run
+     * one after another unless <code>STAN_THREADS</code> is defined,
+     * in which case they are pulled off a shared counter by a pool
+     * of at most one thread per core, each writing its progress
+     * messages to <code>o</code> a line at a time.  All vectors hold
+     * one element per chain.
+     *
+     * @param samplers sampler for each chain
+     * @param adapt_engaged true if the samplers adapt during warmup
+     * @param num_warmup number of warmup iterations
+     * @param num_samples number of sampling iterations
+     * @param num_thin period between saved iterations
+     * @param refresh period between progress messages
+     * @param save_warmup true if warmup iterations are written out
+     * @param model model
+     * @param chain_rngs random number generator for each chain
+     * @param chain_samples initial state of each chain
+     * @param sample_recorders recorder for the samples of each chain
+     * @param diagnostic_streams stream for the diagnostics of each
+     *   chain; elements may be 0
+     * @param summaries streaming summary of the kept draws of each chain
+     * @param prefixes prefix for the progress messages of each chain
+     * @param o stream for progress messages
+     */
+    template <class Model, class RNG, class SampleRecorder, class Stream>
+    void run_chains(std::vector<stan::mcmc::base_mcmc*>& samplers,
+                    bool adapt_engaged,
+                    int num_warmup,
+                    int num_samples,
+                    int num_thin,
+                    int refresh,
+                    bool save_warmup,
+                    Model& model,
+                    std::vector<RNG>& chain_rngs,
+                    std::vector<stan::mcmc::sample>& chain_samples,
+                    std::vector<SampleRecorder*>& sample_recorders,
+                    std::vector<Stream*>& diagnostic_streams,
+                    std::vector<stan::mcmc::online_summary*>& summaries,
+                    const std::vector<std::string>& prefixes,
+                    std::ostream& o) {
+      int num_chains = samplers.size();
+#ifdef STAN_THREADS
+      if (num_chains > 1) {
+        int num_threads
+          = std::min<int>(num_chains,
+                          std::max(1U, std::thread::hardware_concurrency()));
+        std::atomic<int> next_chain(0);
+        std::vector<std::exception_ptr> errors(num_chains);
+        std::mutex o_mutex;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+          threads.push_back(std::thread([&]() {
+            for (int chain = next_chain++; chain < num_chains;
+                 chain = next_chain++) {
+              line_buffer chain_buffer(o, o_mutex);
+              std::ostream chain_o(&chain_buffer);
+              try {
+                run_sampler<Model, RNG>(samplers[chain], adapt_engaged,
+                                        num_warmup, num_samples, num_thin,
+                                        refresh, save_warmup,
+                                        model, chain_rngs[chain],
+                                        chain_samples[chain],
+                                        *sample_recorders[chain],
+                                        diagnostic_streams[chain],
+                                        *summaries[chain], prefixes[chain],
+                                        chain_o);
+                chain_o.flush();
+              } catch (...) {
+                errors[chain] = std::current_exception();
+              }
+            }
+          }));
+        }
+        for (size_t t = 0; t < threads.size(); ++t)
+          threads[t].join();
+        for (int chain = 0; chain < num_chains; ++chain)
+          if (errors[chain])
+            std::rethrow_exception(errors[chain]);
+        return;
+      }
+#endif
+      for (int chain = 0; chain < num_chains; ++chain)
+        run_sampler<Model, RNG>(samplers[chain], adapt_engaged,
+                                num_warmup, num_samples, num_thin,
+                                refresh, save_warmup,
+                                model, chain_rngs[chain],
+                                chain_samples[chain],
+                                *sample_recorders[chain],
+                                diagnostic_streams[chain],
+                                *summaries[chain], prefixes[chain], o);
+    }
+
+  }
+}
+
+#endif
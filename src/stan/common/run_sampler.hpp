@@ -0,0 +1,176 @@
+#ifndef STAN__COMMON__RUN_SAMPLER_HPP
+#define STAN__COMMON__RUN_SAMPLER_HPP
+
+#include <ctime>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/mcmc/base_adapter.hpp>
+#include <stan/mcmc/base_mcmc.hpp>
+#include <stan/mcmc/chains_summary.hpp>
+#include <stan/mcmc/sample.hpp>
+#include <stan/io/mcmc_writer.hpp>
+#include <stan/common/warmup.hpp>
+#include <stan/common/sample.hpp>
+#include <stan/common/recorder/csv.hpp>
+#include <stan/common/recorder/messages.hpp>
+#include <stan/common/recorder/tee.hpp>
+
+namespace stan {
+  namespace common {
+
+    /**
+     * Return the name of the file a chain writes to.  With a single
+     * chain the file name is returned unchanged; otherwise the
+     * one-based chain number is inserted before the extension, so
+     * that <code>output.csv</code> becomes <code>output_2.csv</code>
+     * for the second chain.
+     *
+     * @param file_name file name given on the command line
+     * @param chain zero-based chain index
+     * @param num_chains number of chains in this run
+     */
+    inline std::string chain_file_name(const std::string& file_name,
+                                       int chain,
+                                       int num_chains) {
+      if (num_chains == 1 || file_name == "")
+        return file_name;
+      std::stringstream suffix;
+      suffix << "_" << chain + 1;
+      size_t dot = file_name.find_last_of('.');
+      size_t slash = file_name.find_last_of("/\\");
+      if (dot == std::string::npos
+          || (slash != std::string::npos && dot < slash))
+        return file_name + suffix.str();
+      return file_name.substr(0, dot) + suffix.str() + file_name.substr(dot);
+    }
+
+    /**
+     * Return a time stamp in seconds for timing a chain.
+     *
+     * <code>clock()</code> measures CPU time of the whole process,
+     * which sums over every chain when they run on separate threads,
+     * so threaded builds use wall-clock time instead.
+     */
+    inline double chain_clock() {
+#ifdef STAN_THREADS
+      return (boost::posix_time::microsec_clock::universal_time()
+              - boost::posix_time::ptime(boost::posix_time::min_date_time))
+        .total_microseconds() * 1e-6;
+#else
+      return static_cast<double>(clock()) / CLOCKS_PER_SEC;
+#endif
+    }
+
+    struct no_op_callback {
+      void operator()() { }
+    };
+
+    /**
+     * Run warmup and sampling for one chain, writing its output to
+     * its own recorder and stream.
+     *
+     * Draws kept during sampling are also added to
+     * <code>summary</code> as each transition is written, so the
+     * chain can be summarized without storing its draws.  Only the
+     * model is shared between
+     * chains, so several calls may run concurrently as long as each
+     * has its own sampler, random number generator, streams and
+     * autodiff stack (see <code>STAN_THREADS</code>).
+     *
+     * @param sampler sampler for this chain
+     * @param adapt_engaged true if the sampler adapts during warmup
+     * @param num_warmup number of warmup iterations
+     * @param num_samples number of sampling iterations
+     * @param num_thin period between saved iterations
+     * @param refresh period between progress messages
+     * @param save_warmup true if warmup iterations are written out
+     * @param model model
+     * @param base_rng random number generator for this chain
+     * @param s initial state; holds the final state on return
+     * @param sample_recorder recorder for samples, such as
+     *   <code>recorder::csv</code> or <code>recorder::binary</code>
+     * @param diagnostic_stream stream for diagnostics; may be 0
+     * @param summary streaming summary of the kept draws
+     * @param prefix prefix for progress messages
+     * @param o stream for progress messages
+     */
+    template <class Model, class RNG, class SampleRecorder>
+    void run_sampler(stan::mcmc::base_mcmc* sampler,
+                     bool adapt_engaged,
+                     int num_warmup,
+                     int num_samples,
+                     int num_thin,
+                     int refresh,
+                     bool save_warmup,
+                     Model& model,
+                     RNG& base_rng,
+                     stan::mcmc::sample& s,
+                     SampleRecorder& sample_recorder,
+                     std::ostream* diagnostic_stream,
+                     stan::mcmc::online_summary& summary,
+                     const std::string& prefix,
+                     std::ostream& o) {
+      typedef recorder::tee<SampleRecorder,
+                            stan::mcmc::online_summary> sample_recorder_t;
+
+      recorder::csv diagnostic_recorder(diagnostic_stream, "# ");
+      recorder::messages message_recorder(&o, "# ");
+      sample_recorder_t sample_summary_recorder(sample_recorder, summary);
+
+      stan::io::mcmc_writer<Model, SampleRecorder, recorder::csv,
+                            recorder::messages>
+        warmup_writer(sample_recorder, diagnostic_recorder, message_recorder,
+                      &o);
+      stan::io::mcmc_writer<Model, sample_recorder_t, recorder::csv,
+                            recorder::messages>
+        writer(sample_summary_recorder, diagnostic_recorder, message_recorder,
+               &o);
+
+      // Headers
+      warmup_writer.write_sample_names(s, sampler, model);
+      warmup_writer.write_diagnostic_names(s, sampler, model);
+
+      std::string suffix = "\n";
+      no_op_callback callback;
+
+      // Warm-Up
+      double start = chain_clock();
+
+      warmup<Model, RNG>(sampler, num_warmup, num_samples, num_thin,
+                         refresh, save_warmup,
+                         warmup_writer,
+                         s, model, base_rng,
+                         prefix, suffix, o,
+                         callback);
+
+      double warmDeltaT = chain_clock() - start;
+
+      if (adapt_engaged) {
+        dynamic_cast<mcmc::base_adapter*>(sampler)->disengage_adaptation();
+        writer.write_adapt_finish(sampler);
+      }
+
+      // Sampling
+      start = chain_clock();
+
+      stan::common::sample<Model, RNG>(sampler, num_warmup, num_samples,
+                                       num_thin, refresh, true,
+                                       writer,
+                                       s, model, base_rng,
+                                       prefix, suffix, o,
+                                       callback);
+
+      double sampleDeltaT = chain_clock() - start;
+
+      writer.write_timing(warmDeltaT, sampleDeltaT);
+    }
+
+  }
+}
+
+#endif
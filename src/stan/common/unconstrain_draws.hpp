@@ -0,0 +1,103 @@
+#ifndef STAN__COMMON__UNCONSTRAIN_DRAWS_HPP
+#define STAN__COMMON__UNCONSTRAIN_DRAWS_HPP
+
+#include <algorithm>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/io/array_var_context.hpp>
+#include <stan/common/write_error_msg.hpp>
+
+namespace stan {
+  namespace common {
+
+    /**
+     * Transform each row of draws of the model's constrained
+     * parameters, as read by <code>stan_csv_reader</code>, to a
+     * column of unconstrained parameters.  The columns of the draws
+     * are matched to the parameters by name; other columns are
+     * ignored.
+     *
+     * @param[in] model model
+     * @param[in] header column names of the draws
+     * @param[in] draws draws, one per row
+     * @param[out] params_r unconstrained parameters, one draw per
+     *   column
+     * @param[in,out] output stream for error messages; may be 0
+     * @return <code>true</code> if every draw was transformed
+     */
+    template <class Model>
+    bool unconstrain_draws(const Model& model,
+                           const Eigen::Matrix<std::string,
+                                               Eigen::Dynamic, 1>& header,
+                           const Eigen::MatrixXd& draws,
+                           Eigen::MatrixXd& params_r,
+                           std::ostream* output) {
+      std::vector<std::string> names;
+      model.constrained_param_names(names, false, false);
+
+      // the parameters come before the transformed parameters and
+      // generated quantities
+      std::vector<std::string> param_names;
+      model.get_param_names(param_names);
+      std::vector<std::vector<size_t> > param_dims;
+      model.get_dims(param_dims);
+      size_t num_params = 0;
+      for (size_t size = 0; size < names.size(); ++num_params) {
+        size_t param_size = 1;
+        for (size_t i = 0; i < param_dims[num_params].size(); ++i)
+          param_size *= param_dims[num_params][i];
+        size += param_size;
+      }
+      param_names.resize(num_params);
+      param_dims.resize(num_params);
+
+      std::map<std::string, int> columns;
+      for (int j = 0; j < header.size(); ++j)
+        columns[header(j)] = j;
+      std::vector<int> cols(names.size());
+      for (size_t k = 0; k < names.size(); ++k) {
+        // stan_csv_reader writes a.1.2 as a[1,2]
+        int pos = names[k].find('.');
+        if (pos > 0) {
+          names[k].replace(pos, 1, "[");
+          std::replace(names[k].begin(), names[k].end(), '.', ',');
+          names[k] += "]";
+        }
+        std::map<std::string, int>::const_iterator it = columns.find(names[k]);
+        if (it == columns.end()) {
+          if (output)
+            *output << "Draws have no column " << names[k] << std::endl;
+          return false;
+        }
+        cols[k] = it->second;
+      }
+
+      params_r.resize(model.num_params_r(), draws.rows());
+      std::vector<double> values(names.size());
+      for (int n = 0; n < draws.rows(); ++n) {
+        for (size_t k = 0; k < cols.size(); ++k)
+          values[k] = draws(n, cols[k]);
+        try {
+          stan::io::array_var_context context(param_names, values,
+                                              param_dims);
+          Eigen::VectorXd x;
+          model.transform_inits(context, x, output);
+          params_r.col(n) = x;
+        } catch (const std::exception& e) {
+          if (output)
+            *output << "Draw " << n + 1 << " could not be transformed."
+                    << std::endl;
+          write_error_msg(output, e);
+          return false;
+        }
+      }
+      return true;
+    }
+
+  }
+}
+#endif
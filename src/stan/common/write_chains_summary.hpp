@@ -0,0 +1,68 @@
+#ifndef STAN__COMMON__WRITE_CHAINS_SUMMARY_HPP
+#define STAN__COMMON__WRITE_CHAINS_SUMMARY_HPP
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <stan/mcmc/chains_summary.hpp>
+
+namespace stan {
+
+  namespace common {
+
+    /**
+     * Write the posterior mean, standard deviation, effective
+     * sample size and split R-hat of every parameter, computed
+     * across all of the chains from their streaming summaries.
+     *
+     * @param o stream to write to
+     * @param names parameter names
+     * @param chains streaming summary of the kept draws of every chain
+     */
+    inline void
+    write_chains_summary(std::ostream& o,
+                         const std::vector<std::string>& names,
+                         const std::vector<stan::mcmc::online_summary*>& chains) {
+      std::streamsize precision = o.precision();
+      int name_width = 4;
+      for (size_t i = 0; i < names.size(); ++i)
+        name_width = std::max(name_width, static_cast<int>(names[i].size()));
+
+      size_t num_kept_samples = 0;
+      std::vector<const stan::mcmc::online_summary*> summaries;
+      for (size_t chain = 0; chain < chains.size(); ++chain) {
+        num_kept_samples += chains[chain]->num_draws();
+        summaries.push_back(chains[chain]);
+      }
+
+      o << std::endl
+        << "Summary of " << chains.size() << " chains, "
+        << num_kept_samples << " kept draws:" << std::endl
+        << std::setw(name_width) << "name"
+        << std::setw(14) << "Mean"
+        << std::setw(14) << "StdDev"
+        << std::setw(10) << "N_Eff"
+        << std::setw(10) << "R_hat" << std::endl;
+
+      stan::mcmc::chains_summary summary
+        = stan::mcmc::online_summary::summarize(summaries);
+      for (size_t i = 0; i < names.size(); ++i) {
+        o << std::setw(name_width) << names[i]
+          << std::setw(14) << std::setprecision(6) << summary.mean(i)
+          << std::setw(14) << std::setprecision(6) << summary.sd(i)
+          << std::setw(10) << std::setprecision(4) << summary.n_eff(i)
+          << std::setw(10) << std::setprecision(4) << summary.r_hat(i)
+          << std::endl;
+      }
+      o << std::endl;
+      o.precision(precision);
+    }
+
+  } // namespace common
+
+} // namespace stan
+
+#endif
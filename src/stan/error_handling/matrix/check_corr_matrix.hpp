@@ -1,6 +1,7 @@
 #ifndef STAN__ERROR_HANDLING__MATRIX__CHECK_CORR_MATRIX_HPP
 #define STAN__ERROR_HANDLING__MATRIX__CHECK_CORR_MATRIX_HPP
 
+#include <cmath>
 #include <sstream>
 
 #include <stan/error_handling/scalar/dom_err.hpp>
@@ -10,6 +11,7 @@
 #include <stan/error_handling/matrix/check_size_match.hpp>
 #include <stan/error_handling/matrix/constraint_tolerance.hpp>
 #include <stan/math/matrix/Eigen.hpp>
+#include <stan/math/matrix/value_of_rec.hpp>
 #include <stan/math/matrix/meta/index_type.hpp>
 
 
@@ -40,6 +42,7 @@ namespace stan {
       using Eigen::Dynamic;
       using Eigen::Matrix;
       using stan::math::index_type;
+      using stan::math::value_of_rec;
 
       typedef typename index_type<Matrix<T_y,Dynamic,Dynamic> >::type size_t;
 
@@ -52,7 +55,7 @@ namespace stan {
       check_symmetric(function, "y", y);
       
       for (size_t k = 0; k < y.rows(); ++k) {
-        if (!(fabs(y(k,k) - 1.0) <= CONSTRAINT_TOLERANCE)) {
+        if (!(std::fabs(value_of_rec(y(k,k)) - 1.0) <= CONSTRAINT_TOLERANCE)) {
           std::ostringstream msg;
           msg << "is not a valid correlation matrix. " 
               << name << "(" << stan::error_index::value + k 
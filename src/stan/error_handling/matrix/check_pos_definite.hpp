@@ -3,6 +3,7 @@
 
 #include <sstream>
 #include <stan/math/matrix/Eigen.hpp>
+#include <stan/math/matrix/value_of_rec.hpp>
 #include <stan/error_handling/scalar/dom_err.hpp>
 #include <stan/error_handling/scalar/check_not_nan.hpp>
 #include <stan/error_handling/matrix/constraint_tolerance.hpp>
@@ -39,8 +40,8 @@ namespace stan {
       for (int i = 0; i < y.size(); ++i)
         check_not_nan(function, name, y(i));
 
-      Eigen::LDLT< Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic> > cholesky 
-        = y.ldlt();
+      Eigen::LDLT< Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic> >
+        cholesky = stan::math::value_of_rec(y).ldlt();
       if (cholesky.info() != Eigen::Success
           || !cholesky.isPositive()
           || (cholesky.vectorD().array() <= CONSTRAINT_TOLERANCE).any()) {
@@ -1,10 +1,12 @@
 #ifndef STAN__ERROR_HANDLING__MATRIX__CHECK_SIMPLEX_HPP
 #define STAN__ERROR_HANDLING__MATRIX__CHECK_SIMPLEX_HPP
 
+#include <cmath>
 #include <sstream>
 #include <stan/error_handling/scalar/dom_err.hpp>
 #include <stan/error_handling/matrix/constraint_tolerance.hpp>
 #include <stan/math/matrix/Eigen.hpp>
+#include <stan/math/matrix/value_of_rec.hpp>
 #include <stan/math/matrix/meta/index_type.hpp>
 #include <stan/meta/traits.hpp>
 
@@ -46,9 +48,9 @@ namespace stan {
                 msg_str.c_str());
         return false;
       }
-      if (!(fabs(1.0 - theta.sum()) <= CONSTRAINT_TOLERANCE)) {
+      double sum = stan::math::value_of_rec(theta).sum();
+      if (!(std::fabs(1.0 - sum) <= CONSTRAINT_TOLERANCE)) {
         std::stringstream msg;
-        T_prob sum = theta.sum();
         msg << "is not a valid simplex.";
         msg.precision(10);
         msg << " sum(" << name << ") = " << sum
@@ -1,11 +1,13 @@
 #ifndef STAN__ERROR_HANDLING__MATRIX__CHECK_SYMMETRIC_HPP
 #define STAN__ERROR_HANDLING__MATRIX__CHECK_SYMMETRIC_HPP
 
+#include <cmath>
 #include <sstream>
 
 #include <stan/error_handling/scalar/dom_err.hpp>
 #include <stan/error_handling/matrix/constraint_tolerance.hpp>
 #include <stan/math/matrix/Eigen.hpp>
+#include <stan/math/matrix/value_of_rec.hpp>
 #include <stan/math/matrix/meta/index_type.hpp>
 #include <stan/meta/traits.hpp>
 
@@ -18,6 +20,9 @@ namespace stan {
      * 
      * NOTE: squareness is not checked by this function
      *
+     * The comparison is done on the values, so nothing is recorded
+     * for auto-dif arguments.
+     *
      * @param function 
      * @param y Matrix to test.
      * @param name
@@ -33,6 +38,7 @@ namespace stan {
       using Eigen::Dynamic;
       using Eigen::Matrix;
       using stan::math::index_type;
+      using stan::math::value_of_rec;
 
       typedef typename index_type<Matrix<T_y,Dynamic,Dynamic> >::type size_type;
 
@@ -41,7 +47,8 @@ namespace stan {
         return true;
       for (size_type m = 0; m < k; ++m) {
         for (size_type n = m + 1; n < k; ++n) {
-          if (!(fabs(y(m,n) - y(n,m)) <= CONSTRAINT_TOLERANCE)) {
+          if (!(std::fabs(value_of_rec(y(m,n)) - value_of_rec(y(n,m)))
+                <= CONSTRAINT_TOLERANCE)) {
             std::ostringstream msg1;
             msg1 << "is not symmetric. " 
                     << name << "[" << stan::error_index::value + m << "," 
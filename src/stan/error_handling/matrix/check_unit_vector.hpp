@@ -1,8 +1,10 @@
 #ifndef STAN__ERROR_HANDLING__MATRIX__CHECK_UNIT_VECTOR_HPP
 #define STAN__ERROR_HANDLING__MATRIX__CHECK_UNIT_VECTOR_HPP
 
+#include <cmath>
 #include <sstream>
 #include <stan/math/matrix/Eigen.hpp>
+#include <stan/math/matrix/value_of_rec.hpp>
 #include <stan/error_handling/scalar/dom_err.hpp>
 #include <stan/error_handling/matrix/constraint_tolerance.hpp>
 
@@ -31,8 +33,8 @@ namespace stan {
                 "is not a valid unit vector. ",
                 " elements in the vector.");
       }
-      T_prob ssq = theta.squaredNorm();
-      if (!(fabs(1.0 - ssq) <= CONSTRAINT_TOLERANCE)) {
+      double ssq = stan::math::value_of_rec(theta).squaredNorm();
+      if (!(std::fabs(1.0 - ssq) <= CONSTRAINT_TOLERANCE)) {
         std::stringstream msg;
         msg << "is not a valid unit vector."
             << " The sum of the squares of the elements should be 1, but is ";
@@ -0,0 +1,32 @@
+#ifndef STAN__GM__ARGUMENTS__BINARY__HPP
+#define STAN__GM__ARGUMENTS__BINARY__HPP
+
+#include <stan/gm/arguments/categorical_argument.hpp>
+
+#include <stan/gm/arguments/arg_binary_layout.hpp>
+
+namespace stan {
+  
+  namespace gm {
+    
+    class arg_binary: public categorical_argument {
+      
+    public:
+      
+      arg_binary() {
+        
+        _name = "binary";
+        _description = "Binary draws, read with stan::io::stan_binary_reader";
+        
+        _subarguments.push_back(new arg_binary_layout());
+        
+      }
+      
+    };
+    
+  } // gm
+  
+} // stan
+
+#endif
+
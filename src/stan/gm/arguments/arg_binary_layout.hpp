@@ -0,0 +1,37 @@
+#ifndef STAN__GM__ARGUMENTS__BINARY__LAYOUT__HPP
+#define STAN__GM__ARGUMENTS__BINARY__LAYOUT__HPP
+
+#include <stan/gm/arguments/singleton_argument.hpp>
+
+namespace stan {
+  
+  namespace gm {
+    
+    class arg_binary_layout: public string_argument {
+      
+    public:
+      
+      arg_binary_layout(): string_argument() {
+        _name = "layout";
+        _description = "Order of the draws in the file";
+        _validity = "iteration or column";
+        _default = "iteration";
+        _default_value = "iteration";
+        _constrained = true;
+        _good_value = "column";
+        _bad_value = "row";
+        _value = _default_value;
+      };
+      
+      bool is_valid(std::string value) {
+        return value == "iteration" || value == "column";
+      }
+      
+    };
+    
+  } // gm
+  
+} // stan
+
+#endif
+
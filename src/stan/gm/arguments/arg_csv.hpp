@@ -0,0 +1,28 @@
+#ifndef STAN__GM__ARGUMENTS__CSV__HPP
+#define STAN__GM__ARGUMENTS__CSV__HPP
+
+#include <stan/gm/arguments/categorical_argument.hpp>
+
+namespace stan {
+  
+  namespace gm {
+    
+    class arg_csv: public categorical_argument {
+      
+    public:
+      
+      arg_csv() {
+        
+        _name = "csv";
+        _description = "Comma separated values";
+        
+      }
+      
+    };
+    
+  } // gm
+  
+} // stan
+
+#endif
+
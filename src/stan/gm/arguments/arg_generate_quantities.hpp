@@ -0,0 +1,31 @@
+#ifndef STAN__GM__ARGUMENTS__GENERATE__QUANTITIES__HPP
+#define STAN__GM__ARGUMENTS__GENERATE__QUANTITIES__HPP
+
+#include <stan/gm/arguments/categorical_argument.hpp>
+
+#include <stan/gm/arguments/arg_generate_quantities_file.hpp>
+
+namespace stan {
+  
+  namespace gm {
+    
+    class arg_generate_quantities: public categorical_argument {
+      
+    public:
+      
+      arg_generate_quantities() {
+        
+        _name = "generate_quantities";
+        _description = "Transformed parameters and generated quantities at stored draws";
+        
+        _subarguments.push_back(new arg_generate_quantities_file());
+        
+      }
+      
+    };
+    
+  } // gm
+  
+} // stan
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef STAN__GM__ARGUMENTS__GENERATE__QUANTITIES__FILE__HPP
+#define STAN__GM__ARGUMENTS__GENERATE__QUANTITIES__FILE__HPP
+
+#include <stan/gm/arguments/singleton_argument.hpp>
+
+namespace stan {
+  
+  namespace gm {
+    
+    class arg_generate_quantities_file: public string_argument {
+      
+    public:
+      
+      arg_generate_quantities_file(): string_argument() {
+        _name = "file";
+        _description = "Input Stan CSV file of fitted draws";
+        _validity = "Path to existing file";
+        _default = "\"\"";
+        _default_value = "";
+        _constrained = false;
+        _good_value = "good";
+        _value = _default_value;
+      };
+      
+    };
+    
+  } // gm
+  
+} // stan
+
+#endif
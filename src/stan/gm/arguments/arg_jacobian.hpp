@@ -0,0 +1,31 @@
+#ifndef STAN__GM__ARGUMENTS__JACOBIAN__HPP
+#define STAN__GM__ARGUMENTS__JACOBIAN__HPP
+
+#include <stan/gm/arguments/singleton_argument.hpp>
+
+namespace stan {
+  
+  namespace gm {
+    
+    class arg_jacobian: public bool_argument {
+      
+    public:
+      
+      arg_jacobian(): bool_argument() {
+        _name = "jacobian";
+        _description = "Include the Jacobian of the parameter transforms?";
+        _validity = "[0, 1]";
+        _default = "1";
+        _default_value = true;
+        _constrained = false;
+        _good_value = 1;
+        _value = _default_value;
+      };
+      
+    };
+    
+  } // gm
+  
+} // stan
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef STAN__GM__ARGUMENTS__LOG__PROB__HPP
+#define STAN__GM__ARGUMENTS__LOG__PROB__HPP
+
+#include <stan/gm/arguments/categorical_argument.hpp>
+
+#include <stan/gm/arguments/arg_log_prob_file.hpp>
+#include <stan/gm/arguments/arg_jacobian.hpp>
+#include <stan/gm/arguments/arg_log_prob_gradient.hpp>
+
+namespace stan {
+  
+  namespace gm {
+    
+    class arg_log_prob: public categorical_argument {
+      
+    public:
+      
+      arg_log_prob() {
+        
+        _name = "log_prob";
+        _description = "Log density, including constants, at stored draws";
+        
+        _subarguments.push_back(new arg_log_prob_file());
+        _subarguments.push_back(new arg_jacobian());
+        _subarguments.push_back(new arg_log_prob_gradient());
+        
+      }
+      
+    };
+    
+  } // gm
+  
+} // stan
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef STAN__GM__ARGUMENTS__LOG__PROB__GRADIENT__HPP
+#define STAN__GM__ARGUMENTS__LOG__PROB__GRADIENT__HPP
+
+#include <stan/gm/arguments/singleton_argument.hpp>
+
+namespace stan {
+  
+  namespace gm {
+    
+    class arg_log_prob_gradient: public bool_argument {
+      
+    public:
+      
+      arg_log_prob_gradient(): bool_argument() {
+        _name = "gradient";
+        _description = "Also write the gradient with respect to the unconstrained parameters?";
+        _validity = "[0, 1]";
+        _default = "0";
+        _default_value = false;
+        _constrained = false;
+        _good_value = 1;
+        _value = _default_value;
+      };
+      
+    };
+    
+  } // gm
+  
+} // stan
+
+#endif
@@ -6,6 +6,8 @@
 #include <stan/gm/arguments/arg_sample.hpp>
 #include <stan/gm/arguments/arg_optimize.hpp>
 #include <stan/gm/arguments/arg_diagnose.hpp>
+#include <stan/gm/arguments/arg_log_prob.hpp>
+#include <stan/gm/arguments/arg_generate_quantities.hpp>
 
 namespace stan {
   
@@ -23,6 +25,8 @@ namespace stan {
         _values.push_back(new arg_sample());
         _values.push_back(new arg_optimize());
         _values.push_back(new arg_diagnose());
+        _values.push_back(new arg_log_prob());
+        _values.push_back(new arg_generate_quantities());
         
         _default_cursor = 0;
         _cursor = _default_cursor;
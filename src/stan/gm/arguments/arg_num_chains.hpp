@@ -0,0 +1,35 @@
+#ifndef STAN__GM__ARGUMENTS__NUM__CHAINS__HPP
+#define STAN__GM__ARGUMENTS__NUM__CHAINS__HPP
+
+#include <stan/gm/arguments/singleton_argument.hpp>
+
+namespace stan {
+  
+  namespace gm {
+    
+    class arg_num_chains: public int_argument {
+      
+    public:
+      
+      arg_num_chains(): int_argument() {
+        _name = "num_chains";
+        _description = "Number of chains sharing one model instance";
+        _validity = "0 < num_chains";
+        _default = "1";
+        _default_value = 1;
+        _constrained = true;
+        _good_value = 2.0;
+        _bad_value = 0.0;
+        _value = _default_value;
+      };
+      
+      bool is_valid(int value) { return value > 0; }
+      
+    };
+    
+  } // gm
+  
+} // stan
+
+#endif
+
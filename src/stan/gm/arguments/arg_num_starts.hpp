@@ -0,0 +1,35 @@
+#ifndef STAN__GM__ARGUMENTS__NUM__STARTS__HPP
+#define STAN__GM__ARGUMENTS__NUM__STARTS__HPP
+
+#include <stan/gm/arguments/singleton_argument.hpp>
+
+namespace stan {
+  
+  namespace gm {
+    
+    class arg_num_starts: public int_argument {
+      
+    public:
+      
+      arg_num_starts(): int_argument() {
+        _name = "num_starts";
+        _description = "Number of bfgs or lbfgs runs from independent initializations sharing one model instance; more than one requires save_iterations=0";
+        _validity = "0 < num_starts";
+        _default = "1";
+        _default_value = 1;
+        _constrained = true;
+        _good_value = 2.0;
+        _bad_value = 0.0;
+        _value = _default_value;
+      };
+      
+      bool is_valid(int value) { return value > 0; }
+      
+    };
+    
+  } // gm
+  
+} // stan
+
+#endif
+
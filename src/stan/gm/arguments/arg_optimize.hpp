@@ -6,6 +6,8 @@
 #include <stan/gm/arguments/arg_optimize_algo.hpp>
 #include <stan/gm/arguments/arg_iter.hpp>
 #include <stan/gm/arguments/arg_save_iterations.hpp>
+#include <stan/gm/arguments/arg_num_starts.hpp>
+#include <stan/gm/arguments/arg_tolerance.hpp>
 
 namespace stan {
   
@@ -23,6 +25,8 @@ namespace stan {
         _subarguments.push_back(new arg_optimize_algo());
         _subarguments.push_back(new arg_iter());
         _subarguments.push_back(new arg_save_iterations());
+        _subarguments.push_back(new arg_num_starts());
+        _subarguments.push_back(new arg_tolerance("mode_tol", "Relative tolerance in each unconstrained parameter within which the optima of two runs are the same mode", 1e-3));
         
       }
       
@@ -6,6 +6,7 @@
 #include <stan/gm/arguments/arg_output_file.hpp>
 #include <stan/gm/arguments/arg_diagnostic_file.hpp>
 #include <stan/gm/arguments/arg_refresh.hpp>
+#include <stan/gm/arguments/arg_output_format.hpp>
 
 namespace stan {
   
@@ -23,6 +24,7 @@ namespace stan {
         _subarguments.push_back(new arg_output_file());
         _subarguments.push_back(new arg_diagnostic_file());
         _subarguments.push_back(new arg_refresh());
+        _subarguments.push_back(new arg_output_format());
         
       }
       
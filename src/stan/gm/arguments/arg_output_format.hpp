@@ -0,0 +1,37 @@
+#ifndef STAN__GM__ARGUMENTS__OUTPUT__FORMAT__HPP
+#define STAN__GM__ARGUMENTS__OUTPUT__FORMAT__HPP
+
+#include <stan/gm/arguments/list_argument.hpp>
+
+#include <stan/gm/arguments/arg_csv.hpp>
+#include <stan/gm/arguments/arg_binary.hpp>
+
+namespace stan {
+  
+  namespace gm {
+    
+    class arg_output_format: public list_argument {
+      
+    public:
+      
+      arg_output_format() {
+        
+        _name = "format";
+        _description = "Format of the sample output file";
+        
+        _values.push_back(new arg_csv());
+        _values.push_back(new arg_binary());
+        
+        _default_cursor = 0;
+        _cursor = _default_cursor;
+        
+      }
+      
+    };
+    
+  } // gm
+  
+} // stan
+
+#endif
+
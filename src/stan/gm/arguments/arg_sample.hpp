@@ -5,6 +5,7 @@
 
 #include <stan/gm/arguments/arg_num_samples.hpp>
 #include <stan/gm/arguments/arg_num_warmup.hpp>
+#include <stan/gm/arguments/arg_num_chains.hpp>
 #include <stan/gm/arguments/arg_save_warmup.hpp>
 #include <stan/gm/arguments/arg_thin.hpp>
 #include <stan/gm/arguments/arg_adapt.hpp>
@@ -27,6 +28,7 @@ namespace stan {
         _subarguments.push_back(new arg_num_warmup());
         _subarguments.push_back(new arg_save_warmup());
         _subarguments.push_back(new arg_thin());
+        _subarguments.push_back(new arg_num_chains());
         _subarguments.push_back(new arg_adapt());
         _subarguments.push_back(new arg_sample_algo());
         
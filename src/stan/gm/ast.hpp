@@ -48,6 +48,7 @@ namespace stan {
     struct sample;
     struct simplex_var_decl;
     struct integrate_ode;
+    struct integrate_ode_stiff;
     struct unit_vector_var_decl;
     struct statement;
     struct statements;
@@ -204,6 +205,7 @@ namespace stan {
       expr_type operator()(const variable& e) const;
       expr_type operator()(const fun& e) const;
       expr_type operator()(const integrate_ode& e) const;
+      expr_type operator()(const integrate_ode_stiff& e) const;
       expr_type operator()(const index_op& e) const;
       expr_type operator()(const binary_op& e) const;
       expr_type operator()(const unary_op& e) const;
@@ -220,6 +222,7 @@ namespace stan {
                              boost::recursive_wrapper<array_literal>,
                              boost::recursive_wrapper<variable>,
                              boost::recursive_wrapper<integrate_ode>,
+                             boost::recursive_wrapper<integrate_ode_stiff>,
                              boost::recursive_wrapper<fun>,
                              boost::recursive_wrapper<index_op>,
                              boost::recursive_wrapper<binary_op>,
@@ -237,6 +240,7 @@ namespace stan {
       expression(const variable& expr);
       expression(const fun& expr);
       expression(const integrate_ode& expr);
+      expression(const integrate_ode_stiff& expr);
       expression(const index_op& expr);
       expression(const binary_op& expr);
       expression(const unary_op& expr);
@@ -274,6 +278,7 @@ namespace stan {
       bool operator()(const array_literal& x) const;
       bool operator()(const variable& x) const;
       bool operator()(const integrate_ode& x) const;
+      bool operator()(const integrate_ode_stiff& x) const;
       bool operator()(const fun& x) const;
       bool operator()(const index_op& x) const;
       bool operator()(const binary_op& x) const;
@@ -347,6 +352,30 @@ namespace stan {
                 const expression& x_int);
     };
 
+    struct integrate_ode_stiff {
+      std::string system_function_name_;
+      expression y0_;    // initial state
+      expression t0_;    // initial time
+      expression ts_;    // solution times
+      expression theta_; // params
+      expression x_;     // data
+      expression x_int_;     // integer data
+      expression rel_tol_;   // relative tolerance
+      expression abs_tol_;   // absolute tolerance
+      expression max_num_steps_; // maximum number of steps
+      integrate_ode_stiff();
+      integrate_ode_stiff(const std::string& system_function_name,
+                          const expression& y0,
+                          const expression& t0,
+                          const expression& ts,
+                          const expression& theta,
+                          const expression& x,
+                          const expression& x_int,
+                          const expression& rel_tol,
+                          const expression& abs_tol,
+                          const expression& max_num_steps);
+    };
+
     struct fun {
       std::string name_;
       std::vector<expression> args_;
@@ -856,6 +885,7 @@ namespace stan {
       bool operator()(const array_literal& e) const;
       bool operator()(const variable& e) const;
       bool operator()(const integrate_ode& e) const;
+      bool operator()(const integrate_ode_stiff& e) const;
       bool operator()(const fun& e) const;
       bool operator()(const index_op& e) const;
       bool operator()(const binary_op& e) const;
@@ -875,6 +905,7 @@ namespace stan {
       bool operator()(const array_literal& e) const;
       bool operator()(const variable& e) const;
       bool operator()(const integrate_ode& e) const;
+      bool operator()(const integrate_ode_stiff& e) const;
       bool operator()(const fun& e) const;
       bool operator()(const index_op& e) const;
       bool operator()(const binary_op& e) const;
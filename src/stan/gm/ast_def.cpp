@@ -548,6 +548,9 @@ namespace stan {
     expr_type expression_type_vis::operator()(const integrate_ode& e) const {
       return expr_type(DOUBLE_T,2);
     }
+    expr_type expression_type_vis::operator()(const integrate_ode_stiff& e) const {
+      return expr_type(DOUBLE_T,2);
+    }
     expr_type expression_type_vis::operator()(const fun& e) const {
       return e.type_;
     }
@@ -581,6 +584,7 @@ namespace stan {
     expression::expression(const array_literal& expr) : expr_(expr) { }
     expression::expression(const variable& expr) : expr_(expr) { }
     expression::expression(const integrate_ode& expr) : expr_(expr) { }
+    expression::expression(const integrate_ode_stiff& expr) : expr_(expr) { }
     expression::expression(const fun& expr) : expr_(expr) { }
     expression::expression(const index_op& expr) : expr_(expr) { }
     expression::expression(const binary_op& expr) : expr_(expr) { }
@@ -630,6 +634,12 @@ namespace stan {
         || boost::apply_visitor(*this, e.theta_.expr_)
         ;
     }
+    bool contains_var::operator()(const integrate_ode_stiff& e) const {
+      // only init state and params may contain vars
+      return boost::apply_visitor(*this, e.y0_.expr_)
+        || boost::apply_visitor(*this, e.theta_.expr_)
+        ;
+    }
     bool contains_var::operator()(const index_op& e) const {
       return boost::apply_visitor(*this,e.expr_.expr_);
     }
@@ -707,6 +717,12 @@ namespace stan {
         || boost::apply_visitor(*this, e.theta_.expr_)
         ;
     }
+    bool contains_nonparam_var::operator()(const integrate_ode_stiff& e) const {
+      // if any vars, return true because integration will be nonlinear
+      return boost::apply_visitor(*this, e.y0_.expr_)
+        || boost::apply_visitor(*this, e.theta_.expr_)
+        ;
+    }
     bool contains_nonparam_var::operator()(const fun& e) const {
       // any function applied to non-linearly transformed var
       for (size_t i = 0; i < e.args_.size(); ++i)
@@ -757,6 +773,7 @@ namespace stan {
     bool is_nil_op::operator()(const array_literal& /* x */) const { return false; }
     bool is_nil_op::operator()(const variable& /* x */) const { return false; }
     bool is_nil_op::operator()(const integrate_ode& /* x */) const { return false; }
+    bool is_nil_op::operator()(const integrate_ode_stiff& /* x */) const { return false; }
     bool is_nil_op::operator()(const fun& /* x */) const { return false; }
     bool is_nil_op::operator()(const index_op& /* x */) const { return false; }
     bool is_nil_op::operator()(const binary_op& /* x */) const { return false; }
@@ -849,6 +866,29 @@ namespace stan {
         x_int_(x_int) {
     }
 
+    integrate_ode_stiff::integrate_ode_stiff() { }
+    integrate_ode_stiff::integrate_ode_stiff(const std::string& system_function_name,
+                                             const expression& y0,
+                                             const expression& t0,
+                                             const expression& ts,
+                                             const expression& theta,
+                                             const expression& x,
+                                             const expression& x_int,
+                                             const expression& rel_tol,
+                                             const expression& abs_tol,
+                                             const expression& max_num_steps)
+      : system_function_name_(system_function_name),
+        y0_(y0),
+        t0_(t0),
+        ts_(ts),
+        theta_(theta),
+        x_(x),
+        x_int_(x_int),
+        rel_tol_(rel_tol),
+        abs_tol_(abs_tol),
+        max_num_steps_(max_num_steps) {
+    }
+
 
     fun::fun() { }
     fun::fun(std::string const& name,
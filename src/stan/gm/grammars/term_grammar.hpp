@@ -73,6 +73,11 @@ namespace stan {
                               whitespace_grammar<Iterator> > 
       integrate_ode_r;
 
+      boost::spirit::qi::rule<Iterator, 
+                              integrate_ode_stiff(var_origin), 
+                              whitespace_grammar<Iterator> > 
+      integrate_ode_stiff_r;
+
 
       boost::spirit::qi::rule<Iterator, 
                               std::string(), 
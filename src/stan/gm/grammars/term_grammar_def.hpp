@@ -59,6 +59,18 @@ BOOST_FUSION_ADAPT_STRUCT(stan::gm::integrate_ode,
                           (stan::gm::expression, x_)
                           (stan::gm::expression, x_int_) );
 
+BOOST_FUSION_ADAPT_STRUCT(stan::gm::integrate_ode_stiff,
+                          (std::string, system_function_name_)
+                          (stan::gm::expression, y0_)
+                          (stan::gm::expression, t0_)
+                          (stan::gm::expression, ts_)
+                          (stan::gm::expression, theta_)
+                          (stan::gm::expression, x_)
+                          (stan::gm::expression, x_int_)
+                          (stan::gm::expression, rel_tol_)
+                          (stan::gm::expression, abs_tol_)
+                          (stan::gm::expression, max_num_steps_) );
+
 BOOST_FUSION_ADAPT_STRUCT(stan::gm::fun,
                           (std::string, name_)
                           (std::vector<stan::gm::expression>, args_) );
@@ -77,6 +89,110 @@ namespace stan {
   namespace gm {
 
 
+    /**
+     * Check the arguments shared by <code>integrate_ode</code> and
+     * <code>integrate_ode_stiff</code>, writing a message for each
+     * failure.
+     *
+     * @tparam T type of ODE integrator expression
+     * @param ode_fun ODE integrator expression
+     * @param fun_name name of the integrator in messages
+     * @param var_map variables in scope
+     * @param error_msgs stream for error messages
+     * @return true if all arguments are valid
+     */
+    template <typename T>
+    bool validate_integrate_ode_args(const T& ode_fun,
+                                     const std::string& fun_name,
+                                     const variable_map& var_map,
+                                     std::ostream& error_msgs) {
+      bool pass = true;
+
+      // test function argument type
+      expr_type sys_result_type(DOUBLE_T,1);
+      std::vector<expr_type> sys_arg_types;
+      sys_arg_types.push_back(expr_type(DOUBLE_T,0));
+      sys_arg_types.push_back(expr_type(DOUBLE_T,1));
+      sys_arg_types.push_back(expr_type(DOUBLE_T,1));
+      sys_arg_types.push_back(expr_type(DOUBLE_T,1));
+      sys_arg_types.push_back(expr_type(INT_T,1));
+      function_signature_t system_signature(sys_result_type, sys_arg_types);
+      if (!function_signatures::instance()
+          .is_defined(ode_fun.system_function_name_,system_signature)) {
+        error_msgs << "first argument to " << fun_name << " must be a function with signature"
+                   << " (real, real[], real[], real[], int[]) : real[] ";
+        pass = false;
+      }
+
+      // test regular argument types
+      if (ode_fun.y0_.expression_type() != expr_type(DOUBLE_T,1)) {
+        error_msgs << "second argument to " << fun_name << " must be type real[]"
+                   << " for intial system state"
+                   << "; found type=" 
+                   << ode_fun.y0_.expression_type()
+                   << ". ";
+        pass = false;
+      } 
+      if (!ode_fun.t0_.expression_type().is_primitive()) {
+        error_msgs << "third argument to " << fun_name << " must be type real or int"
+                   << " for initial time"
+                   << "; found type=" 
+                   << ode_fun.t0_.expression_type()
+                   << ". ";
+        pass = false;
+      }
+      if (ode_fun.ts_.expression_type() != expr_type(DOUBLE_T,1)) {
+        error_msgs << "fourth argument to " << fun_name << " must be type real[]"
+                   << " for requested solution times"
+                   << "; found type=" 
+                   << ode_fun.ts_.expression_type()
+                   << ". ";
+        pass = false;
+      }
+      if (ode_fun.theta_.expression_type() != expr_type(DOUBLE_T,1)) {
+        error_msgs << "fifth argument to " << fun_name << " must be type real[]"
+                   << " for parameters"
+                   << "; found type=" 
+                   << ode_fun.theta_.expression_type()
+                   << ". ";
+        pass = false;
+      }
+      if (ode_fun.x_.expression_type() != expr_type(DOUBLE_T,1)) {
+        error_msgs << "sixth argument to " << fun_name << " must be type real[]"
+                   << " for real data;"
+                   << " found type=" 
+                   << ode_fun.x_.expression_type()
+                   << ". ";
+        pass = false;
+      }
+      if (ode_fun.x_int_.expression_type() != expr_type(INT_T,1)) {
+        error_msgs << "seventh argument to " << fun_name << " must be type int[]"
+                   << " for integer data;"
+                   << " found type=" 
+                   << ode_fun.x_int_.expression_type()
+                   << ". ";
+        pass = false;
+      }
+
+      // test data-only variables do not have parameters (int locals OK)
+      if (has_var(ode_fun.t0_, var_map)) {
+        error_msgs << "third argument to " << fun_name << " (initial times)"
+                   << " must be data only and not reference parameters";
+        pass = false;
+      }
+      if (has_var(ode_fun.ts_, var_map)) {
+        error_msgs << "fourth argument to " << fun_name << " (solution times)"
+                   << " must be data only and not reference parameters";
+        pass = false;
+      }
+      if (has_var(ode_fun.x_, var_map)) {
+        error_msgs << "fifth argument to " << fun_name << " (real data)"
+                   << " must be data only and not reference parameters";
+        pass = false;
+      }
+      return pass;
+    }
+
     struct validate_integrate_ode {
 
       template <typename T1, typename T2, typename T3, typename T4>
@@ -86,93 +202,68 @@ namespace stan {
                       const variable_map& var_map,
                       bool& pass,
                       std::ostream& error_msgs) const {
-        pass = true;
+        pass = validate_integrate_ode_args(ode_fun, "integrate_ode", var_map,
+                                           error_msgs);
+      }
+    };
+    boost::phoenix::function<validate_integrate_ode> validate_integrate_ode_f;
 
-        // test function argument type
-        expr_type sys_result_type(DOUBLE_T,1);
-        std::vector<expr_type> sys_arg_types;
-        sys_arg_types.push_back(expr_type(DOUBLE_T,0));
-        sys_arg_types.push_back(expr_type(DOUBLE_T,1));
-        sys_arg_types.push_back(expr_type(DOUBLE_T,1));
-        sys_arg_types.push_back(expr_type(DOUBLE_T,1));
-        sys_arg_types.push_back(expr_type(INT_T,1));
-        function_signature_t system_signature(sys_result_type, sys_arg_types);
-        if (!function_signatures::instance()
-            .is_defined(ode_fun.system_function_name_,system_signature)) {
-          error_msgs << "first argument to integrate_ode must be a function with signature"
-                     << " (real, real[], real[], real[], int[]) : real[] ";
-          pass = false;
-        }
+    struct validate_integrate_ode_stiff {
 
-        // test regular argument types
-        if (ode_fun.y0_.expression_type() != expr_type(DOUBLE_T,1)) {
-          error_msgs << "second argument to integrate_ode must be type real[]"
-                     << " for intial system state"
-                     << "; found type=" 
-                     << ode_fun.y0_.expression_type()
-                     << ". ";
-          pass = false;
-        } 
-        if (!ode_fun.t0_.expression_type().is_primitive()) {
-          error_msgs << "third argument to integrate_ode must be type real or int"
-                     << " for initial time"
-                     << "; found type=" 
-                     << ode_fun.t0_.expression_type()
-                     << ". ";
-          pass = false;
-        }
-        if (ode_fun.ts_.expression_type() != expr_type(DOUBLE_T,1)) {
-          error_msgs << "fourth argument to integrate_ode must be type real[]"
-                     << " for requested solution times"
-                     << "; found type=" 
-                     << ode_fun.ts_.expression_type()
-                     << ". ";
-          pass = false;
-        }
-        if (ode_fun.theta_.expression_type() != expr_type(DOUBLE_T,1)) {
-          error_msgs << "fifth argument to integrate_ode must be type real[]"
-                     << " for parameters"
-                     << "; found type=" 
-                     << ode_fun.theta_.expression_type()
+      template <typename T1, typename T2, typename T3, typename T4>
+      struct result { typedef void type; };
+
+      void operator()(const integrate_ode_stiff& ode_fun,
+                      const variable_map& var_map,
+                      bool& pass,
+                      std::ostream& error_msgs) const {
+        pass = validate_integrate_ode_args(ode_fun, "integrate_ode_stiff",
+                                           var_map, error_msgs);
+
+        if (!ode_fun.rel_tol_.expression_type().is_primitive()) {
+          error_msgs << "eighth argument to integrate_ode_stiff must be type"
+                     << " real or int for relative tolerance"
+                     << "; found type="
+                     << ode_fun.rel_tol_.expression_type()
                      << ". ";
           pass = false;
         }
-        if (ode_fun.x_.expression_type() != expr_type(DOUBLE_T,1)) {
-          error_msgs << "sixth argument to integrate_ode must be type real[]"
-                     << " for real data;"
-                     << " found type=" 
-                     << ode_fun.x_.expression_type()
+        if (!ode_fun.abs_tol_.expression_type().is_primitive()) {
+          error_msgs << "ninth argument to integrate_ode_stiff must be type"
+                     << " real or int for absolute tolerance"
+                     << "; found type="
+                     << ode_fun.abs_tol_.expression_type()
                      << ". ";
           pass = false;
         }
-        if (ode_fun.x_int_.expression_type() != expr_type(INT_T,1)) {
-          error_msgs << "seventh argument to integrate_ode must be type int[]"
-                     << " for integer data;"
-                     << " found type=" 
-                     << ode_fun.x_int_.expression_type()
+        if (ode_fun.max_num_steps_.expression_type() != expr_type(INT_T,0)) {
+          error_msgs << "tenth argument to integrate_ode_stiff must be type int"
+                     << " for maximum number of steps"
+                     << "; found type="
+                     << ode_fun.max_num_steps_.expression_type()
                      << ". ";
           pass = false;
         }
 
-        // test data-only variables do not have parameters (int locals OK)
-        if (has_var(ode_fun.t0_, var_map)) {
-          error_msgs << "third argument to integrate_ode (initial times)"
+        if (has_var(ode_fun.rel_tol_, var_map)) {
+          error_msgs << "eighth argument to integrate_ode_stiff (relative tolerance)"
                      << " must be data only and not reference parameters";
           pass = false;
         }
-        if (has_var(ode_fun.ts_, var_map)) {
-          error_msgs << "fourth argument to integrate_ode (solution times)"
+        if (has_var(ode_fun.abs_tol_, var_map)) {
+          error_msgs << "ninth argument to integrate_ode_stiff (absolute tolerance)"
                      << " must be data only and not reference parameters";
           pass = false;
         }
-        if (has_var(ode_fun.x_, var_map)) {
-          error_msgs << "fifth argument to integrate_ode (real data)"
+        if (has_var(ode_fun.max_num_steps_, var_map)) {
+          error_msgs << "tenth argument to integrate_ode_stiff (maximum number of steps)"
                      << " must be data only and not reference parameters";
           pass = false;
         }
       }
     };
-    boost::phoenix::function<validate_integrate_ode> validate_integrate_ode_f;
+    boost::phoenix::function<validate_integrate_ode_stiff>
+    validate_integrate_ode_stiff_f;
     
     struct set_fun_type {
       template <typename T1, typename T2>
@@ -725,9 +816,38 @@ namespace stan {
                                          _pass,
                                          boost::phoenix::ref(error_msgs_))];
 
+      integrate_ode_stiff_r.name("solve stiff ode");
+      integrate_ode_stiff_r
+        %= (lit("integrate_ode_stiff") >> no_skip[!char_("a-zA-Z0-9_")])
+        > lit('(')
+        > identifier_r          // system function name (function only)
+        > lit(',')
+        > expression_g(_r1)     // y0
+        > lit(',')
+        > expression_g(_r1)     // t0 (data only)
+        > lit(',')
+        > expression_g(_r1)     // ts (data only)
+        > lit(',')
+        > expression_g(_r1)     // theta
+        > lit(',')
+        > expression_g(_r1)     // x (data only)
+        > lit(',')
+        > expression_g(_r1)     // x_int (data only)
+        > lit(',')
+        > expression_g(_r1)     // relative tolerance (data only)
+        > lit(',')
+        > expression_g(_r1)     // absolute tolerance (data only)
+        > lit(',')
+        > expression_g(_r1)     // maximum number of steps (data only)
+        > lit(')') [validate_integrate_ode_stiff_f(_val,
+                                         boost::phoenix::ref(var_map_),
+                                         _pass,
+                                         boost::phoenix::ref(error_msgs_))];
+
       factor_r.name("factor");
       factor_r =
-        integrate_ode_r(_r1)    [_val = _1]
+        integrate_ode_stiff_r(_r1)    [_val = _1]
+        | integrate_ode_r(_r1)    [_val = _1]
         | 
         fun_r(_r1)          [set_fun_type_named_f(_val,_1,_r1,_pass,
                                                     boost::phoenix::ref(error_msgs_))]
@@ -211,6 +211,10 @@ namespace stan {
         return boost::apply_visitor(*this, x.y0_.expr_)
           && boost::apply_visitor(*this, x.theta_.expr_);
       }
+      bool operator()(const integrate_ode_stiff& x) const {
+        return boost::apply_visitor(*this, x.y0_.expr_)
+          && boost::apply_visitor(*this, x.theta_.expr_);
+      }
       bool operator()(const fun& x) const {
         for (size_t i = 0; i < x.args_.size(); ++i)
           if (!boost::apply_visitor(*this,x.args_[i].expr_))
@@ -0,0 +1,113 @@
+#ifndef STAN__IO__ARRAY_VAR_CONTEXT_HPP
+#define STAN__IO__ARRAY_VAR_CONTEXT_HPP
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <stan/io/var_context.hpp>
+
+namespace stan {
+
+  namespace io {
+
+    /**
+     * An <code>array_var_context</code> holds floating point
+     * variables whose values are laid out one after another in a
+     * single array, each in column-major order, as in a row of draws
+     * of a Stan CSV file.
+     */
+    class array_var_context : public var_context {
+    private:
+      std::map<std::string,
+               std::pair<std::vector<double>,
+                         std::vector<size_t> > > vars_r_;
+      std::vector<double> const empty_vec_r_;
+      std::vector<int> const empty_vec_i_;
+      std::vector<size_t> const empty_vec_ui_;
+
+    public:
+
+      /**
+       * Construct a context with the specified variable names,
+       * values and dimensions.
+       *
+       * @param names Name of each variable.
+       * @param values Values of all the variables, in order.
+       * @param dims Dimensions of each variable.
+       * @throw std::invalid_argument if there are not as many names
+       * as dimensions or values as the dimensions require.
+       */
+      array_var_context(const std::vector<std::string>& names,
+                        const std::vector<double>& values,
+                        const std::vector<std::vector<size_t> >& dims) {
+        if (names.size() != dims.size())
+          throw std::invalid_argument("array_var_context: number of names"
+                                      " and dimensions differ");
+        size_t pos = 0;
+        for (size_t k = 0; k < names.size(); ++k) {
+          size_t size = 1;
+          for (size_t i = 0; i < dims[k].size(); ++i)
+            size *= dims[k][i];
+          if (pos + size > values.size())
+            throw std::invalid_argument("array_var_context: too few values");
+          vars_r_[names[k]]
+            = std::pair<std::vector<double>,
+                        std::vector<size_t> >(std::vector<double>(values.begin() + pos,
+                                                                  values.begin() + pos + size),
+                                              dims[k]);
+          pos += size;
+        }
+        if (pos != values.size())
+          throw std::invalid_argument("array_var_context: too many values");
+      }
+
+      bool contains_r(const std::string& name) const {
+        return vars_r_.find(name) != vars_r_.end();
+      }
+
+      std::vector<double> vals_r(const std::string& name) const {
+        if (contains_r(name))
+          return vars_r_.find(name)->second.first;
+        return empty_vec_r_;
+      }
+
+      std::vector<size_t> dims_r(const std::string& name) const {
+        if (contains_r(name))
+          return vars_r_.find(name)->second.second;
+        return empty_vec_ui_;
+      }
+
+      bool contains_i(const std::string& name) const {
+        return false;
+      }
+
+      std::vector<int> vals_i(const std::string& name) const {
+        return empty_vec_i_;
+      }
+
+      std::vector<size_t> dims_i(const std::string& name) const {
+        return empty_vec_ui_;
+      }
+
+      void names_r(std::vector<std::string>& names) const {
+        names.resize(0);
+        for (std::map<std::string,
+                      std::pair<std::vector<double>,
+                                std::vector<size_t> > >
+                 ::const_iterator it = vars_r_.begin();
+             it != vars_r_.end(); ++it)
+          names.push_back(it->first);
+      }
+
+      void names_i(std::vector<std::string>& names) const {
+        names.resize(0);
+      }
+
+    };
+
+  }
+
+}
+#endif
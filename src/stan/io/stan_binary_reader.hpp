@@ -0,0 +1,316 @@
+#ifndef STAN__IO__STAN_BINARY_READER_HPP
+#define STAN__IO__STAN_BINARY_READER_HPP
+
+#include <cstring>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <stan/io/stan_csv_reader.hpp>
+#include <stan/math/matrix/Eigen.hpp>
+
+namespace stan {
+  namespace io {
+
+    /**
+     * Reads Stan output written by
+     * <code>stan::common::recorder::binary</code>.
+     *
+     * The file is memory mapped rather than read, and only its
+     * record headers are scanned on construction, so single values
+     * and columns can be extracted without loading every draw.
+     */
+    class stan_binary_reader {
+    private:
+      struct block {
+        size_t first_row;
+        size_t num_rows;
+        bool by_column;
+        const char* values;
+      };
+
+      boost::interprocess::file_mapping file_;
+      boost::interprocess::mapped_region region_;
+      const char* begin_;
+      const char* end_;
+
+      std::vector<std::string> names_;
+      std::vector<std::string> var_names_;
+      std::vector<std::vector<size_t> > var_dims_;
+      std::vector<std::string> comments_before_names_;
+      std::vector<std::string> comments_before_draws_;
+      std::vector<std::string> comments_after_draws_;
+      std::vector<block> blocks_;
+      size_t num_draws_;
+
+      void check_size(const char* pos, boost::uint64_t size) const {
+        if (static_cast<boost::uint64_t>(end_ - pos) < size)
+          throw std::invalid_argument("stan_binary_reader: truncated file");
+      }
+
+      static boost::uint64_t read_uint(const char* pos, int num_bytes) {
+        boost::uint64_t x = 0;
+        for (int i = num_bytes - 1; i >= 0; --i)
+          x = (x << 8) | static_cast<unsigned char>(pos[i]);
+        return x;
+      }
+
+      boost::uint32_t read_uint32(const char*& pos) const {
+        check_size(pos, 4);
+        boost::uint32_t x = read_uint(pos, 4);
+        pos += 4;
+        return x;
+      }
+
+      std::string read_string(const char*& pos) const {
+        boost::uint32_t size = read_uint32(pos);
+        check_size(pos, size);
+        std::string x(pos, size);
+        pos += size;
+        return x;
+      }
+
+      static double read_double(const char* pos) {
+        boost::uint64_t bits = read_uint(pos, 8);
+        double x;
+        std::memcpy(&x, &bits, sizeof(double));
+        return x;
+      }
+
+      void read_names(const char* pos) {
+        boost::uint32_t num_names = read_uint32(pos);
+        names_.clear();
+        for (boost::uint32_t n = 0; n < num_names; ++n)
+          names_.push_back(read_string(pos));
+        boost::uint32_t num_vars = read_uint32(pos);
+        var_names_.clear();
+        var_dims_.clear();
+        for (boost::uint32_t n = 0; n < num_vars; ++n) {
+          var_names_.push_back(read_string(pos));
+          var_dims_.push_back(std::vector<size_t>(read_uint32(pos)));
+          for (size_t i = 0; i < var_dims_.back().size(); ++i)
+            var_dims_.back()[i] = read_uint32(pos);
+        }
+      }
+
+      void read_draws(const char* pos) {
+        check_size(pos, 1);
+        block b;
+        b.by_column = *pos++ != 0;
+        b.num_rows = read_uint32(pos);
+        if (read_uint32(pos) != names_.size())
+          throw std::invalid_argument("stan_binary_reader: draws do not"
+                                      " match the number of columns");
+        check_size(pos, 8 * b.num_rows * names_.size());
+        b.first_row = num_draws_;
+        b.values = pos;
+        blocks_.push_back(b);
+        num_draws_ += b.num_rows;
+      }
+
+      static std::string comment_text(const std::vector<std::string>& comments) {
+        std::stringstream ss;
+        for (size_t n = 0; n < comments.size(); ++n)
+          ss << "# " << comments[n] << std::endl;
+        return ss.str();
+      }
+
+    public:
+      /**
+       * Map the specified file and scan its records.
+       *
+       * @param file_name name of a file written by the binary recorder
+       * @throw std::invalid_argument if the file is not in the binary
+       *   format or is truncated
+       * @throw boost::interprocess::interprocess_exception if the
+       *   file cannot be mapped
+       */
+      explicit stan_binary_reader(const std::string& file_name)
+        : file_(file_name.c_str(), boost::interprocess::read_only),
+          region_(file_, boost::interprocess::read_only),
+          begin_(static_cast<const char*>(region_.get_address())),
+          end_(begin_ + region_.get_size()),
+          num_draws_(0) {
+        if (region_.get_size() < 8 || std::memcmp(begin_, "STANBIN", 7) != 0)
+          throw std::invalid_argument("stan_binary_reader: not a Stan binary"
+                                      " output file");
+        if (begin_[7] != 1)
+          throw std::invalid_argument("stan_binary_reader: unknown format"
+                                      " version");
+
+        const char* pos = begin_ + 8;
+        while (pos < end_) {
+          check_size(pos, 9);
+          char tag = *pos;
+          boost::uint64_t size = read_uint(pos + 1, 8);
+          pos += 9;
+          check_size(pos, size);
+
+          if (tag == 'N') {
+            read_names(pos);
+          } else if (tag == 'D') {
+            read_draws(pos);
+          } else if (tag == 'C') {
+            std::string comment(pos, size);
+            if (names_.empty())
+              comments_before_names_.push_back(comment);
+            else if (blocks_.empty())
+              comments_before_draws_.push_back(comment);
+            else
+              comments_after_draws_.push_back(comment);
+          }
+          pos += size;
+        }
+      }
+
+      /**
+       * Return the column names.
+       */
+      const std::vector<std::string>& names() const {
+        return names_;
+      }
+
+      /**
+       * Return the names of the variables indexed by the columns.
+       */
+      const std::vector<std::string>& variable_names() const {
+        return var_names_;
+      }
+
+      /**
+       * Return the dimensions of each variable.
+       */
+      const std::vector<std::vector<size_t> >& variable_dims() const {
+        return var_dims_;
+      }
+
+      /**
+       * Return the number of draws in the file.
+       */
+      size_t num_draws() const {
+        return num_draws_;
+      }
+
+      /**
+       * Return the value of the specified column in the specified
+       * draw.
+       *
+       * @param draw zero-based index of the draw
+       * @param col zero-based index of the column
+       * @throw std::out_of_range if either index is out of range
+       */
+      double operator()(size_t draw, size_t col) const {
+        if (draw >= num_draws_ || col >= names_.size())
+          throw std::out_of_range("stan_binary_reader: index out of range");
+        // last block starting at or before the draw
+        size_t lo = 0;
+        size_t hi = blocks_.size();
+        while (hi - lo > 1) {
+          size_t mid = lo + (hi - lo) / 2;
+          if (blocks_[mid].first_row <= draw)
+            lo = mid;
+          else
+            hi = mid;
+        }
+        const block& blk = blocks_[lo];
+        size_t row = draw - blk.first_row;
+        size_t offset = blk.by_column
+          ? col * blk.num_rows + row
+          : row * names_.size() + col;
+        return read_double(blk.values + 8 * offset);
+      }
+
+      /**
+       * Return every draw of the specified column.
+       *
+       * @param col zero-based index of the column
+       * @throw std::out_of_range if the column is out of range
+       */
+      Eigen::VectorXd column(size_t col) const {
+        if (col >= names_.size())
+          throw std::out_of_range("stan_binary_reader: index out of range");
+        Eigen::VectorXd x(num_draws_);
+        for (size_t b = 0; b < blocks_.size(); ++b) {
+          const block& blk = blocks_[b];
+          for (size_t row = 0; row < blk.num_rows; ++row) {
+            size_t offset = blk.by_column
+              ? col * blk.num_rows + row
+              : row * names_.size() + col;
+            x(blk.first_row + row) = read_double(blk.values + 8 * offset);
+          }
+        }
+        return x;
+      }
+
+      /**
+       * Return every draw as a matrix with one row per draw.
+       */
+      Eigen::MatrixXd samples() const {
+        Eigen::MatrixXd x(num_draws_, names_.size());
+        for (size_t col = 0; col < names_.size(); ++col)
+          x.col(col) = column(col);
+        return x;
+      }
+
+      /**
+       * Return the contents of the file in the same form as
+       * <code>stan_csv_reader::parse()</code>.  The comments are
+       * parsed exactly as the comment lines of a CSV file.
+       *
+       * @param out stream for warnings about unreadable metadata or
+       *   adaptation comments; may be 0
+       * @throw std::invalid_argument if the column names cannot be
+       *   read
+       */
+      stan_csv parse(std::ostream* out = 0) const {
+        stan_csv data;
+
+        std::stringstream metadata(comment_text(comments_before_names_));
+        if (!stan_csv_reader::read_metadata(metadata, data.metadata) && out)
+          *out << "Warning: non-fatal error reading metadata" << std::endl;
+
+        std::stringstream header;
+        for (size_t n = 0; n < names_.size(); ++n)
+          header << (n > 0 ? "," : "") << names_[n];
+        if (!stan_csv_reader::read_header(header, data.header))
+          throw std::invalid_argument("Error with header of input file in parse");
+
+        std::stringstream adaptation(comment_text(comments_before_draws_));
+        if (!stan_csv_reader::read_adaptation(adaptation, data.adaptation)
+            && out)
+          *out << "Warning: non-fatal error reading adapation data"
+               << std::endl;
+
+        data.samples = samples();
+
+        data.timing.warmup = 0;
+        data.timing.sampling = 0;
+        for (size_t n = 0; n < comments_after_draws_.size(); ++n) {
+          std::string line = "# " + comments_after_draws_[n];
+          int left = 17;
+          int right = line.find(" seconds");
+          if (line.find("(Warm-up)") != std::string::npos)
+            data.timing.warmup
+              += boost::lexical_cast<double>(line.substr(left, right - left));
+          else if (line.find("(Sampling)") != std::string::npos)
+            data.timing.sampling
+              += boost::lexical_cast<double>(line.substr(left, right - left));
+        }
+
+        return data;
+      }
+
+    };
+
+  } // io
+
+} // stan
+
+#endif
@@ -1,10 +1,15 @@
 #ifndef STAN__IO__STAN_CSV_READER_HPP
 #define STAN__IO__STAN_CSV_READER_HPP
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <istream>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <stan/math/matrix.hpp>
@@ -69,6 +74,171 @@ namespace stan {
      * Reads from a Stan output csv file.
      */
     class stan_csv_reader {
+
+    private:
+
+      static void read_timing(const std::string& line, stan_csv_timing& timing) {
+        if (line.find("(Warm-up)") != std::string::npos) {
+          int left = 17;
+          int right = line.find(" seconds");
+          timing.warmup += boost::lexical_cast<double>(line.substr(left, right - left));
+        } else if (line.find("(Sampling)") != std::string::npos) {
+          int left = 17;
+          int right = line.find(" seconds");
+          timing.sampling += boost::lexical_cast<double>(line.substr(left, right - left));
+        }
+      }
+
+      // Parses the comma separated values in [begin, end), where *end
+      // is '\0', into row; only columns marked in keep are converted.
+      static void parse_row(const char* begin, const char* end,
+                            const std::vector<char>& keep,
+                            std::vector<double>& row) {
+        const char* pos = begin;
+        for (size_t col = 0; col < row.size(); ++col) {
+          if (keep[col]) {
+            char* value_end;
+            row[col] = std::strtod(pos, &value_end);
+            if (value_end == pos)
+              throw boost::bad_lexical_cast(typeid(std::string), typeid(double));
+            pos = value_end;
+            while (*pos == ' ' || *pos == '\t' || *pos == '\r')
+              ++pos;
+            if (*pos != ',' && pos != end)
+              throw boost::bad_lexical_cast(typeid(std::string), typeid(double));
+          } else {
+            pos = static_cast<const char*>(std::memchr(pos, ',', end - pos));
+            if (!pos)
+              pos = end;
+          }
+          ++pos;
+        }
+      }
+
+      static bool read_samples(std::istream& in, Eigen::MatrixXd& samples, stan_csv_timing& timing,
+                               const std::vector<size_t>* columns) {
+
+        if (in.peek() == '#' || in.good() == false)
+          return false;
+
+        // unparsed text is kept in [begin, end) of the buffer, which
+        // has room for a terminating '\0' after the last character
+        std::vector<char> buffer(1 << 20);
+        size_t begin = 0;
+        size_t end = 0;
+        bool eof = false;
+
+        int rows = 0;
+        int cols = -1;
+        std::vector<char> keep;
+        std::vector<double> row;
+        std::vector<double> values;
+
+        while (true) {
+          char* line = &buffer[begin];
+          char* line_end = static_cast<char*>(std::memchr(line, '\n', end - begin));
+          if (!line_end) {
+            if (eof) {
+              if (begin == end)
+                break;
+              line_end = &buffer[end];
+            } else {
+              std::memmove(&buffer[0], line, end - begin);
+              end -= begin;
+              begin = 0;
+              if (end + 1 == buffer.size())
+                buffer.resize(2 * buffer.size());
+              in.read(&buffer[end], buffer.size() - 1 - end);
+              end += in.gcount();
+              eof = !in.good();
+              continue;
+            }
+          }
+          *line_end = '\0';
+          begin = std::min<size_t>(line_end - &buffer[0] + 1, end);
+
+          if (line[0] == '#') {
+            read_timing(line, timing);
+            continue;
+          }
+          if (line == line_end || (line[0] == '\r' && line + 1 == line_end))
+            continue;
+
+          int current_cols = std::count(line, static_cast<char*>(line_end), ',') + 1;
+          if (cols == -1) {
+            cols = current_cols;
+            keep.assign(cols, columns == 0);
+            if (columns) {
+              for (size_t n = 0; n < columns->size(); ++n) {
+                if ((*columns)[n] >= static_cast<size_t>(cols))
+                  throw std::out_of_range("stan_csv_reader: column index out of range");
+                keep[(*columns)[n]] = true;
+              }
+            }
+            row.resize(cols);
+          } else if (cols != current_cols) {
+            std::cout << "Error: expected " << cols << " columns, but found " 
+                      << current_cols << " instead for row " << rows + 1 << std::endl;
+            return false;
+          }
+
+          parse_row(line, line_end, keep, row);
+          if (columns) {
+            for (size_t n = 0; n < columns->size(); ++n)
+              values.push_back(row[(*columns)[n]]);
+          } else {
+            values.insert(values.end(), row.begin(), row.end());
+          }
+          rows++;
+        }
+
+        if (rows > 0) {
+          int out_cols = columns ? columns->size() : cols;
+          samples.resize(rows, out_cols);
+          if (out_cols > 0)
+            samples = Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic,
+                                               Eigen::RowMajor> >(&values[0], rows, out_cols);
+        }
+        return true;
+      }
+
+      static stan_csv parse(std::istream& in, const std::vector<size_t>* columns) {
+        
+        stan_csv data;
+        
+        if (!read_metadata(in, data.metadata)) {
+          std::cout << "Warning: non-fatal error reading metadata" << std::endl;
+        }
+        
+        if (!read_header(in, data.header)) {
+          std::cout << "Error: error reading header" << std::endl;
+          throw std::invalid_argument("Error with header of input file in parse");
+        }
+
+        if (columns) {
+          Eigen::Matrix<std::string, Eigen::Dynamic, 1> header(columns->size());
+          for (size_t n = 0; n < columns->size(); ++n) {
+            if ((*columns)[n] >= static_cast<size_t>(data.header.size()))
+              throw std::out_of_range("stan_csv_reader: column index out of range");
+            header(n) = data.header((*columns)[n]);
+          }
+          data.header = header;
+        }
+
+        if (!read_adaptation(in, data.adaptation)) {
+          std::cout << "Warning: non-fatal error reading adapation data" << std::endl;
+        }
+
+        data.timing.warmup = 0;
+        data.timing.sampling = 0;
+        
+        if (!read_samples(in, data.samples, data.timing, columns)) {
+          std::cout << "Warning: non-fatal error reading samples" << std::endl;
+        }
+        
+        return data;
+        
+      }
     
     public:
       
@@ -239,77 +409,40 @@ namespace stan {
 
       }
       
+      /**
+       * Reads the draws and the timing that follows them.
+       *
+       * The stream is read in large blocks and each value is parsed
+       * in place, without copying lines or fields into strings.
+       *
+       * @param in stream positioned after the adaptation comments
+       * @param samples matrix of draws, one row per draw
+       * @param timing timing read from the trailing comments
+       * @return false if the stream does not start with draws or the
+       *   rows have different numbers of columns
+       * @throw boost::bad_lexical_cast if a value is not a number
+       */
       static bool read_samples(std::istream& in, Eigen::MatrixXd& samples, stan_csv_timing& timing) {
-        
-        std::stringstream ss;
-        std::string line;
-
-        int rows = 0;  
-        int cols = -1;
-
-        if (in.peek() == '#' || in.good() == false)
-          return false;
-
-        while (in.good()) {
-          
-          bool comment_line = (in.peek() == '#');
-          bool empty_line   = (in.peek() == '\n');
-
-          std::getline(in, line);
-          
-          if (empty_line) continue;
-          if (!line.length()) break;
-          
-          if (comment_line) {
-
-            if (line.find("(Warm-up)") != std::string::npos) {
-              int left = 17;
-              int right = line.find(" seconds");
-              timing.warmup += boost::lexical_cast<double>(line.substr(left, right - left));
-            } else if (line.find("(Sampling)") != std::string::npos) {
-              int left = 17;
-              int right = line.find(" seconds");
-              timing.sampling += boost::lexical_cast<double>(line.substr(left, right - left));
-            }
-            
-          }
-          else {
-
-            ss << line << '\n';
-            
-            int current_cols = std::count(line.begin(), line.end(), ',') + 1;
-            if (cols == -1) {
-              cols = current_cols;
-            } else if (cols != current_cols) {
-              std::cout << "Error: expected " << cols << " columns, but found " 
-                        << current_cols << " instead for row " << rows + 1 << std::endl;
-              return false;
-            }
-            rows++;
-            
-          }
-          
-          in.peek();
-        
-        }
-          
-        ss.seekg(std::ios_base::beg);
+        return read_samples(in, samples, timing, 0);
+      }
 
-        if (rows > 0) {
-          samples.resize(rows, cols);
-          for (int row = 0; row < rows; row++) {
-            std::getline(ss, line);
-            std::stringstream ls(line);
-            for (int col = 0; col < cols; col++) {
-              std::getline(ls, line, ',');
-              boost::trim(line);
-              //std::cout << "line: !" << line << "@" << std::endl;
-              samples(row, col) = boost::lexical_cast<double>(line);
-              //std::cout << "after" << std::endl << std::endl;
-            }
-          }
-        }
-        return true;
+      /**
+       * Reads the specified columns of the draws and the timing that
+       * follows them.
+       *
+       * @param in stream positioned after the adaptation comments
+       * @param samples matrix of draws, with one row per draw and one
+       *   column for each element of <code>columns</code>
+       * @param timing timing read from the trailing comments
+       * @param columns zero-based indexes of the columns to read
+       * @return false if the stream does not start with draws or the
+       *   rows have different numbers of columns
+       * @throw boost::bad_lexical_cast if a value is not a number
+       * @throw std::out_of_range if a column index is out of range
+       */
+      static bool read_samples(std::istream& in, Eigen::MatrixXd& samples, stan_csv_timing& timing,
+                               const std::vector<size_t>& columns) {
+        return read_samples(in, samples, timing, &columns);
       }
       
       /** 
@@ -317,31 +450,19 @@ namespace stan {
        * 
        */
       static stan_csv parse(std::istream& in) {
-        
-        stan_csv data;
-        
-        if (!read_metadata(in, data.metadata)) {
-          std::cout << "Warning: non-fatal error reading metadata" << std::endl;
-        }
-        
-        if (!read_header(in, data.header)) {
-          std::cout << "Error: error reading header" << std::endl;
-          throw std::invalid_argument("Error with header of input file in parse");
-        }
-
-        if (!read_adaptation(in, data.adaptation)) {
-          std::cout << "Warning: non-fatal error reading adapation data" << std::endl;
-        }
+        return parse(in, 0);
+      }
 
-        data.timing.warmup = 0;
-        data.timing.sampling = 0;
-        
-        if (!read_samples(in, data.samples, data.timing)) {
-          std::cout << "Warning: non-fatal error reading samples" << std::endl;
-        }
-        
-        return data;
-        
+      /**
+       * Parses the file, keeping only the specified columns of the
+       * header and the draws.
+       *
+       * @param in stream to read
+       * @param columns zero-based indexes of the columns to keep
+       * @throw std::out_of_range if a column index is out of range
+       */
+      static stan_csv parse(std::istream& in, const std::vector<size_t>& columns) {
+        return parse(in, &columns);
       }
       
     };
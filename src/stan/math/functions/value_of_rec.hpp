@@ -0,0 +1,39 @@
+#ifndef STAN__MATH__FUNCTIONS__VALUE_OF_REC_HPP
+#define STAN__MATH__FUNCTIONS__VALUE_OF_REC_HPP
+
+namespace stan {
+
+  namespace math {
+    
+    /**
+     * Return the value of the specified scalar argument
+     * converted to a double value.
+     *
+     * <p>Unlike <code>value_of</code>, the auto-dif specializations
+     * of this function recurse through nested auto-dif types, so
+     * the result is a <code>double</code> for every scalar type.
+     *
+     * @tparam T Type of scalar.
+     * @param x Scalar to convert to double.
+     * @return Value of scalar cast to a double.
+     */
+    template <typename T>
+    inline double value_of_rec(const T x) {
+      return static_cast<double>(x);
+    }
+
+    /**
+     * Return the specified argument. 
+     *
+     * @param x Specified value.
+     * @return Specified value.
+     */
+    template <>
+    inline double value_of_rec<double>(const double x) {
+      return x; 
+    }
+
+  }
+}
+
+#endif
@@ -17,6 +17,7 @@
 #include <stan/math/matrix/common_type.hpp>
 #include <stan/math/matrix/containers_conversion.hpp>
 #include <stan/math/matrix/crossprod.hpp>
+#include <stan/math/matrix/csr_matrix_times_vector.hpp>
 #include <stan/math/matrix/cumulative_sum.hpp>
 #include <stan/math/matrix/determinant.hpp>
 #include <stan/math/matrix/diag_matrix.hpp>
@@ -103,6 +104,8 @@
 #include <stan/math/matrix/trace_quad_form.hpp>
 #include <stan/math/matrix/transpose.hpp>
 #include <stan/math/matrix/typedefs.hpp>
+#include <stan/math/matrix/value_array.hpp>
+#include <stan/math/matrix/value_of_rec.hpp>
 #include <stan/math/matrix/variance.hpp>
 
 #endif
@@ -0,0 +1,95 @@
+#ifndef STAN__MATH__MATRIX__CSR_MATRIX_TIMES_VECTOR_HPP
+#define STAN__MATH__MATRIX__CSR_MATRIX_TIMES_VECTOR_HPP
+
+#include <vector>
+#include <boost/math/tools/promotion.hpp>
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/error_handling/matrix/check_size_match.hpp>
+#include <stan/error_handling/scalar/check_bounded.hpp>
+#include <stan/error_handling/scalar/check_equal.hpp>
+#include <stan/error_handling/scalar/check_greater_or_equal.hpp>
+#include <stan/error_handling/scalar/check_positive.hpp>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Check that the specified arrays describe an m by n matrix in
+     * compressed sparse row form, with one-based indexes.
+     *
+     * @param function Name of the calling function.
+     * @param m Number of rows.
+     * @param n Number of columns.
+     * @param w_size Number of non-zero values.
+     * @param v Column index of each non-zero value.
+     * @param u Index in <code>w</code> of the first non-zero value of
+     * each row, followed by one past the last non-zero value.
+     * @throw std::domain_error if the arrays are not consistent.
+     */
+    inline void check_csr(const char* function, int m, int n, int w_size,
+                          const std::vector<int>& v,
+                          const std::vector<int>& u) {
+      using stan::error_handling::check_bounded;
+      using stan::error_handling::check_equal;
+      using stan::error_handling::check_greater_or_equal;
+      using stan::error_handling::check_positive;
+      using stan::error_handling::check_size_match;
+      check_positive(function, "m", m);
+      check_positive(function, "n", n);
+      check_size_match(function, "w", w_size, "v", v.size());
+      check_size_match(function, "u", u.size(), "m + 1", m + 1);
+      check_equal(function, "u[1]", u[0], 1);
+      check_equal(function, "u[m + 1]", u[m], w_size + 1);
+      for (int i = 0; i < m; ++i)
+        check_greater_or_equal(function, "u", u[i + 1], u[i]);
+      check_bounded(function, "v", v, 1, n);
+    }
+
+    /**
+     * Return the product of the m by n sparse matrix in compressed
+     * sparse row form and the specified vector.
+     *
+     * <p>Row <code>i</code> holds the non-zero values
+     * <code>w[u[i]]</code> through <code>w[u[i + 1] - 1]</code>, in
+     * columns <code>v[u[i]]</code> through
+     * <code>v[u[i + 1] - 1]</code>.  Indexes are one-based.
+     *
+     * @tparam T1 Type of non-zero values.
+     * @tparam T2 Type of vector entries.
+     * @param m Number of rows.
+     * @param n Number of columns.
+     * @param w Non-zero values.
+     * @param v Column index of each non-zero value.
+     * @param u Index in <code>w</code> of the first non-zero value of
+     * each row, followed by one past the last non-zero value.
+     * @param b Vector of size n.
+     * @return Vector of size m.
+     * @throw std::domain_error if the arrays do not describe an m by
+     * n matrix or if b is not of size n.
+     */
+    template <typename T1, typename T2>
+    inline
+    Eigen::Matrix<typename boost::math::tools::promote_args<T1,T2>::type,
+                  Eigen::Dynamic, 1>
+    csr_matrix_times_vector(int m, int n,
+                            const Eigen::Matrix<T1,Eigen::Dynamic,1>& w,
+                            const std::vector<int>& v,
+                            const std::vector<int>& u,
+                            const Eigen::Matrix<T2,Eigen::Dynamic,1>& b) {
+      typedef typename boost::math::tools::promote_args<T1,T2>::type T;
+      check_csr("csr_matrix_times_vector", m, n, w.size(), v, u);
+      stan::error_handling::check_size_match("csr_matrix_times_vector",
+                                             "b", b.size(), "n", n);
+      Eigen::Matrix<T,Eigen::Dynamic,1> result(m);
+      for (int i = 0; i < m; ++i) {
+        T sum(0.0);
+        for (int k = u[i] - 1; k < u[i + 1] - 1; ++k)
+          sum += w(k) * b(v[k] - 1);
+        result(i) = sum;
+      }
+      return result;
+    }
+
+  }
+}
+#endif
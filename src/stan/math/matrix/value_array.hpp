@@ -0,0 +1,62 @@
+#ifndef STAN__MATH__MATRIX__VALUE_ARRAY_HPP
+#define STAN__MATH__MATRIX__VALUE_ARRAY_HPP
+
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/math/functions/value_of.hpp>
+#include <stan/meta/traits.hpp>
+
+namespace stan {
+
+  namespace math {
+
+    /**
+     * Maximum size of the arrays returned by
+     * <code>value_array()</code>.  The vectorized densities work
+     * through their arguments in blocks of this size, so that their
+     * intermediate arrays live on the stack and stay in the cache.
+     */
+    const int VALUE_ARRAY_MAX_SIZE = 256;
+
+    /**
+     * Type of the arrays returned by <code>value_array()</code>.
+     *
+     * @tparam T Scalar type.
+     */
+    template <typename T>
+    struct value_array_type {
+      typedef Eigen::Array<T,Eigen::Dynamic,1,Eigen::ColMajor,
+                           VALUE_ARRAY_MAX_SIZE,1> type;
+    };
+
+    /**
+     * Return the values of a block of elements of the specified
+     * scalar or container as a column array.
+     *
+     * <p>A scalar is broadcast to every element of the result.
+     *
+     * @tparam T_return Scalar type of the result.
+     * @tparam T Type of scalar or container.
+     * @param x Scalar or container.
+     * @param start Index of the first element.
+     * @param size Number of elements, at most
+     *   <code>VALUE_ARRAY_MAX_SIZE</code>.
+     * @return Array of values.
+     */
+    template <typename T_return, typename T>
+    inline typename value_array_type<T_return>::type
+    value_array(const T& x, size_t start, size_t size) {
+      using stan::math::value_of;
+      typename value_array_type<T_return>::type result(size);
+      if (!is_vector<T>::value) {
+        result.setConstant(value_of(stan::get(x, 0)));
+      } else {
+        for (size_t n = 0; n < size; ++n)
+          result(n) = value_of(stan::get(x, start + n));
+      }
+      return result;
+    }
+
+  }
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef STAN__MATH__MATRIX__VALUE_OF_REC_HPP
+#define STAN__MATH__MATRIX__VALUE_OF_REC_HPP
+
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/math/functions/value_of_rec.hpp>
+
+namespace stan {
+
+  namespace math {
+
+    /**
+     * Return the matrix of <code>double</code> values of the
+     * specified matrix.
+     *
+     * <p>This lets argument checks and other code that only needs
+     * values work on <code>double</code> without recording anything
+     * on the auto-dif stack.
+     *
+     * @tparam T Scalar type of matrix.
+     * @param M Matrix.
+     * @return Matrix of values.
+     */
+    template <typename T, int R, int C>
+    inline Eigen::Matrix<double,R,C>
+    value_of_rec(const Eigen::Matrix<T,R,C>& M) {
+      Eigen::Matrix<double,R,C> Md(M.rows(), M.cols());
+      for (int i = 0; i < M.size(); ++i)
+        Md(i) = value_of_rec(M(i));
+      return Md;
+    }
+
+    /**
+     * Return the specified matrix of doubles.
+     *
+     * @param M Matrix.
+     * @return Reference to the matrix.
+     */
+    template <int R, int C>
+    inline const Eigen::Matrix<double,R,C>&
+    value_of_rec(const Eigen::Matrix<double,R,C>& M) {
+      return M;
+    }
+
+  }
+}
+
+#endif
@@ -12,12 +12,15 @@
 #include <vector>
 #include <fstream>
 #include <cstdlib>
+#include <limits>
+#ifdef STAN_THREADS
+#include <atomic>
+#include <thread>
+#endif
 
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
 #include <boost/accumulators/statistics/mean.hpp>
-#include <boost/accumulators/statistics/tail_quantile.hpp>
-#include <boost/accumulators/statistics/p_square_quantile.hpp>
 #include <boost/accumulators/statistics/variance.hpp>
 #include <boost/accumulators/statistics/covariance.hpp>
 #include <boost/accumulators/statistics/variates/covariate.hpp>
@@ -26,6 +29,7 @@
 #include <boost/random/additive_combine.hpp>
 
 #include <stan/io/stan_csv_reader.hpp>
+#include <stan/mcmc/chains_summary.hpp>
 #include <stan/math/matrix.hpp>
 #include <stan/math/matrix/variance.hpp>
 #include <stan/math/matrix/meta/index_type.hpp>
@@ -118,66 +122,37 @@ namespace stan {
                                * boost::accumulators::variance(acc_y));
       }
       
-      static double quantile(const Eigen::VectorXd& x, const double prob) {
-        using boost::accumulators::accumulator_set;
-        using boost::accumulators::left;
-        using boost::accumulators::quantile_probability;
-        using boost::accumulators::right;
-        using boost::accumulators::stats;
-        using boost::accumulators::tag::tail;
-        using boost::accumulators::tag::tail_quantile;
-        double M = x.rows();
-        //size_t cache_size = std::min(prob, 1-prob)*M + 2;
-        size_t cache_size = M;
-
+      // Quantile of sorted draws, picked exactly as boost's
+      // tail_quantile accumulator with a cache of every draw does
+      static double sorted_quantile(const std::vector<double>& sorted,
+                                    const double prob) {
+        size_t M = sorted.size();
         if (prob < 0.5) {
-          accumulator_set<double, stats<tail_quantile<left> > > 
-            acc(tail<left>::cache_size = cache_size);
-          for (int i = 0; i < M; i++)
-            acc(x(i));
-          return boost::accumulators::quantile(acc, quantile_probability=prob);
-        } 
-        accumulator_set<double, stats<tail_quantile<right> > > 
-          acc(tail<right>::cache_size = cache_size);
-        for (int i = 0; i < M; i++)
-          acc(x(i));
-        return boost::accumulators::quantile(acc, quantile_probability=prob);
+          size_t n = std::ceil(M * prob);
+          if (n >= M)
+            return std::numeric_limits<double>::quiet_NaN();
+          return sorted[n > 0 ? n - 1 : 0];
+        }
+        size_t n = std::ceil(M * (1 - prob));
+        if (n >= M)
+          return std::numeric_limits<double>::quiet_NaN();
+        return sorted[n > 0 ? M - n : M - 1];
+      }
+
+      static double quantile(const Eigen::VectorXd& x, const double prob) {
+        std::vector<double> sorted(x.data(), x.data() + x.size());
+        std::sort(sorted.begin(), sorted.end());
+        return sorted_quantile(sorted, prob);
       }
 
       static Eigen::VectorXd 
       quantiles(const Eigen::VectorXd& x, const Eigen::VectorXd& probs)
       {
-        using boost::accumulators::accumulator_set;
-        using boost::accumulators::left;
-        using boost::accumulators::quantile_probability;
-        using boost::accumulators::right;
-        using boost::accumulators::stats;
-        using boost::accumulators::tag::tail;
-        using boost::accumulators::tag::tail_quantile;
-        double M = x.rows();
-
-        //size_t cache_size = M/2 + 2;
-        size_t cache_size = M;///2 + 2;
-
-        accumulator_set<double, stats<tail_quantile<left> > > 
-          acc_left(tail<left>::cache_size = cache_size);
-        accumulator_set<double, stats<tail_quantile<right> > > 
-          acc_right(tail<right>::cache_size = cache_size);
-  
-        for (int i = 0; i < M; i++) {
-          acc_left(x(i));
-          acc_right(x(i));
-        }
-
+        std::vector<double> sorted(x.data(), x.data() + x.size());
+        std::sort(sorted.begin(), sorted.end());
         Eigen::VectorXd q(probs.size());  
-        for (int i = 0; i < probs.size(); i++) {
-          if (probs(i) < 0.5) 
-            q(i) = boost::accumulators::quantile(acc_left, 
-                                                 quantile_probability=probs(i));
-          else
-            q(i) = boost::accumulators::quantile(acc_right, 
-                                                 quantile_probability=probs(i));
-        }
+        for (int i = 0; i < probs.size(); i++)
+          q(i) = sorted_quantile(sorted, probs(i));
         return q;
       }
 
@@ -199,6 +174,12 @@ namespace stan {
       }
 
       static Eigen::VectorXd autocovariance(const Eigen::VectorXd& x) {
+        Eigen::FFT<double> fft;
+        return autocovariance(x, fft);
+      }
+
+      static Eigen::VectorXd autocovariance(const Eigen::VectorXd& x,
+                                            Eigen::FFT<double>& fft) {
         using std::vector;
         using stan::math::index_type;
         typedef typename index_type<vector<double> >::type idx_t;
@@ -207,7 +188,7 @@ namespace stan {
         std::vector<double> sample(x.size());
         for (int i = 0; i < x.size(); i++)
           sample[i] = x(i);
-        stan::prob::autocovariance(sample, ac);
+        stan::prob::autocovariance(sample, ac, fft);
 
         Eigen::VectorXd ac2(ac.size());
         for (idx_t i = 0; i < ac.size(); i++)
@@ -232,6 +213,13 @@ namespace stan {
        */
       double effective_sample_size(const Eigen::Matrix<Eigen::VectorXd,
                                    Eigen::Dynamic, 1> &samples) const {
+        Eigen::FFT<double> fft;
+        return effective_sample_size(samples, fft);
+      }
+
+      double effective_sample_size(const Eigen::Matrix<Eigen::VectorXd,
+                                   Eigen::Dynamic, 1> &samples,
+                                   Eigen::FFT<double>& fft) const {
         int chains = samples.size();
   
         // need to generalize to each jagged samples per chain
@@ -242,7 +230,7 @@ namespace stan {
 
         Eigen::Matrix<Eigen::VectorXd, Eigen::Dynamic, 1> acov(chains);
         for (int chain = 0; chain < chains; chain++) {
-          acov(chain) = autocovariance(samples(chain));
+          acov(chain) = autocovariance(samples(chain), fft);
         }
   
         Eigen::VectorXd chain_mean(chains);
@@ -321,6 +309,29 @@ namespace stan {
         // rewrote [(n-1)*W/n + B/n]/W as (n-1+ B/W)/n
         return sqrt((var_between/var_within + n-1)/n);
       }
+
+      // Summarizes one parameter into row index of s, reusing the
+      // caller's FFT engine
+      void summarize(const int index, Eigen::FFT<double>& fft,
+                     chains_summary& s) const {
+        Eigen::Matrix<Eigen::VectorXd, Eigen::Dynamic, 1>
+          chain_samples(num_chains());
+        for (int chain = 0; chain < num_chains(); chain++)
+          chain_samples(chain) = samples(chain, index);
+        Eigen::VectorXd x = samples(index);
+
+        s.mean(index) = mean(x);
+        s.sd(index) = sd(x);
+        s.n_eff(index) = effective_sample_size(chain_samples, fft);
+        s.r_hat(index) = split_potential_scale_reduction(chain_samples);
+
+        if (s.probs.size() > 0) {
+          std::vector<double> sorted(x.data(), x.data() + x.size());
+          std::sort(sorted.begin(), sorted.end());
+          for (int i = 0; i < s.probs.size(); i++)
+            s.quantiles(index, i) = sorted_quantile(sorted, s.probs(i));
+        }
+      }
       
     public:
       chains(const Eigen::Matrix<std::string, Eigen::Dynamic, 1>& param_names) 
@@ -697,6 +708,56 @@ namespace stan {
       double split_potential_scale_reduction(const std::string& name) const {  
         return split_potential_scale_reduction(index(name));
       }
+
+      /**
+       * Return the mean, standard deviation, effective sample size,
+       * split R-hat and quantiles of every parameter across all
+       * kept samples, with the same values as the corresponding
+       * single-parameter methods.
+       *
+       * <p>Parameters are summarized independently, each with one
+       * FFT engine per thread reused for every autocovariance and one
+       * sort for all its quantiles.  If <code>STAN_THREADS</code> is
+       * defined, parameters are shared among a pool of at most one
+       * thread per core.
+       *
+       * @param probs probabilities of the quantiles
+       */
+      chains_summary summary(const Eigen::VectorXd& probs
+                             = Eigen::VectorXd()) const {
+        chains_summary s;
+        s.mean.resize(num_params());
+        s.sd.resize(num_params());
+        s.n_eff.resize(num_params());
+        s.r_hat.resize(num_params());
+        s.probs = probs;
+        s.quantiles.resize(num_params(), probs.size());
+
+#ifdef STAN_THREADS
+        int num_threads
+          = std::min<int>(num_params(),
+                          std::max(1U, std::thread::hardware_concurrency()));
+        if (num_threads > 1) {
+          std::atomic<int> next_index(0);
+          std::vector<std::thread> threads;
+          for (int t = 0; t < num_threads; ++t) {
+            threads.push_back(std::thread([&]() {
+              Eigen::FFT<double> fft;
+              for (int index = next_index++; index < num_params();
+                   index = next_index++)
+                summarize(index, fft, s);
+            }));
+          }
+          for (size_t t = 0; t < threads.size(); ++t)
+            threads[t].join();
+          return s;
+        }
+#endif
+        Eigen::FFT<double> fft;
+        for (int index = 0; index < num_params(); index++)
+          summarize(index, fft, s);
+        return s;
+      }
     };
 
   }
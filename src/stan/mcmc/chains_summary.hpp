@@ -0,0 +1,302 @@
+#ifndef STAN__MCMC__CHAINS_SUMMARY_HPP
+#define STAN__MCMC__CHAINS_SUMMARY_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/accumulators/accumulators.hpp>
+#include <boost/accumulators/statistics/stats.hpp>
+#include <boost/accumulators/statistics/p_square_quantile.hpp>
+
+#include <stan/math/matrix/Eigen.hpp>
+
+namespace stan {
+
+  namespace mcmc {
+
+    /**
+     * Summary statistics of every parameter, with one element or row
+     * per parameter.
+     */
+    struct chains_summary {
+      Eigen::VectorXd mean;
+      Eigen::VectorXd sd;
+      Eigen::VectorXd n_eff;
+      Eigen::VectorXd r_hat;
+      Eigen::VectorXd probs;
+      Eigen::MatrixXd quantiles;  // one column per probability
+    };
+
+    /**
+     * Streaming summary of the draws of one chain, updated in
+     * constant time and memory per draw so that no draws need to be
+     * stored.
+     *
+     * <p>It has the interface of the recorders in
+     * <code>stan::common::recorder</code>, so it can be tee'd onto
+     * the sample recorder of a running chain and summarized at any
+     * point with <code>summarize()</code>.
+     *
+     * <p>Means and variances are accumulated with Welford's
+     * algorithm, separately for each half of the expected number of
+     * draws so that split R-hat matches the batch computation once
+     * every draw has arrived.  The effective sample size uses batch
+     * means with batches of about the square root of the expected
+     * number of draws, and quantiles use the P-square algorithm, so
+     * both are approximations of the values computed from stored
+     * draws by <code>chains::summary()</code>.
+     */
+    class online_summary {
+    private:
+      size_t num_draws_;
+      size_t batch_size_;
+      Eigen::VectorXd probs_;
+
+      size_t n_;
+      Eigen::VectorXd mean_;
+      Eigen::VectorXd m2_;
+      size_t half_n_[2];
+      Eigen::VectorXd half_mean_[2];
+      Eigen::VectorXd half_m2_[2];
+      size_t num_batches_;
+      Eigen::VectorXd batch_sum_;
+      Eigen::VectorXd batch_mean_;
+      Eigen::VectorXd batch_m2_;
+      Eigen::VectorXd draw_;
+
+      typedef boost::accumulators::accumulator_set<double,
+        boost::accumulators::stats<boost::accumulators::tag::p_square_quantile> >
+        quantile_acc_t;
+      std::vector<quantile_acc_t> quantile_accs_;
+
+      static void welford(size_t n, const Eigen::VectorXd& x,
+                          Eigen::VectorXd& mean, Eigen::VectorXd& m2) {
+        for (int i = 0; i < x.size(); ++i) {
+          double delta = x(i) - mean(i);
+          mean(i) += delta / n;
+          m2(i) += delta * (x(i) - mean(i));
+        }
+      }
+
+      void resize(int num_params) {
+        mean_.setZero(num_params);
+        m2_.setZero(num_params);
+        for (int h = 0; h < 2; ++h) {
+          half_n_[h] = 0;
+          half_mean_[h].setZero(num_params);
+          half_m2_[h].setZero(num_params);
+        }
+        batch_sum_.setZero(num_params);
+        batch_mean_.setZero(num_params);
+        batch_m2_.setZero(num_params);
+        draw_.resize(num_params);
+        quantile_accs_.clear();
+        for (int i = 0; i < num_params; ++i)
+          for (int k = 0; k < probs_.size(); ++k)
+            quantile_accs_.push_back(quantile_acc_t(
+              boost::accumulators::quantile_probability = probs_(k)));
+      }
+
+      static double sample_variance(const Eigen::VectorXd& x) {
+        double m = x.mean();
+        return (x.array() - m).square().sum() / (x.size() - 1.0);
+      }
+
+    public:
+      /**
+       * Construct an empty summary.
+       *
+       * @param num_draws number of draws the chain will produce
+       * @param probs probabilities of the quantiles to estimate
+       */
+      explicit online_summary(size_t num_draws,
+                              const Eigen::VectorXd& probs = Eigen::VectorXd())
+        : num_draws_(num_draws),
+          batch_size_(std::max<size_t>(1, std::sqrt(static_cast<double>(num_draws)))),
+          probs_(probs), n_(0), num_batches_(0) { }
+
+      /**
+       * Start a new summary of the specified columns.
+       *
+       * @param names column names
+       */
+      void operator()(const std::vector<std::string>& names) {
+        n_ = 0;
+        num_batches_ = 0;
+        resize(names.size());
+      }
+
+      /**
+       * Add a draw.
+       *
+       * @tparam T type of element
+       * @param x draw, one value per column
+       */
+      template <class T>
+      void operator()(const std::vector<T>& x) {
+        if (n_ == 0 && mean_.size() != static_cast<int>(x.size()))
+          resize(x.size());
+        if (mean_.size() != static_cast<int>(x.size()))
+          throw std::length_error("vector provided does not match the"
+                                  " number of columns");
+        for (size_t i = 0; i < x.size(); ++i)
+          draw_(i) = x[i];
+
+        size_t half_size = num_draws_ / 2;
+        if (n_ < half_size)
+          welford(++half_n_[0], draw_, half_mean_[0], half_m2_[0]);
+        else if (n_ >= num_draws_ - half_size && n_ < num_draws_)
+          welford(++half_n_[1], draw_, half_mean_[1], half_m2_[1]);
+
+        welford(++n_, draw_, mean_, m2_);
+
+        batch_sum_ += draw_;
+        if (n_ % batch_size_ == 0) {
+          welford(++num_batches_, batch_sum_ / batch_size_,
+                  batch_mean_, batch_m2_);
+          batch_sum_.setZero();
+        }
+
+        for (int i = 0; i < draw_.size(); ++i)
+          for (int k = 0; k < probs_.size(); ++k)
+            quantile_accs_[i * probs_.size() + k](draw_(i));
+      }
+
+      /**
+       * Comments are ignored.
+       */
+      void operator()(const std::string x) { }
+
+      /**
+       * Blank lines are ignored.
+       */
+      void operator()() { }
+
+      bool is_recording() const {
+        return true;
+      }
+
+      /**
+       * Return the number of draws added so far.
+       */
+      size_t num_draws() const {
+        return n_;
+      }
+
+      /**
+       * Return the summary of the draws added so far to the
+       * specified chains, which must all have the same columns and
+       * quantile probabilities.  Quantiles are averaged over the
+       * chains.
+       *
+       * @param chains summary of each chain
+       * @throw std::invalid_argument if there are no chains or they
+       *   do not have the same columns
+       */
+      static chains_summary
+      summarize(const std::vector<const online_summary*>& chains) {
+        if (chains.empty())
+          throw std::invalid_argument("summarize: no chains");
+        int num_chains = chains.size();
+        int num_params = chains[0]->mean_.size();
+        Eigen::VectorXd probs = chains[0]->probs_;
+        for (int c = 1; c < num_chains; ++c)
+          if (chains[c]->mean_.size() != num_params
+              || chains[c]->probs_.size() != probs.size())
+            throw std::invalid_argument("summarize: chains do not have the"
+                                        " same columns");
+
+        chains_summary s;
+        s.mean.setZero(num_params);
+        s.sd.resize(num_params);
+        s.n_eff.resize(num_params);
+        s.r_hat.resize(num_params);
+        s.probs = probs;
+        s.quantiles.setZero(num_params, probs.size());
+
+        double nan = std::numeric_limits<double>::quiet_NaN();
+        size_t total = 0;
+        for (int c = 0; c < num_chains; ++c)
+          total += chains[c]->n_;
+
+        Eigen::VectorXd chain_mean(num_chains);
+        Eigen::VectorXd chain_var(num_chains);
+        Eigen::VectorXd chain_batch_var(num_chains);
+        Eigen::VectorXd split_mean(2 * num_chains);
+        Eigen::VectorXd split_var(2 * num_chains);
+        for (int i = 0; i < num_params; ++i) {
+          double sum_sq = 0;
+          for (int c = 0; c < num_chains; ++c) {
+            const online_summary& chain = *chains[c];
+            s.mean(i) += chain.mean_(i) * chain.n_ / total;
+            chain_mean(c) = chain.mean_(i);
+            chain_var(c) = chain.m2_(i) / (chain.n_ - 1.0);
+            chain_batch_var(c) = chain.batch_size_ * chain.batch_m2_(i)
+              / (chain.num_batches_ - 1.0);
+            for (int h = 0; h < 2; ++h) {
+              split_mean(2 * c + h) = chain.half_mean_[h](i);
+              split_var(2 * c + h) = chain.half_m2_[h](i)
+                / (chain.half_n_[h] - 1.0);
+            }
+            for (int k = 0; k < probs.size(); ++k)
+              s.quantiles(i, k) += boost::accumulators::p_square_quantile(
+                chain.quantile_accs_[i * probs.size() + k]) / num_chains;
+          }
+          // pooled variance of all draws
+          for (int c = 0; c < num_chains; ++c) {
+            const online_summary& chain = *chains[c];
+            double delta = chain.mean_(i) - s.mean(i);
+            sum_sq += chain.m2_(i) + chain.n_ * delta * delta;
+          }
+          s.sd(i) = std::sqrt(sum_sq / (total - 1.0));
+
+          // batch means estimate of the effective sample size
+          size_t n = chains[0]->n_;
+          for (int c = 1; c < num_chains; ++c)
+            n = std::min(n, chains[c]->n_);
+          double var_plus = chain_var.mean() * (n - 1.0) / n;
+          if (num_chains > 1)
+            var_plus += sample_variance(chain_mean);
+          bool have_batches = true;
+          for (int c = 0; c < num_chains; ++c)
+            have_batches = have_batches && chains[c]->num_batches_ > 1;
+          s.n_eff(i) = have_batches
+            ? num_chains * n * var_plus / chain_batch_var.mean()
+            : nan;
+
+          // split R-hat from the half-chain means and variances
+          size_t half_n = chains[0]->half_n_[1];
+          bool have_halves = half_n > 1;
+          for (int c = 0; c < num_chains; ++c)
+            have_halves = have_halves
+              && chains[c]->half_n_[0] == half_n
+              && chains[c]->half_n_[1] == half_n;
+          if (have_halves) {
+            double var_between = half_n * sample_variance(split_mean);
+            double var_within = split_var.mean();
+            s.r_hat(i) = std::sqrt((var_between / var_within + half_n - 1)
+                                   / half_n);
+          } else {
+            s.r_hat(i) = nan;
+          }
+        }
+        return s;
+      }
+
+      /**
+       * Return the summary of the draws added so far.
+       */
+      chains_summary summarize() const {
+        return summarize(std::vector<const online_summary*>(1, this));
+      }
+    };
+
+  }
+
+}
+
+#endif
@@ -26,7 +26,9 @@ namespace stan {
       ~dense_e_metric() {};
       
       double T(dense_e_point& z) {
-        return 0.5 * z.p.transpose() * z.mInv * z.p;
+        Eigen::VectorXd Lt_p
+          = z.mInv_L().triangularView<Eigen::Lower>().transpose() * z.p;
+        return 0.5 * Lt_p.squaredNorm();
       }
       
       double tau(dense_e_point& z) { return T(z); }
@@ -37,7 +39,7 @@ namespace stan {
       }
 
       const Eigen::VectorXd dtau_dp(dense_e_point& z) {
-        return z.mInv * z.p;
+        return z.mInv() * z.p;
       }
       
       const Eigen::VectorXd dphi_dq(dense_e_point& z) {
@@ -54,7 +56,7 @@ namespace stan {
         for (idx_t i = 0; i < u.size(); ++i) 
           u(i) = rand_dense_gaus();
 
-        z.p = z.mInv.llt().matrixL().solve(u);
+        z.p = z.mInv_L().triangularView<Eigen::Lower>().solve(u);
         
       }
       
@@ -1,6 +1,9 @@
 #ifndef STAN__MCMC__DENSE__E__POINT__BETA
 #define STAN__MCMC__DENSE__E__POINT__BETA
 
+#include <stan/math/matrix/Eigen.hpp>
+#include <Eigen/Cholesky>
+
 #include <stan/mcmc/hmc/hamiltonians/ps_point.hpp>
 
 namespace stan {
@@ -13,27 +16,57 @@ namespace stan {
       
     public:
       
-      dense_e_point(int n): ps_point(n), mInv(n, n) {
-        mInv.setIdentity();
+      dense_e_point(int n): ps_point(n), mInv_(n, n), mInv_L_(n, n),
+                            mInv_L_valid_(true) {
+        mInv_.setIdentity();
+        mInv_L_.setIdentity();
       };
       
-      Eigen::MatrixXd mInv;
+      dense_e_point(const dense_e_point& z): ps_point(z), mInv_(z.mInv_.rows(), z.mInv_.cols()),
+                                             mInv_L_valid_(z.mInv_L_valid_) {
+        fast_matrix_copy_<double>(mInv_, z.mInv_);
+        if (mInv_L_valid_)
+          fast_matrix_copy_<double>(mInv_L_, z.mInv_L_);
+      }
       
-      dense_e_point(const dense_e_point& z): ps_point(z), mInv(z.mInv.rows(), z.mInv.cols()) {
-        fast_matrix_copy_<double>(mInv, z.mInv);
+      const Eigen::MatrixXd& mInv() const {
+        return mInv_;
+      }
+      
+      // Replace the inverse metric; its Cholesky factor is
+      // recomputed the next time it is needed.
+      void set_mInv(const Eigen::MatrixXd& mInv) {
+        mInv_ = mInv;
+        mInv_L_valid_ = false;
+      }
+      
+      // Lower Cholesky factor of mInv, computed once per change
+      // of the metric.
+      const Eigen::MatrixXd& mInv_L() {
+        if (!mInv_L_valid_) {
+          mInv_L_ = mInv_.llt().matrixL();
+          mInv_L_valid_ = true;
+        }
+        return mInv_L_;
       }
       
       void write_metric(std::ostream* o) {
         if(!o) return;
         *o << "# Elements of inverse mass matrix:" << std::endl;
-        for(int i = 0; i < mInv.rows(); ++i) {
-          *o << "# " << mInv(i, 0) << std::flush;
-          for(int j = 1; j < mInv.cols(); ++j)
-            *o << ", " << mInv(i, j) << std::flush;
+        for(int i = 0; i < mInv_.rows(); ++i) {
+          *o << "# " << mInv_(i, 0) << std::flush;
+          for(int j = 1; j < mInv_.cols(); ++j)
+            *o << ", " << mInv_(i, j) << std::flush;
           *o << std::endl;
         }
       };
       
+    private:
+      
+      Eigen::MatrixXd mInv_;
+      Eigen::MatrixXd mInv_L_;
+      bool mInv_L_valid_;
+      
     };
     
   } // mcmc
@@ -34,9 +34,16 @@ namespace stan {
           
           this->stepsize_adaptation_.learn_stepsize(this->nom_epsilon_, s.accept_stat());
           
-          bool update = this->covar_adaptation_.learn_covariance(this->z_.mInv, this->z_.q);
+          // the adaptation only reads and rewrites the metric at the
+          // end of a window, so only then is it copied out
+          Eigen::MatrixXd mInv;
+          if (this->covar_adaptation_.end_adaptation_window())
+            mInv = this->z_.mInv();
+          
+          bool update = this->covar_adaptation_.learn_covariance(mInv, this->z_.q);
           
           if(update) {
+            this->z_.set_mInv(mInv);
             this->init_stepsize();
             
             this->stepsize_adaptation_.set_mu(log(10 * this->nom_epsilon_));
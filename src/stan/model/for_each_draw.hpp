@@ -0,0 +1,94 @@
+#ifndef STAN__MODEL__FOR_EACH_DRAW_HPP
+#define STAN__MODEL__FOR_EACH_DRAW_HPP
+
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#ifdef STAN_THREADS
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#endif
+
+namespace stan {
+
+  namespace model {
+
+    /**
+     * Messages written while processing draws, kept separately for
+     * each draw so that draws processed concurrently never write to
+     * the same stream.  <code>flush()</code> writes them to the
+     * output stream in draw order.
+     */
+    class draw_messages {
+    private:
+      std::ostream* msgs_;
+      std::vector<std::string> messages_;
+
+    public:
+      draw_messages(std::ostream* msgs, int num_draws)
+        : msgs_(msgs), messages_(msgs ? num_draws : 0) { }
+
+      /**
+       * Return the specified buffer if messages are kept and 0
+       * otherwise, for passing to the model.
+       */
+      std::ostream* stream(std::stringstream& buffer) const {
+        return msgs_ ? &buffer : 0;
+      }
+
+      /**
+       * Keep the contents of the buffer as the messages of draw
+       * <code>n</code>.
+       */
+      void save(int n, const std::stringstream& buffer) {
+        if (msgs_)
+          messages_[n] = buffer.str();
+      }
+
+      void flush() {
+        for (size_t n = 0; n < messages_.size(); ++n)
+          (*msgs_) << messages_[n];
+      }
+    };
+
+    /**
+     * Call the functor with the index of every draw.  Draws are
+     * processed one after another unless <code>STAN_THREADS</code> is
+     * defined, in which case they are pulled off a shared counter by
+     * a pool of at most one thread per core, each with its own
+     * autodiff stack.  The functor must not throw.
+     *
+     * @tparam F Class of functor, with <code>operator()(int)</code>.
+     * @param num_draws Number of draws.
+     * @param f Functor called once for each draw.
+     */
+    template <class F>
+    void for_each_draw(int num_draws, F& f) {
+#ifdef STAN_THREADS
+      int num_threads
+        = std::min<int>(num_draws,
+                        std::max(1U, std::thread::hardware_concurrency()));
+      if (num_threads > 1) {
+        std::atomic<int> next_draw(0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+          threads.push_back(std::thread([&]() {
+            for (int n = next_draw++; n < num_draws; n = next_draw++)
+              f(n);
+          }));
+        }
+        for (size_t t = 0; t < threads.size(); ++t)
+          threads[t].join();
+        return;
+      }
+#endif
+      for (int n = 0; n < num_draws; ++n)
+        f(n);
+    }
+
+  }
+
+}
+#endif
@@ -0,0 +1,175 @@
+#ifndef STAN__MODEL__LOG_PROB_BATCH_HPP
+#define STAN__MODEL__LOG_PROB_BATCH_HPP
+
+#include <exception>
+#include <limits>
+#include <ostream>
+#include <sstream>
+
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/agrad/rev/var.hpp>
+#include <stan/agrad/rev/var_stack.hpp>
+#include <stan/model/for_each_draw.hpp>
+#include <stan/model/util.hpp>
+
+namespace stan {
+
+  namespace model {
+
+    namespace {
+
+      template <bool propto, bool jacobian_adjust_transform, class M>
+      struct log_prob_draw {
+        const M& model_;
+        const Eigen::MatrixXd& params_r_;
+        Eigen::VectorXd& lp_;
+        draw_messages& draw_msgs_;
+
+        log_prob_draw(const M& model, const Eigen::MatrixXd& params_r,
+                      Eigen::VectorXd& lp, draw_messages& msgs)
+          : model_(model), params_r_(params_r), lp_(lp),
+            draw_msgs_(msgs) { }
+
+        void operator()(int n) {
+          std::stringstream buffer;
+          std::ostream* msgs = draw_msgs_.stream(buffer);
+          try {
+            if (propto) {
+              Eigen::Matrix<stan::agrad::var,Eigen::Dynamic,1>
+                x(params_r_.rows());
+              for (int i = 0; i < x.size(); ++i)
+                x(i) = params_r_(i, n);
+              lp_(n) = model_.template log_prob<true,
+                                                jacobian_adjust_transform>(x,
+                                                                           msgs)
+                .val();
+            } else {
+              Eigen::VectorXd x(params_r_.col(n));
+              lp_(n) = model_.template log_prob<false,
+                                                jacobian_adjust_transform>(x,
+                                                                           msgs);
+            }
+          } catch (const std::exception&) {
+            lp_(n) = -std::numeric_limits<double>::infinity();
+          }
+          if (propto)
+            stan::agrad::recover_memory();
+          draw_msgs_.save(n, buffer);
+        }
+      };
+
+      template <bool propto, bool jacobian_adjust_transform, class M>
+      struct log_prob_grad_draw {
+        const M& model_;
+        const Eigen::MatrixXd& params_r_;
+        Eigen::VectorXd& lp_;
+        Eigen::MatrixXd& gradients_;
+        draw_messages& draw_msgs_;
+
+        log_prob_grad_draw(const M& model, const Eigen::MatrixXd& params_r,
+                           Eigen::VectorXd& lp, Eigen::MatrixXd& gradients,
+                           draw_messages& msgs)
+          : model_(model), params_r_(params_r), lp_(lp),
+            gradients_(gradients), draw_msgs_(msgs) { }
+
+        void operator()(int n) {
+          Eigen::VectorXd x(params_r_.col(n));
+          Eigen::VectorXd gradient;
+          std::stringstream buffer;
+          std::ostream* msgs = draw_msgs_.stream(buffer);
+          try {
+            lp_(n) = log_prob_grad<propto,
+                                   jacobian_adjust_transform>(model_, x,
+                                                              gradient,
+                                                              msgs);
+            stan::agrad::recover_memory();
+            gradients_.col(n) = gradient;
+          } catch (const std::exception&) {
+            lp_(n) = -std::numeric_limits<double>::infinity();
+            gradients_.col(n).fill(std::numeric_limits<double>::quiet_NaN());
+          }
+          draw_msgs_.save(n, buffer);
+        }
+      };
+
+    }
+
+    /**
+     * Compute the log density of the model at each column of the
+     * specified matrix of unconstrained parameters.
+     *
+     * <p>Without <code>propto</code> the log density is evaluated with
+     * <code>double</code> scalars and no expression graph is built;
+     * dropping constants requires autodiff variables.  With
+     * <code>STAN_THREADS</code> the draws are evaluated concurrently.
+     * Draws at which the log density cannot be evaluated get a log
+     * density of negative infinity.  Messages from the model are
+     * written to <code>msgs</code> in draw order once every draw is
+     * done.
+     *
+     * @tparam propto True if calculation is up to proportion
+     * (double-only terms dropped).
+     * @tparam jacobian_adjust_transform True if the log absolute
+     * Jacobian determinant of inverse parameter transforms is added to
+     * the log probability.
+     * @tparam M Class of model.
+     * @param[in] model Model.
+     * @param[in] params_r Unconstrained parameters, one draw per column.
+     * @param[out] lp Log density of each draw.
+     * @param[in,out] msgs
+     */
+    template <bool propto, bool jacobian_adjust_transform, class M>
+    void log_prob_batch(const M& model,
+                        const Eigen::MatrixXd& params_r,
+                        Eigen::VectorXd& lp,
+                        std::ostream* msgs = 0) {
+      lp.resize(params_r.cols());
+      draw_messages draw_msgs(msgs, params_r.cols());
+      log_prob_draw<propto, jacobian_adjust_transform, M>
+        f(model, params_r, lp, draw_msgs);
+      for_each_draw(params_r.cols(), f);
+      draw_msgs.flush();
+    }
+
+    /**
+     * Compute the log density of the model and its gradient at each
+     * column of the specified matrix of unconstrained parameters.
+     *
+     * <p>With <code>STAN_THREADS</code> the draws are evaluated
+     * concurrently, each thread on its own autodiff stack.  Draws at
+     * which the log density cannot be evaluated get a log density of
+     * negative infinity and a gradient of not-a-number.  Messages
+     * from the model are written to <code>msgs</code> in draw order
+     * once every draw is done.
+     *
+     * @tparam propto True if calculation is up to proportion
+     * (double-only terms dropped).
+     * @tparam jacobian_adjust_transform True if the log absolute
+     * Jacobian determinant of inverse parameter transforms is added to
+     * the log probability.
+     * @tparam M Class of model.
+     * @param[in] model Model.
+     * @param[in] params_r Unconstrained parameters, one draw per column.
+     * @param[out] lp Log density of each draw.
+     * @param[out] gradients Gradient of each draw, one per column.
+     * @param[in,out] msgs
+     */
+    template <bool propto, bool jacobian_adjust_transform, class M>
+    void log_prob_grad_batch(const M& model,
+                             const Eigen::MatrixXd& params_r,
+                             Eigen::VectorXd& lp,
+                             Eigen::MatrixXd& gradients,
+                             std::ostream* msgs = 0) {
+      lp.resize(params_r.cols());
+      gradients.resize(params_r.rows(), params_r.cols());
+      draw_messages draw_msgs(msgs, params_r.cols());
+      log_prob_grad_draw<propto, jacobian_adjust_transform, M>
+        f(model, params_r, lp, gradients, draw_msgs);
+      for_each_draw(params_r.cols(), f);
+      draw_msgs.flush();
+    }
+
+  }
+
+}
+#endif
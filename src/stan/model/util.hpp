@@ -11,6 +11,7 @@
 #include <stan/agrad/rev/var.hpp>
 #include <stan/agrad/rev/var.hpp>
 #include <stan/agrad/autodiff.hpp>
+#include <stan/agrad/fwd/ode.hpp>
 
 namespace stan {
 
@@ -384,6 +385,187 @@ namespace stan {
       return result;
     }
     
+    /**
+     * Evaluate the log-probability, its gradient, and its Hessian
+     * at params_r using forward-over-reverse automatic
+     * differentiation, so the Hessian is exact to rounding error.
+     *
+     * The parameters are taken K directions at a time.  Each block
+     * takes one evaluation of the model's <code>log_prob()</code>
+     * with <code>fvar_k&lt;var,K&gt;</code> scalars whose tangents
+     * are K unit vectors, so the directions share a single forward
+     * pass, followed by one reverse sweep from each tangent of the
+     * result.  Each block is evaluated on its own nested autodiff
+     * stack, so memory use is that of K gradients.
+     *
+     * @tparam propto True if calculation is up to proportion
+     * (double-only terms dropped).
+     * @tparam jacobian_adjust_transform True if the log absolute
+     * Jacobian determinant of inverse parameter transforms is added to the
+     * log probability.
+     * @tparam K Number of directions per evaluation.
+     * @tparam M Class of model.
+     * @param model Model.
+     * @param params_r Real-valued parameter vector.
+     * @param params_i Integer-valued parameter vector.
+     * @param gradient Vector to write gradient to.
+     * @param hessian Vector to write Hessian to. hessian[i*D + j]
+     * gives the element at the ith row and jth column of the Hessian
+     * (where D=params_r.size()).
+     * @param msgs Stream to which print statements in Stan
+     * programs are written, default is 0
+     * @throw stan::agrad::fvar_not_supported if the model's log
+     * density does not support forward-mode autodiff, as for ODE
+     * solutions.
+     */
+    template <bool propto, bool jacobian_adjust_transform, int K, class M>
+    double exact_grad_hess_log_prob(const M& model,
+                                    std::vector<double>& params_r, 
+                                    std::vector<int>& params_i,
+                                    std::vector<double>& gradient,
+                                    std::vector<double>& hessian,
+                                    std::ostream* msgs = 0) {
+      using std::vector;
+      using stan::agrad::var;
+      using stan::agrad::fvar_k;
+
+      size_t D = params_r.size();
+      double lp(0);
+      gradient.resize(D);
+      hessian.resize(D * D);
+      vector<fvar_k<var,K> > ad_params_r(D);
+      // a model without parameters is still evaluated once
+      for (size_t d = 0; d == 0 || d < D; d += K) {
+        stan::agrad::start_nested();
+        try {
+          for (size_t i = 0; i < D; ++i) {
+            ad_params_r[i] = fvar_k<var,K>(params_r[i]);
+            if (i >= d && i < d + K)
+              ad_params_r[i].d_[i - d] = 1.0;
+          }
+          fvar_k<var,K> adLogProb
+            = model
+            .template log_prob<propto,
+                               jacobian_adjust_transform>(ad_params_r,
+                                                          params_i,
+                                                          d == 0 ? msgs : 0);
+          if (d == 0)
+            lp = adLogProb.val_.val();
+          for (size_t k = 0; k < static_cast<size_t>(K) && d + k < D; ++k) {
+            gradient[d + k] = adLogProb.d_[k].val();
+            if (k > 0)
+              stan::agrad::set_zero_all_adjoints_nested();
+            stan::agrad::grad(adLogProb.d_[k].vi_);
+            for (size_t i = 0; i < D; ++i)
+              hessian[(d + k) * D + i] = ad_params_r[i].val_.adj();
+          }
+        } catch (const std::exception& e) {
+          stan::agrad::recover_memory_nested();
+          throw;
+        }
+        stan::agrad::recover_memory_nested();
+      }
+      return lp;
+    }
+
+    /**
+     * Evaluate the log-probability, its gradient, and its Hessian
+     * at params_r using forward-over-reverse automatic
+     * differentiation, four directions per evaluation of the
+     * model's <code>log_prob()</code>.
+     *
+     * @tparam propto True if calculation is up to proportion
+     * (double-only terms dropped).
+     * @tparam jacobian_adjust_transform True if the log absolute
+     * Jacobian determinant of inverse parameter transforms is added to the
+     * log probability.
+     * @tparam M Class of model.
+     * @param model Model.
+     * @param params_r Real-valued parameter vector.
+     * @param params_i Integer-valued parameter vector.
+     * @param gradient Vector to write gradient to.
+     * @param hessian Vector to write Hessian to. hessian[i*D + j]
+     * gives the element at the ith row and jth column of the Hessian
+     * (where D=params_r.size()).
+     * @param msgs Stream to which print statements in Stan
+     * programs are written, default is 0
+     * @throw stan::agrad::fvar_not_supported if the model's log
+     * density does not support forward-mode autodiff.
+     */
+    template <bool propto, bool jacobian_adjust_transform, class M>
+    double exact_grad_hess_log_prob(const M& model,
+                                    std::vector<double>& params_r, 
+                                    std::vector<int>& params_i,
+                                    std::vector<double>& gradient,
+                                    std::vector<double>& hessian,
+                                    std::ostream* msgs = 0) {
+      return exact_grad_hess_log_prob<propto,jacobian_adjust_transform,4>
+        (model, params_r, params_i, gradient, hessian, msgs);
+    }
+
+    /**
+     * Evaluate the log-probability, its gradient, and the product
+     * of its Hessian with the vector v at params_r, using a single
+     * forward-over-reverse pass with the tangents of the parameters
+     * set to v.
+     *
+     * @tparam propto True if calculation is up to proportion
+     * (double-only terms dropped).
+     * @tparam jacobian_adjust_transform True if the log absolute
+     * Jacobian determinant of inverse parameter transforms is added to the
+     * log probability.
+     * @tparam M Class of model.
+     * @param model Model.
+     * @param params_r Real-valued parameter vector.
+     * @param params_i Integer-valued parameter vector.
+     * @param v Vector to multiply the Hessian by.
+     * @param gradient Vector to write gradient to.
+     * @param hessian_v Vector to write the Hessian times v to.
+     * @param msgs Stream to which print statements in Stan
+     * programs are written, default is 0
+     * @throw stan::agrad::fvar_not_supported if the model's log
+     * density does not support forward-mode autodiff, as for ODE
+     * solutions.
+     */
+    template <bool propto, bool jacobian_adjust_transform, class M>
+    double grad_hess_vector_log_prob(const M& model,
+                                     std::vector<double>& params_r, 
+                                     std::vector<int>& params_i,
+                                     const std::vector<double>& v,
+                                     std::vector<double>& gradient,
+                                     std::vector<double>& hessian_v,
+                                     std::ostream* msgs = 0) {
+      using std::vector;
+      using stan::agrad::var;
+      using stan::agrad::fvar;
+
+      size_t D = params_r.size();
+      double lp;
+      stan::agrad::start_nested();
+      try {
+        vector<var> x(D);
+        vector<fvar<var> > ad_params_r(D);
+        for (size_t i = 0; i < D; ++i) {
+          x[i] = params_r[i];
+          ad_params_r[i] = fvar<var>(x[i], v[i]);
+        }
+        fvar<var> adLogProb
+          = model
+          .template log_prob<propto,
+                             jacobian_adjust_transform>(ad_params_r,
+                                                        params_i, msgs);
+        lp = adLogProb.val_.val();
+        adLogProb.val_.grad(x, gradient);
+        stan::agrad::set_zero_all_adjoints_nested();
+        adLogProb.d_.grad(x, hessian_v);
+      } catch (const std::exception& e) {
+        stan::agrad::recover_memory_nested();
+        throw;
+      }
+      stan::agrad::recover_memory_nested();
+      return lp;
+    }
+    
     // Interface for automatic differentiation of models
     
     template <class M>
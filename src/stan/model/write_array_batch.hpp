@@ -0,0 +1,124 @@
+#ifndef STAN__MODEL__WRITE_ARRAY_BATCH_HPP
+#define STAN__MODEL__WRITE_ARRAY_BATCH_HPP
+
+#include <exception>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/model/for_each_draw.hpp>
+
+namespace stan {
+
+  namespace model {
+
+    namespace {
+
+      template <class M, class RNG>
+      struct write_array_draw {
+        const M& model_;
+        const RNG& base_rng_;
+        boost::uintmax_t rng_stride_;
+        const Eigen::MatrixXd& params_r_;
+        Eigen::MatrixXd& values_;
+        std::vector<int>& failed_;
+        draw_messages& draw_msgs_;
+
+        write_array_draw(const M& model, const RNG& base_rng,
+                         boost::uintmax_t rng_stride,
+                         const Eigen::MatrixXd& params_r,
+                         Eigen::MatrixXd& values,
+                         std::vector<int>& failed,
+                         draw_messages& msgs)
+          : model_(model), base_rng_(base_rng), rng_stride_(rng_stride),
+            params_r_(params_r), values_(values), failed_(failed),
+            draw_msgs_(msgs) { }
+
+        void operator()(int n) {
+          RNG rng(base_rng_);
+          rng.discard(rng_stride_ * n);
+          std::vector<double> params_r(params_r_.col(n).data(),
+                                       params_r_.col(n).data()
+                                       + params_r_.rows());
+          std::vector<int> params_i;
+          std::vector<double> vars;
+          std::stringstream buffer;
+          std::ostream* msgs = draw_msgs_.stream(buffer);
+          try {
+            model_.write_array(rng, params_r, params_i, vars,
+                               true, true, msgs);
+          } catch (const std::exception&) {
+            vars.clear();
+          }
+          draw_msgs_.save(n, buffer);
+          if (vars.size() != static_cast<size_t>(values_.rows())) {
+            failed_[n] = 1;
+            values_.col(n).fill(std::numeric_limits<double>::quiet_NaN());
+            return;
+          }
+          for (size_t i = 0; i < vars.size(); ++i)
+            values_(i, n) = vars[i];
+        }
+      };
+
+    }
+
+    /**
+     * Compute the constrained parameters, transformed parameters and
+     * generated quantities of the model at each column of the
+     * specified matrix of unconstrained parameters, as
+     * <code>write_array()</code> does for a single draw.
+     *
+     * <p>Draw <code>n</code> uses a copy of the specified random
+     * number generator advanced by <code>n * rng_stride</code>, so the
+     * values do not depend on the order in which draws are
+     * processed.  With <code>STAN_THREADS</code> the draws are
+     * processed concurrently.  Draws at which the values cannot be
+     * computed get not-a-number values.  Messages from the model are
+     * written to <code>msgs</code> in draw order once every draw is
+     * done.
+     *
+     * @tparam M Class of model.
+     * @tparam RNG Class of random number generator.
+     * @param[in] model Model.
+     * @param[in] base_rng Random number generator for the first draw.
+     * @param[in] rng_stride Random numbers between successive draws.
+     * @param[in] params_r Unconstrained parameters, one draw per column.
+     * @param[out] values Values of each draw, one per column, in the
+     * order of <code>constrained_param_names()</code>.
+     * @param[in,out] msgs
+     * @return Indices of the draws at which the values could not be
+     * computed, in increasing order.
+     */
+    template <class M, class RNG>
+    std::vector<int> write_array_batch(const M& model,
+                          const RNG& base_rng,
+                          boost::uintmax_t rng_stride,
+                          const Eigen::MatrixXd& params_r,
+                          Eigen::MatrixXd& values,
+                          std::ostream* msgs = 0) {
+      std::vector<std::string> names;
+      model.constrained_param_names(names, true, true);
+      values.resize(names.size(), params_r.cols());
+      std::vector<int> failed(params_r.cols(), 0);
+      draw_messages draw_msgs(msgs, params_r.cols());
+      write_array_draw<M, RNG>
+        f(model, base_rng, rng_stride, params_r, values, failed, draw_msgs);
+      for_each_draw(params_r.cols(), f);
+      draw_msgs.flush();
+
+      std::vector<int> failed_draws;
+      for (size_t n = 0; n < failed.size(); ++n)
+        if (failed[n])
+          failed_draws.push_back(n);
+      return failed_draws;
+    }
+
+  }
+
+}
+#endif
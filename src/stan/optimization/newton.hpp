@@ -5,6 +5,7 @@
 #include <Eigen/Cholesky>
 #include <Eigen/Eigenvalues>
 
+#include <stan/agrad/fwd/ode.hpp>
 #include <stan/model/util.hpp>
 
 namespace stan {
@@ -30,6 +31,19 @@ namespace stan {
       }
     }
 
+    /**
+     * Take a Newton step from the specified parameters and return
+     * the new log density.
+     *
+     * <p>If <code>STAN_NEWTON_EXACT_HESSIAN</code> is defined, the
+     * Hessian is computed exactly by forward-over-reverse autodiff.
+     * That instantiates the model's <code>log_prob()</code> with
+     * <code>fvar_k&lt;var,K&gt;</code> scalars, so it is opt-in.
+     * The ODE solvers have overloads that throw
+     * <code>stan::agrad::fvar_not_supported</code>, in which case,
+     * as without the macro, the Hessian is computed by finite
+     * differences of gradients.
+     */
     template <typename M>
     double newton_step(M& model, 
                        std::vector<double>& params_r,
@@ -38,10 +52,24 @@ namespace stan {
         std::vector<double> gradient;
         std::vector<double> hessian;
         
-        double f0 
-          = stan::model::grad_hess_log_prob<true,false>(model,
+        double f0;
+#ifdef STAN_NEWTON_EXACT_HESSIAN
+        try {
+          f0 = stan::model::exact_grad_hess_log_prob<true,false>(model,
+                                                                 params_r,
+                                                                 params_i, 
+                                                                 gradient,
+                                                                 hessian);
+        } catch (const stan::agrad::fvar_not_supported&) {
+          f0 = stan::model::grad_hess_log_prob<true,false>(model,
+                                                          params_r, params_i, 
+                                                          gradient, hessian);
+        }
+#else
+        f0 = stan::model::grad_hess_log_prob<true,false>(model,
                                                         params_r, params_i, 
                                                         gradient, hessian);
+#endif
         matrix_d H(params_r.size(), params_r.size());
         for (size_t i = 0; i < hessian.size(); i++) {
           H(i) = hessian[i];
@@ -1,8 +1,13 @@
 #ifndef STAN__PROB__DISTRIBUTIONS__MULTIVARIATE__CONTINUOUS__GAUSSIAN_DLM_OBS_HPP
 #define STAN__PROB__DISTRIBUTIONS__MULTIVARIATE__CONTINUOUS__GAUSSIAN_DLM_OBS_HPP
 
+#include <cmath>
+#include <stdexcept>
+#include <vector>
 #include <boost/random/normal_distribution.hpp>
 #include <boost/random/variate_generator.hpp>
+#include <stan/agrad/partials_vari_mvt.hpp>
+#include <stan/agrad/rev/functions/value_of_rec.hpp>
 #include <stan/error_handling/matrix/check_cov_matrix.hpp>
 #include <stan/error_handling/matrix/check_size_match.hpp>
 #include <stan/error_handling/matrix/check_spsd_matrix.hpp>
@@ -20,6 +25,7 @@
 #include <stan/math/matrix/tcrossprod.hpp>
 #include <stan/math/matrix/trace_quad_form.hpp>
 #include <stan/math/matrix/transpose.hpp>
+#include <stan/math/matrix/value_of_rec.hpp>
 #include <stan/meta/traits.hpp>
 #include <stan/prob/constants.hpp>
 #include <stan/prob/traits.hpp>
@@ -33,6 +39,467 @@
 
 namespace stan {
   namespace prob {
+    namespace {
+
+      /**
+       * Log density of the Gaussian dynamic linear model for autodiff
+       * types that carry tangents.  The Kalman filter is recorded
+       * through the generic matrix functions.
+       */
+      template <bool propto,
+                typename T_y,
+                typename T_F, typename T_G,
+                typename T_V, typename T_W,
+                typename T_m0, typename T_C0,
+                typename T_lp, bool is_fvar = contains_fvar<T_lp>::value>
+      struct gaussian_dlm_obs_lp {
+        static T_lp
+        apply(const Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic>& y,
+              const Eigen::Matrix<T_F,Eigen::Dynamic,Eigen::Dynamic>& F,
+              const Eigen::Matrix<T_G,Eigen::Dynamic,Eigen::Dynamic>& G,
+              const Eigen::Matrix<T_V,Eigen::Dynamic,Eigen::Dynamic>& V,
+              const Eigen::Matrix<T_W,Eigen::Dynamic,Eigen::Dynamic>& W,
+              const Eigen::Matrix<T_m0,Eigen::Dynamic,1>& m0,
+              const Eigen::Matrix<T_C0,Eigen::Dynamic,Eigen::Dynamic>& C0) {
+          using stan::math::add;
+          using stan::math::inverse_spd;
+          using stan::math::log_determinant_spd;
+          using stan::math::multiply;
+          using stan::math::quad_form_sym;
+          using stan::math::subtract;
+          using stan::math::trace_quad_form;
+          using stan::math::transpose;
+
+          int r = y.rows(); // number of variables
+          int T = y.cols(); // number of observations
+          int n = G.rows(); // number of states
+          T_lp lp(0.0);
+
+          if (include_summand<propto>::value) {
+            lp -= 0.5 * LOG_TWO_PI * r * T;
+          }
+
+          if (include_summand<propto,T_y,T_F,T_G,T_V,T_W,T_m0,T_C0>::value) {
+            Eigen::Matrix<T_lp,Eigen::Dynamic, 1> m(n);
+            Eigen::Matrix<T_lp,Eigen::Dynamic, Eigen::Dynamic> C(n, n);
+
+            // TODO: how to recast matrices
+            for (int i = 0; i < m0.size(); i ++ ) {
+              m(i) = m0(i);
+            }
+            for (int i = 0; i < C0.rows(); i ++ ) {
+              for (int j = 0; j < C0.cols(); j ++ ) {
+                C(i, j) = C0(i, j);
+              }
+            }
+
+            Eigen::Matrix<typename return_type<T_y>::type,
+                          Eigen::Dynamic, 1> yi(r);
+            Eigen::Matrix<T_lp,Eigen::Dynamic, 1> a(n);
+            Eigen::Matrix<T_lp,Eigen::Dynamic, Eigen::Dynamic> R(n, n);
+            Eigen::Matrix<T_lp,Eigen::Dynamic, 1> f(r);
+            Eigen::Matrix<T_lp,Eigen::Dynamic, Eigen::Dynamic> Q(r, r);
+            Eigen::Matrix<T_lp,Eigen::Dynamic, Eigen::Dynamic> Q_inv(r, r);
+            Eigen::Matrix<T_lp,Eigen::Dynamic, 1> e(r);
+            Eigen::Matrix<T_lp,Eigen::Dynamic, Eigen::Dynamic> A(n, r);
+
+            for (int i = 0; i < y.cols(); i++) {
+              yi = y.col(i);
+              // // Predict state
+              // a_t = G_t m_{t-1}
+              a = multiply(G, m);
+              // R_t = G_t C_{t-1} G_t' + W_t
+              R = add(quad_form_sym(C, transpose(G)), W);
+              // // predict observation
+              // f_t = F_t' a_t
+              f = multiply(transpose(F), a);
+              // Q_t = F'_t R_t F_t + V_t
+              Q = add(quad_form_sym(R, F), V);
+              Q_inv = inverse_spd(Q);
+              // // filtered state
+              // e_t = y_t - f_t
+              e = subtract(yi, f);
+              // A_t = R_t F_t Q^{-1}_t
+              A = multiply(multiply(R, F), Q_inv);
+              // m_t = a_t + A_t e_t
+              m = add(a, multiply(A, e));
+              // C = R_t - A_t Q_t A_t'
+              C = subtract(R, quad_form_sym(Q, transpose(A)));
+              lp -= 0.5 * (log_determinant_spd(Q) + trace_quad_form(Q_inv, e));
+            }
+          }
+          return lp;
+        }
+
+        static T_lp
+        apply(const Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic>& y,
+              const Eigen::Matrix<T_F,Eigen::Dynamic,Eigen::Dynamic>& F,
+              const Eigen::Matrix<T_G,Eigen::Dynamic,Eigen::Dynamic>& G,
+              const Eigen::Matrix<T_V,Eigen::Dynamic,1>& V,
+              const Eigen::Matrix<T_W,Eigen::Dynamic,Eigen::Dynamic>& W,
+              const Eigen::Matrix<T_m0,Eigen::Dynamic,1>& m0,
+              const Eigen::Matrix<T_C0,Eigen::Dynamic,Eigen::Dynamic>& C0) {
+          using stan::math::add;
+          using stan::math::dot_product;
+          using stan::math::multiply;
+          using stan::math::quad_form_sym;
+          using stan::math::trace_quad_form;
+          using stan::math::transpose;
+
+          int r = y.rows(); // number of variables
+          int T = y.cols(); // number of observations
+          int n = G.rows(); // number of states
+          T_lp lp(0.0);
+
+          if (include_summand<propto>::value) {
+            lp += 0.5 * NEG_LOG_TWO_PI * r * T;
+          }
+
+          if (include_summand<propto,T_y,T_F,T_G,T_V,T_W,T_m0,T_C0>::value) {
+            T_lp f;
+            T_lp Q;
+            T_lp Q_inv;
+            T_lp e;
+            Eigen::Matrix<T_lp, Eigen::Dynamic, 1> A(n);
+            Eigen::Matrix<T_lp, Eigen::Dynamic, 1> Fj(n);
+            Eigen::Matrix<T_lp, Eigen::Dynamic, 1> m(n);
+            Eigen::Matrix<T_lp, Eigen::Dynamic, Eigen::Dynamic> C(n, n);
+
+            // TODO: how to recast matrices
+            for (int i = 0; i < m0.size(); i ++ ) {
+              m(i) = m0(i);
+            }
+            for (int i = 0; i < C0.rows(); i ++ ) {
+              for (int j = 0; j < C0.cols(); j ++ ) {
+                C(i, j) = C0(i, j);
+              }
+            }
+
+            for (int i = 0; i < y.cols(); i++) {
+              // Predict state
+              // reuse m and C instead of using a and R
+              m = multiply(G, m);
+              C = add(quad_form_sym(C, transpose(G)), W);
+              for (int j = 0; j < y.rows(); ++j) {
+                // predict observation
+                T_lp yij(y(j, i));
+                // dim Fj = (n, 1)
+                for (int k = 0; k < F.rows(); ++k) {
+                  Fj(k) = F(k, j);
+                }
+                // // f_{t,i} = F_{t,i}' m_{t,i-1}
+                f = dot_product(Fj, m);
+                Q = trace_quad_form(C, Fj) + V(j);
+                Q_inv = 1.0 / Q;
+                // // filtered observation
+                // // e_{t,i} = y_{t,i} - f_{t,i}
+                e = yij - f;
+                // // A_{t,i} = C_{t,i-1} F_{t,i} Q_{t,i}^{-1}
+                A = multiply(multiply(C, Fj), Q_inv);
+                // // m_{t,i} = m_{t,i-1} + A_{t,i} e_{t,i}
+                m += multiply(A, e);
+                // // c_{t,i} = C_{t,i-1} - Q_{t,i} A_{t,i} A_{t,i}'
+                // // // tcrossprod throws an error (ambiguous)
+                // C = subtract(C, multiply(Q, tcrossprod(A)));
+                C -= multiply(Q, multiply(A, transpose(A)));
+                C = 0.5 * add(C, transpose(C));
+                lp -= 0.5 * (log(Q) + pow(e, 2) * Q_inv);
+              }
+            }
+          }
+          return lp;
+        }
+      };
+
+      /**
+       * One observation vector of the Kalman filter for the Gaussian
+       * dynamic linear model, on doubles.
+       *
+       * <p><code>filter()</code> advances the state mean and
+       * covariance and keeps the intermediate quantities of the step;
+       * <code>adjoint()</code> then propagates the adjoints of the
+       * filtered mean and covariance back through the step, adding
+       * the partials of the step's term of the log density.  The
+       * adjoints follow the generic path's operations, so a symmetric
+       * argument gets the same full-matrix partials as it would there.
+       */
+      class dlm_filter_step {
+      private:
+        Eigen::VectorXd a_;      // predicted state mean, G * m
+        Eigen::MatrixXd R_;      // predicted state covariance
+        Eigen::MatrixXd RF_;     // R * F
+        Eigen::MatrixXd Q_inv_;  // inverse of forecast covariance
+        Eigen::MatrixXd K_;      // gain, R * F * Q_inv
+        Eigen::VectorXd e_;      // forecast error
+
+      public:
+        double filter(const Eigen::MatrixXd& F, const Eigen::MatrixXd& G,
+                      const Eigen::MatrixXd& V, const Eigen::MatrixXd& W,
+                      const Eigen::VectorXd& y,
+                      Eigen::VectorXd& m, Eigen::MatrixXd& C) {
+          using Eigen::MatrixXd;
+          a_ = G * m;
+          MatrixXd GCG = G * C * G.transpose();
+          R_ = 0.5 * (GCG + GCG.transpose()) + W;
+          RF_ = R_ * F;
+          MatrixXd FRF = F.transpose() * RF_;
+          MatrixXd Q = 0.5 * (FRF + FRF.transpose()) + V;
+          Eigen::LDLT<MatrixXd> ldlt(Q);
+          if (ldlt.info() != Eigen::Success || !ldlt.isPositive()
+              || (ldlt.vectorD().array() <= 0).any())
+            throw std::domain_error("Error in gaussian_dlm_obs_log,"
+                                    " forecast covariance not positive"
+                                    " definite");
+          Q_inv_ = ldlt.solve(MatrixXd::Identity(Q.rows(), Q.cols()));
+          e_ = y - F.transpose() * a_;
+          K_ = RF_ * Q_inv_;
+          m = a_ + K_ * e_;
+          MatrixXd KQK = K_ * RF_.transpose();
+          C = R_ - 0.5 * (KQK + KQK.transpose());
+          return -0.5 * (ldlt.vectorD().array().log().sum()
+                         + e_.dot(Q_inv_ * e_));
+        }
+
+        void adjoint(const Eigen::MatrixXd& F, const Eigen::MatrixXd& G,
+                     const Eigen::VectorXd& m_prev,
+                     const Eigen::MatrixXd& C_prev,
+                     Eigen::VectorXd& d_m, Eigen::MatrixXd& d_C,
+                     Eigen::VectorXd& d_y,
+                     Eigen::MatrixXd& d_F, Eigen::MatrixXd& d_G,
+                     Eigen::MatrixXd& d_V, Eigen::MatrixXd& d_W) const {
+          using Eigen::MatrixXd;
+          using Eigen::VectorXd;
+          // log density term, m = a + K * e and C = R - K * Q * K'
+          MatrixXd d_Q = -0.5 * Q_inv_ - K_.transpose() * d_C * K_;
+          VectorXd d_e = K_.transpose() * d_m - Q_inv_ * e_;
+          MatrixXd d_K = d_m * e_.transpose() - 2.0 * d_C * RF_;
+          // K = R * F * Q_inv
+          MatrixXd d_RF = d_K * Q_inv_;
+          MatrixXd d_Q_inv = RF_.transpose() * d_K - 0.5 * e_ * e_.transpose();
+          d_Q -= 0.5 * Q_inv_ * (d_Q_inv + d_Q_inv.transpose()) * Q_inv_;
+          // e = y - F' * a
+          d_y = d_e;
+          VectorXd d_a = d_m - F * d_e;
+          d_F -= a_ * d_e.transpose();
+          // Q = F' * R * F + V
+          d_V += d_Q;
+          MatrixXd d_R = d_C + F * d_Q * F.transpose() + d_RF * F.transpose();
+          d_F += 2.0 * RF_ * d_Q + R_ * d_RF;
+          // R = G * C_prev * G' + W and a = G * m_prev
+          d_W += d_R;
+          MatrixXd S = 0.5 * (d_R + d_R.transpose());
+          d_G += 2.0 * S * G * C_prev + d_a * m_prev.transpose();
+          d_C = G.transpose() * S * G;
+          d_m = G.transpose() * d_a;
+        }
+      };
+
+      /**
+       * One time step of the sequential Kalman filter for the
+       * Gaussian dynamic linear model with uncorrelated observation
+       * disturbances, on doubles.  The state before each observation
+       * of the step is kept for <code>adjoint()</code>.
+       */
+      class dlm_seq_filter_step {
+      private:
+        std::vector<Eigen::VectorXd> m_;
+        std::vector<Eigen::MatrixXd> C_;
+        Eigen::VectorXd Q_;
+        Eigen::VectorXd e_;
+
+      public:
+        double filter(const Eigen::MatrixXd& F, const Eigen::MatrixXd& G,
+                      const Eigen::VectorXd& V, const Eigen::MatrixXd& W,
+                      const Eigen::VectorXd& y,
+                      Eigen::VectorXd& m, Eigen::MatrixXd& C) {
+          using Eigen::MatrixXd;
+          using Eigen::VectorXd;
+          int r = y.size();
+          m_.resize(r);
+          C_.resize(r);
+          Q_.resize(r);
+          e_.resize(r);
+          m = G * m;
+          MatrixXd GCG = G * C * G.transpose();
+          C = 0.5 * (GCG + GCG.transpose()) + W;
+          double lp = 0.0;
+          for (int j = 0; j < r; ++j) {
+            m_[j] = m;
+            C_[j] = C;
+            VectorXd c = C * F.col(j);
+            double Q = F.col(j).dot(c) + V(j);
+            double e = y(j) - F.col(j).dot(m);
+            m += c * (e / Q);
+            C -= c * c.transpose() / Q;
+            C = (0.5 * (C + C.transpose())).eval();
+            Q_(j) = Q;
+            e_(j) = e;
+            lp -= 0.5 * (std::log(Q) + e * e / Q);
+          }
+          return lp;
+        }
+
+        void adjoint(const Eigen::MatrixXd& F, const Eigen::MatrixXd& G,
+                     const Eigen::VectorXd& m_prev,
+                     const Eigen::MatrixXd& C_prev,
+                     Eigen::VectorXd& d_m, Eigen::MatrixXd& d_C,
+                     Eigen::VectorXd& d_y,
+                     Eigen::MatrixXd& d_F, Eigen::MatrixXd& d_G,
+                     Eigen::VectorXd& d_V, Eigen::MatrixXd& d_W) const {
+          using Eigen::MatrixXd;
+          using Eigen::VectorXd;
+          d_y.resize(e_.size());
+          for (int j = e_.size(); j-- > 0; ) {
+            const VectorXd& m = m_[j];
+            const MatrixXd& C = C_[j];
+            VectorXd c = C * F.col(j);
+            double Q_inv = 1.0 / Q_(j);
+            double e = e_(j);
+            VectorXd A = c * Q_inv;
+            // C = C - Q * A * A', then symmetrized
+            d_C = (0.5 * (d_C + d_C.transpose())).eval();
+            VectorXd d_C_A = d_C * A;
+            double d_Q = -A.dot(d_C_A) - 0.5 * Q_inv;
+            // m = m + A * e and the log density term
+            VectorXd d_A = d_m * e - 2.0 * Q_(j) * d_C_A;
+            double d_e = A.dot(d_m) - e * Q_inv;
+            // A = C * F_j * Q_inv
+            VectorXd d_c = d_A * Q_inv;
+            d_Q -= Q_inv * Q_inv * (c.dot(d_A) - 0.5 * e * e);
+            // e = y - F_j' * m and Q = F_j' * C * F_j + V_j
+            d_y(j) = d_e;
+            d_m -= d_e * F.col(j);
+            d_V(j) += d_Q;
+            d_F.col(j) += -d_e * m + 2.0 * d_Q * c + C * d_c;
+            d_C += (d_Q * F.col(j) + d_c) * F.col(j).transpose();
+          }
+          // C = G * C_prev * G' + W and m = G * m_prev
+          d_W += d_C;
+          MatrixXd S = 0.5 * (d_C + d_C.transpose());
+          d_G += 2.0 * S * G * C_prev + d_m * m_prev.transpose();
+          d_C = G.transpose() * S * G;
+          d_m = G.transpose() * d_m;
+        }
+      };
+
+      /**
+       * Log density of the Gaussian dynamic linear model on doubles.
+       *
+       * <p>The filter runs forward on values, keeping the state mean
+       * and covariance at the start of each time step.  When a
+       * gradient is needed, the steps are recomputed in reverse from
+       * those states and the adjoint recursion accumulates the
+       * partials of every argument, which are put on the stack as a
+       * single node.  The memory used is a state mean and covariance
+       * per time step, independent of the number of operations.
+       */
+      template <bool propto,
+                typename T_y,
+                typename T_F, typename T_G,
+                typename T_V, typename T_W,
+                typename T_m0, typename T_C0,
+                typename T_lp>
+      struct gaussian_dlm_obs_lp<propto,T_y,T_F,T_G,T_V,T_W,T_m0,T_C0,
+                                 T_lp,false> {
+        template <typename T_step, int C_V>
+        static T_lp
+        filter(const Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic>& y,
+               const Eigen::Matrix<T_F,Eigen::Dynamic,Eigen::Dynamic>& F,
+               const Eigen::Matrix<T_G,Eigen::Dynamic,Eigen::Dynamic>& G,
+               const Eigen::Matrix<T_V,Eigen::Dynamic,C_V>& V,
+               const Eigen::Matrix<T_W,Eigen::Dynamic,Eigen::Dynamic>& W,
+               const Eigen::Matrix<T_m0,Eigen::Dynamic,1>& m0,
+               const Eigen::Matrix<T_C0,Eigen::Dynamic,Eigen::Dynamic>& C0,
+               double lp) {
+          using stan::math::value_of_rec;
+          using Eigen::MatrixXd;
+          using Eigen::VectorXd;
+          typedef Eigen::Matrix<double,Eigen::Dynamic,C_V> T_V_d;
+
+          int T = y.cols();
+          agrad::OperandsAndPartialsMvt<T_lp> operands;
+          if (!include_summand<propto,T_y,T_F,T_G,T_V,T_W,T_m0,T_C0>::value)
+            return operands.to_var(lp);
+
+          const MatrixXd& y_d = value_of_rec(y);
+          const MatrixXd& F_d = value_of_rec(F);
+          const MatrixXd& G_d = value_of_rec(G);
+          const T_V_d& V_d = value_of_rec(V);
+          const MatrixXd& W_d = value_of_rec(W);
+          bool need_partials = !is_constant<T_lp>::value;
+
+          VectorXd m = value_of_rec(m0);
+          MatrixXd C = value_of_rec(C0);
+          std::vector<VectorXd> m_prev;
+          std::vector<MatrixXd> C_prev;
+          T_step step;
+          for (int t = 0; t < T; ++t) {
+            if (need_partials) {
+              m_prev.push_back(m);
+              C_prev.push_back(C);
+            }
+            lp += step.filter(F_d, G_d, V_d, W_d, y_d.col(t), m, C);
+          }
+          if (!need_partials)
+            return operands.to_var(lp);
+
+          MatrixXd d_y(y.rows(), T);
+          MatrixXd d_F = MatrixXd::Zero(F.rows(), F.cols());
+          MatrixXd d_G = MatrixXd::Zero(G.rows(), G.cols());
+          T_V_d d_V = T_V_d::Zero(V.rows(), V.cols());
+          MatrixXd d_W = MatrixXd::Zero(W.rows(), W.cols());
+          VectorXd d_m = VectorXd::Zero(m.size());
+          MatrixXd d_C = MatrixXd::Zero(C.rows(), C.cols());
+          VectorXd d_y_t;
+          for (int t = T; t-- > 0; ) {
+            m = m_prev[t];
+            C = C_prev[t];
+            step.filter(F_d, G_d, V_d, W_d, y_d.col(t), m, C);
+            step.adjoint(F_d, G_d, m_prev[t], C_prev[t], d_m, d_C, d_y_t,
+                         d_F, d_G, d_V, d_W);
+            d_y.col(t) = d_y_t;
+          }
+          operands.add(y, d_y);
+          operands.add(F, d_F);
+          operands.add(G, d_G);
+          operands.add(V, d_V);
+          operands.add(W, d_W);
+          operands.add(m0, d_m);
+          operands.add(C0, d_C);
+          return operands.to_var(lp);
+        }
+
+        static T_lp
+        apply(const Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic>& y,
+              const Eigen::Matrix<T_F,Eigen::Dynamic,Eigen::Dynamic>& F,
+              const Eigen::Matrix<T_G,Eigen::Dynamic,Eigen::Dynamic>& G,
+              const Eigen::Matrix<T_V,Eigen::Dynamic,Eigen::Dynamic>& V,
+              const Eigen::Matrix<T_W,Eigen::Dynamic,Eigen::Dynamic>& W,
+              const Eigen::Matrix<T_m0,Eigen::Dynamic,1>& m0,
+              const Eigen::Matrix<T_C0,Eigen::Dynamic,Eigen::Dynamic>& C0) {
+          double lp(0.0);
+          if (include_summand<propto>::value)
+            lp -= 0.5 * LOG_TWO_PI * y.rows() * y.cols();
+          return filter<dlm_filter_step>(y, F, G, V, W, m0, C0, lp);
+        }
+
+        static T_lp
+        apply(const Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic>& y,
+              const Eigen::Matrix<T_F,Eigen::Dynamic,Eigen::Dynamic>& F,
+              const Eigen::Matrix<T_G,Eigen::Dynamic,Eigen::Dynamic>& G,
+              const Eigen::Matrix<T_V,Eigen::Dynamic,1>& V,
+              const Eigen::Matrix<T_W,Eigen::Dynamic,Eigen::Dynamic>& W,
+              const Eigen::Matrix<T_m0,Eigen::Dynamic,1>& m0,
+              const Eigen::Matrix<T_C0,Eigen::Dynamic,Eigen::Dynamic>& C0) {
+          double lp(0.0);
+          if (include_summand<propto>::value)
+            lp += 0.5 * NEG_LOG_TWO_PI * y.rows() * y.cols();
+          return filter<dlm_seq_filter_step>(y, F, G, V, W, m0, C0, lp);
+        }
+      };
+
+    }
+
     /**
      * The log of a Gaussian dynamic linear model (GDLM).
      * This distribution is equivalent to, for \f$t = 1:T\f$,
@@ -86,25 +553,12 @@ namespace stan {
       typedef typename return_type<
         T_y,
         typename return_type<T_F,T_G,T_V,T_W,T_m0,T_C0>::type  >::type T_lp;
-      T_lp lp(0.0);
 
-      using stan::math::add;
       using stan::error_handling::check_cov_matrix;
       using stan::error_handling::check_finite;
       using stan::error_handling::check_not_nan;
       using stan::error_handling::check_size_match;
       using stan::error_handling::check_spsd_matrix;
-      using stan::math::inverse_spd;
-      using stan::math::log_determinant_spd;
-      using stan::math::multiply;
-      using stan::math::quad_form_sym;
-      using stan::math::subtract;
-      using stan::math::trace_quad_form;
-      using stan::math::transpose;
-
-      int r = y.rows(); // number of variables
-      int T = y.cols(); // number of observations
-      int n = G.rows(); // number of states
 
       // check y
       check_finite(function, "y", y);
@@ -155,62 +609,10 @@ namespace stan {
       check_not_nan(function, "C0", C0);
 
       if (y.cols() == 0 || y.rows() == 0)
-        return lp;
-
-      if (include_summand<propto>::value) {
-        lp -= 0.5 * LOG_TWO_PI * r * T;
-      }
-
-      if (include_summand<propto,T_y,T_F,T_G,T_V,T_W,T_m0,T_C0>::value) {
-        Eigen::Matrix<T_lp,Eigen::Dynamic, 1> m(n);
-        Eigen::Matrix<T_lp,Eigen::Dynamic, Eigen::Dynamic> C(n, n);
-
-        // TODO: how to recast matrices
-        for (int i = 0; i < m0.size(); i ++ ) {
-          m(i) = m0(i);
-        }
-        for (int i = 0; i < C0.rows(); i ++ ) {
-          for (int j = 0; j < C0.cols(); j ++ ) {
-            C(i, j) = C0(i, j);
-          }
-        }
+        return T_lp(0.0);
 
-        Eigen::Matrix<typename return_type<T_y>::type,
-                      Eigen::Dynamic, 1> yi(r);
-        Eigen::Matrix<T_lp,Eigen::Dynamic, 1> a(n);
-        Eigen::Matrix<T_lp,Eigen::Dynamic, Eigen::Dynamic> R(n, n);
-        Eigen::Matrix<T_lp,Eigen::Dynamic, 1> f(r);
-        Eigen::Matrix<T_lp,Eigen::Dynamic, Eigen::Dynamic> Q(r, r);
-        Eigen::Matrix<T_lp,Eigen::Dynamic, Eigen::Dynamic> Q_inv(r, r);
-        Eigen::Matrix<T_lp,Eigen::Dynamic, 1> e(r);
-        Eigen::Matrix<T_lp,Eigen::Dynamic, Eigen::Dynamic> A(n, r);
-
-        for (int i = 0; i < y.cols(); i++) {
-          yi = y.col(i);
-          // // Predict state
-          // a_t = G_t m_{t-1}
-          a = multiply(G, m);
-          // R_t = G_t C_{t-1} G_t' + W_t
-          R = add(quad_form_sym(C, transpose(G)), W);
-          // // predict observation
-          // f_t = F_t' a_t
-          f = multiply(transpose(F), a);
-          // Q_t = F'_t R_t F_t + V_t
-          Q = add(quad_form_sym(R, F), V);
-          Q_inv = inverse_spd(Q);
-          // // filtered state
-          // e_t = y_t - f_t
-          e = subtract(yi, f);
-          // A_t = R_t F_t Q^{-1}_t
-          A = multiply(multiply(R, F), Q_inv);
-          // m_t = a_t + A_t e_t
-          m = add(a, multiply(A, e));
-          // C = R_t - A_t Q_t A_t'
-          C = subtract(R, quad_form_sym(Q, transpose(A)));
-          lp -= 0.5 * (log_determinant_spd(Q) + trace_quad_form(Q_inv, e));
-        }
-      }
-      return lp;
+      return gaussian_dlm_obs_lp<propto,T_y,T_F,T_G,T_V,T_W,T_m0,T_C0,T_lp>
+        ::apply(y, F, G, V, W, m0, C0);
     }
 
     template <typename T_y,
@@ -287,26 +689,13 @@ namespace stan {
       typedef typename return_type<
         T_y,
         typename return_type<T_F,T_G,T_V,T_W,T_m0,T_C0>::type  >::type T_lp;
-      T_lp lp(0.0);
 
-      using stan::math::add;
       using stan::error_handling::check_cov_matrix;
       using stan::error_handling::check_finite;
       using stan::error_handling::check_nonnegative;
       using stan::error_handling::check_not_nan;
       using stan::error_handling::check_size_match;
       using stan::error_handling::check_spsd_matrix;
-      using stan::math::dot_product;
-      using stan::math::multiply;
-      using stan::math::quad_form_sym;
-      using stan::math::subtract;
-      using stan::math::tcrossprod;
-      using stan::math::trace_quad_form;
-      using stan::math::transpose;
-
-      int r = y.rows(); // number of variables
-      int T = y.cols(); // number of observations
-      int n = G.rows(); // number of states
 
       // check y
       check_finite(function, "y", y);
@@ -357,65 +746,10 @@ namespace stan {
       check_not_nan(function, "C0", C0);
 
       if (y.cols() == 0 || y.rows() == 0)
-        return lp;
-
-      if (include_summand<propto>::value) {
-        lp += 0.5 * NEG_LOG_TWO_PI * r * T;
-      }
-
-      if (include_summand<propto,T_y,T_F,T_G,T_V,T_W,T_m0,T_C0>::value) {
-        T_lp f;
-        T_lp Q;
-        T_lp Q_inv;
-        T_lp e;
-        Eigen::Matrix<T_lp, Eigen::Dynamic, 1> A(n);
-        Eigen::Matrix<T_lp, Eigen::Dynamic, 1> Fj(n);
-        Eigen::Matrix<T_lp, Eigen::Dynamic, 1> m(n);
-        Eigen::Matrix<T_lp, Eigen::Dynamic, Eigen::Dynamic> C(n, n);
-
-        // TODO: how to recast matrices
-        for (int i = 0; i < m0.size(); i ++ ) {
-          m(i) = m0(i);
-        }
-        for (int i = 0; i < C0.rows(); i ++ ) {
-          for (int j = 0; j < C0.cols(); j ++ ) {
-            C(i, j) = C0(i, j);
-          }
-        }
+        return T_lp(0.0);
 
-        for (int i = 0; i < y.cols(); i++) {
-          // Predict state
-          // reuse m and C instead of using a and R
-          m = multiply(G, m);
-          C = add(quad_form_sym(C, transpose(G)), W);
-          for (int j = 0; j < y.rows(); ++j) {
-            // predict observation
-            T_lp yij(y(j, i));
-            // dim Fj = (n, 1)
-            for (int k = 0; k < F.rows(); ++k) {
-              Fj(k) = F(k, j);
-            }
-            // // f_{t,i} = F_{t,i}' m_{t,i-1}
-            f = dot_product(Fj, m);
-            Q = trace_quad_form(C, Fj) + V(j);
-            Q_inv = 1.0 / Q;
-            // // filtered observation
-            // // e_{t,i} = y_{t,i} - f_{t,i}
-            e = yij - f;
-            // // A_{t,i} = C_{t,i-1} F_{t,i} Q_{t,i}^{-1}
-            A = multiply(multiply(C, Fj), Q_inv);
-            // // m_{t,i} = m_{t,i-1} + A_{t,i} e_{t,i}
-            m += multiply(A, e);
-            // // c_{t,i} = C_{t,i-1} - Q_{t,i} A_{t,i} A_{t,i}'
-            // // // tcrossprod throws an error (ambiguous)
-            // C = subtract(C, multiply(Q, tcrossprod(A)));
-            C -= multiply(Q, multiply(A, transpose(A)));
-            C = 0.5 * add(C, transpose(C));
-            lp -= 0.5 * (log(Q) + pow(e, 2) * Q_inv);
-          }
-        }
-      }
-      return lp;
+      return gaussian_dlm_obs_lp<propto,T_y,T_F,T_G,T_V,T_W,T_m0,T_C0,T_lp>
+        ::apply(y, F, G, V, W, m0, C0);
     }
 
     template <typename T_y,
@@ -1,12 +1,15 @@
 #ifndef STAN__PROB__DISTRIBUTIONS__MULTIVARIATE__CONTINUOUS__INV_WISHART_HPP
 #define STAN__PROB__DISTRIBUTIONS__MULTIVARIATE__CONTINUOUS__INV_WISHART_HPP
 
+#include <stan/agrad/partials_vari_mvt.hpp>
+#include <stan/agrad/rev/functions/value_of_rec.hpp>
 #include <stan/error_handling/matrix/check_ldlt_factor.hpp>
 #include <stan/error_handling/scalar/check_greater.hpp>
 #include <stan/error_handling/matrix/check_size_match.hpp>
 #include <stan/math/matrix/meta/index_type.hpp>
 #include <stan/math/matrix/log_determinant_ldlt.hpp>
 #include <stan/math/matrix/mdivide_left_ldlt.hpp>
+#include <stan/math/matrix/value_of_rec.hpp>
 #include <stan/meta/traits.hpp>
 #include <stan/prob/constants.hpp>
 #include <stan/prob/traits.hpp>
@@ -14,6 +17,145 @@
 
 namespace stan {
   namespace prob {
+
+    namespace {
+
+      /**
+       * Log density of the inverse Wishart for autodiff types that
+       * carry tangents.  Every operation is recorded through the
+       * generic matrix functions.
+       */
+      template <bool propto,
+                typename T_y, typename T_dof, typename T_scale,
+                typename T_lp, bool is_fvar = contains_fvar<T_lp>::value>
+      struct inv_wishart_lp {
+        static T_lp
+        apply(const Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic>& /* W */,
+              const T_dof& nu,
+              const Eigen::Matrix<T_scale,Eigen::Dynamic,Eigen::Dynamic>& S,
+              stan::math::LDLT_factor<T_y,Eigen::Dynamic,Eigen::Dynamic>& ldlt_W,
+              stan::math::LDLT_factor<T_scale,Eigen::Dynamic,Eigen::Dynamic>& ldlt_S,
+              typename stan::math::index_type<Eigen::Matrix<T_scale,Eigen::Dynamic,Eigen::Dynamic> >::type k) {
+          using boost::math::tools::promote_args;
+          using stan::math::lmgamma;
+          using stan::math::log_determinant_ldlt;
+          using stan::math::mdivide_left_ldlt;
+          using stan::math::trace;
+
+          T_lp lp(0.0);
+
+          if (include_summand<propto,T_dof>::value)
+            lp -= lmgamma(k, 0.5 * nu);
+          if (include_summand<propto,T_dof,T_scale>::value) {
+            lp += 0.5 * nu * log_determinant_ldlt(ldlt_S);
+          }
+          if (include_summand<propto,T_y,T_dof,T_scale>::value) {
+            lp -= 0.5 * (nu + k + 1.0) * log_determinant_ldlt(ldlt_W);
+          }
+          if (include_summand<propto,T_y,T_scale>::value) {
+//            L = crossprod(mdivide_left_tri_low(L));
+//            Eigen::Matrix<T_y,Eigen::Dynamic,1> W_inv_vec = Eigen::Map<
+//              const Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic> >(
+//                                                                       &L(0), L.size(), 1);
+//            Eigen::Matrix<T_scale,Eigen::Dynamic,1> S_vec = Eigen::Map<
+//              const Eigen::Matrix<T_scale,Eigen::Dynamic,Eigen::Dynamic> >(
+//                                                                           &S(0), S.size(), 1);
+//            lp -= 0.5 * dot_product(S_vec, W_inv_vec); // trace(S * W^-1)
+            Eigen::Matrix<typename promote_args<T_y,T_scale>::type,Eigen::Dynamic,Eigen::Dynamic> Winv_S(mdivide_left_ldlt(ldlt_W, static_cast<Eigen::Matrix<T_scale,Eigen::Dynamic,Eigen::Dynamic> >(S.template selfadjointView<Eigen::Lower>())));
+            lp -= 0.5*trace(Winv_S);
+          }
+          if (include_summand<propto,T_dof,T_scale>::value)
+            lp += nu * k * NEG_LOG_TWO_OVER_TWO;
+          return lp;
+        }
+      };
+
+      /**
+       * Log density of the inverse Wishart on doubles.
+       *
+       * <p>Only the lower triangle of <code>S</code> enters the
+       * trace term, so its partials,
+       * <code>-0.5 * (2 - I) .* inverse(W)</code>, are given to the
+       * lower triangle only.  The partials of <code>W</code> are
+       * <code>0.5 * inverse(W) * (S * inverse(W) - (nu + k + 1) * I)</code>.
+       */
+      template <bool propto,
+                typename T_y, typename T_dof, typename T_scale,
+                typename T_lp>
+      struct inv_wishart_lp<propto,T_y,T_dof,T_scale,T_lp,false> {
+        static T_lp
+        apply(const Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic>& W,
+              const T_dof& nu,
+              const Eigen::Matrix<T_scale,Eigen::Dynamic,Eigen::Dynamic>& S,
+              stan::math::LDLT_factor<T_y,Eigen::Dynamic,Eigen::Dynamic>& ldlt_W,
+              stan::math::LDLT_factor<T_scale,Eigen::Dynamic,Eigen::Dynamic>& ldlt_S,
+              typename stan::math::index_type<Eigen::Matrix<T_scale,Eigen::Dynamic,Eigen::Dynamic> >::type k) {
+          using Eigen::Lower;
+          using Eigen::MatrixXd;
+          using stan::math::digamma;
+          using stan::math::lmgamma;
+          using stan::math::value_of_rec;
+
+          agrad::OperandsAndPartialsMvt<T_lp> operands;
+          double nu_dbl = value_of_rec(nu);
+          double lp(0.0);
+          double d_nu(0.0);
+          MatrixXd d_W = MatrixXd::Zero(k, k);
+          MatrixXd d_S = MatrixXd::Zero(k, k);
+
+          if (include_summand<propto,T_dof>::value) {
+            lp -= lmgamma(k, 0.5 * nu_dbl);
+            for (int j = 1; j <= k; ++j)
+              d_nu -= 0.5 * digamma(0.5 * nu_dbl + (1.0 - j) / 2.0);
+          }
+          if (include_summand<propto,T_dof,T_scale>::value) {
+            double log_det_S = ldlt_S.vectorD().array().log().sum();
+            lp += 0.5 * nu_dbl * log_det_S;
+            d_nu += 0.5 * log_det_S;
+            if (!is_constant_struct<T_scale>::value)
+              d_S += 0.5 * nu_dbl
+                * MatrixXd(ldlt_S.solve(MatrixXd::Identity(k, k)));
+          }
+
+          MatrixXd inv_W;
+          if (!is_constant_struct<T_y>::value
+              || !is_constant_struct<T_scale>::value)
+            inv_W = ldlt_W.solve(MatrixXd::Identity(k, k));
+
+          if (include_summand<propto,T_y,T_dof,T_scale>::value) {
+            double log_det_W = ldlt_W.vectorD().array().log().sum();
+            lp -= 0.5 * (nu_dbl + k + 1.0) * log_det_W;
+            d_nu -= 0.5 * log_det_W;
+            if (!is_constant_struct<T_y>::value)
+              d_W -= 0.5 * (nu_dbl + k + 1.0) * inv_W;
+          }
+          if (include_summand<propto,T_y,T_scale>::value) {
+            MatrixXd S_sym = value_of_rec(S).template selfadjointView<Lower>();
+            MatrixXd Winv_S = ldlt_W.solve(S_sym);
+            lp -= 0.5 * Winv_S.trace();
+            if (!is_constant_struct<T_y>::value)
+              d_W.noalias() += 0.5 * Winv_S * inv_W;
+            if (!is_constant_struct<T_scale>::value)
+              for (int n = 0; n < k; ++n) {
+                d_S(n,n) -= 0.5 * inv_W(n,n);
+                for (int m = n + 1; m < k; ++m)
+                  d_S(m,n) -= inv_W(m,n);
+              }
+          }
+          if (include_summand<propto,T_dof,T_scale>::value) {
+            lp += nu_dbl * k * NEG_LOG_TWO_OVER_TWO;
+            d_nu += k * NEG_LOG_TWO_OVER_TWO;
+          }
+
+          operands.add(W, d_W);
+          operands.add(nu, d_nu);
+          operands.add(S, d_S);
+          return operands.to_var(lp);
+        }
+      };
+
+    }
+
     // InvWishart(Sigma|n,Omega)  [W, S symmetric, non-neg, definite; 
     //                             W.dims() = S.dims();
     //                             n > S.rows() - 1]
@@ -61,7 +203,7 @@ namespace stan {
 
       typename index_type<Matrix<T_scale,Dynamic,Dynamic> >::type k 
         = S.rows();
-      typename promote_args<T_y,T_dof,T_scale>::type lp(0.0);
+      typedef typename promote_args<T_y,T_dof,T_scale>::type T_lp;
       
       check_greater(function, "Degrees of freedom parameter", nu, k-1);
       check_size_match(function, 
@@ -76,10 +218,6 @@ namespace stan {
 
       // FIXME: domain checks
         
-      using stan::math::lmgamma;
-      using stan::math::log_determinant_ldlt;
-      using stan::math::mdivide_left_ldlt;
-      using stan::math::trace;
       using stan::math::LDLT_factor;
       using stan::error_handling::check_ldlt_factor;
       
@@ -88,29 +226,8 @@ namespace stan {
       LDLT_factor<T_scale,Eigen::Dynamic,Eigen::Dynamic> ldlt_S(S);
       check_ldlt_factor(function, "LDLT_Factor of scale parameter", ldlt_S);
       
-      if (include_summand<propto,T_dof>::value)
-        lp -= lmgamma(k, 0.5 * nu);
-      if (include_summand<propto,T_dof,T_scale>::value) {
-        lp += 0.5 * nu * log_determinant_ldlt(ldlt_S);
-      }
-      if (include_summand<propto,T_y,T_dof,T_scale>::value) {
-        lp -= 0.5 * (nu + k + 1.0) * log_determinant_ldlt(ldlt_W);
-      }
-      if (include_summand<propto,T_y,T_scale>::value) {
-//        L = crossprod(mdivide_left_tri_low(L));
-//        Eigen::Matrix<T_y,Eigen::Dynamic,1> W_inv_vec = Eigen::Map<
-//          const Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic> >(
-//                                                                   &L(0), L.size(), 1);
-//        Eigen::Matrix<T_scale,Eigen::Dynamic,1> S_vec = Eigen::Map<
-//          const Eigen::Matrix<T_scale,Eigen::Dynamic,Eigen::Dynamic> >(
-//                                                                       &S(0), S.size(), 1);
-//        lp -= 0.5 * dot_product(S_vec, W_inv_vec); // trace(S * W^-1)
-        Eigen::Matrix<typename promote_args<T_y,T_scale>::type,Eigen::Dynamic,Eigen::Dynamic> Winv_S(mdivide_left_ldlt(ldlt_W, static_cast<Eigen::Matrix<T_scale,Eigen::Dynamic,Eigen::Dynamic> >(S.template selfadjointView<Eigen::Lower>())));
-        lp -= 0.5*trace(Winv_S);
-      }
-      if (include_summand<propto,T_dof,T_scale>::value)
-        lp += nu * k * NEG_LOG_TWO_OVER_TWO;
-      return lp;
+      return inv_wishart_lp<propto,T_y,T_dof,T_scale,T_lp>
+        ::apply(W, nu, S, ldlt_W, ldlt_S, k);
     }
 
     template <typename T_y, typename T_dof, typename T_scale>
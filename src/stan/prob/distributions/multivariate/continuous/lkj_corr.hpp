@@ -1,9 +1,13 @@
 #ifndef STAN__PROB__DISTRIBUTIONS__MULTIVARIATE__CONTINUOUS__LKJ_CORR_HPP
 #define STAN__PROB__DISTRIBUTIONS__MULTIVARIATE__CONTINUOUS__LKJ_CORR_HPP
 
+#include <stan/agrad/partials_vari_mvt.hpp>
+#include <stan/agrad/rev/functions/value_of_rec.hpp>
 #include <stan/error_handling/matrix/check_size_match.hpp>
 #include <stan/error_handling/scalar/check_finite.hpp>
 #include <stan/error_handling/scalar/check_positive.hpp>
+#include <stan/math/functions/digamma.hpp>
+#include <stan/math/matrix/value_of_rec.hpp>
 #include <stan/prob/constants.hpp>
 #include <stan/prob/distributions/univariate/continuous/beta.hpp>
 #include <stan/prob/traits.hpp>
@@ -41,6 +45,179 @@ namespace stan {
       return constant;
     }
 
+    namespace {
+
+      /**
+       * Return the derivative of <code>do_lkj_constant()</code> with
+       * respect to <code>eta</code>.  The constant does not depend
+       * on <code>eta</code> when <code>eta</code> is one.
+       */
+      inline double do_lkj_constant_d_eta(double eta, const unsigned int& K) {
+        using stan::math::digamma;
+
+        const int Km1 = K - 1;
+        if (eta == 1.0)
+          return 0;
+        double d_eta = -Km1 * digamma(eta + 0.5 * Km1);
+        for (int k = 1; k <= Km1; k++)
+          d_eta += digamma(eta + 0.5 * (Km1 - k));
+        return d_eta;
+      }
+
+      /**
+       * Log density of the LKJ distribution of a Cholesky factor of
+       * a correlation matrix for autodiff types that carry tangents.
+       */
+      template <bool propto, typename T_covar, typename T_shape,
+                typename T_lp, bool is_fvar = contains_fvar<T_lp>::value>
+      struct lkj_corr_cholesky_lp {
+        static T_lp
+        apply(const Eigen::Matrix<T_covar,Eigen::Dynamic,Eigen::Dynamic>& L,
+              const T_shape& eta, const unsigned int K) {
+          using stan::math::sum;
+
+          T_lp lp(0.0);
+
+          if (include_summand<propto,T_shape>::value) 
+            lp += do_lkj_constant(eta, K);
+          if (include_summand<propto,T_covar,T_shape>::value) {
+            const int Km1 = K - 1;
+            Eigen::Matrix<T_covar,Eigen::Dynamic,1> log_diagonals =
+              L.diagonal().tail(Km1).array().log();
+            Eigen::Matrix<T_covar,Eigen::Dynamic,1> values(Km1);
+            for (size_t k = 0; k < Km1; k++)
+              values(k) = (Km1 - k - 1) * log_diagonals(k);
+            if ( (eta == 1.0) &&
+                stan::is_constant<typename stan::scalar_type<T_shape> >::value) {
+                lp += sum(values);
+                return(lp);
+            }
+            values += (2.0 * eta - 2.0) * log_diagonals;
+            lp += sum(values);
+          }
+          
+          return lp;
+        }
+      };
+
+      /**
+       * Log density of the LKJ distribution of a Cholesky factor of
+       * a correlation matrix on doubles.  Only the diagonal of
+       * <code>L</code> below its first element is an operand.
+       */
+      template <bool propto, typename T_covar, typename T_shape,
+                typename T_lp>
+      struct lkj_corr_cholesky_lp<propto,T_covar,T_shape,T_lp,false> {
+        static T_lp
+        apply(const Eigen::Matrix<T_covar,Eigen::Dynamic,Eigen::Dynamic>& L,
+              const T_shape& eta, const unsigned int K) {
+          using stan::math::value_of_rec;
+          using std::log;
+
+          agrad::OperandsAndPartialsMvt<T_lp> operands;
+          double eta_dbl = value_of_rec(eta);
+          double lp(0.0);
+          double d_eta(0.0);
+
+          if (include_summand<propto,T_shape>::value) {
+            lp += do_lkj_constant(eta_dbl, K);
+            d_eta += do_lkj_constant_d_eta(eta_dbl, K);
+          }
+          if (include_summand<propto,T_covar,T_shape>::value) {
+            const int Km1 = K - 1;
+            for (int k = 0; k < Km1; k++) {
+              double L_kk = value_of_rec(L(k + 1, k + 1));
+              double log_diagonal = log(L_kk);
+              lp += (Km1 - k - 1 + 2.0 * eta_dbl - 2.0) * log_diagonal;
+              d_eta += 2.0 * log_diagonal;
+              operands.add(L(k + 1, k + 1),
+                           (Km1 - k - 1 + 2.0 * eta_dbl - 2.0) / L_kk);
+            }
+          }
+          operands.add(eta, d_eta);
+          return operands.to_var(lp);
+        }
+      };
+
+      /**
+       * Log density of the LKJ distribution of a correlation matrix
+       * for autodiff types that carry tangents.
+       */
+      template <bool propto, typename T_y, typename T_shape,
+                typename T_lp, bool is_fvar = contains_fvar<T_lp>::value>
+      struct lkj_corr_lp {
+        static T_lp
+        apply(const Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic>& y,
+              const T_shape& eta, const unsigned int K) {
+          using stan::math::sum;
+
+          T_lp lp(0.0);
+
+          if (include_summand<propto,T_shape>::value)
+            lp += do_lkj_constant(eta, K);
+
+          if ( (eta == 1.0) &&
+              stan::is_constant<typename stan::scalar_type<T_shape> >::value )
+            return lp;
+
+          if (!include_summand<propto,T_y,T_shape>::value)
+              return lp;
+
+          Eigen::Matrix<T_y,Eigen::Dynamic,1> values =
+            y.ldlt().vectorD().array().log().matrix();
+          lp += (eta - 1.0) * sum(values);
+          return lp;
+        }
+      };
+
+      /**
+       * Log density of the LKJ distribution of a correlation matrix
+       * on doubles.
+       *
+       * <p>The log determinant of <code>y</code> is computed from its
+       * LDLT factorization, which reads the lower triangle, so the
+       * partials <code>(eta - 1) * (2 - I) .* inverse(y)</code> are
+       * given to the lower triangle only.
+       */
+      template <bool propto, typename T_y, typename T_shape,
+                typename T_lp>
+      struct lkj_corr_lp<propto,T_y,T_shape,T_lp,false> {
+        static T_lp
+        apply(const Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic>& y,
+              const T_shape& eta, const unsigned int K) {
+          using stan::math::value_of_rec;
+          using Eigen::MatrixXd;
+
+          agrad::OperandsAndPartialsMvt<T_lp> operands;
+          double eta_dbl = value_of_rec(eta);
+          double lp(0.0);
+          double d_eta(0.0);
+
+          if (include_summand<propto,T_shape>::value) {
+            lp += do_lkj_constant(eta_dbl, K);
+            d_eta += do_lkj_constant_d_eta(eta_dbl, K);
+          }
+
+          if (include_summand<propto,T_y,T_shape>::value
+              && !(eta_dbl == 1.0 && is_constant_struct<T_shape>::value)) {
+            Eigen::LDLT<MatrixXd> ldlt_y(value_of_rec(y));
+            double log_det_y = ldlt_y.vectorD().array().log().sum();
+            lp += (eta_dbl - 1.0) * log_det_y;
+            d_eta += log_det_y;
+            if (!is_constant_struct<T_y>::value) {
+              MatrixXd d_y = ldlt_y.solve(MatrixXd::Identity(K, K));
+              d_y *= 2.0 * (eta_dbl - 1.0);
+              d_y.diagonal() *= 0.5;
+              operands.add_lower(y, d_y);
+            }
+          }
+          operands.add(eta, d_eta);
+          return operands.to_var(lp);
+        }
+      };
+
+    }
+
     // LKJ_Corr(L|eta) [ L Cholesky factor of correlation matrix
     //                  eta > 0; eta == 1 <-> uniform]
     template <bool propto,
@@ -55,9 +232,8 @@ namespace stan {
       using boost::math::tools::promote_args;
       using stan::error_handling::check_positive;
       using stan::error_handling::check_lower_triangular;
-      using stan::math::sum;
-      
-      typename promote_args<T_covar,T_shape>::type lp(0.0);
+
+      typedef typename promote_args<T_covar,T_shape>::type T_lp;
       check_positive(function, "Shape parameter", eta);
       check_lower_triangular(function, "Random variable", L);
 
@@ -65,25 +241,8 @@ namespace stan {
       if (K == 0)
         return 0.0;
             
-      if (include_summand<propto,T_shape>::value) 
-        lp += do_lkj_constant(eta, K);
-      if (include_summand<propto,T_covar,T_shape>::value) {
-        const int Km1 = K - 1;
-        Eigen::Matrix<T_covar,Eigen::Dynamic,1> log_diagonals =
-          L.diagonal().tail(Km1).array().log();
-        Eigen::Matrix<T_covar,Eigen::Dynamic,1> values(Km1);
-        for (size_t k = 0; k < Km1; k++)
-          values(k) = (Km1 - k - 1) * log_diagonals(k);
-        if ( (eta == 1.0) &&
-            stan::is_constant<typename stan::scalar_type<T_shape> >::value) {
-            lp += sum(values);
-            return(lp);
-        }
-        values += (2.0 * eta - 2.0) * log_diagonals;
-        lp += sum(values);
-      }
-      
-      return lp;
+      return lkj_corr_cholesky_lp<propto,T_covar,T_shape,T_lp>
+        ::apply(L, eta, K);
     }
 
     template <typename T_covar, typename T_shape>
@@ -108,10 +267,9 @@ namespace stan {
       using stan::error_handling::check_not_nan;
       using stan::error_handling::check_positive;
       using stan::error_handling::check_corr_matrix;
-      using stan::math::sum;
       using boost::math::tools::promote_args;
       
-      typename promote_args<T_y,T_shape>::type lp(0.0);
+      typedef typename promote_args<T_y,T_shape>::type T_lp;
       check_positive(function, "Shape parameter", eta);
       check_size_match(function, 
                        "Rows of correlation matrix", y.rows(), 
@@ -123,20 +281,7 @@ namespace stan {
       if (K == 0)
         return 0.0;
 
-      if (include_summand<propto,T_shape>::value)
-        lp += do_lkj_constant(eta, K);
-
-      if ( (eta == 1.0) &&
-          stan::is_constant<typename stan::scalar_type<T_shape> >::value )
-        return lp;
-
-      if (!include_summand<propto,T_y,T_shape>::value)
-          return lp;
-
-      Eigen::Matrix<T_y,Eigen::Dynamic,1> values =
-        y.ldlt().vectorD().array().log().matrix();
-      lp += (eta - 1.0) * sum(values);
-      return lp;
+      return lkj_corr_lp<propto,T_y,T_shape,T_lp>::apply(y, eta, K);
     }
 
     template <typename T_y, typename T_shape>
@@ -1,6 +1,8 @@
 #ifndef STAN__PROB__DISTRIBUTIONS__MULTIVARIATE__CONTINUOUS__MATRIX_NORMAL_HPP
 #define STAN__PROB__DISTRIBUTIONS__MULTIVARIATE__CONTINUOUS__MATRIX_NORMAL_HPP
 
+#include <stan/agrad/partials_vari_mvt.hpp>
+#include <stan/agrad/rev/functions/value_of_rec.hpp>
 #include <stan/error_handling/matrix/check_ldlt_factor.hpp>
 #include <stan/error_handling/matrix/check_size_match.hpp>
 #include <stan/error_handling/matrix/check_symmetric.hpp>
@@ -14,11 +16,132 @@
 #include <stan/math/matrix/subtract.hpp>
 #include <stan/math/matrix/trace_quad_form.hpp>
 #include <stan/math/matrix/trace_gen_quad_form.hpp>
+#include <stan/math/matrix/value_of_rec.hpp>
 #include <stan/prob/constants.hpp>
 #include <stan/prob/traits.hpp>
 
 namespace stan {
   namespace prob {
+
+    namespace {
+
+      /**
+       * Log density of the matrix normal with precision matrices for
+       * autodiff types that carry tangents.  Every operation is
+       * recorded through the generic matrix functions.
+       */
+      template <bool propto,
+                typename T_y, typename T_Mu, typename T_Sigma, typename T_D,
+                typename T_lp, bool is_fvar = contains_fvar<T_lp>::value>
+      struct matrix_normal_prec_lp {
+        static T_lp
+        apply(const Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic>& y,
+              const Eigen::Matrix<T_Mu,Eigen::Dynamic,Eigen::Dynamic>& Mu,
+              const Eigen::Matrix<T_Sigma,Eigen::Dynamic,Eigen::Dynamic>& Sigma,
+              const Eigen::Matrix<T_D,Eigen::Dynamic,Eigen::Dynamic>& D,
+              stan::math::LDLT_factor<T_Sigma,Eigen::Dynamic,Eigen::Dynamic>& ldlt_Sigma,
+              stan::math::LDLT_factor<T_D,Eigen::Dynamic,Eigen::Dynamic>& ldlt_D) {
+          using stan::math::trace_gen_quad_form;
+          using stan::math::log_determinant_ldlt;
+          using stan::math::subtract;
+
+          T_lp lp(0.0);
+
+          if (include_summand<propto>::value) 
+            lp += NEG_LOG_SQRT_TWO_PI * y.cols() * y.rows();
+      
+          if (include_summand<propto,T_Sigma>::value) {
+            lp += log_determinant_ldlt(ldlt_Sigma) * (0.5 * y.rows());
+          }
+
+          if (include_summand<propto,T_D>::value) {
+            lp += log_determinant_ldlt(ldlt_D) * (0.5 * y.cols());
+          }
+      
+          if (include_summand<propto,T_y,T_Mu,T_Sigma,T_D>::value) {
+            lp -= 0.5 * trace_gen_quad_form(D,Sigma,subtract(y,Mu));
+          }
+          return lp;
+        }
+      };
+
+      /**
+       * Log density of the matrix normal with precision matrices on
+       * doubles.
+       *
+       * <p>With the residual <code>R = y - Mu</code>, the partials
+       * are <code>-Sigma * R * D</code> for <code>y</code>, its
+       * negation for <code>Mu</code>,
+       * <code>0.5 * (m * inverse(Sigma) - R * D * R')</code> for
+       * <code>Sigma</code> and
+       * <code>0.5 * (n * inverse(D) - R' * Sigma * R)</code> for
+       * <code>D</code>, where <code>y</code> is
+       * <code>m</code> by <code>n</code>.
+       */
+      template <bool propto,
+                typename T_y, typename T_Mu, typename T_Sigma, typename T_D,
+                typename T_lp>
+      struct matrix_normal_prec_lp<propto,T_y,T_Mu,T_Sigma,T_D,T_lp,false> {
+        static T_lp
+        apply(const Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic>& y,
+              const Eigen::Matrix<T_Mu,Eigen::Dynamic,Eigen::Dynamic>& Mu,
+              const Eigen::Matrix<T_Sigma,Eigen::Dynamic,Eigen::Dynamic>& Sigma,
+              const Eigen::Matrix<T_D,Eigen::Dynamic,Eigen::Dynamic>& D,
+              stan::math::LDLT_factor<T_Sigma,Eigen::Dynamic,Eigen::Dynamic>& ldlt_Sigma,
+              stan::math::LDLT_factor<T_D,Eigen::Dynamic,Eigen::Dynamic>& ldlt_D) {
+          using stan::math::value_of_rec;
+          using Eigen::MatrixXd;
+
+          agrad::OperandsAndPartialsMvt<T_lp> operands;
+          double lp(0.0);
+          int m = y.rows();
+          int n = y.cols();
+
+          MatrixXd d_Sigma;
+          MatrixXd d_D;
+          if (!is_constant_struct<T_Sigma>::value)
+            d_Sigma = (0.5 * m)
+              * MatrixXd(ldlt_Sigma.solve(MatrixXd::Identity(m, m)));
+          if (!is_constant_struct<T_D>::value)
+            d_D = (0.5 * n)
+              * MatrixXd(ldlt_D.solve(MatrixXd::Identity(n, n)));
+
+          if (include_summand<propto>::value) 
+            lp += NEG_LOG_SQRT_TWO_PI * n * m;
+      
+          if (include_summand<propto,T_Sigma>::value) {
+            lp += ldlt_Sigma.vectorD().array().log().sum() * (0.5 * m);
+          }
+
+          if (include_summand<propto,T_D>::value) {
+            lp += ldlt_D.vectorD().array().log().sum() * (0.5 * n);
+          }
+      
+          if (include_summand<propto,T_y,T_Mu,T_Sigma,T_D>::value) {
+            MatrixXd R = value_of_rec(y) - value_of_rec(Mu);
+            MatrixXd Sigma_R = value_of_rec(Sigma) * R;
+            MatrixXd R_D = R * value_of_rec(D);
+            lp -= 0.5 * (Sigma_R.array() * R_D.array()).sum();
+            if (!is_constant_struct<T_y>::value
+                || !is_constant_struct<T_Mu>::value) {
+              MatrixXd Sigma_R_D = Sigma_R * value_of_rec(D);
+              operands.add(y, -Sigma_R_D);
+              operands.add(Mu, Sigma_R_D);
+            }
+            if (!is_constant_struct<T_Sigma>::value)
+              d_Sigma.noalias() -= 0.5 * R_D * R.transpose();
+            if (!is_constant_struct<T_D>::value)
+              d_D.noalias() -= 0.5 * R.transpose() * Sigma_R;
+          }
+
+          operands.add(Sigma, d_Sigma);
+          operands.add(D, d_D);
+          return operands.to_var(lp);
+        }
+      };
+
+    }
+
     /**
      * The log of the matrix normal density for the given y, mu, Sigma and D
      * where Sigma and D are given as precision matrices, not covariance matrices.
@@ -45,16 +168,13 @@ namespace stan {
                            const Eigen::Matrix<T_Sigma,Eigen::Dynamic,Eigen::Dynamic>& Sigma,
                            const Eigen::Matrix<T_D,Eigen::Dynamic,Eigen::Dynamic>& D) {
       static const char* function("stan::prob::matrix_normal_prec_log");
-      typename boost::math::tools::promote_args<T_y,T_Mu,T_Sigma,T_D>::type lp(0.0);
+      typedef typename boost::math::tools::promote_args<T_y,T_Mu,T_Sigma,T_D>::type T_lp;
       
       using stan::error_handling::check_not_nan;
       using stan::error_handling::check_symmetric;
       using stan::error_handling::check_size_match;
       using stan::error_handling::check_positive;
       using stan::error_handling::check_finite;
-      using stan::math::trace_gen_quad_form;
-      using stan::math::log_determinant_ldlt;
-      using stan::math::subtract;
       using stan::math::LDLT_factor;
       using stan::error_handling::check_ldlt_factor;
       
@@ -91,21 +211,8 @@ namespace stan {
       check_finite(function, "Location parameter", Mu);
       check_finite(function, "Random variable", y);
       
-      if (include_summand<propto>::value) 
-        lp += NEG_LOG_SQRT_TWO_PI * y.cols() * y.rows();
-      
-      if (include_summand<propto,T_Sigma>::value) {
-        lp += log_determinant_ldlt(ldlt_Sigma) * (0.5 * y.rows());
-      }
-
-      if (include_summand<propto,T_D>::value) {
-        lp += log_determinant_ldlt(ldlt_D) * (0.5 * y.cols());
-      }
-      
-      if (include_summand<propto,T_y,T_Mu,T_Sigma,T_D>::value) {
-        lp -= 0.5 * trace_gen_quad_form(D,Sigma,subtract(y,Mu));
-      }
-      return lp;      
+      return matrix_normal_prec_lp<propto,T_y,T_Mu,T_Sigma,T_D,T_lp>
+        ::apply(y, Mu, Sigma, D, ldlt_Sigma, ldlt_D);
     }
 
     template <typename T_y, typename T_Mu, typename T_Sigma, typename T_D>
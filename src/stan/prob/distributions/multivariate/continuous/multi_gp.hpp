@@ -1,6 +1,8 @@
 #ifndef STAN__PROB__DISTRIBUTIONS__MULTIVARIATE__CONTINUOUS__MULTI_GP_HPP
 #define STAN__PROB__DISTRIBUTIONS__MULTIVARIATE__CONTINUOUS__MULTI_GP_HPP
 
+#include <stan/agrad/partials_vari_mvt.hpp>
+#include <stan/agrad/rev/functions/value_of_rec.hpp>
 #include <stan/error_handling/matrix/check_ldlt_factor.hpp>
 #include <stan/error_handling/matrix/check_size_match.hpp>
 #include <stan/error_handling/matrix/check_symmetric.hpp>
@@ -14,11 +16,130 @@
 #include <stan/math/matrix/multiply.hpp>
 #include <stan/math/matrix/sum.hpp>
 #include <stan/math/matrix/trace_gen_inv_quad_form_ldlt.hpp>
+#include <stan/math/matrix/value_of_rec.hpp>
 #include <stan/prob/constants.hpp>
 #include <stan/prob/traits.hpp>
 
 namespace stan {
   namespace prob {
+
+    namespace {
+
+      /**
+       * Log density of the multivariate Gaussian process for
+       * autodiff types that carry tangents.  Every operation is
+       * recorded through the generic matrix functions.
+       */
+      template <bool propto,
+                typename T_y, typename T_covar, typename T_w,
+                typename T_lp, bool is_fvar = contains_fvar<T_lp>::value>
+      struct multi_gp_lp {
+        static T_lp
+        apply(const Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic>& y,
+              const Eigen::Matrix<T_covar,Eigen::Dynamic,Eigen::Dynamic>& Sigma,
+              const Eigen::Matrix<T_w,Eigen::Dynamic,1>& w,
+              stan::math::LDLT_factor<T_covar,Eigen::Dynamic,Eigen::Dynamic>& ldlt_Sigma) {
+          using stan::math::sum;
+          using stan::math::log;
+          using stan::math::log_determinant_ldlt;
+          using stan::math::trace_gen_inv_quad_form_ldlt;
+
+          T_lp lp(0.0);
+
+          if (include_summand<propto>::value) {
+            lp += NEG_LOG_SQRT_TWO_PI * y.rows() * y.cols();
+          }
+
+          if (include_summand<propto,T_covar>::value) {
+            lp -= 0.5 * log_determinant_ldlt(ldlt_Sigma) * y.rows();
+          }
+
+          if (include_summand<propto,T_w>::value) {
+            lp += (0.5 * y.cols()) * sum(log(w));
+          }
+      
+          if (include_summand<propto,T_y,T_w,T_covar>::value) {
+            Eigen::Matrix<T_w,Eigen::Dynamic,Eigen::Dynamic> w_mat(w.asDiagonal());
+            Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic> yT(y.transpose());
+            lp -= 0.5 * trace_gen_inv_quad_form_ldlt(w_mat,ldlt_Sigma,yT);
+          }
+
+          return lp;
+        }
+      };
+
+      /**
+       * Log density of the multivariate Gaussian process on doubles.
+       *
+       * <p>With <code>Z = inverse(Sigma) * y'</code> and the
+       * quadratic forms <code>q[i] = y[i] * Z.col(i)</code> of the
+       * rows of <code>y</code>, the partials are
+       * <code>-w[i] * Z.col(i)'</code> for row <code>i</code> of
+       * <code>y</code>,
+       * <code>0.5 * (Z * diag(w) * Z' - d * inverse(Sigma))</code>
+       * for <code>Sigma</code>, and
+       * <code>0.5 * (N / w[i] - q[i])</code> for <code>w</code>.
+       */
+      template <bool propto,
+                typename T_y, typename T_covar, typename T_w,
+                typename T_lp>
+      struct multi_gp_lp<propto,T_y,T_covar,T_w,T_lp,false> {
+        static T_lp
+        apply(const Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic>& y,
+              const Eigen::Matrix<T_covar,Eigen::Dynamic,Eigen::Dynamic>& Sigma,
+              const Eigen::Matrix<T_w,Eigen::Dynamic,1>& w,
+              stan::math::LDLT_factor<T_covar,Eigen::Dynamic,Eigen::Dynamic>& ldlt_Sigma) {
+          using stan::math::value_of_rec;
+          using Eigen::MatrixXd;
+          using Eigen::VectorXd;
+
+          agrad::OperandsAndPartialsMvt<T_lp> operands;
+          double lp(0.0);
+          int d = y.rows();
+          int N = y.cols();
+
+          VectorXd w_d = value_of_rec(w);
+          MatrixXd d_Sigma;
+          VectorXd d_w;
+          if (!is_constant_struct<T_covar>::value)
+            d_Sigma = -0.5 * d
+              * MatrixXd(ldlt_Sigma.solve(MatrixXd::Identity(N, N)));
+          if (!is_constant_struct<T_w>::value)
+            d_w = (0.5 * N) * w_d.array().inverse();
+
+          if (include_summand<propto>::value) {
+            lp += NEG_LOG_SQRT_TWO_PI * d * N;
+          }
+
+          if (include_summand<propto,T_covar>::value) {
+            lp -= 0.5 * ldlt_Sigma.vectorD().array().log().sum() * d;
+          }
+
+          if (include_summand<propto,T_w>::value) {
+            lp += (0.5 * N) * w_d.array().log().sum();
+          }
+      
+          if (include_summand<propto,T_y,T_w,T_covar>::value) {
+            MatrixXd y_d = value_of_rec(y);
+            MatrixXd Z = ldlt_Sigma.solve(MatrixXd(y_d.transpose()));
+            MatrixXd y_Zt = y_d.array() * Z.transpose().array();
+            lp -= 0.5 * (w_d.asDiagonal() * y_Zt).rowwise().sum().sum();
+            if (!is_constant_struct<T_y>::value)
+              operands.add(y, MatrixXd(-(w_d.asDiagonal() * Z.transpose())));
+            if (!is_constant_struct<T_covar>::value)
+              d_Sigma.noalias() += 0.5 * Z * w_d.asDiagonal() * Z.transpose();
+            if (!is_constant_struct<T_w>::value)
+              d_w -= 0.5 * y_Zt.rowwise().sum();
+          }
+
+          operands.add(Sigma, d_Sigma);
+          operands.add(w, d_w);
+          return operands.to_var(lp);
+        }
+      };
+
+    }
+
     // MultiGP(y|Sigma,w)   [y.rows() = w.size(), y.cols() = Sigma.rows();
     //                            Sigma symmetric, non-negative, definite]
     /**
@@ -47,13 +168,8 @@ namespace stan {
                  const Eigen::Matrix<T_w,Eigen::Dynamic,1>& w) {
       static const char* function("stan::prob::multi_gp_log");
       typedef typename boost::math::tools::promote_args<T_y,T_covar,T_w>::type T_lp;
-      T_lp lp(0.0);
       
-      using stan::math::sum;
-      using stan::math::log;
       using stan::math::LDLT_factor;
-      using stan::math::log_determinant_ldlt;
-      using stan::math::trace_gen_inv_quad_form_ldlt;
 
       using stan::error_handling::check_size_match;
       using stan::error_handling::check_positive_finite;
@@ -83,27 +199,10 @@ namespace stan {
       check_finite(function, "Random variable", y);
       
       if (y.rows() == 0)
-        return lp;
-      
-      if (include_summand<propto>::value) {
-        lp += NEG_LOG_SQRT_TWO_PI * y.rows() * y.cols();
-      }
-
-      if (include_summand<propto,T_covar>::value) {
-        lp -= 0.5 * log_determinant_ldlt(ldlt_Sigma) * y.rows();
-      }
-
-      if (include_summand<propto,T_w>::value) {
-        lp += (0.5 * y.cols()) * sum(log(w));
-      }
-      
-      if (include_summand<propto,T_y,T_w,T_covar>::value) {
-        Eigen::Matrix<T_w,Eigen::Dynamic,Eigen::Dynamic> w_mat(w.asDiagonal());
-        Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic> yT(y.transpose());
-        lp -= 0.5 * trace_gen_inv_quad_form_ldlt(w_mat,ldlt_Sigma,yT);
-      }
+        return T_lp(0.0);
 
-      return lp;
+      return multi_gp_lp<propto,T_y,T_covar,T_w,T_lp>
+        ::apply(y, Sigma, w, ldlt_Sigma);
     }
     
     template <typename T_y, typename T_covar, typename T_w>
@@ -3,6 +3,8 @@
 
 #include <boost/random/normal_distribution.hpp>
 #include <boost/random/variate_generator.hpp>
+#include <stan/agrad/partials_vari_mvt.hpp>
+#include <stan/agrad/rev/functions/value_of_rec.hpp>
 #include <stan/error_handling/matrix/check_ldlt_factor.hpp>
 #include <stan/error_handling/matrix/check_size_match.hpp>
 #include <stan/error_handling/matrix/check_symmetric.hpp>
@@ -11,6 +13,7 @@
 #include <stan/error_handling/scalar/check_positive.hpp>
 #include <stan/math/matrix/trace_inv_quad_form_ldlt.hpp>
 #include <stan/math/matrix/log_determinant_ldlt.hpp>
+#include <stan/math/matrix/value_of_rec.hpp>
 #include <stan/meta/traits.hpp>
 #include <stan/prob/constants.hpp>
 #include <stan/prob/traits.hpp>
@@ -19,6 +22,105 @@ namespace stan {
 
   namespace prob {
 
+    namespace {
+
+      /**
+       * Log density of the multivariate normal for autodiff types
+       * that carry tangents.  Every operation is recorded through the
+       * generic matrix functions.
+       */
+      template <bool propto,
+                typename T_y, typename T_loc, typename T_covar,
+                typename T_lp, bool is_fvar = contains_fvar<T_lp>::value>
+      struct multi_normal_lp {
+        static T_lp
+        apply(const T_y& y, const T_loc& mu,
+              const Eigen::Matrix<T_covar,Eigen::Dynamic,Eigen::Dynamic>& /* Sigma */,
+              stan::math::LDLT_factor<T_covar,Eigen::Dynamic,Eigen::Dynamic>& ldlt_Sigma,
+              size_t size_vec, int size_y) {
+          VectorViewMvt<const T_y> y_vec(y);
+          VectorViewMvt<const T_loc> mu_vec(mu);
+          T_lp lp(0.0);
+
+          if (include_summand<propto>::value) 
+            lp += NEG_LOG_SQRT_TWO_PI * size_y * size_vec;
+
+          if (include_summand<propto, T_covar>::value)
+            lp -= 0.5 * log_determinant_ldlt(ldlt_Sigma) * size_vec;
+
+          if (include_summand<propto,T_y,T_loc,T_covar>::value) {
+            T_lp sum_lp_vec(0.0);
+            for (size_t i = 0; i < size_vec; i++) {
+              Eigen::Matrix<typename 
+                  boost::math::tools::promote_args<typename scalar_type<T_y>::type, typename scalar_type<T_loc>::type>::type,
+                  Eigen::Dynamic, 1> y_minus_mu(size_y);
+              for (int j = 0; j < size_y; j++)
+                y_minus_mu(j) = y_vec[i](j)-mu_vec[i](j);
+              sum_lp_vec += trace_inv_quad_form_ldlt(ldlt_Sigma,y_minus_mu);
+            }
+            lp -= 0.5*sum_lp_vec;
+          }
+          return lp;
+        }
+      };
+
+      /**
+       * Log density of the multivariate normal on doubles.
+       *
+       * <p>With the residuals <code>r = y - mu</code> of the
+       * observations as columns and <code>S = Sigma \ r</code>, the
+       * partials are <code>-S</code> for <code>y</code>,
+       * <code>S</code> for <code>mu</code>, and
+       * <code>0.5 * (S * S' - size_vec * inverse(Sigma))</code> for
+       * <code>Sigma</code>.
+       */
+      template <bool propto,
+                typename T_y, typename T_loc, typename T_covar,
+                typename T_lp>
+      struct multi_normal_lp<propto,T_y,T_loc,T_covar,T_lp,false> {
+        static T_lp
+        apply(const T_y& y, const T_loc& mu,
+              const Eigen::Matrix<T_covar,Eigen::Dynamic,Eigen::Dynamic>& Sigma,
+              stan::math::LDLT_factor<T_covar,Eigen::Dynamic,Eigen::Dynamic>& ldlt_Sigma,
+              size_t size_vec, int size_y) {
+          using stan::math::value_of_rec;
+          using Eigen::MatrixXd;
+
+          VectorViewMvt<const T_y> y_vec(y);
+          VectorViewMvt<const T_loc> mu_vec(mu);
+          agrad::OperandsAndPartialsMvt<T_lp> operands;
+          double lp(0.0);
+
+          if (include_summand<propto>::value) 
+            lp += NEG_LOG_SQRT_TWO_PI * size_y * size_vec;
+
+          MatrixXd d_Sigma;
+          if (!is_constant_struct<T_covar>::value)
+            d_Sigma = -0.5 * size_vec
+              * MatrixXd(ldlt_Sigma.solve(MatrixXd::Identity(size_y, size_y)));
+
+          if (include_summand<propto, T_covar>::value)
+            lp -= 0.5 * ldlt_Sigma.vectorD().array().log().sum() * size_vec;
+
+          if (include_summand<propto,T_y,T_loc,T_covar>::value) {
+            MatrixXd r(size_y, size_vec);
+            for (size_t i = 0; i < size_vec; i++)
+              for (int j = 0; j < size_y; j++)
+                r(j,i) = value_of_rec(y_vec[i](j)) - value_of_rec(mu_vec[i](j));
+            MatrixXd S = ldlt_Sigma.solve(r);
+            lp -= 0.5 * (r.array() * S.array()).sum();
+            operands.add_mvt(y, -S);
+            operands.add_mvt(mu, S);
+            if (!is_constant_struct<T_covar>::value)
+              d_Sigma.noalias() += 0.5 * S * S.transpose();
+          }
+          operands.add(Sigma, d_Sigma);
+          return operands.to_var(lp);
+        }
+      };
+
+    }
+
    template <bool propto,
              typename T_y, typename T_loc, typename T_covar>
     typename boost::math::tools::promote_args<typename scalar_type<T_y>::type, typename scalar_type<T_loc>::type, T_covar>::type
@@ -27,7 +129,6 @@ namespace stan {
                      const Eigen::Matrix<T_covar,Eigen::Dynamic,Eigen::Dynamic>& Sigma) {
      static const char* function("stan::prob::multi_normal_log");
       typedef typename boost::math::tools::promote_args<typename scalar_type<T_y>::type, typename scalar_type<T_loc>::type, T_covar>::type lp_type;
-      lp_type lp(0.0);
       
       using stan::error_handling::check_size_match;
       using stan::error_handling::check_finite;
@@ -94,27 +195,10 @@ namespace stan {
       }
       
       if (size_y == 0) //y_vec[0].size() == 0
-        return lp;
-
-      if (include_summand<propto>::value) 
-        lp += NEG_LOG_SQRT_TWO_PI * size_y * size_vec;
-
-      if (include_summand<propto, T_covar>::value)
-        lp -= 0.5 * log_determinant_ldlt(ldlt_Sigma) * size_vec;
-
-      if (include_summand<propto,T_y,T_loc,T_covar>::value) {
-        lp_type sum_lp_vec(0.0);
-        for (size_t i = 0; i < size_vec; i++) {
-          Eigen::Matrix<typename 
-              boost::math::tools::promote_args<typename scalar_type<T_y>::type, typename scalar_type<T_loc>::type>::type,
-              Eigen::Dynamic, 1> y_minus_mu(size_y);
-          for (int j = 0; j < size_y; j++)
-            y_minus_mu(j) = y_vec[i](j)-mu_vec[i](j);
-          sum_lp_vec += trace_inv_quad_form_ldlt(ldlt_Sigma,y_minus_mu);
-        }
-        lp -= 0.5*sum_lp_vec;
-      }
-      return lp;
+        return lp_type(0.0);
+
+      return multi_normal_lp<propto,T_y,T_loc,T_covar,lp_type>
+        ::apply(y, mu, Sigma, ldlt_Sigma, size_vec, size_y);
     }
 
     template <typename T_y, typename T_loc, typename T_covar>
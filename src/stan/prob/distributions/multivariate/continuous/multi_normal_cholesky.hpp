@@ -3,6 +3,8 @@
 
 #include <boost/random/normal_distribution.hpp>
 #include <boost/random/variate_generator.hpp>
+#include <stan/agrad/partials_vari_mvt.hpp>
+#include <stan/agrad/rev/functions/value_of_rec.hpp>
 #include <stan/error_handling/matrix/check_size_match.hpp>
 #include <stan/error_handling/scalar/check_finite.hpp>
 #include <stan/error_handling/scalar/check_not_nan.hpp>
@@ -17,6 +19,7 @@
 #include <stan/math/matrix/multiply.hpp>
 #include <stan/math/matrix/subtract.hpp>
 #include <stan/math/matrix/sum.hpp>
+#include <stan/math/matrix/value_of_rec.hpp>
 #include <stan/meta/traits.hpp>
 #include <stan/prob/constants.hpp>
 #include <stan/prob/traits.hpp>
@@ -25,6 +28,116 @@ namespace stan {
 
   namespace prob {
 
+    namespace {
+
+      /**
+       * Log density of the multivariate normal for autodiff types
+       * that carry tangents.  Every operation is recorded through the
+       * generic matrix functions.
+       */
+      template <bool propto,
+                typename T_y, typename T_loc, typename T_covar,
+                typename T_lp, bool is_fvar = contains_fvar<T_lp>::value>
+      struct multi_normal_cholesky_lp {
+        static T_lp
+        apply(const T_y& y, const T_loc& mu,
+              const Eigen::Matrix<T_covar,Eigen::Dynamic,Eigen::Dynamic>& L,
+              size_t size_vec, int size_y) {
+          using stan::math::mdivide_left_tri_low;
+          using stan::math::dot_self;
+
+          VectorViewMvt<const T_y> y_vec(y);
+          VectorViewMvt<const T_loc> mu_vec(mu);
+          T_lp lp(0.0);
+
+          if (include_summand<propto>::value) 
+            lp += NEG_LOG_SQRT_TWO_PI * size_y * size_vec;
+
+          if (include_summand<propto,T_covar>::value)
+            lp -= L.diagonal().array().log().sum() * size_vec;
+
+          if (include_summand<propto,T_y,T_loc,T_covar>::value) {
+            T_lp sum_lp_vec(0.0);
+            for (size_t i = 0; i < size_vec; i++) {
+              Eigen::Matrix<typename 
+                  boost::math::tools::promote_args<typename scalar_type<T_y>::type, typename scalar_type<T_loc>::type>::type,
+                  Eigen::Dynamic, 1> y_minus_mu(size_y);
+              for (int j = 0; j < size_y; j++)
+                y_minus_mu(j) = y_vec[i](j)-mu_vec[i](j);
+              Eigen::Matrix<T_lp,Eigen::Dynamic,1> 
+                half(mdivide_left_tri_low(L,y_minus_mu));
+              sum_lp_vec += dot_self(half);
+            }
+            lp -= 0.5*sum_lp_vec;
+          }
+          return lp;
+        }
+      };
+
+      /**
+       * Log density of the multivariate normal on doubles.
+       *
+       * <p>All observations are solved together as one triangular
+       * system with <code>size_vec</code> right-hand sides.  With
+       * <code>half = L \ (y - mu)</code> and
+       * <code>scaled = L' \ half</code>, the partials are
+       * <code>-scaled</code> for <code>y</code>, <code>scaled</code>
+       * for <code>mu</code>, and the lower triangle of
+       * <code>scaled * half' - size_vec * diag(1 / L)</code> for
+       * <code>L</code>.  The upper triangle of <code>L</code> is
+       * never read, so it is not an operand.
+       */
+      template <bool propto,
+                typename T_y, typename T_loc, typename T_covar,
+                typename T_lp>
+      struct multi_normal_cholesky_lp<propto,T_y,T_loc,T_covar,T_lp,false> {
+        static T_lp
+        apply(const T_y& y, const T_loc& mu,
+              const Eigen::Matrix<T_covar,Eigen::Dynamic,Eigen::Dynamic>& L,
+              size_t size_vec, int size_y) {
+          using stan::math::value_of_rec;
+          using Eigen::MatrixXd;
+
+          VectorViewMvt<const T_y> y_vec(y);
+          VectorViewMvt<const T_loc> mu_vec(mu);
+          agrad::OperandsAndPartialsMvt<T_lp> operands;
+          MatrixXd L_d = value_of_rec(L);
+          double lp(0.0);
+
+          if (include_summand<propto>::value) 
+            lp += NEG_LOG_SQRT_TWO_PI * size_y * size_vec;
+
+          if (include_summand<propto,T_covar>::value)
+            lp -= L_d.diagonal().array().log().sum() * size_vec;
+
+          MatrixXd half(size_y, size_vec);
+          for (size_t i = 0; i < size_vec; i++)
+            for (int j = 0; j < size_y; j++)
+              half(j,i) = value_of_rec(y_vec[i](j)) - value_of_rec(mu_vec[i](j));
+          L_d.triangularView<Eigen::Lower>().solveInPlace(half);
+
+          if (include_summand<propto,T_y,T_loc,T_covar>::value)
+            lp -= 0.5 * half.squaredNorm();
+
+          if (!is_constant_struct<T_y>::value
+              || !is_constant_struct<T_loc>::value
+              || !is_constant_struct<T_covar>::value) {
+            MatrixXd scaled(half);
+            L_d.transpose().triangularView<Eigen::Upper>().solveInPlace(scaled);
+            operands.add_mvt(y, -scaled);
+            operands.add_mvt(mu, scaled);
+            if (!is_constant_struct<T_covar>::value) {
+              MatrixXd d_L = scaled * half.transpose();
+              d_L.diagonal().array() -= size_vec / L_d.diagonal().array();
+              operands.add_lower(L, d_L);
+            }
+          }
+          return operands.to_var(lp);
+        }
+      };
+
+    }
+
     /**
      * The log of the multivariate normal density for the given y, mu, and
      * a Cholesky factor L of the variance matrix.
@@ -50,14 +163,7 @@ namespace stan {
                               const Eigen::Matrix<T_covar,Eigen::Dynamic,Eigen::Dynamic>& L) {
       static const char* function("stan::prob::multi_normal_cholesky_log");
       typedef typename boost::math::tools::promote_args<typename scalar_type<T_y>::type, typename scalar_type<T_loc>::type, T_covar>::type lp_type;
-      lp_type lp(0.0);
 
-      using stan::math::mdivide_left_tri_low;
-      using stan::math::dot_self;
-      using stan::math::multiply;
-      using stan::math::subtract;
-      using stan::math::sum;
-      
       using stan::error_handling::check_size_match;
       using stan::error_handling::check_finite;
       using stan::error_handling::check_not_nan;
@@ -111,36 +217,10 @@ namespace stan {
       }
       
       if (size_y == 0)
-        return lp;
-
-      if (include_summand<propto>::value) 
-        lp += NEG_LOG_SQRT_TWO_PI * size_y * size_vec;
-
-      if (include_summand<propto,T_covar>::value)
-        lp -= L.diagonal().array().log().sum() * size_vec;
-
-      if (include_summand<propto,T_y,T_loc,T_covar>::value) {
-        lp_type sum_lp_vec(0.0);
-        for (size_t i = 0; i < size_vec; i++) {
-          Eigen::Matrix<typename 
-              boost::math::tools::promote_args<typename scalar_type<T_y>::type, typename scalar_type<T_loc>::type>::type,
-              Eigen::Dynamic, 1> y_minus_mu(size_y);
-          for (int j = 0; j < size_y; j++)
-            y_minus_mu(j) = y_vec[i](j)-mu_vec[i](j);
-          Eigen::Matrix<typename 
-            boost::math::tools::promote_args<T_covar,typename scalar_type<T_loc>::type,typename scalar_type<T_y>::type>::type,
-            Eigen::Dynamic, 1> 
-            half(mdivide_left_tri_low(L,y_minus_mu));
-          // FIXME: this code does not compile. revert after fixing subtract()
-          // Eigen::Matrix<typename 
-          //               boost::math::tools::promote_args<T_covar,typename scalar_type<T_loc>::type,typename scalar_type<T_y>::type>::type>::type,
-          //               Eigen::Dynamic, 1> 
-          //   half(mdivide_left_tri_low(L,subtract(y,mu)));
-          sum_lp_vec += dot_self(half);
-        }
-        lp -= 0.5*sum_lp_vec;
-      }
-      return lp;
+        return lp_type(0.0);
+
+      return multi_normal_cholesky_lp<propto,T_y,T_loc,T_covar,lp_type>
+        ::apply(y, mu, L, size_vec, size_y);
     }
 
     template <typename T_y, typename T_loc, typename T_covar>
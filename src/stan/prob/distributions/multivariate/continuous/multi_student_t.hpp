@@ -5,15 +5,19 @@
 #include <boost/math/special_functions/gamma.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <boost/random/variate_generator.hpp>
+#include <stan/agrad/partials_vari_mvt.hpp>
+#include <stan/agrad/rev/functions/value_of_rec.hpp>
 #include <stan/error_handling/matrix/check_ldlt_factor.hpp>
 #include <stan/error_handling/matrix/check_size_match.hpp>
 #include <stan/error_handling/matrix/check_symmetric.hpp>
 #include <stan/error_handling/scalar/check_finite.hpp>
 #include <stan/error_handling/scalar/check_not_nan.hpp>
 #include <stan/error_handling/scalar/check_positive.hpp>
+#include <stan/math/functions/digamma.hpp>
 #include <stan/math/matrix/multiply.hpp>
 #include <stan/math/matrix/dot_product.hpp>
 #include <stan/math/matrix/subtract.hpp>
+#include <stan/math/matrix/value_of_rec.hpp>
 #include <stan/prob/constants.hpp>
 #include <stan/prob/distributions/multivariate/continuous/multi_normal.hpp>
 #include <stan/prob/distributions/univariate/continuous/inv_gamma.hpp>
@@ -23,6 +27,142 @@ namespace stan {
 
   namespace prob {
 
+    namespace {
+
+      /**
+       * Log density of the multivariate Student t for autodiff types
+       * that carry tangents.  Every operation is recorded through the
+       * generic matrix functions.
+       */
+      template <bool propto,
+                typename T_y, typename T_dof, typename T_loc, typename T_scale,
+                typename T_lp, bool is_fvar = contains_fvar<T_lp>::value>
+      struct multi_student_t_lp {
+        static T_lp
+        apply(const T_y& y, const T_dof& nu, const T_loc& mu,
+              const Eigen::Matrix<T_scale,Eigen::Dynamic,Eigen::Dynamic>& /* Sigma */,
+              stan::math::LDLT_factor<T_scale,Eigen::Dynamic,Eigen::Dynamic>& ldlt_Sigma,
+              size_t size_vec, int size_y) {
+          using boost::math::lgamma;
+          using stan::math::log_determinant_ldlt;
+
+          VectorViewMvt<const T_y> y_vec(y);
+          VectorViewMvt<const T_loc> mu_vec(mu);
+          T_lp lp(0.0);
+
+          if (include_summand<propto,T_dof>::value) {
+            lp += lgamma(0.5 * (nu + size_y)) * size_vec;
+            lp -= lgamma(0.5 * nu) * size_vec;
+            lp -= (0.5 * size_y) * log(nu) * size_vec;
+          }
+
+          if (include_summand<propto>::value) 
+            lp -= (0.5 * size_y) * LOG_PI * size_vec;
+
+          if (include_summand<propto,T_scale>::value) {
+            lp -= 0.5 * log_determinant_ldlt(ldlt_Sigma) * size_vec;
+          }
+
+          if (include_summand<propto,T_y,T_dof,T_loc,T_scale>::value) {
+            T_lp sum_lp_vec(0.0);
+            for (size_t i = 0; i < size_vec; i++) {
+              Eigen::Matrix<typename 
+                  boost::math::tools::promote_args<typename scalar_type<T_y>::type, typename scalar_type<T_loc>::type>::type,
+                  Eigen::Dynamic, 1> y_minus_mu(size_y);
+              for (int j = 0; j < size_y; j++)
+                y_minus_mu(j) = y_vec[i](j)-mu_vec[i](j);
+              sum_lp_vec += log(1.0 + trace_inv_quad_form_ldlt(ldlt_Sigma,y_minus_mu) / nu);
+            }
+            lp -= 0.5 * (nu + size_y) * sum_lp_vec;
+          }
+          return lp;
+        }
+      };
+
+      /**
+       * Log density of the multivariate Student t on doubles.
+       *
+       * <p>With the residuals <code>r = y - mu</code> of the
+       * observations as columns, <code>S = Sigma \ r</code> and the
+       * quadratic forms <code>q = r' * S</code>, each observation
+       * contributes <code>-(nu + K) / (nu + q) * S</code> to the
+       * partials of <code>y</code>, its negation to those of
+       * <code>mu</code>, and
+       * <code>0.5 * (nu + K) / (nu + q) * S * S'</code> to those of
+       * <code>Sigma</code>.
+       */
+      template <bool propto,
+                typename T_y, typename T_dof, typename T_loc, typename T_scale,
+                typename T_lp>
+      struct multi_student_t_lp<propto,T_y,T_dof,T_loc,T_scale,T_lp,false> {
+        static T_lp
+        apply(const T_y& y, const T_dof& nu, const T_loc& mu,
+              const Eigen::Matrix<T_scale,Eigen::Dynamic,Eigen::Dynamic>& Sigma,
+              stan::math::LDLT_factor<T_scale,Eigen::Dynamic,Eigen::Dynamic>& ldlt_Sigma,
+              size_t size_vec, int size_y) {
+          using boost::math::lgamma;
+          using stan::math::digamma;
+          using stan::math::value_of_rec;
+          using std::log;
+          using Eigen::MatrixXd;
+
+          VectorViewMvt<const T_y> y_vec(y);
+          VectorViewMvt<const T_loc> mu_vec(mu);
+          agrad::OperandsAndPartialsMvt<T_lp> operands;
+          double nu_dbl = value_of_rec(nu);
+          double lp(0.0);
+          double d_nu(0.0);
+
+          if (include_summand<propto,T_dof>::value) {
+            lp += lgamma(0.5 * (nu_dbl + size_y)) * size_vec;
+            lp -= lgamma(0.5 * nu_dbl) * size_vec;
+            lp -= (0.5 * size_y) * log(nu_dbl) * size_vec;
+            if (!is_constant_struct<T_dof>::value)
+              d_nu += 0.5 * (digamma(0.5 * (nu_dbl + size_y))
+                             - digamma(0.5 * nu_dbl)
+                             - size_y / nu_dbl) * size_vec;
+          }
+
+          if (include_summand<propto>::value) 
+            lp -= (0.5 * size_y) * LOG_PI * size_vec;
+
+          MatrixXd d_Sigma;
+          if (!is_constant_struct<T_scale>::value)
+            d_Sigma = -0.5 * size_vec
+              * MatrixXd(ldlt_Sigma.solve(MatrixXd::Identity(size_y, size_y)));
+
+          if (include_summand<propto,T_scale>::value)
+            lp -= 0.5 * ldlt_Sigma.vectorD().array().log().sum() * size_vec;
+
+          if (include_summand<propto,T_y,T_dof,T_loc,T_scale>::value) {
+            MatrixXd r(size_y, size_vec);
+            for (size_t i = 0; i < size_vec; i++)
+              for (int j = 0; j < size_y; j++)
+                r(j,i) = value_of_rec(y_vec[i](j)) - value_of_rec(mu_vec[i](j));
+            MatrixXd S = ldlt_Sigma.solve(r);
+            double sum_lp_vec(0.0);
+            for (size_t i = 0; i < size_vec; i++) {
+              double q = r.col(i).dot(S.col(i));
+              sum_lp_vec += log(1.0 + q / nu_dbl);
+              double w = (nu_dbl + size_y) / (nu_dbl + q);
+              d_nu += 0.5 * w * q / nu_dbl;
+              if (!is_constant_struct<T_scale>::value)
+                d_Sigma.noalias() += 0.5 * w * S.col(i) * S.col(i).transpose();
+              S.col(i) *= w;
+            }
+            lp -= 0.5 * (nu_dbl + size_y) * sum_lp_vec;
+            d_nu -= 0.5 * sum_lp_vec;
+            operands.add_mvt(y, -S);
+            operands.add_mvt(mu, S);
+          }
+          operands.add(nu, d_nu);
+          operands.add(Sigma, d_Sigma);
+          return operands.to_var(lp);
+        }
+      };
+
+    }
+
     /**
      * Return the log of the multivariate Student t distribution
      * at the specified arguments.
@@ -46,26 +186,21 @@ namespace stan {
       using stan::error_handling::check_symmetric;
       using stan::error_handling::check_positive;      
       using boost::math::tools::promote_args;
-      using boost::math::lgamma;
-      using stan::math::log_determinant_ldlt;
       using stan::math::LDLT_factor;
       using stan::error_handling::check_ldlt_factor;
 
       typedef typename boost::math::tools::promote_args<typename scalar_type<T_y>::type,T_dof,typename scalar_type<T_loc>::type,T_scale>::type lp_type;
-      lp_type lp(0.0);
       
       // allows infinities
       check_not_nan(function, "Degrees of freedom parameter", nu);
       check_positive(function, "Degrees of freedom parameter", nu);
       
       using boost::math::isinf;
+      using stan::math::value_of_rec;
 
-      if (isinf(nu)) // already checked nu > 0
+      if (isinf(value_of_rec(nu))) // already checked nu > 0
         return multi_normal_log(y,mu,Sigma);
 
-      using Eigen::Matrix;
-      using Eigen::Dynamic;
-      using std::vector;
       VectorViewMvt<const T_y> y_vec(y);
       VectorViewMvt<const T_loc> mu_vec(mu);
       //size of std::vector of Eigen vectors
@@ -122,40 +257,10 @@ namespace stan {
       check_ldlt_factor(function, "LDLT_Factor of scale parameter", ldlt_Sigma);
 
       if (size_y == 0) //y_vec[0].size() == 0
-        return lp;
-
-      if (include_summand<propto,T_dof>::value) {
-        lp += lgamma(0.5 * (nu + size_y)) * size_vec;
-        lp -= lgamma(0.5 * nu) * size_vec;
-        lp -= (0.5 * size_y) * log(nu) * size_vec;
-      }
-
-      if (include_summand<propto>::value) 
-        lp -= (0.5 * size_y) * LOG_PI * size_vec;
+        return lp_type(0.0);
 
-      using stan::math::multiply;
-      using stan::math::dot_product;
-      using stan::math::subtract;
-      using Eigen::Array;
-
-
-      if (include_summand<propto,T_scale>::value) {
-        lp -= 0.5 * log_determinant_ldlt(ldlt_Sigma) * size_vec;
-      }
-
-      if (include_summand<propto,T_y,T_dof,T_loc,T_scale>::value) {
-        lp_type sum_lp_vec(0.0);
-        for (size_t i = 0; i < size_vec; i++) {
-          Matrix<typename 
-              boost::math::tools::promote_args<typename scalar_type<T_y>::type, typename scalar_type<T_loc>::type>::type,
-              Dynamic, 1> y_minus_mu(size_y);
-          for (int j = 0; j < size_y; j++)
-            y_minus_mu(j) = y_vec[i](j)-mu_vec[i](j);
-          sum_lp_vec += log(1.0 + trace_inv_quad_form_ldlt(ldlt_Sigma,y_minus_mu) / nu);
-        }
-        lp -= 0.5 * (nu + size_y) * sum_lp_vec;
-      }
-      return lp;
+      return multi_student_t_lp<propto,T_y,T_dof,T_loc,T_scale,lp_type>
+        ::apply(y, nu, mu, Sigma, ldlt_Sigma, size_vec, size_y);
     }
 
     template <typename T_y, typename T_dof, typename T_loc, typename T_scale>
@@ -1,9 +1,12 @@
 #ifndef STAN__PROB__DISTRIBUTIONS__MULTIVARIATE__CONTINUOUS__WISHART_HPP
 #define STAN__PROB__DISTRIBUTIONS__MULTIVARIATE__CONTINUOUS__WISHART_HPP
 
+#include <stan/agrad/partials_vari_mvt.hpp>
+#include <stan/agrad/rev/functions/value_of_rec.hpp>
 #include <stan/error_handling/matrix/check_size_match.hpp>
 #include <stan/error_handling/matrix/check_ldlt_factor.hpp>
 #include <stan/error_handling/scalar/check_greater.hpp>
+#include <stan/math/functions/digamma.hpp>
 #include <stan/math/functions/lmgamma.hpp>
 #include <stan/math/matrix/crossprod.hpp>
 #include <stan/math/matrix/columns_dot_product.hpp>
@@ -14,6 +17,7 @@
 #include <stan/math/matrix/mdivide_left_tri_low.hpp>
 #include <stan/math/matrix/multiply_lower_tri_self_transpose.hpp>
 #include <stan/math/matrix/meta/index_type.hpp>
+#include <stan/math/matrix/value_of_rec.hpp>
 #include <stan/prob/constants.hpp>
 #include <stan/prob/distributions/univariate/continuous/normal.hpp>
 #include <stan/prob/distributions/univariate/continuous/chi_square.hpp>
@@ -23,6 +27,146 @@ namespace stan {
 
   namespace prob {
 
+    namespace {
+
+      /**
+       * Log density of the Wishart for autodiff types that carry
+       * tangents.  Every operation is recorded through the generic
+       * matrix functions.
+       */
+      template <bool propto,
+                typename T_y, typename T_dof, typename T_scale,
+                typename T_lp, bool is_fvar = contains_fvar<T_lp>::value>
+      struct wishart_lp {
+        static T_lp
+        apply(const Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic>& W,
+              const T_dof& nu,
+              const Eigen::Matrix<T_scale,Eigen::Dynamic,Eigen::Dynamic>& /* S */,
+              stan::math::LDLT_factor<T_y,Eigen::Dynamic,Eigen::Dynamic>& ldlt_W,
+              stan::math::LDLT_factor<T_scale,Eigen::Dynamic,Eigen::Dynamic>& ldlt_S,
+              typename stan::math::index_type<Eigen::Matrix<T_scale,Eigen::Dynamic,Eigen::Dynamic> >::type k) {
+          using boost::math::tools::promote_args;
+          using Eigen::Dynamic;
+          using Eigen::Lower;
+          using Eigen::Matrix;
+          using stan::math::lmgamma;
+          using stan::math::log_determinant_ldlt;
+          using stan::math::mdivide_left_ldlt;
+          using stan::math::trace;
+
+          T_lp lp(0.0);
+
+          if (include_summand<propto,T_dof>::value)
+            lp += nu * k * NEG_LOG_TWO_OVER_TWO;
+
+          if (include_summand<propto,T_dof>::value)
+            lp -= lmgamma(k, 0.5 * nu);
+
+          if (include_summand<propto,T_dof,T_scale>::value)
+            lp -= 0.5 * nu * log_determinant_ldlt(ldlt_S);
+
+          if (include_summand<propto,T_scale,T_y>::value) {
+            Matrix<typename promote_args<T_y,T_scale>::type,Dynamic,Dynamic> 
+              Sinv_W(mdivide_left_ldlt(ldlt_S, 
+                                       static_cast<Matrix<T_y,Dynamic,Dynamic> >(W.template selfadjointView<Lower>())));
+            lp -= 0.5 * trace(Sinv_W);
+          }
+
+          if (include_summand<propto,T_y,T_dof>::value && nu != (k + 1))
+            lp += 0.5 * (nu - k - 1.0) * log_determinant_ldlt(ldlt_W);
+          return lp;
+        }
+      };
+
+      /**
+       * Log density of the Wishart on doubles.
+       *
+       * <p>Only the lower triangle of <code>W</code> enters the
+       * trace term, so its partials,
+       * <code>-0.5 * (2 - I) .* inverse(S)</code>, are given to the
+       * lower triangle only.  The partials of <code>S</code> are
+       * <code>0.5 * inverse(S) * (W * inverse(S) - nu * I)</code>.
+       */
+      template <bool propto,
+                typename T_y, typename T_dof, typename T_scale,
+                typename T_lp>
+      struct wishart_lp<propto,T_y,T_dof,T_scale,T_lp,false> {
+        static T_lp
+        apply(const Eigen::Matrix<T_y,Eigen::Dynamic,Eigen::Dynamic>& W,
+              const T_dof& nu,
+              const Eigen::Matrix<T_scale,Eigen::Dynamic,Eigen::Dynamic>& S,
+              stan::math::LDLT_factor<T_y,Eigen::Dynamic,Eigen::Dynamic>& ldlt_W,
+              stan::math::LDLT_factor<T_scale,Eigen::Dynamic,Eigen::Dynamic>& ldlt_S,
+              typename stan::math::index_type<Eigen::Matrix<T_scale,Eigen::Dynamic,Eigen::Dynamic> >::type k) {
+          using Eigen::Lower;
+          using Eigen::MatrixXd;
+          using stan::math::digamma;
+          using stan::math::lmgamma;
+          using stan::math::value_of_rec;
+
+          agrad::OperandsAndPartialsMvt<T_lp> operands;
+          double nu_dbl = value_of_rec(nu);
+          double lp(0.0);
+          double d_nu(0.0);
+          MatrixXd d_W = MatrixXd::Zero(k, k);
+          MatrixXd d_S = MatrixXd::Zero(k, k);
+
+          if (include_summand<propto,T_dof>::value) {
+            lp += nu_dbl * k * NEG_LOG_TWO_OVER_TWO;
+            d_nu += k * NEG_LOG_TWO_OVER_TWO;
+          }
+
+          if (include_summand<propto,T_dof>::value) {
+            lp -= lmgamma(k, 0.5 * nu_dbl);
+            for (int j = 1; j <= k; ++j)
+              d_nu -= 0.5 * digamma(0.5 * nu_dbl + (1.0 - j) / 2.0);
+          }
+
+          MatrixXd inv_S;
+          if (!is_constant_struct<T_y>::value
+              || !is_constant_struct<T_scale>::value)
+            inv_S = ldlt_S.solve(MatrixXd::Identity(k, k));
+
+          if (include_summand<propto,T_dof,T_scale>::value) {
+            double log_det_S = ldlt_S.vectorD().array().log().sum();
+            lp -= 0.5 * nu_dbl * log_det_S;
+            d_nu -= 0.5 * log_det_S;
+            if (!is_constant_struct<T_scale>::value)
+              d_S -= 0.5 * nu_dbl * inv_S;
+          }
+
+          if (include_summand<propto,T_scale,T_y>::value) {
+            MatrixXd W_sym = value_of_rec(W).template selfadjointView<Lower>();
+            MatrixXd Sinv_W = ldlt_S.solve(W_sym);
+            lp -= 0.5 * Sinv_W.trace();
+            if (!is_constant_struct<T_scale>::value)
+              d_S.noalias() += 0.5 * Sinv_W * inv_S;
+            if (!is_constant_struct<T_y>::value)
+              for (int n = 0; n < k; ++n) {
+                d_W(n,n) -= 0.5 * inv_S(n,n);
+                for (int m = n + 1; m < k; ++m)
+                  d_W(m,n) -= inv_S(m,n);
+              }
+          }
+
+          if (include_summand<propto,T_y,T_dof>::value && nu_dbl != (k + 1)) {
+            double log_det_W = ldlt_W.vectorD().array().log().sum();
+            lp += 0.5 * (nu_dbl - k - 1.0) * log_det_W;
+            d_nu += 0.5 * log_det_W;
+            if (!is_constant_struct<T_y>::value)
+              d_W += 0.5 * (nu_dbl - k - 1.0)
+                * MatrixXd(ldlt_W.solve(MatrixXd::Identity(k, k)));
+          }
+
+          operands.add(W, d_W);
+          operands.add(nu, d_nu);
+          operands.add(S, d_S);
+          return operands.to_var(lp);
+        }
+      };
+
+    }
+
     // Wishart(Sigma|n,Omega)  [Sigma, Omega symmetric, non-neg, definite; 
     //                          Sigma.dims() = Omega.dims();
     //                           n > Sigma.rows() - 1]
@@ -63,20 +207,17 @@ namespace stan {
 
       using boost::math::tools::promote_args;
       using Eigen::Dynamic;
-      using Eigen::Lower;
       using Eigen::Matrix;
       using stan::error_handling::check_greater;
       using stan::error_handling::check_ldlt_factor;
       using stan::error_handling::check_size_match;
       using stan::math::index_type;
       using stan::math::LDLT_factor;
-      using stan::math::log_determinant_ldlt;
-      using stan::math::mdivide_left_ldlt;
-      
+
+      typedef typename promote_args<T_y,T_dof,T_scale>::type T_lp;
 
       typename index_type<Matrix<T_scale,Dynamic,Dynamic> >::type k 
         = W.rows();
-      typename promote_args<T_y,T_dof,T_scale>::type lp(0.0);
       check_greater(function, "Degrees of freedom parameter", nu, k-1);
       check_size_match(function, 
                        "Rows of random variable", W.rows(), 
@@ -91,33 +232,14 @@ namespace stan {
 
       LDLT_factor<T_y,Eigen::Dynamic,Eigen::Dynamic> ldlt_W(W);
       if (!check_ldlt_factor(function, "LDLT_Factor of random variable", ldlt_W))
-        return lp;
+        return T_lp(0.0);
 
       LDLT_factor<T_scale,Eigen::Dynamic,Eigen::Dynamic> ldlt_S(S);
       if (!check_ldlt_factor(function, "LDLT_Factor of scale parameter", ldlt_S))
-        return lp;
+        return T_lp(0.0);
       
-      using stan::math::trace;
-      using stan::math::lmgamma;
-      if (include_summand<propto,T_dof>::value)
-        lp += nu * k * NEG_LOG_TWO_OVER_TWO;
-
-      if (include_summand<propto,T_dof>::value)
-        lp -= lmgamma(k, 0.5 * nu);
-
-      if (include_summand<propto,T_dof,T_scale>::value)
-        lp -= 0.5 * nu * log_determinant_ldlt(ldlt_S);
-
-      if (include_summand<propto,T_scale,T_y>::value) {
-        Matrix<typename promote_args<T_y,T_scale>::type,Dynamic,Dynamic> 
-          Sinv_W(mdivide_left_ldlt(ldlt_S, 
-                                   static_cast<Matrix<T_y,Dynamic,Dynamic> >(W.template selfadjointView<Lower>())));
-        lp -= 0.5 * trace(Sinv_W);
-      }
-
-      if (include_summand<propto,T_y,T_dof>::value && nu != (k + 1))
-        lp += 0.5 * (nu - k - 1.0) * log_determinant_ldlt(ldlt_W);
-      return lp;
+      return wishart_lp<propto,T_y,T_dof,T_scale,T_lp>
+        ::apply(W, nu, S, ldlt_W, ldlt_S, k);
     }
 
     template <typename T_y, typename T_dof, typename T_scale>
@@ -1,6 +1,7 @@
 #ifndef STAN__PROB__DISTRIBUTIONS__UNIVARIATE__CONTINUOUS__GAMMA_HPP
 #define STAN__PROB__DISTRIBUTIONS__UNIVARIATE__CONTINUOUS__GAMMA_HPP
 
+#include <algorithm>
 #include <boost/random/gamma_distribution.hpp>
 #include <boost/random/variate_generator.hpp>
 #include <stan/agrad/partials_vari.hpp>
@@ -15,6 +16,8 @@
 #include <stan/math/functions/value_of.hpp>
 #include <stan/math/functions/gamma_p.hpp>
 #include <stan/math/functions/digamma.hpp>
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/math/matrix/value_array.hpp>
 #include <stan/meta/traits.hpp>
 #include <stan/prob/constants.hpp>
 #include <stan/prob/traits.hpp>
@@ -55,6 +58,8 @@ namespace stan {
       typedef typename stan::partials_return_type<T_y,T_shape,
                                                   T_inv_scale>::type 
         T_partials_return;
+      typedef typename stan::math::value_array_type<T_partials_return>::type
+        array_t;
 
       using stan::is_constant_struct;
       using stan::error_handling::check_not_nan;
@@ -101,58 +106,64 @@ namespace stan {
         operands_and_partials(y, alpha, beta);
 
       using boost::math::lgamma;
-      using stan::math::multiply_log;
       using boost::math::digamma;
-      
-      VectorBuilder<include_summand<propto,T_y,T_shape>::value,
-                    T_partials_return, T_y> log_y(length(y));
-      if (include_summand<propto,T_y,T_shape>::value)
-        for(size_t n = 0; n < length(y); n++) {
-          if (value_of(y_vec[n]) > 0)
-            log_y[n] = log(value_of(y_vec[n]));
-        }
+      using stan::math::value_array;
+      using stan::math::VALUE_ARRAY_MAX_SIZE;
 
-      VectorBuilder<include_summand<propto,T_shape>::value,
-                    T_partials_return, T_shape> lgamma_alpha(length(alpha));
-      VectorBuilder<!is_constant_struct<T_shape>::value,
-                    T_partials_return, T_shape> digamma_alpha(length(alpha));
-      for (size_t n = 0; n < length(alpha); n++) {
+      // terms of alpha or beta alone are computed once per element and
+      // scaled by the number of times each is repeated
+      const double alpha_repeats = static_cast<double>(N) / length(alpha);
+      for (size_t i = 0; i < length(alpha); i++) {
         if (include_summand<propto,T_shape>::value)
-          lgamma_alpha[n] = lgamma(value_of(alpha_vec[n]));
+          logp -= lgamma(value_of(alpha_vec[i])) * alpha_repeats;
         if (!is_constant_struct<T_shape>::value)
-          digamma_alpha[n] = digamma(value_of(alpha_vec[n]));
+          operands_and_partials.d_x2[i]
+            -= digamma(value_of(alpha_vec[i])) * alpha_repeats;
       }
+      T_partials_return log_beta_scalar(0.0);
+      if (include_summand<propto,T_shape,T_inv_scale>::value
+          && !is_vector<T_inv_scale>::value)
+        log_beta_scalar = log(value_of(beta_vec[0]));
+
+      // blocks of the other terms at once, as array expressions
+      for (size_t start = 0; start < N; start += VALUE_ARRAY_MAX_SIZE) {
+        size_t size = std::min<size_t>(VALUE_ARRAY_MAX_SIZE, N - start);
+        const array_t y_dbl = value_array<T_partials_return>(y, start, size);
+        const array_t alpha_dbl
+          = value_array<T_partials_return>(alpha, start, size);
+        const array_t beta_dbl
+          = value_array<T_partials_return>(beta, start, size);
+
+        array_t log_y = array_t::Zero(size);
+        if (include_summand<propto,T_y,T_shape>::value)
+          for (size_t n = 0; n < size; n++)
+            if (y_dbl(n) > 0)
+              log_y(n) = log(y_dbl(n));
+
+        array_t log_beta(size);
+        if (include_summand<propto,T_shape,T_inv_scale>::value) {
+          if (is_vector<T_inv_scale>::value)
+            log_beta = beta_dbl.log();
+          else
+            log_beta.setConstant(log_beta_scalar);
+        }
 
-      VectorBuilder<include_summand<propto,T_shape,T_inv_scale>::value,
-                    T_partials_return, T_inv_scale> log_beta(length(beta));
-      if (include_summand<propto,T_shape,T_inv_scale>::value)
-        for (size_t n = 0; n < length(beta); n++)
-          log_beta[n] = log(value_of(beta_vec[n]));
-      
-      for (size_t n = 0; n < N; n++) {
-        // pull out values of arguments
-        const T_partials_return y_dbl = value_of(y_vec[n]);
-        const T_partials_return alpha_dbl = value_of(alpha_vec[n]);
-        const T_partials_return beta_dbl = value_of(beta_vec[n]);
-  
-        if (include_summand<propto,T_shape>::value)
-          logp -= lgamma_alpha[n];
         if (include_summand<propto,T_shape,T_inv_scale>::value)
-          logp += alpha_dbl * log_beta[n];
+          logp += (alpha_dbl * log_beta).sum();
         if (include_summand<propto,T_y,T_shape>::value)
-          logp += (alpha_dbl-1.0) * log_y[n];
+          logp += ((alpha_dbl - 1.0) * log_y).sum();
         if (include_summand<propto,T_y,T_inv_scale>::value)
-          logp -= beta_dbl * y_dbl;
-  
+          logp -= (beta_dbl * y_dbl).sum();
+
         // gradients
-        if (!is_constant_struct<T_y>::value)
-          operands_and_partials.d_x1[n] += (alpha_dbl-1)/y_dbl - beta_dbl;
-        if (!is_constant_struct<T_shape>::value)
-          operands_and_partials.d_x2[n] += -digamma_alpha[n] + log_beta[n] 
-            + log_y[n];
-        if (!is_constant_struct<T_inv_scale>::value)
-          operands_and_partials.d_x3[n] += alpha_dbl / beta_dbl - y_dbl;
+        agrad::add_partials(operands_and_partials.d_x1, start,
+                            (alpha_dbl - 1.0) / y_dbl - beta_dbl);
+        agrad::add_partials(operands_and_partials.d_x2, start,
+                            log_beta + log_y);
+        agrad::add_partials(operands_and_partials.d_x3, start,
+                            alpha_dbl / beta_dbl - y_dbl);
       }
+
       return operands_and_partials.to_var(logp,y,alpha,beta);
     }
 
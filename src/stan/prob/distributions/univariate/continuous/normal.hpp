@@ -1,6 +1,7 @@
 #ifndef STAN__PROB__DISTRIBUTIONS__UNIVARIATE__CONTINUOUS__NORMAL_HPP
 #define STAN__PROB__DISTRIBUTIONS__UNIVARIATE__CONTINUOUS__NORMAL_HPP
 
+#include <algorithm>
 #include <boost/random/normal_distribution.hpp>
 #include <boost/random/variate_generator.hpp>
 #include <stan/agrad/partials_vari.hpp>
@@ -10,6 +11,8 @@
 #include <stan/error_handling/scalar/check_positive.hpp>
 #include <stan/math/functions/constants.hpp>
 #include <stan/math/functions/value_of.hpp>
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/math/matrix/value_array.hpp>
 #include <stan/meta/traits.hpp>
 #include <stan/prob/constants.hpp>
 #include <stan/prob/traits.hpp>
@@ -43,6 +46,8 @@ namespace stan {
       static const char* function("stan::prob::normal_log");
       typedef typename stan::partials_return_type<T_y,T_loc,T_scale>::type 
         T_partials_return;
+      typedef typename stan::math::value_array_type<T_partials_return>::type
+        array_t;
 
       using std::log;
       using stan::is_constant_struct;
@@ -51,6 +56,8 @@ namespace stan {
       using stan::error_handling::check_not_nan;
       using stan::error_handling::check_consistent_sizes;
       using stan::math::value_of;
+      using stan::math::value_array;
+      using stan::math::VALUE_ARRAY_MAX_SIZE;
       using stan::prob::include_summand;
 
       // check if any vectors are zero length
@@ -78,53 +85,42 @@ namespace stan {
       agrad::OperandsAndPartials<T_y, T_loc, T_scale> 
         operands_and_partials(y, mu, sigma);
 
-      VectorView<const T_y> y_vec(y);
-      VectorView<const T_loc> mu_vec(mu);
       VectorView<const T_scale> sigma_vec(sigma);
       size_t N = max_size(y, mu, sigma);
 
-      VectorBuilder<true, T_partials_return, T_scale> inv_sigma(length(sigma));
-      VectorBuilder<include_summand<propto,T_scale>::value, 
-                    T_partials_return, T_scale> log_sigma(length(sigma));
-      for (size_t i = 0; i < length(sigma); i++) {
-        inv_sigma[i] = 1.0 / value_of(sigma_vec[i]);
-        if (include_summand<propto,T_scale>::value)
-          log_sigma[i] = log(value_of(sigma_vec[i]));
-      }
-
-      for (size_t n = 0; n < N; n++) {
-        // pull out values of arguments
-        const T_partials_return y_dbl = value_of(y_vec[n]);
-        const T_partials_return mu_dbl = value_of(mu_vec[n]);
-      
-        // reusable subexpression values
-        const T_partials_return y_minus_mu_over_sigma 
-          = (y_dbl - mu_dbl) * inv_sigma[n];
-        const T_partials_return y_minus_mu_over_sigma_squared 
-          = y_minus_mu_over_sigma * y_minus_mu_over_sigma;
-
-        static double NEGATIVE_HALF = - 0.5;
+      if (include_summand<propto>::value)
+        logp += NEG_LOG_SQRT_TWO_PI * N;
+      if (include_summand<propto,T_scale>::value
+          && !is_vector<T_scale>::value)
+        logp -= log(value_of(sigma_vec[0])) * N;
+
+      // blocks of terms at once, as array expressions
+      for (size_t start = 0; start < N; start += VALUE_ARRAY_MAX_SIZE) {
+        size_t size = std::min<size_t>(VALUE_ARRAY_MAX_SIZE, N - start);
+        const array_t sigma_dbl
+          = value_array<T_partials_return>(sigma, start, size);
+        const array_t inv_sigma = sigma_dbl.inverse();
+        const array_t y_minus_mu_over_sigma
+          = (value_array<T_partials_return>(y, start, size)
+             - value_array<T_partials_return>(mu, start, size)) * inv_sigma;
 
         // log probability
-        if (include_summand<propto>::value)
-          logp += NEG_LOG_SQRT_TWO_PI;
-        if (include_summand<propto,T_scale>::value)
-          logp -= log_sigma[n];
+        if (include_summand<propto,T_scale>::value
+            && is_vector<T_scale>::value)
+          logp -= sigma_dbl.log().sum();
         if (include_summand<propto,T_y,T_loc,T_scale>::value)
-          logp += NEGATIVE_HALF * y_minus_mu_over_sigma_squared;
+          logp -= 0.5 * y_minus_mu_over_sigma.square().sum();
 
         // gradients
-        T_partials_return scaled_diff = inv_sigma[n] * y_minus_mu_over_sigma;
-        if (!is_constant_struct<T_y>::value)
-          operands_and_partials.d_x1[n] -= scaled_diff;
-        if (!is_constant_struct<T_loc>::value)
-          operands_and_partials.d_x2[n] += scaled_diff;
-        if (!is_constant_struct<T_scale>::value)
-          operands_and_partials.d_x3[n] 
-            += -inv_sigma[n] + inv_sigma[n] * y_minus_mu_over_sigma_squared;
+        agrad::add_partials(operands_and_partials.d_x1, start,
+                            -inv_sigma * y_minus_mu_over_sigma);
+        agrad::add_partials(operands_and_partials.d_x2, start,
+                            inv_sigma * y_minus_mu_over_sigma);
+        agrad::add_partials(operands_and_partials.d_x3, start,
+                            inv_sigma
+                            * (y_minus_mu_over_sigma.square() - 1.0));
       }
 
-      
       return operands_and_partials.to_var(logp,y,mu,sigma);
 
     }
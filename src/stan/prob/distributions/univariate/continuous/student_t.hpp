@@ -1,6 +1,7 @@
 #ifndef STAN__PROB__DISTRIBUTIONS__UNIVARIATE__CONTINUOUS__STUDENT_T_HPP
 #define STAN__PROB__DISTRIBUTIONS__UNIVARIATE__CONTINUOUS__STUDENT_T_HPP
 
+#include <algorithm>
 #include <boost/random/student_t_distribution.hpp>
 #include <boost/random/variate_generator.hpp>
 #include <stan/agrad/partials_vari.hpp>
@@ -14,6 +15,8 @@
 #include <stan/math/functions/lbeta.hpp>
 #include <stan/math/functions/lgamma.hpp>
 #include <stan/math/functions/digamma.hpp>
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/math/matrix/value_array.hpp>
 #include <stan/meta/traits.hpp>
 #include <stan/prob/constants.hpp>
 #include <stan/prob/internal_math/math/grad_reg_inc_beta.hpp>
@@ -60,6 +63,8 @@ namespace stan {
       typedef typename stan::partials_return_type<T_y,T_dof,T_loc,
                                                   T_scale>::type 
         T_partials_return;
+      typedef typename stan::math::value_array_type<T_partials_return>::type
+        array_t;
 
       using stan::error_handling::check_positive_finite;
       using stan::error_handling::check_finite;
@@ -90,124 +95,79 @@ namespace stan {
       if (!include_summand<propto,T_y,T_dof,T_loc,T_scale>::value)
         return 0.0;
 
-      VectorView<const T_y> y_vec(y);
       VectorView<const T_dof> nu_vec(nu);
-      VectorView<const T_loc> mu_vec(mu);
       VectorView<const T_scale> sigma_vec(sigma);
       size_t N = max_size(y, nu, mu, sigma);
 
       using std::log;
       using stan::math::digamma;
       using stan::math::lgamma;
-      using stan::math::square;
       using stan::math::value_of;
-
-      VectorBuilder<include_summand<propto,T_y,T_dof,T_loc,T_scale>::value,
-                    T_partials_return, T_dof> half_nu(length(nu));
-      for (size_t i = 0; i < length(nu); i++) 
-        if (include_summand<propto,T_y,T_dof,T_loc,T_scale>::value) 
-          half_nu[i] = 0.5 * value_of(nu_vec[i]);
-
-      VectorBuilder<include_summand<propto,T_dof>::value,
-                    T_partials_return, T_dof> lgamma_half_nu(length(nu));
-      VectorBuilder<include_summand<propto,T_dof>::value,
-                    T_partials_return, T_dof> 
-        lgamma_half_nu_plus_half(length(nu));
-      if (include_summand<propto,T_dof>::value)
-        for (size_t i = 0; i < length(nu); i++) {
-          lgamma_half_nu[i] = lgamma(half_nu[i]);
-          lgamma_half_nu_plus_half[i] = lgamma(half_nu[i] + 0.5);
-        }
-
-      VectorBuilder<!is_constant_struct<T_dof>::value,
-                    T_partials_return, T_dof> digamma_half_nu(length(nu));
-      VectorBuilder<!is_constant_struct<T_dof>::value,
-                    T_partials_return, T_dof>
-        digamma_half_nu_plus_half(length(nu));
-      if (!is_constant_struct<T_dof>::value)
-        for (size_t i = 0; i < length(nu); i++) {
-          digamma_half_nu[i] = digamma(half_nu[i]);
-          digamma_half_nu_plus_half[i] = digamma(half_nu[i] + 0.5);
-        }
-
-      VectorBuilder<include_summand<propto,T_dof>::value,
-                    T_partials_return, T_dof> log_nu(length(nu));
-      for (size_t i = 0; i < length(nu); i++)
-        if (include_summand<propto,T_dof>::value)
-          log_nu[i] = log(value_of(nu_vec[i]));
-
-      VectorBuilder<include_summand<propto,T_scale>::value,
-                    T_partials_return, T_scale> log_sigma(length(sigma));
-      for (size_t i = 0; i < length(sigma); i++)
-        if (include_summand<propto,T_scale>::value)
-          log_sigma[i] = log(value_of(sigma_vec[i]));
-
-      VectorBuilder<include_summand<propto,T_y,T_dof,T_loc,T_scale>::value,
-                    T_partials_return, T_y, T_dof, T_loc, T_scale>
-        square_y_minus_mu_over_sigma__over_nu(N);
-
-      VectorBuilder<include_summand<propto,T_y,T_dof,T_loc,T_scale>::value,
-                    T_partials_return, T_y, T_dof, T_loc, T_scale>
-        log1p_exp(N);
-
-      for (size_t i = 0; i < N; i++) 
-        if (include_summand<propto,T_y,T_dof,T_loc,T_scale>::value) {
-          const T_partials_return y_dbl = value_of(y_vec[i]);
-          const T_partials_return mu_dbl = value_of(mu_vec[i]);
-          const T_partials_return sigma_dbl = value_of(sigma_vec[i]);
-          const T_partials_return nu_dbl = value_of(nu_vec[i]);
-          square_y_minus_mu_over_sigma__over_nu[i] 
-            = square((y_dbl - mu_dbl) / sigma_dbl) / nu_dbl;
-          log1p_exp[i] = log1p(square_y_minus_mu_over_sigma__over_nu[i]);
-        }
+      using stan::math::value_array;
+      using stan::math::VALUE_ARRAY_MAX_SIZE;
 
       agrad::OperandsAndPartials<T_y,T_dof,T_loc,T_scale>
         operands_and_partials(y,nu,mu,sigma);
-      for (size_t n = 0; n < N; n++) {
-        const T_partials_return y_dbl = value_of(y_vec[n]);
-        const T_partials_return mu_dbl = value_of(mu_vec[n]);
-        const T_partials_return sigma_dbl = value_of(sigma_vec[n]);
-        const T_partials_return nu_dbl = value_of(nu_vec[n]);
-        if (include_summand<propto>::value)
-          logp += NEG_LOG_SQRT_PI;
+
+      // terms of nu or sigma alone are computed once per element and
+      // scaled by the number of times each is repeated
+      const double nu_repeats = static_cast<double>(N) / length(nu);
+      for (size_t i = 0; i < length(nu); i++) {
+        const T_partials_return half_nu = 0.5 * value_of(nu_vec[i]);
         if (include_summand<propto,T_dof>::value)
-          logp += lgamma_half_nu_plus_half[n] - lgamma_half_nu[n]
-            -  0.5 * log_nu[n];
-        if (include_summand<propto,T_scale>::value)
-          logp -= log_sigma[n];
-        if (include_summand<propto,T_y,T_dof,T_loc,T_scale>::value)
-          logp -= (half_nu[n] + 0.5)
-            * log1p_exp[n];
-  
-        if (!is_constant_struct<T_y>::value) {
-          operands_and_partials.d_x1[n] 
-            += -(half_nu[n]+0.5)
-            * 1.0 / (1.0 + square_y_minus_mu_over_sigma__over_nu[n])
-            * (2.0 * (y_dbl - mu_dbl) / square(sigma_dbl) / nu_dbl);
-        }
-        if (!is_constant_struct<T_dof>::value) {
-          const T_partials_return inv_nu = 1.0 / nu_dbl;
-          operands_and_partials.d_x2[n] 
-            += 0.5*digamma_half_nu_plus_half[n] - 0.5*digamma_half_nu[n]
-            - 0.5 * inv_nu
-            - 0.5*log1p_exp[n]
-            + (half_nu[n] + 0.5)
-            * (1.0/(1.0 + square_y_minus_mu_over_sigma__over_nu[n])
-               * square_y_minus_mu_over_sigma__over_nu[n] * inv_nu);
-        }
-        if (!is_constant_struct<T_loc>::value) {
-          operands_and_partials.d_x3[n] 
-            -= (half_nu[n] + 0.5) 
-            / (1.0 + square_y_minus_mu_over_sigma__over_nu[n]) 
-            * (2.0 * (mu_dbl - y_dbl) / (sigma_dbl*sigma_dbl*nu_dbl));
-        }
-        if (!is_constant_struct<T_scale>::value) {
-          const T_partials_return inv_sigma = 1.0 / sigma_dbl;
-          operands_and_partials.d_x4[n] 
-            += -inv_sigma
-            + (nu_dbl + 1.0) / (1.0 + square_y_minus_mu_over_sigma__over_nu[n])
-            * (square_y_minus_mu_over_sigma__over_nu[n] * inv_sigma);
-        }
+          logp += (lgamma(half_nu + 0.5) - lgamma(half_nu)
+                   - 0.5 * log(value_of(nu_vec[i]))) * nu_repeats;
+        if (!is_constant_struct<T_dof>::value)
+          operands_and_partials.d_x2[i]
+            += (0.5 * digamma(half_nu + 0.5) - 0.5 * digamma(half_nu)
+                - 0.5 / value_of(nu_vec[i])) * nu_repeats;
+      }
+      if (include_summand<propto,T_scale>::value) {
+        const double sigma_repeats = static_cast<double>(N) / length(sigma);
+        for (size_t i = 0; i < length(sigma); i++)
+          logp -= log(value_of(sigma_vec[i])) * sigma_repeats;
+      }
+      if (include_summand<propto>::value)
+        logp += NEG_LOG_SQRT_PI * N;
+
+      // blocks of the other terms at once, as array expressions
+      for (size_t start = 0; start < N; start += VALUE_ARRAY_MAX_SIZE) {
+        size_t size = std::min<size_t>(VALUE_ARRAY_MAX_SIZE, N - start);
+        const array_t nu_dbl
+          = value_array<T_partials_return>(nu, start, size);
+        const array_t half_nu = 0.5 * nu_dbl;
+        const array_t sigma_dbl
+          = value_array<T_partials_return>(sigma, start, size);
+        const array_t y_minus_mu
+          = value_array<T_partials_return>(y, start, size)
+          - value_array<T_partials_return>(mu, start, size);
+        const array_t square_y_minus_mu_over_sigma__over_nu
+          = (y_minus_mu / sigma_dbl).square() / nu_dbl;
+        const array_t inv_1p_square__over_nu
+          = (1.0 + square_y_minus_mu_over_sigma__over_nu).inverse();
+        array_t log1p_exp(size);
+        for (size_t n = 0; n < size; n++)
+          log1p_exp(n) = log1p(square_y_minus_mu_over_sigma__over_nu(n));
+
+        logp -= ((half_nu + 0.5) * log1p_exp).sum();
+
+        agrad::add_partials(operands_and_partials.d_x1, start,
+                            -(half_nu + 0.5) * inv_1p_square__over_nu
+                            * (2.0 * y_minus_mu / sigma_dbl.square()
+                               / nu_dbl));
+        agrad::add_partials(operands_and_partials.d_x2, start,
+                            -0.5 * log1p_exp
+                            + (half_nu + 0.5) * inv_1p_square__over_nu
+                            * square_y_minus_mu_over_sigma__over_nu / nu_dbl);
+        agrad::add_partials(operands_and_partials.d_x3, start,
+                            (half_nu + 0.5) * inv_1p_square__over_nu
+                            * (2.0 * y_minus_mu / sigma_dbl.square()
+                               / nu_dbl));
+        agrad::add_partials(operands_and_partials.d_x4, start,
+                            -sigma_dbl.inverse()
+                            + (nu_dbl + 1.0) * inv_1p_square__over_nu
+                            * square_y_minus_mu_over_sigma__over_nu
+                            / sigma_dbl);
       }
       return operands_and_partials.to_var(logp,y,nu,mu,sigma);
     }
@@ -1,6 +1,7 @@
 #ifndef STAN__PROB__DISTRIBUTIONS__UNIVARIATE__DISCRETE__BERNOULLI_HPP
 #define STAN__PROB__DISTRIBUTIONS__UNIVARIATE__DISCRETE__BERNOULLI_HPP
 
+#include <algorithm>
 #include <boost/random/bernoulli_distribution.hpp>
 #include <boost/random/variate_generator.hpp>
 #include <stan/agrad/partials_vari.hpp>
@@ -12,6 +13,8 @@
 #include <stan/math/functions/inv_logit.hpp>
 #include <stan/math/functions/log1m.hpp>
 #include <stan/math/functions/value_of.hpp>
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/math/matrix/value_array.hpp>
 #include <stan/meta/traits.hpp>
 #include <stan/prob/constants.hpp>
 #include <stan/prob/traits.hpp>
@@ -131,11 +134,14 @@ namespace stan {
       static const char* function("stan::prob::bernoulli_logit_log");
       typedef typename stan::partials_return_type<T_n,T_prob>::type
         T_partials_return;
+      typedef typename stan::math::value_array_type<T_partials_return>::type
+        array_t;
 
       using stan::is_constant_struct;
       using stan::error_handling::check_not_nan;
       using stan::error_handling::check_bounded;
-      using stan::math::value_of;
+      using stan::math::value_array;
+      using stan::math::VALUE_ARRAY_MAX_SIZE;
       using stan::error_handling::check_consistent_sizes;
       using stan::prob::include_summand;
       using stan::math::log1p;
@@ -160,42 +166,36 @@ namespace stan {
       if (!include_summand<propto,T_prob>::value)
         return 0.0;
       
-      // set up template expressions wrapping scalars into vector views
-      VectorView<const T_n> n_vec(n);
-      VectorView<const T_prob> theta_vec(theta);
       size_t N = max_size(n, theta);
       agrad::OperandsAndPartials<T_prob> operands_and_partials(theta);
 
-      for (size_t n = 0; n < N; n++) {
-        // pull out values of arguments
-        const int n_int = value_of(n_vec[n]);
-        const T_partials_return theta_dbl = value_of(theta_vec[n]);
+      // blocks of terms at once, as array expressions
+      for (size_t start = 0; start < N; start += VALUE_ARRAY_MAX_SIZE) {
+        size_t size = std::min<size_t>(VALUE_ARRAY_MAX_SIZE, N - start);
+        const array_t sign
+          = 2.0 * value_array<T_partials_return>(n, start, size) - 1.0;
+        const array_t ntheta
+          = sign * value_array<T_partials_return>(theta, start, size);
+        const array_t exp_m_ntheta = (-ntheta).exp();
+        array_t log1p_exp_m_ntheta(size);
+        for (size_t i = 0; i < size; i++)
+          log1p_exp_m_ntheta(i) = log1p(exp_m_ntheta(i));
 
-        // reusable subexpression values
-        const int sign = 2*n_int-1;
-        const T_partials_return ntheta = sign * theta_dbl;
-        const T_partials_return exp_m_ntheta = exp(-ntheta);
-  
         // Handle extreme values gracefully using Taylor approximations.
         const static double cutoff = 20.0;
-        if (ntheta > cutoff)
-          logp -= exp_m_ntheta;
-        else if (ntheta < -cutoff)
-          logp += ntheta;
-        else
-          logp -= log1p(exp_m_ntheta);
+        logp += (ntheta > cutoff)
+          .select(-exp_m_ntheta,
+                  (ntheta < -cutoff).select(ntheta, -log1p_exp_m_ntheta))
+          .sum();
 
         // gradients
-        if (!is_constant_struct<T_prob>::value) {
-          const static double cutoff = 20.0;
-          if (ntheta > cutoff)
-            operands_and_partials.d_x1[n] -= exp_m_ntheta;
-          else if (ntheta < -cutoff)
-            operands_and_partials.d_x1[n] += sign;
-          else
-            operands_and_partials.d_x1[n] += sign * exp_m_ntheta 
-              / (exp_m_ntheta + 1);
-        }
+        if (!is_constant_struct<T_prob>::value)
+          agrad::add_partials(operands_and_partials.d_x1, start,
+                              (ntheta > cutoff)
+                              .select(-exp_m_ntheta,
+                                      (ntheta < -cutoff)
+                                      .select(sign, sign * exp_m_ntheta
+                                              / (exp_m_ntheta + 1.0))));
       }
       return operands_and_partials.to_var(logp,theta);
     }
@@ -1,6 +1,7 @@
 #ifndef STAN__PROB__DISTRIBUTIONS__UNIVARIATE__DISCRETE__POISSON_HPP
 #define STAN__PROB__DISTRIBUTIONS__UNIVARIATE__DISCRETE__POISSON_HPP
 
+#include <algorithm>
 #include <limits>
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <boost/random/poisson_distribution.hpp>
@@ -14,6 +15,8 @@
 #include <stan/math/functions/multiply_log.hpp>
 #include <stan/math/functions/gamma_q.hpp>
 #include <stan/math/functions/value_of.hpp>
+#include <stan/math/matrix/Eigen.hpp>
+#include <stan/math/matrix/value_array.hpp>
 #include <stan/meta/traits.hpp>
 #include <stan/prob/traits.hpp>
 #include <stan/prob/constants.hpp>
@@ -28,6 +31,8 @@ namespace stan {
     poisson_log(const T_n& n, const T_rate& lambda) {
       typedef typename stan::partials_return_type<T_n,T_rate>::type
         T_partials_return;
+      typedef typename stan::math::value_array_type<T_partials_return>::type
+        array_t;
 
       static const char* function("stan::prob::poisson_log");
       
@@ -36,7 +41,8 @@ namespace stan {
       using stan::error_handling::check_not_nan;
       using stan::error_handling::check_nonnegative;
       using stan::prob::include_summand;
-      using stan::math::value_of;
+      using stan::math::value_array;
+      using stan::math::VALUE_ARRAY_MAX_SIZE;
       
       // check if any vectors are zero length
       if (!(stan::length(n)
@@ -73,24 +79,30 @@ namespace stan {
       // return accumulator with gradients
       agrad::OperandsAndPartials<T_rate> operands_and_partials(lambda);
 
-      using stan::math::multiply_log;
-      for (size_t i = 0; i < size; i++) {
-        if (!(lambda_vec[i] == 0 && n_vec[i] == 0)) {
-          if (include_summand<propto>::value)
+      if (include_summand<propto>::value)
+        for (size_t i = 0; i < size; i++)
+          if (!(lambda_vec[i] == 0 && n_vec[i] == 0))
             logp -= lgamma(n_vec[i] + 1.0);
-          if (include_summand<propto,T_rate>::value)
-            logp += multiply_log(n_vec[i], value_of(lambda_vec[i])) 
-              - value_of(lambda_vec[i]);
-        }
-  
+
+      // blocks of the other terms at once, as array expressions; the
+      // terms with lambda == 0 (so n == 0) are zero
+      for (size_t start = 0; start < size; start += VALUE_ARRAY_MAX_SIZE) {
+        size_t block_size = std::min<size_t>(VALUE_ARRAY_MAX_SIZE,
+                                             size - start);
+        const array_t n_dbl
+          = value_array<T_partials_return>(n, start, block_size);
+        const array_t lambda_dbl
+          = value_array<T_partials_return>(lambda, start, block_size);
+
+        if (include_summand<propto,T_rate>::value)
+          logp += (lambda_dbl > 0)
+            .select(n_dbl * lambda_dbl.log() - lambda_dbl, 0.0).sum();
+
         // gradients
-        if (!is_constant_struct<T_rate>::value)
-          operands_and_partials.d_x1[i] 
-            += n_vec[i] / value_of(lambda_vec[i]) - 1.0;
-        
+        agrad::add_partials(operands_and_partials.d_x1, start,
+                            n_dbl / lambda_dbl - 1.0);
       }
 
-
       return operands_and_partials.to_var(logp,lambda);
     }
     
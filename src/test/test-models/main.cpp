@@ -0,0 +1,7 @@
+// Driver for test model executables; the generated model header is
+// passed on the command line with -include (see make/models).
+#include <stan/common/command.hpp>
+
+int main(int argc, const char* argv[]) {
+  return stan::common::command<stan_model>(argc, argv);
+}
@@ -1,5 +1,7 @@
 #include <stdexcept>
 #include <gtest/gtest.h>
+#include <stan/agrad/rev/matrix.hpp>
+#include <stan/agrad/fwd/matrix.hpp>
 #include <stan/agrad/autodiff.hpp>
 
 struct fun0 {
@@ -205,6 +207,81 @@ TEST(AgradAutodiff,hessian) {
   EXPECT_FLOAT_EQ(2 * 3, H2(1,1));
 
 }
+
+// fun3(x) = sum_i exp(x_i) * x_{i+1} + log_sum_exp(x)
+struct fun3 {
+  template <typename T>
+  inline
+  T operator()(const Eigen::Matrix<T,Eigen::Dynamic,1>& x) const {
+    using std::exp;
+    using stan::agrad::exp;
+    using stan::agrad::log_sum_exp;
+    T y = log_sum_exp(x);
+    for (int i = 0; i + 1 < x.size(); ++i)
+      y += exp(x(i)) * x(i + 1);
+    return y;
+  }
+};
+
+struct fun4 {
+  template <typename T>
+  inline
+  Eigen::Matrix<T,Eigen::Dynamic,1>
+  operator()(const Eigen::Matrix<T,Eigen::Dynamic,1>& x) const {
+    using std::sin;
+    using stan::agrad::sin;
+    Eigen::Matrix<T,Eigen::Dynamic,1> z(3);
+    z << x(0) * x(4), sin(x(1)) + x(2), x(3) / x(0);
+    return z;
+  }
+};
+
+template <int K>
+void expect_k_directions_match() {
+  using Eigen::Matrix;  using Eigen::Dynamic;
+  Matrix<double,Dynamic,1> x(5);
+  x << 0.5, -1.0, 0.25, 2.0, 1.5;
+
+  double fx, fx_k;
+  Matrix<double,Dynamic,1> grad, grad_k;
+  stan::agrad::gradient(fun3(),x,fx,grad);
+  stan::agrad::gradient<K>(fun3(),x,fx_k,grad_k);
+  EXPECT_FLOAT_EQ(fx, fx_k);
+  ASSERT_EQ(grad.size(), grad_k.size());
+  for (int i = 0; i < x.size(); ++i)
+    EXPECT_FLOAT_EQ(grad(i), grad_k(i));
+
+  Matrix<double,Dynamic,1> fx_vec, fx_vec_k;
+  Matrix<double,Dynamic,Dynamic> J, J_k;
+  stan::agrad::jacobian<double>(fun4(),x,fx_vec,J);
+  stan::agrad::jacobian<K>(fun4(),x,fx_vec_k,J_k);
+  ASSERT_EQ(fx_vec.size(), fx_vec_k.size());
+  for (int i = 0; i < fx_vec.size(); ++i)
+    EXPECT_FLOAT_EQ(fx_vec(i), fx_vec_k(i));
+  ASSERT_EQ(J.rows(), J_k.rows());
+  ASSERT_EQ(J.cols(), J_k.cols());
+  for (int i = 0; i < J.size(); ++i)
+    EXPECT_FLOAT_EQ(J(i), J_k(i));
+
+  Matrix<double,Dynamic,Dynamic> H, H_k;
+  stan::agrad::hessian(fun3(),x,fx,grad,H);
+  stan::agrad::hessian<K>(fun3(),x,fx_k,grad_k,H_k);
+  EXPECT_FLOAT_EQ(fx, fx_k);
+  for (int i = 0; i < x.size(); ++i)
+    EXPECT_FLOAT_EQ(grad(i), grad_k(i));
+  ASSERT_EQ(H.rows(), H_k.rows());
+  ASSERT_EQ(H.cols(), H_k.cols());
+  for (int i = 0; i < H.size(); ++i)
+    EXPECT_FLOAT_EQ(H(i), H_k(i));
+}
+
+TEST(AgradAutodiff,kDirections) {
+  expect_k_directions_match<1>();
+  expect_k_directions_match<2>();
+  expect_k_directions_match<4>();
+  expect_k_directions_match<5>();
+  expect_k_directions_match<8>();
+}
   
 TEST(AgradAutodiff,GradientTraceMatrixTimesHessian) {
   using Eigen::Matrix;
@@ -0,0 +1,23 @@
+#include <stan/agrad/fwd/functions/value_of_rec.hpp>
+#include <stan/agrad/rev/functions/value_of_rec.hpp>
+#include <test/unit/agrad/util.hpp>
+#include <gtest/gtest.h>
+#include <stan/math/functions/value_of_rec.hpp>
+
+TEST(AgradFwd,value_of_rec) {
+  using stan::agrad::fvar;
+  using stan::agrad::var;
+  using stan::math::value_of_rec;
+  using stan::agrad::value_of_rec;
+
+  fvar<double> a = 5.0;
+  EXPECT_FLOAT_EQ(5.0, value_of_rec(a));
+
+  fvar<fvar<double> > b = 4.0;
+  EXPECT_FLOAT_EQ(4.0, value_of_rec(b));
+
+  fvar<var> c = 3.0;
+  fvar<fvar<var> > d = 2.0;
+  EXPECT_FLOAT_EQ(3.0, value_of_rec(c));
+  EXPECT_FLOAT_EQ(2.0, value_of_rec(d));
+}
@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+#include <stan/agrad/fwd.hpp>
+#include <stan/agrad/fwd/matrix.hpp>
+#include <stan/agrad/fwd/fvar_k.hpp>
+#include <stan/agrad/fwd/fvar_k_functions.hpp>
+#include <stan/agrad/fwd/fvar_k_matrix.hpp>
+#include <stan/agrad/rev.hpp>
+#include <stan/math/matrix/softmax.hpp>
+
+using stan::agrad::fvar;
+using stan::agrad::fvar_k;
+
+typedef fvar_k<double,3> fvk;
+
+// Returns an fvar_k with the value and tangents d0, d1, d2.
+fvk make_fvk(double val, double d0, double d1, double d2) {
+  fvk x(val);
+  x.d_[0] = d0;
+  x.d_[1] = d1;
+  x.d_[2] = d2;
+  return x;
+}
+
+// Returns the fvar carrying tangent k of x.
+fvar<double> slice(const fvk& x, int k) {
+  return fvar<double>(x.val_, x.d_[k]);
+}
+
+void expect_slice(const fvar<double>& expected, const fvk& y, int k) {
+  EXPECT_FLOAT_EQ(expected.val_, y.val_);
+  EXPECT_FLOAT_EQ(expected.d_, y.d_[k]) << "tangent " << k;
+}
+
+const fvk x1 = make_fvk(0.4, 1.0, -0.5, 2.0);
+const fvk x2 = make_fvk(1.3, 0.0, 1.5, -1.0);
+const fvk x3 = make_fvk(-0.7, 0.3, 0.0, 1.0);
+
+#define EXPECT_UNARY_MATCHES_FVAR(F, X)                         \
+  for (int k = 0; k < 3; ++k)                                   \
+    expect_slice(F(slice(X, k)), F(X), k);
+
+#define EXPECT_BINARY_MATCHES_FVAR(F, X1, X2)                   \
+  for (int k = 0; k < 3; ++k) {                                 \
+    expect_slice(F(slice(X1, k), slice(X2, k)), F(X1, X2), k);  \
+    expect_slice(F(slice(X1, k), X2.val_), F(X1, X2.val_), k);  \
+    expect_slice(F(X1.val_, slice(X2, k)), F(X1.val_, X2), k);  \
+  }
+
+TEST(AgradFwdFvarK, construction) {
+  fvk a;
+  EXPECT_FLOAT_EQ(0.0, a.val_);
+  for (int k = 0; k < 3; ++k)
+    EXPECT_FLOAT_EQ(0.0, a.d_[k]);
+
+  fvk b(1.9);
+  EXPECT_FLOAT_EQ(1.9, b.val());
+  for (int k = 0; k < 3; ++k)
+    EXPECT_FLOAT_EQ(0.0, b.tangent(k));
+
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  fvk c(nan);
+  EXPECT_TRUE(boost::math::isnan(c.val_));
+  for (int k = 0; k < 3; ++k)
+    EXPECT_TRUE(boost::math::isnan(c.d_[k]));
+}
+
+TEST(AgradFwdFvarK, operators) {
+  for (int k = 0; k < 3; ++k) {
+    fvar<double> a = slice(x1, k);
+    fvar<double> b = slice(x2, k);
+    expect_slice(a + b, x1 + x2, k);
+    expect_slice(a + 2.0, x1 + 2.0, k);
+    expect_slice(2.0 + a, 2.0 + x1, k);
+    expect_slice(a - b, x1 - x2, k);
+    expect_slice(a - 2.0, x1 - 2.0, k);
+    expect_slice(2.0 - a, 2.0 - x1, k);
+    expect_slice(-a, -x1, k);
+    expect_slice(a * b, x1 * x2, k);
+    expect_slice(a * 2.0, x1 * 2.0, k);
+    expect_slice(2.0 * a, 2.0 * x1, k);
+    expect_slice(a / b, x1 / x2, k);
+    expect_slice(a / 2.0, x1 / 2.0, k);
+    expect_slice(2.0 / a, 2.0 / x1, k);
+  }
+  fvk y = x1;
+  EXPECT_FLOAT_EQ(0.4, (y++).val_);
+  EXPECT_FLOAT_EQ(2.4, (++y).val_);
+  EXPECT_FLOAT_EQ(-0.5, y.d_[1]);
+
+  EXPECT_TRUE(x1 < x2);
+  EXPECT_TRUE(x1 <= 0.4);
+  EXPECT_TRUE(0.4 >= x1);
+  EXPECT_TRUE(x2 > x3);
+  EXPECT_TRUE(x1 == x1);
+  EXPECT_TRUE(x1 != x2);
+}
+
+TEST(AgradFwdFvarK, unaryFunctions) {
+  using stan::agrad::Phi;
+  EXPECT_UNARY_MATCHES_FVAR(exp, x1);
+  EXPECT_UNARY_MATCHES_FVAR(log, x1);
+  EXPECT_UNARY_MATCHES_FVAR(sqrt, x1);
+  EXPECT_UNARY_MATCHES_FVAR(square, x3);
+  EXPECT_UNARY_MATCHES_FVAR(sin, x3);
+  EXPECT_UNARY_MATCHES_FVAR(tanh, x3);
+  EXPECT_UNARY_MATCHES_FVAR(lgamma, x2);
+  EXPECT_UNARY_MATCHES_FVAR(digamma, x2);
+  EXPECT_UNARY_MATCHES_FVAR(inv_logit, x3);
+  EXPECT_UNARY_MATCHES_FVAR(log1p_exp, x3);
+  EXPECT_UNARY_MATCHES_FVAR(log1m, x1);
+  EXPECT_UNARY_MATCHES_FVAR(Phi, x3);
+  EXPECT_UNARY_MATCHES_FVAR(fabs, x3);
+
+  for (int k = 0; k < 3; ++k) {
+    expect_slice(lmgamma(3, slice(x2, k)), lmgamma(3, x2), k);
+    expect_slice(bessel_first_kind(1, slice(x2, k)),
+                 bessel_first_kind(1, x2), k);
+  }
+}
+
+TEST(AgradFwdFvarK, binaryFunctions) {
+  EXPECT_BINARY_MATCHES_FVAR(pow, x1, x2);
+  EXPECT_BINARY_MATCHES_FVAR(atan2, x3, x2);
+  EXPECT_BINARY_MATCHES_FVAR(hypot, x1, x3);
+  EXPECT_BINARY_MATCHES_FVAR(log_sum_exp, x1, x3);
+  EXPECT_BINARY_MATCHES_FVAR(lbeta, x1, x2);
+  EXPECT_BINARY_MATCHES_FVAR(multiply_log, x1, x2);
+  EXPECT_BINARY_MATCHES_FVAR(fmax, x1, x2);
+}
+
+TEST(AgradFwdFvarK, ternaryFunctions) {
+  for (int k = 0; k < 3; ++k) {
+    fvar<double> a = slice(x1, k);
+    fvar<double> b = slice(x2, k);
+    fvar<double> c = slice(x3, k);
+    expect_slice(fma(a, b, c), fma(x1, x2, x3), k);
+    expect_slice(fma(a, 1.3, c), fma(x1, 1.3, x3), k);
+    expect_slice(fma(0.4, 1.3, c), fma(0.4, 1.3, x3), k);
+    expect_slice(log_mix(a, b, c), log_mix(x1, x2, x3), k);
+    expect_slice(log_mix(0.4, b, -0.7), log_mix(0.4, x2, -0.7), k);
+  }
+}
+
+TEST(AgradFwdFvarK, classification) {
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  double inf = std::numeric_limits<double>::infinity();
+  EXPECT_TRUE(stan::agrad::is_nan(fvk(nan)));
+  EXPECT_FALSE(stan::agrad::is_nan(x1));
+  EXPECT_TRUE(stan::agrad::is_inf(fvk(inf)));
+  EXPECT_FALSE(stan::agrad::is_inf(x1));
+  EXPECT_FLOAT_EQ(0.4, stan::agrad::value_of(x1));
+  EXPECT_FLOAT_EQ(0.4, stan::agrad::value_of_rec(x1));
+}
+
+TEST(AgradFwdFvarK, matrixFunctions) {
+  using Eigen::Matrix;
+  using Eigen::Dynamic;
+  Matrix<fvk,Dynamic,1> v(3);
+  v << x1, x2, x3;
+  Matrix<fvk,Dynamic,Dynamic> m(2,3);
+  m << x1, x2, x3, x3, x1, x2;
+  Eigen::VectorXd w(3);
+  w << 2.0, -1.0, 0.5;
+
+  for (int k = 0; k < 3; ++k) {
+    Matrix<fvar<double>,Dynamic,1> v_k(3);
+    Matrix<fvar<double>,Dynamic,Dynamic> m_k(2,3);
+    for (int i = 0; i < 3; ++i)
+      v_k(i) = slice(v(i), k);
+    for (int i = 0; i < 6; ++i)
+      m_k(i) = slice(m(i), k);
+
+    expect_slice(stan::agrad::dot_product(v_k, v_k),
+                 stan::agrad::dot_product(v, v), k);
+    expect_slice(stan::agrad::dot_product(v_k, w),
+                 stan::agrad::dot_product(v, w), k);
+    expect_slice(stan::agrad::dot_product(w, v_k),
+                 stan::agrad::dot_product(w, v), k);
+    expect_slice(stan::agrad::dot_self(v_k),
+                 stan::agrad::dot_self(v), k);
+    expect_slice(stan::agrad::sum(m_k), stan::agrad::sum(m), k);
+    expect_slice(stan::agrad::log_sum_exp(v_k),
+                 stan::agrad::log_sum_exp(v), k);
+
+    Matrix<fvar<double>,Dynamic,1> mv_k = stan::agrad::multiply(m_k, v_k);
+    Matrix<fvk,Dynamic,1> mv = stan::agrad::multiply(m, v);
+    Matrix<fvar<double>,Dynamic,1> mw_k = stan::agrad::multiply(m_k, w);
+    Matrix<fvk,Dynamic,1> mw = stan::agrad::multiply(m, w);
+    for (int i = 0; i < 2; ++i) {
+      expect_slice(mv_k(i), mv(i), k);
+      expect_slice(mw_k(i), mw(i), k);
+    }
+
+    Matrix<fvar<double>,Dynamic,1> sm_k = stan::math::softmax(v_k);
+    Matrix<fvk,Dynamic,1> sm = stan::math::softmax(v);
+    for (int i = 0; i < 3; ++i)
+      expect_slice(sm_k(i), sm(i), k);
+  }
+}
+
+TEST(AgradFwdFvarK, fvarKVar) {
+  using stan::agrad::var;
+  fvar_k<var,2> x(var(0.5));
+  x.d_[0] = 1.0;
+  x.d_[1] = 2.0;
+  fvar_k<var,2> y = exp(x) * x;
+  EXPECT_FLOAT_EQ(0.5 * std::exp(0.5), y.val_.val());
+  double dy = std::exp(0.5) * 1.5;
+  EXPECT_FLOAT_EQ(dy, y.d_[0].val());
+  EXPECT_FLOAT_EQ(2 * dy, y.d_[1].val());
+
+  std::vector<var> xs(1, x.val_);
+  std::vector<double> g;
+  y.d_[1].grad(xs, g);
+  EXPECT_FLOAT_EQ(2 * std::exp(0.5) * 2.5, g[0]);
+  stan::agrad::recover_memory();
+}
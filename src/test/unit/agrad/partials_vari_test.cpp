@@ -1,6 +1,15 @@
 #include <stan/agrad/partials_vari.hpp>
 #include <gtest/gtest.h>
 #include <stan/agrad/rev.hpp>
+#include <stan/agrad/fwd/fvar_k.hpp>
+#include <stan/prob/distributions/univariate/continuous/gamma.hpp>
+#include <stan/prob/distributions/univariate/continuous/normal.hpp>
+#include <stan/prob/distributions/univariate/continuous/student_t.hpp>
+#include <stan/prob/distributions/univariate/discrete/bernoulli.hpp>
+#include <stan/prob/distributions/univariate/discrete/poisson.hpp>
+#include <boost/random/additive_combine.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <ctime>
 
 
 
@@ -186,6 +195,27 @@ TEST(AgradPartialsVari, OperandsAndPartialsFvarVec) {
   EXPECT_FLOAT_EQ(2*17 + 3*13 - 2*19 + 2*4*23,y.d_);
   EXPECT_FLOAT_EQ(-1,y.val_);
 }
+TEST(AgradPartialsVari, OperandsAndPartialsFvarK) {
+  using stan::agrad::OperandsAndPartials;
+  using stan::agrad::fvar_k;
+
+  std::vector<fvar_k<double,2> > x1(2, fvar_k<double,2>(2.0));
+  x1[0].d_[0] = 2.0;
+  x1[1].d_[1] = 3.0;
+  fvar_k<double,2> x2 = 3.0;
+  x2.d_[0] = -1.0;
+  x2.d_[1] = 4.0;
+
+  OperandsAndPartials<std::vector<fvar_k<double,2> >,fvar_k<double,2> > o(x1, x2);
+  o.d_x1[0] += 17.0; 
+  o.d_x1[1] += 13.0; 
+  o.d_x2[0] += 19.0;  
+  fvar_k<double,2> y = o.to_var(-1.0,x1,x2);
+
+  EXPECT_FLOAT_EQ(2*17 - 19,y.d_[0]);
+  EXPECT_FLOAT_EQ(3*13 + 4*19,y.d_[1]);
+  EXPECT_FLOAT_EQ(-1,y.val_);
+}
 
 TEST(AgradPartialsVari, incr_deriv_double) {
   using stan::VectorView;
@@ -200,11 +230,12 @@ TEST(AgradPartialsVari, incr_deriv_double) {
 
 
   
-  double result = incr_deriv<VectorView<const double,
-                                           is_vector<double>::value,
-                                           is_constant_struct<double>::value>,
-                             double,double>().incr(d_a,a);
-  EXPECT_FLOAT_EQ(0, result);
+  stan::agrad::fvar<double> result(0.0);
+  incr_deriv<VectorView<const double,
+                        is_vector<double>::value,
+                        is_constant_struct<double>::value>,
+             double,stan::agrad::fvar<double> >().incr(result,d_a,a);
+  EXPECT_FLOAT_EQ(0, result.d_);
 }
 
 TEST(AgradPartialsVari, incr_deriv_vec_double) {
@@ -222,12 +253,13 @@ TEST(AgradPartialsVari, incr_deriv_vec_double) {
              stan::is_constant_struct<std::vector<double> >::value> 
     d_b(stan::length(b) * 0);
 
-  double result = incr_deriv<VectorView<const std::vector<double>,
-                                        is_vector<std::vector<double> >::value,
-                                        is_constant_struct<std::vector<double> >::value>,
-                             std::vector<double>,double>().incr(d_b,b);
+  stan::agrad::fvar<double> result(0.0);
+  incr_deriv<VectorView<const std::vector<double>,
+                        is_vector<std::vector<double> >::value,
+                        is_constant_struct<std::vector<double> >::value>,
+             std::vector<double>,stan::agrad::fvar<double> >().incr(result,d_b,b);
 
-  EXPECT_FLOAT_EQ(0, result);
+  EXPECT_FLOAT_EQ(0, result.d_);
 }
 
 
@@ -248,12 +280,13 @@ TEST(AgradPartialsVari, incr_deriv_fvar) {
              stan::is_constant_struct<fvar<double> >::value>
     d_c(c_deriv);
 
-  double result2 = incr_deriv<VectorView<const double,
-                                         is_vector<fvar<double> >::value,
-                                         is_constant_struct<fvar<double> >::value>,
-                              fvar<double>,double>().incr(d_c,c);
+  fvar<double> result2(0.0);
+  incr_deriv<VectorView<const double,
+                        is_vector<fvar<double> >::value,
+                        is_constant_struct<fvar<double> >::value>,
+             fvar<double>,fvar<double> >().incr(result2,d_c,c);
 
-  EXPECT_FLOAT_EQ(2, result2);
+  EXPECT_FLOAT_EQ(2, result2.d_);
 }
 
 TEST(AgradPartialsVari, incr_deriv_vec_fvar) {
@@ -278,10 +311,235 @@ TEST(AgradPartialsVari, incr_deriv_vec_fvar) {
              stan::is_constant_struct<std::vector<fvar<double> > >::value>
     d_d(d_deriv);
 
-  double result3 = incr_deriv<VectorView<const double,
-                                         is_vector<std::vector<fvar<double> > >::value,
-                                         is_constant_struct<std::vector<fvar<double> > >::value>,
-                              std::vector<fvar<double> >,double>().incr(d_d,d);
+  fvar<double> result3(0.0);
+  incr_deriv<VectorView<const double,
+                        is_vector<std::vector<fvar<double> > >::value,
+                        is_constant_struct<std::vector<fvar<double> > >::value>,
+             std::vector<fvar<double> >,fvar<double> >().incr(result3,d_d,d);
+
+  EXPECT_FLOAT_EQ(7, result3.d_);
+}
+
+TEST(AgradPartialsVari, add_partials) {
+  using stan::agrad::OperandsAndPartials;
+  using stan::agrad::add_partials;
+  using stan::agrad::var;
+
+  std::vector<var> v_vec;
+  v_vec.push_back(1.0);
+  v_vec.push_back(2.0);
+  v_vec.push_back(3.0);
+  var s = 4.0;
+  std::vector<double> d_vec(3, 5.0);
+
+  OperandsAndPartials<std::vector<var>,var,std::vector<double> >
+    o(v_vec, s, d_vec);
+  EXPECT_EQ(0U, reinterpret_cast<size_t>(o.all_partials) % 16);
+
+  Eigen::ArrayXd x(3);
+  x << 10, 20, 30;
+  add_partials(o.d_x1, 0, x);
+  add_partials(o.d_x1, 1, 2 * x.head(2));
+  add_partials(o.d_x2, 0, x);
+  add_partials(o.d_x3, 0, x);  // constant, ignored
+  EXPECT_FLOAT_EQ(10, o.d_x1[0]);
+  EXPECT_FLOAT_EQ(40, o.d_x1[1]);
+  EXPECT_FLOAT_EQ(70, o.d_x1[2]);
+  EXPECT_FLOAT_EQ(60, o.d_x2[0]);
+
+  var y = o.to_var(1.0, v_vec, s, d_vec);
+  stan::agrad::grad(y.vi_);
+  EXPECT_FLOAT_EQ(10, v_vec[0].adj());
+  EXPECT_FLOAT_EQ(40, v_vec[1].adj());
+  EXPECT_FLOAT_EQ(70, v_vec[2].adj());
+  EXPECT_FLOAT_EQ(60, s.adj());
+  stan::agrad::recover_memory();
+}
+
+namespace {
+  // normal_log as it was written before the densities used
+  // add_partials, one observation at a time
+  template <typename T_y, typename T_loc, typename T_scale>
+  stan::agrad::var
+  normal_log_scalar_loop(const T_y& y, const T_loc& mu,
+                         const T_scale& sigma) {
+    using stan::math::value_of;
+    stan::agrad::OperandsAndPartials<T_y, T_loc, T_scale>
+      operands_and_partials(y, mu, sigma);
+    stan::VectorView<const T_y> y_vec(y);
+    stan::VectorView<const T_loc> mu_vec(mu);
+    stan::VectorView<const T_scale> sigma_vec(sigma);
+    size_t N = stan::max_size(y, mu, sigma);
+    double logp = 0;
+    for (size_t n = 0; n < N; n++) {
+      double inv_sigma = 1.0 / value_of(sigma_vec[n]);
+      double y_scaled = (value_of(y_vec[n]) - value_of(mu_vec[n])) * inv_sigma;
+      logp += stan::prob::NEG_LOG_SQRT_TWO_PI - std::log(value_of(sigma_vec[n]))
+        - 0.5 * y_scaled * y_scaled;
+      double scaled_diff = inv_sigma * y_scaled;
+      operands_and_partials.d_x2[n] += scaled_diff;
+      operands_and_partials.d_x3[n]
+        += -inv_sigma + inv_sigma * y_scaled * y_scaled;
+    }
+    return operands_and_partials.to_var(logp, y, mu, sigma);
+  }
+}
+
+TEST(AgradPartialsVari, add_partials_performance) {
+  using stan::agrad::var;
+
+  int N = 1000000;
+  boost::ecuyer1988 rng(1234);
+  boost::random::normal_distribution<double> normal;
+  std::vector<double> y(N);
+  for (int n = 0; n < N; n++)
+    y[n] = normal(rng);
+
+  std::vector<var> mu(N);
+  for (int n = 0; n < N; n++)
+    mu[n] = 0.1 * n / N;
+  var sigma = 1.5;
+  clock_t start = clock();
+  var lp_loop = normal_log_scalar_loop(y, mu, sigma);
+  stan::agrad::grad(lp_loop.vi_);
+  double t_loop = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+  std::vector<double> grad_loop(N);
+  for (int n = 0; n < N; n++)
+    grad_loop[n] = mu[n].adj();
+  double sigma_adj_loop = sigma.adj();
+  stan::agrad::recover_memory();
+
+  for (int n = 0; n < N; n++)
+    mu[n] = 0.1 * n / N;
+  sigma = 1.5;
+  start = clock();
+  var lp = stan::prob::normal_log(y, mu, sigma);
+  stan::agrad::grad(lp.vi_);
+  double t_array = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+
+  std::cout << "normal_log of " << N << " observations with gradient: "
+            << "scalar loop " << t_loop << " s, array expressions "
+            << t_array << " s" << std::endl;
+
+  EXPECT_NEAR(lp_loop.val(), lp.val(), 1e-10 * std::fabs(lp.val()));
+  for (int n = 0; n < N; n++)
+    EXPECT_NEAR(grad_loop[n], mu[n].adj(), 1e-12);
+  EXPECT_NEAR(sigma_adj_loop, sigma.adj(), 1e-10 * std::fabs(sigma.adj()));
+  stan::agrad::recover_memory();
+}
+
+namespace {
+  // checks that a density of vectors longer than one block of
+  // value_array() equals the sum of the densities of the elements
+  template <typename F>
+  void expect_blocks_match_elements(const F& f) {
+    using stan::agrad::var;
+    size_t N = 2 * stan::math::VALUE_ARRAY_MAX_SIZE + 7;
+    std::vector<var> theta(N);
+    var phi = 1.25;
+    for (size_t n = 0; n < N; n++)
+      theta[n] = 0.5 + 0.01 * n;
+    var lp = f(0, theta, phi);
+    stan::agrad::grad(lp.vi_);
+    std::vector<double> theta_adj(N);
+    for (size_t n = 0; n < N; n++)
+      theta_adj[n] = theta[n].adj();
+    double phi_adj = phi.adj();
+    stan::agrad::set_zero_all_adjoints();
+
+    var lp_sum = 0;
+    for (size_t n = 0; n < N; n++) {
+      std::vector<var> theta_n(1, theta[n]);
+      lp_sum += f(n, theta_n, phi);
+    }
+    stan::agrad::grad(lp_sum.vi_);
+    EXPECT_FLOAT_EQ(lp_sum.val(), lp.val());
+    for (size_t n = 0; n < N; n++)
+      EXPECT_FLOAT_EQ(theta[n].adj(), theta_adj[n]);
+    EXPECT_FLOAT_EQ(phi.adj(), phi_adj);
+    stan::agrad::recover_memory();
+  }
+
+  // the first argument is the index of the first element of theta
+  // in the whole vector
+  struct normal_f {
+    stan::agrad::var operator()(size_t n, const std::vector<stan::agrad::var>& theta,
+                                const stan::agrad::var& phi) const {
+      std::vector<double> y(theta.size());
+      for (size_t i = 0; i < y.size(); i++)
+        y[i] = std::sin(n + i);
+      return stan::prob::normal_log(y, theta, phi);
+    }
+  };
+  struct student_t_f {
+    stan::agrad::var operator()(size_t n, const std::vector<stan::agrad::var>& theta,
+                                const stan::agrad::var& phi) const {
+      std::vector<double> y(theta.size());
+      for (size_t i = 0; i < y.size(); i++)
+        y[i] = std::sin(n + i);
+      return stan::prob::student_t_log(y, theta, 0.5, phi);
+    }
+  };
+  struct gamma_f {
+    stan::agrad::var operator()(size_t n, const std::vector<stan::agrad::var>& theta,
+                                const stan::agrad::var& phi) const {
+      std::vector<double> y(theta.size());
+      for (size_t i = 0; i < y.size(); i++)
+        y[i] = 1.5 + std::sin(n + i);
+      return stan::prob::gamma_log(y, theta, phi);
+    }
+  };
+  struct poisson_f {
+    stan::agrad::var operator()(size_t n, const std::vector<stan::agrad::var>& theta,
+                                const stan::agrad::var& phi) const {
+      std::vector<int> k(theta.size());
+      for (size_t i = 0; i < k.size(); i++)
+        k[i] = (n + i) % 5;
+      return stan::prob::poisson_log(k, theta);
+    }
+  };
+  struct bernoulli_logit_f {
+    stan::agrad::var operator()(size_t n, const std::vector<stan::agrad::var>& theta,
+                                const stan::agrad::var& phi) const {
+      std::vector<int> k(theta.size());
+      for (size_t i = 0; i < k.size(); i++)
+        k[i] = (n + i) % 2;
+      return stan::prob::bernoulli_logit_log(k, theta);
+    }
+  };
+}
+
+TEST(AgradPartialsVari, add_partials_blocks) {
+  expect_blocks_match_elements(normal_f());
+  expect_blocks_match_elements(student_t_f());
+  expect_blocks_match_elements(gamma_f());
+  expect_blocks_match_elements(poisson_f());
+  expect_blocks_match_elements(bernoulli_logit_f());
+}
+
+TEST(AgradPartialsVari, chain_blocks) {
+  using stan::agrad::var;
+  using stan::agrad::vari;
+  using stan::agrad::partials_vari;
 
-  EXPECT_FLOAT_EQ(7, result3);
+  // more operands than one block, with x repeated throughout
+  size_t N = 600;
+  var x = 2.0;
+  std::vector<var> y(N / 2);
+  std::vector<vari*> operands(N);
+  std::vector<double> partials(N);
+  for (size_t n = 0; n < N / 2; ++n) {
+    y[n] = n;
+    operands[2 * n] = x.vi_;
+    operands[2 * n + 1] = y[n].vi_;
+    partials[2 * n] = 1;
+    partials[2 * n + 1] = n;
+  }
+  var f(new partials_vari(0, N, &operands[0], &partials[0]));
+  stan::agrad::grad(f.vi_);
+
+  EXPECT_FLOAT_EQ(N / 2, x.adj());
+  for (size_t n = 0; n < N / 2; ++n)
+    EXPECT_FLOAT_EQ(n, y[n].adj());
+  stan::agrad::recover_memory();
 }
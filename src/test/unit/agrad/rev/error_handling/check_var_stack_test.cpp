@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <stan/error_handling/matrix.hpp>
+#include <stan/error_handling/scalar.hpp>
+#include <stan/agrad/fwd.hpp>
+#include <stan/agrad/rev.hpp>
+
+using stan::agrad::var;
+using stan::agrad::fvar;
+using stan::agrad::ChainableStack;
+using Eigen::Dynamic;
+using Eigen::Matrix;
+
+// the checks are done on values, so neither passing nor failing a
+// check may leave anything on the stack
+class AgradRevErrorHandlingStack : public testing::Test {
+public:
+  void SetUp() {
+    stack_size = ChainableStack::var_stack_.size();
+  }
+
+  void TearDown() {
+    EXPECT_EQ(stack_size, ChainableStack::var_stack_.size());
+    stan::agrad::recover_memory();
+  }
+
+  size_t stack_size;
+};
+
+TEST_F(AgradRevErrorHandlingStack, check_finite) {
+  var x = 1.5;
+  std::vector<var> xs(3, x);
+  stack_size = ChainableStack::var_stack_.size();
+
+  EXPECT_TRUE(stan::error_handling::check_finite("check_finite", "x", x));
+  EXPECT_TRUE(stan::error_handling::check_finite("check_finite", "xs", xs));
+}
+
+TEST_F(AgradRevErrorHandlingStack, check_not_nan) {
+  var x = 1.5;
+  std::vector<var> xs(3, x);
+  stack_size = ChainableStack::var_stack_.size();
+
+  EXPECT_TRUE(stan::error_handling::check_not_nan("check_not_nan", "x", x));
+  EXPECT_TRUE(stan::error_handling::check_not_nan("check_not_nan", "xs", xs));
+}
+
+TEST_F(AgradRevErrorHandlingStack, check_symmetric) {
+  Matrix<var,Dynamic,Dynamic> y(3,3);
+  y << 2, 1, 0.5,
+    1, 3, 0.2,
+    0.5, 0.2, 4;
+  Matrix<var,Dynamic,Dynamic> z = y;
+  z(0,1) = 3.5;
+  stack_size = ChainableStack::var_stack_.size();
+
+  EXPECT_TRUE(stan::error_handling::check_symmetric("check_symmetric", "y", y));
+  EXPECT_THROW(stan::error_handling::check_symmetric("check_symmetric", "z", z),
+               std::domain_error);
+}
+
+TEST_F(AgradRevErrorHandlingStack, check_pos_definite) {
+  Matrix<var,Dynamic,Dynamic> y(3,3);
+  y << 2, 1, 0.5,
+    1, 3, 0.2,
+    0.5, 0.2, 4;
+  Matrix<var,Dynamic,Dynamic> z = y;
+  z(0,0) = -2;
+  stack_size = ChainableStack::var_stack_.size();
+
+  EXPECT_TRUE(stan::error_handling::check_pos_definite("check_pos_definite",
+                                                       "y", y));
+  EXPECT_TRUE(stan::error_handling::check_cov_matrix("check_cov_matrix",
+                                                     "y", y));
+  EXPECT_THROW(stan::error_handling::check_pos_definite("check_pos_definite",
+                                                        "z", z),
+               std::domain_error);
+  EXPECT_THROW(stan::error_handling::check_cov_matrix("check_cov_matrix",
+                                                      "z", z),
+               std::domain_error);
+}
+
+TEST_F(AgradRevErrorHandlingStack, check_pos_definite_fvar_var) {
+  Matrix<fvar<var>,Dynamic,Dynamic> y(2,2);
+  y << 2, 1,
+    1, 3;
+  stack_size = ChainableStack::var_stack_.size();
+
+  EXPECT_TRUE(stan::error_handling::check_pos_definite("check_pos_definite",
+                                                       "y", y));
+}
+
+TEST_F(AgradRevErrorHandlingStack, check_pos_semidefinite) {
+  Matrix<var,Dynamic,Dynamic> y(3,3);
+  y << 2, 1, 0.5,
+    1, 3, 0.2,
+    0.5, 0.2, 4;
+  Matrix<var,Dynamic,Dynamic> z = y;
+  z(0,0) = -2;
+  stack_size = ChainableStack::var_stack_.size();
+
+  EXPECT_TRUE(stan::error_handling::check_pos_semidefinite("check_pos_semidefinite",
+                                                           "y", y));
+  EXPECT_TRUE(stan::error_handling::check_spsd_matrix("check_spsd_matrix",
+                                                      "y", y));
+  EXPECT_THROW(stan::error_handling::check_pos_semidefinite("check_pos_semidefinite",
+                                                            "z", z),
+               std::domain_error);
+  EXPECT_THROW(stan::error_handling::check_spsd_matrix("check_spsd_matrix",
+                                                       "z", z),
+               std::domain_error);
+}
+
+TEST_F(AgradRevErrorHandlingStack, check_corr_matrix) {
+  Matrix<var,Dynamic,Dynamic> y(3,3);
+  y << 1, 0.5, 0.2,
+    0.5, 1, 0.1,
+    0.2, 0.1, 1;
+  Matrix<var,Dynamic,Dynamic> z = y;
+  z(1,1) = 2;
+  stack_size = ChainableStack::var_stack_.size();
+
+  EXPECT_TRUE(stan::error_handling::check_corr_matrix("check_corr_matrix",
+                                                      "y", y));
+  EXPECT_THROW(stan::error_handling::check_corr_matrix("check_corr_matrix",
+                                                       "z", z),
+               std::domain_error);
+}
+
+TEST_F(AgradRevErrorHandlingStack, check_cholesky_factor_corr) {
+  Matrix<var,Dynamic,Dynamic> y(2,2);
+  y << 1, 0,
+    0.6, 0.8;
+  Matrix<var,Dynamic,Dynamic> z = y;
+  z(1,0) = 0.5;
+  stack_size = ChainableStack::var_stack_.size();
+
+  EXPECT_TRUE(stan::error_handling::check_cholesky_factor_corr("check_cholesky_factor_corr",
+                                                               "y", y));
+  EXPECT_THROW(stan::error_handling::check_cholesky_factor_corr("check_cholesky_factor_corr",
+                                                                "z", z),
+               std::domain_error);
+}
+
+TEST_F(AgradRevErrorHandlingStack, check_simplex) {
+  Matrix<var,Dynamic,1> y(3);
+  y << 0.5, 0.3, 0.2;
+  Matrix<var,Dynamic,1> z = y;
+  z(0) = 0.6;
+  stack_size = ChainableStack::var_stack_.size();
+
+  EXPECT_TRUE(stan::error_handling::check_simplex("check_simplex", "y", y));
+  EXPECT_THROW(stan::error_handling::check_simplex("check_simplex", "z", z),
+               std::domain_error);
+}
+
+TEST_F(AgradRevErrorHandlingStack, check_unit_vector) {
+  Matrix<var,Dynamic,1> y(2);
+  y << 0.6, 0.8;
+  Matrix<var,Dynamic,1> z = y;
+  z(0) = 0.5;
+  stack_size = ChainableStack::var_stack_.size();
+
+  EXPECT_TRUE(stan::error_handling::check_unit_vector("check_unit_vector",
+                                                      "y", y));
+  EXPECT_THROW(stan::error_handling::check_unit_vector("check_unit_vector",
+                                                       "z", z),
+               std::domain_error);
+}
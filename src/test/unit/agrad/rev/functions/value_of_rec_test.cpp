@@ -0,0 +1,17 @@
+#include <stan/agrad/rev/functions/value_of_rec.hpp>
+#include <stan/math/functions/value_of_rec.hpp>
+#include <test/unit/agrad/util.hpp>
+#include <gtest/gtest.h>
+
+TEST(AgradRev,value_of_rec) {
+  using stan::agrad::var;
+  using stan::math::value_of_rec;
+  using stan::agrad::value_of_rec;
+
+  var a = 5.0;
+  size_t stack_size = stan::agrad::ChainableStack::var_stack_.size();
+  EXPECT_FLOAT_EQ(5.0, value_of_rec(a));
+  EXPECT_FLOAT_EQ(5.0, value_of_rec(5.0)); // make sure all work together
+  EXPECT_FLOAT_EQ(5.0, value_of_rec(5));
+  EXPECT_EQ(stack_size, stan::agrad::ChainableStack::var_stack_.size());
+}
@@ -133,3 +133,49 @@ TEST(AgradRevMathMatrix,accumulateCollection) {
 
 
 
+TEST(AgradRevMatrix,accumulateSingleNode) {
+  using stan::math::accumulator;
+  using stan::agrad::var;
+
+  std::vector<var> x;
+  for (int i = 0; i < 100; ++i)
+    x.push_back(0.5 * i);
+
+  size_t stack_size = stan::agrad::ChainableStack::var_stack_.size();
+  accumulator<var> a;
+  for (int i = 0; i < 100; ++i) {
+    a.add(x[i] * x[i]);
+    a.add(2.0);
+  }
+  var lp = a.sum();
+  // one node per product and one for the sum
+  EXPECT_EQ(stack_size + 101, stan::agrad::ChainableStack::var_stack_.size());
+
+  double expected = 200.0;
+  for (int i = 0; i < 100; ++i)
+    expected += 0.25 * i * i;
+  EXPECT_FLOAT_EQ(expected, lp.val());
+
+  std::vector<double> g;
+  lp.grad(x, g);
+  for (int i = 0; i < 100; ++i)
+    EXPECT_FLOAT_EQ(2 * 0.5 * i, g[i]);
+  stan::agrad::recover_memory();
+}
+
+TEST(AgradRevMatrix,accumulateConstantsOnly) {
+  using stan::math::accumulator;
+  using stan::agrad::var;
+
+  accumulator<var> a;
+  a.add(1.5);
+  a.add(2);
+  var lp = a.sum();
+  EXPECT_FLOAT_EQ(3.5, lp.val());
+
+  var y = 4.0;
+  accumulator<var> b;
+  b.add(y);
+  EXPECT_EQ(y.vi_, b.sum().vi_);
+  stan::agrad::recover_memory();
+}
@@ -7,6 +7,9 @@
 #include <stan/agrad/rev/operators.hpp>
 #include <stan/agrad/rev/functions/sqrt.hpp>
 #include <stan/agrad/rev/functions/fabs.hpp>
+#include <cmath>
+#include <ctime>
+#include <iostream>
 
 TEST(AgradRevMatrix,mat_cholesky) {
   using stan::agrad::matrix_v;
@@ -34,3 +37,103 @@ TEST(AgradRevMatrix,mat_cholesky) {
   EXPECT_NO_THROW(singular_values(X));
 }
 
+
+// a symmetric positive-definite N x N matrix
+stan::math::matrix_d spd_matrix(int N) {
+  stan::math::matrix_d X(N, N);
+  for (int i = 0; i < X.size(); ++i)
+    X(i) = std::sin(0.7 * i + 0.3);
+  stan::math::matrix_d A = X * X.transpose();
+  A.diagonal().array() += N;
+  return A;
+}
+
+// gradients of sum(L .* W) from the Cholesky vari and from running
+// Eigen::LLT on var elements
+void test_cholesky_grad(int N) {
+  using stan::math::matrix_d;
+  using stan::agrad::matrix_v;
+
+  matrix_d A = spd_matrix(N);
+  matrix_d W(N, N);
+  for (int i = 0; i < W.size(); ++i)
+    W(i) = std::cos(1.3 * i);
+
+  matrix_v A1 = stan::agrad::to_var(A);
+  matrix_v L1 = stan::agrad::cholesky_decompose(A1);
+  AVAR f1 = 0;
+  for (int i = 0; i < L1.size(); ++i)
+    f1 += L1(i) * W(i);
+  AVEC x1(A1.data(), A1.data() + A1.size());
+  VEC g1 = cgradvec(f1, x1);
+
+  matrix_v A2 = stan::agrad::to_var(A);
+  matrix_v L2 = stan::math::cholesky_decompose<stan::agrad::var>(A2);
+  AVAR f2 = 0;
+  for (int i = 0; i < L2.size(); ++i)
+    f2 += L2(i) * W(i);
+  AVEC x2(A2.data(), A2.data() + A2.size());
+  VEC g2 = cgradvec(f2, x2);
+
+  for (int i = 0; i < L1.size(); ++i)
+    EXPECT_FLOAT_EQ(L2(i).val(), L1(i).val());
+  EXPECT_FLOAT_EQ(f2.val(), f1.val());
+  ASSERT_EQ(g2.size(), g1.size());
+  for (size_t i = 0; i < g1.size(); ++i)
+    EXPECT_NEAR(g2[i], g1[i], 1e-10) << "N = " << N << ", i = " << i;
+}
+
+TEST(AgradRevMatrix, cholesky_decompose_grad) {
+  // 1 and 5 are a single block, 20 and 50 several blocks of 8
+  test_cholesky_grad(1);
+  test_cholesky_grad(5);
+  test_cholesky_grad(20);
+  test_cholesky_grad(50);
+}
+
+TEST(AgradRevMatrix, cholesky_decompose_exceptions) {
+  using stan::agrad::matrix_v;
+  matrix_v m(0, 0);
+  EXPECT_EQ(0, stan::agrad::cholesky_decompose(m).size());
+
+  m.resize(2, 3);
+  EXPECT_THROW(stan::agrad::cholesky_decompose(m), std::domain_error);
+
+  m.resize(2, 2);
+  m << 1.0, 2.0,
+    3.0, 4.0;
+  EXPECT_THROW(stan::agrad::cholesky_decompose(m), std::domain_error);
+}
+
+TEST(AgradRevMatrix, cholesky_decompose_performance) {
+  using stan::agrad::matrix_v;
+  using stan::agrad::ChainableStack;
+  int N = 100;
+  stan::math::matrix_d A = spd_matrix(N);
+
+  clock_t start = clock();
+  matrix_v A1 = stan::agrad::to_var(A);
+  size_t stack_before = ChainableStack::var_stack_.size();
+  matrix_v L1 = stan::agrad::cholesky_decompose(A1);
+  size_t stack_vari = ChainableStack::var_stack_.size() - stack_before;
+  stan::agrad::grad(stan::agrad::sum(L1).vi_);
+  double t_vari = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+  stan::agrad::recover_memory();
+
+  start = clock();
+  matrix_v A2 = stan::agrad::to_var(A);
+  stack_before = ChainableStack::var_stack_.size();
+  matrix_v L2 = stan::math::cholesky_decompose<stan::agrad::var>(A2);
+  size_t stack_llt = ChainableStack::var_stack_.size() - stack_before;
+  stan::agrad::grad(stan::agrad::sum(L2).vi_);
+  double t_llt = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+  stan::agrad::recover_memory();
+
+  std::cout << "cholesky_decompose " << N << "x" << N << ": "
+            << "vari " << t_vari << " s, " << stack_vari << " stack entries; "
+            << "LLT on var " << t_llt << " s, " << stack_llt
+            << " stack entries" << std::endl;
+
+  EXPECT_EQ(1U, stack_vari);
+  EXPECT_GT(stack_llt, static_cast<size_t>(N * N * N / 3));
+}
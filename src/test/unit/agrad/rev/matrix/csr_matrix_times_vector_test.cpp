@@ -0,0 +1,81 @@
+#include <stan/agrad/rev/matrix.hpp>
+#include <stan/agrad/rev.hpp>
+#include <stan/math/matrix/csr_matrix_times_vector.hpp>
+#include <gtest/gtest.h>
+
+// 3 x 4 matrix
+//   [ 1 0 2 0 ]
+//   [ 0 0 0 0 ]
+//   [ 0 3 0 4 ]
+TEST(AgradRevMatrix, csr_matrix_times_vector) {
+  using stan::agrad::var;
+  using stan::agrad::vector_v;
+  stan::math::vector_d w(4);
+  w << 1, 2, 3, 4;
+  std::vector<int> v(4);
+  v[0] = 1; v[1] = 3; v[2] = 2; v[3] = 4;
+  std::vector<int> u(4);
+  u[0] = 1; u[1] = 3; u[2] = 3; u[3] = 5;
+
+  vector_v b(4);
+  b << 0.5, -1.0, 2.0, 3.0;
+  size_t stack_size = stan::agrad::ChainableStack::var_stack_.size();
+  vector_v y = csr_matrix_times_vector(3, 4, w, v, u, b);
+  // one node per non-empty row, plus the constant zero row
+  EXPECT_EQ(stack_size + 3, stan::agrad::ChainableStack::var_stack_.size());
+
+  ASSERT_EQ(3, y.size());
+  EXPECT_FLOAT_EQ(4.5, y(0).val());
+  EXPECT_FLOAT_EQ(0.0, y(1).val());
+  EXPECT_FLOAT_EQ(9.0, y(2).val());
+
+  var f = 2.0 * y(0) + y(1) - y(2);
+  std::vector<var> x(b.data(), b.data() + b.size());
+  std::vector<double> g;
+  f.grad(x, g);
+  EXPECT_FLOAT_EQ(2.0, g[0]);
+  EXPECT_FLOAT_EQ(-3.0, g[1]);
+  EXPECT_FLOAT_EQ(4.0, g[2]);
+  EXPECT_FLOAT_EQ(-4.0, g[3]);
+  stan::agrad::recover_memory();
+}
+
+TEST(AgradRevMatrix, csr_matrix_times_vector_var_values) {
+  using stan::agrad::var;
+  using stan::agrad::vector_v;
+  vector_v w(4);
+  w << 1, 2, 3, 4;
+  std::vector<int> v(4);
+  v[0] = 1; v[1] = 3; v[2] = 2; v[3] = 4;
+  std::vector<int> u(4);
+  u[0] = 1; u[1] = 3; u[2] = 3; u[3] = 5;
+  stan::math::vector_d b(4);
+  b << 0.5, -1.0, 2.0, 3.0;
+
+  vector_v y = stan::math::csr_matrix_times_vector(3, 4, w, v, u, b);
+  EXPECT_FLOAT_EQ(4.5, y(0).val());
+  EXPECT_FLOAT_EQ(9.0, y(2).val());
+  std::vector<var> x(w.data(), w.data() + w.size());
+  std::vector<double> g;
+  y(2).grad(x, g);
+  EXPECT_FLOAT_EQ(0.0, g[0]);
+  EXPECT_FLOAT_EQ(0.0, g[1]);
+  EXPECT_FLOAT_EQ(-1.0, g[2]);
+  EXPECT_FLOAT_EQ(3.0, g[3]);
+  stan::agrad::recover_memory();
+}
+
+TEST(AgradRevMatrix, csr_matrix_times_vector_exceptions) {
+  using stan::agrad::vector_v;
+  stan::math::vector_d w(2);
+  w << 1, 2;
+  std::vector<int> v(2, 1);
+  std::vector<int> u(3);
+  u[0] = 1; u[1] = 2; u[2] = 3;
+  vector_v b(2);
+  b << 1, 2;
+  EXPECT_THROW(csr_matrix_times_vector(2, 3, w, v, u, b), std::domain_error);
+  v[1] = 0;
+  EXPECT_THROW(csr_matrix_times_vector(2, 2, w, v, u, b), std::domain_error);
+  stan::agrad::recover_memory();
+}
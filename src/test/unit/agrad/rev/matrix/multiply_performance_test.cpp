@@ -0,0 +1,101 @@
+#include <stan/agrad/rev/matrix/multiply.hpp>
+#include <stan/agrad/rev/matrix/dot_product.hpp>
+#include <stan/agrad/rev/matrix/sum.hpp>
+#include <stan/math/matrix/typedefs.hpp>
+#include <stan/agrad/rev/matrix/typedefs.hpp>
+#include <gtest/gtest.h>
+#include <ctime>
+#include <iostream>
+
+// Compares the single matrix vari used by multiply() against the
+// previous implementation, which built one dot_product_vari per
+// element of the result.
+
+namespace {
+
+  stan::agrad::matrix_v multiply_by_dot_products(const stan::agrad::matrix_v& A,
+                                                 const stan::agrad::matrix_v& B) {
+    using stan::agrad::dot_product_vari;
+    using stan::agrad::var;
+    typedef dot_product_vari<var,var> dot_vari;
+    stan::agrad::matrix_v C(A.rows(), B.cols());
+    for (int i = 0; i < A.rows(); i++) {
+      stan::agrad::matrix_v::ConstRowXpr crow(A.row(i));
+      for (int j = 0; j < B.cols(); j++) {
+        stan::agrad::matrix_v::ConstColXpr ccol(B.col(j));
+        dot_vari* v1 = j == 0 ? 0 : static_cast<dot_vari*>(C(i,0).vi_);
+        dot_vari* v2 = i == 0 ? 0 : static_cast<dot_vari*>(C(0,j).vi_);
+        C(i,j) = var(new dot_vari(crow, ccol, v1, v2));
+      }
+    }
+    return C;
+  }
+
+  template <class F>
+  double time_gradient(const F& product, int N, int num_repeats,
+                       Eigen::VectorXd& grad, size_t& stack_size) {
+    using stan::agrad::matrix_v;
+    using stan::agrad::var;
+    clock_t start = clock();
+    for (int n = 0; n < num_repeats; ++n) {
+      matrix_v A(N,N), B(N,N);
+      for (int i = 0; i < A.size(); ++i) {
+        A(i) = std::sin(0.1 * i);
+        B(i) = std::cos(0.2 * i);
+      }
+      matrix_v C = product(A, B);
+      stack_size = stan::agrad::ChainableStack::var_stack_.size();
+      var f = stan::agrad::sum(C);
+      stan::agrad::grad(f.vi_);
+      grad.resize(2 * A.size());
+      for (int i = 0; i < A.size(); ++i) {
+        grad(i) = A(i).adj();
+        grad(A.size() + i) = B(i).adj();
+      }
+      stan::agrad::recover_memory();
+    }
+    return static_cast<double>(clock() - start) / CLOCKS_PER_SEC / num_repeats;
+  }
+
+  struct matrix_vari_product {
+    stan::agrad::matrix_v operator()(const stan::agrad::matrix_v& A,
+                                     const stan::agrad::matrix_v& B) const {
+      return stan::agrad::multiply(A, B);
+    }
+  };
+
+  struct dot_product_product {
+    stan::agrad::matrix_v operator()(const stan::agrad::matrix_v& A,
+                                     const stan::agrad::matrix_v& B) const {
+      return multiply_by_dot_products(A, B);
+    }
+  };
+
+}
+
+TEST(AgradRevMatrix, multiply_performance) {
+  int sizes[] = { 10, 50, 200 };
+  for (int k = 0; k < 3; ++k) {
+    int N = sizes[k];
+    int num_repeats = N < 200 ? 20 : 2;
+    Eigen::VectorXd grad_matrix, grad_dot;
+    size_t stack_matrix, stack_dot;
+    double t_matrix = time_gradient(matrix_vari_product(), N, num_repeats,
+                                    grad_matrix, stack_matrix);
+    double t_dot = time_gradient(dot_product_product(), N, num_repeats,
+                                 grad_dot, stack_dot);
+
+    std::cout << "multiply " << N << "x" << N << ": "
+              << "matrix vari " << t_matrix << " s, "
+              << stack_matrix << " stack entries; "
+              << "dot products " << t_dot << " s, "
+              << stack_dot << " stack entries" << std::endl;
+
+    // the inputs are the only other entries on the stack
+    EXPECT_EQ(2U * N * N + 1U, stack_matrix);
+    EXPECT_EQ(2U * N * N + N * N, stack_dot);
+    ASSERT_EQ(grad_dot.size(), grad_matrix.size());
+    for (int i = 0; i < grad_dot.size(); ++i)
+      EXPECT_FLOAT_EQ(grad_dot(i), grad_matrix(i));
+  }
+}
@@ -4,6 +4,7 @@
 #include <stan/math/matrix/multiply.hpp>
 #include <stan/math/matrix/typedefs.hpp>
 #include <stan/agrad/rev/matrix/typedefs.hpp>
+#include <stan/agrad/rev/operators/operator_plus_equal.hpp>
 
 TEST(AgradRevMatrix, multiply_scalar_scalar) {
   using stan::agrad::multiply;
@@ -507,3 +508,80 @@ TEST(AgradRevMatrix,multiply_vector_int) {
   EXPECT_EQ(6.0, prod_vec[2]);
 }
 
+
+// gradient of sum(multiply(A,B) .* W) is W * B' for A and A' * W for B
+void test_multiply_matrix_grad(bool A_var, bool B_var) {
+  using stan::math::matrix_d;
+  using stan::agrad::matrix_v;
+
+  matrix_d Ad(2,3), Bd(3,4), W(2,4);
+  Ad << 1, -2, 3, 0.5, 4, -1;
+  Bd << 2, 1, 0, -1,
+        3, -2, 1, 0.5,
+        -1, 4, 2, 1;
+  W << 1, 2, 3, 4,
+       -1, 0.5, -2, 3;
+
+  matrix_v Av = stan::agrad::to_var(Ad);
+  matrix_v Bv = stan::agrad::to_var(Bd);
+  AVEC x;
+  if (A_var)
+    for (int i = 0; i < Av.size(); ++i)
+      x.push_back(Av(i));
+  if (B_var)
+    for (int i = 0; i < Bv.size(); ++i)
+      x.push_back(Bv(i));
+
+  matrix_v C;
+  if (A_var && B_var)
+    C = stan::agrad::multiply(Av, Bv);
+  else if (A_var)
+    C = stan::agrad::multiply(Av, Bd);
+  else
+    C = stan::agrad::multiply(Ad, Bv);
+
+  matrix_d Cd = Ad * Bd;
+  ASSERT_EQ(2, C.rows());
+  ASSERT_EQ(4, C.cols());
+  AVAR f = 0;
+  for (int i = 0; i < C.size(); ++i) {
+    EXPECT_FLOAT_EQ(Cd(i), C(i).val());
+    f += C(i) * W(i);
+  }
+
+  VEC g = cgradvec(f, x);
+  size_t pos = 0;
+  if (A_var) {
+    matrix_d gA = W * Bd.transpose();
+    for (int i = 0; i < gA.size(); ++i)
+      EXPECT_FLOAT_EQ(gA(i), g[pos++]);
+  }
+  if (B_var) {
+    matrix_d gB = Ad.transpose() * W;
+    for (int i = 0; i < gB.size(); ++i)
+      EXPECT_FLOAT_EQ(gB(i), g[pos++]);
+  }
+}
+
+TEST(AgradRevMatrix,multiply_matrix_matrix_grad_vv) {
+  test_multiply_matrix_grad(true, true);
+}
+TEST(AgradRevMatrix,multiply_matrix_matrix_grad_vd) {
+  test_multiply_matrix_grad(true, false);
+}
+TEST(AgradRevMatrix,multiply_matrix_matrix_grad_dv) {
+  test_multiply_matrix_grad(false, true);
+}
+
+TEST(AgradRevMatrix,multiply_matrix_matrix_one_node) {
+  using stan::agrad::matrix_v;
+  matrix_v A(20,30), B(30,10);
+  for (int i = 0; i < A.size(); ++i)
+    A(i) = 0.1 * i;
+  for (int i = 0; i < B.size(); ++i)
+    B(i) = 1.0 - 0.01 * i;
+  size_t stack_size = stan::agrad::ChainableStack::var_stack_.size();
+  matrix_v C = stan::agrad::multiply(A, B);
+  EXPECT_EQ(stack_size + 1, stan::agrad::ChainableStack::var_stack_.size());
+  stan::agrad::recover_memory();
+}
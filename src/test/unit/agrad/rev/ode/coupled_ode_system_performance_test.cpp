@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <stan/agrad/rev.hpp>
+#include <stan/agrad/rev/ode/coupled_ode_system.hpp>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+// Compares the coupled system, which records the base system once per
+// right-hand side evaluation, against the previous implementation,
+// which recorded it again on a fresh nested stack for every equation.
+
+namespace {
+
+  // chain of N compartments with saturable elimination, driven by M
+  // rate parameters; the shape of a small PK/PD model
+  struct compartment_ode_fun {
+    template <typename T0, typename T1, typename T2>
+    std::vector<typename stan::return_type<T1,T2>::type>
+    operator()(const T0& t_in,
+               const std::vector<T1>& y,
+               const std::vector<T2>& theta,
+               const std::vector<double>& x,
+               const std::vector<int>& x_int,
+               std::ostream* msgs) const {
+      typedef typename stan::return_type<T1,T2>::type result_t;
+      size_t N = y.size();
+      size_t M = theta.size();
+      std::vector<result_t> dy_dt(N);
+      for (size_t n = 0; n < N; ++n) {
+        result_t outflow = theta[n % M] * y[n] / (1 + theta[(n + N) % M] * y[n]);
+        dy_dt[n] = -outflow;
+        if (n > 0)
+          dy_dt[n] += theta[(n + 1) % M] * y[n - 1];
+      }
+      return dy_dt;
+    }
+  };
+
+  // right-hand side of the coupled system with known initial state,
+  // one nested stack per equation
+  template <typename F>
+  void coupled_rhs_per_equation(const F& f, int N, int M,
+                                const std::vector<double>& y,
+                                const std::vector<double>& theta,
+                                std::vector<double>& dy_dt) {
+    using stan::agrad::var;
+    using std::vector;
+    vector<double> x;
+    vector<int> x_int;
+    vector<double> y_base(y.begin(), y.begin() + N);
+    dy_dt = f(0.0, y_base, theta, x, x_int, 0);
+    vector<double> coupled_sys(N * M);
+    for (int i = 0; i < N; i++) {
+      stan::agrad::start_nested();
+      vector<var> y_temp(y_base.begin(), y_base.end());
+      vector<var> theta_temp(theta.begin(), theta.end());
+      vector<var> vars(y_temp);
+      vars.insert(vars.end(), theta_temp.begin(), theta_temp.end());
+      vector<var> dy_dt_temp = f(0.0, y_temp, theta_temp, x, x_int, 0);
+      vector<double> grad;
+      dy_dt_temp[i].grad(vars, grad);
+      for (int j = 0; j < M; j++) {
+        double temp_deriv = grad[N + j];
+        for (int k = 0; k < N; k++)
+          temp_deriv += y[N + N * j + k] * grad[k];
+        coupled_sys[i + j * N] = temp_deriv;
+      }
+      stan::agrad::recover_memory_nested();
+    }
+    dy_dt.insert(dy_dt.end(), coupled_sys.begin(), coupled_sys.end());
+  }
+
+}
+
+TEST(AgradRevOde, coupled_ode_system_performance) {
+  using stan::agrad::var;
+  using std::vector;
+
+  compartment_ode_fun f;
+  vector<double> x;
+  vector<int> x_int;
+
+  int sizes[][2] = { { 2, 3 }, { 8, 12 }, { 20, 20 } };
+  for (int s = 0; s < 3; ++s) {
+    int N = sizes[s][0];
+    int M = sizes[s][1];
+    vector<double> y0(N);
+    for (int n = 0; n < N; ++n)
+      y0[n] = 1.0 + 0.1 * n;
+    vector<double> theta_d(M);
+    vector<var> theta(M);
+    for (int m = 0; m < M; ++m)
+      theta[m] = theta_d[m] = 0.5 + 0.05 * m;
+
+    stan::math::coupled_ode_system<compartment_ode_fun, double, var>
+      system(f, y0, theta, x, x_int, 0);
+    vector<double> y(system.size());
+    for (size_t i = 0; i < y.size(); ++i)
+      y[i] = std::sin(0.3 * i);
+
+    int num_repeats = 2000;
+    vector<double> dy_dt, dy_dt_ref;
+    size_t stack_size = stan::agrad::ChainableStack::var_stack_.size();
+
+    clock_t start = clock();
+    for (int n = 0; n < num_repeats; ++n)
+      system(y, dy_dt, 0.0);
+    double t_jacobian = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (int n = 0; n < num_repeats; ++n)
+      coupled_rhs_per_equation(f, N, M, y, theta_d, dy_dt_ref);
+    double t_per_equation = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+
+    std::cout << "coupled ode system N=" << N << ", M=" << M << ": "
+              << "one recording " << t_jacobian << " s, "
+              << "one recording per equation " << t_per_equation << " s"
+              << std::endl;
+
+    EXPECT_EQ(stack_size, stan::agrad::ChainableStack::var_stack_.size());
+    ASSERT_EQ(dy_dt_ref.size(), dy_dt.size());
+    for (size_t i = 0; i < dy_dt.size(); ++i)
+      EXPECT_FLOAT_EQ(dy_dt_ref[i], dy_dt[i]);
+  }
+  stan::agrad::recover_memory();
+}
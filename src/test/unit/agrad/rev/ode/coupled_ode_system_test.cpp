@@ -162,28 +162,51 @@ TEST_F(StanAgradRevOde, memory_recovery_exception_dv) {
 
   const int N = 3;
   const int M = 4;
-  for (int n = 0; n < N+1; n++) {
-    std::stringstream scoped_message;
-    scoped_message << "iteration " << n;
-    SCOPED_TRACE(scoped_message.str());
-    mock_throwing_ode_functor<std::logic_error> throwing_ode(message, n+1);
-    
-    std::vector<double> y0_d(N, 0.0);
-    std::vector<var> theta_v(M, 0.0);
-    
-    coupled_ode_system<mock_throwing_ode_functor<std::logic_error>, double, var>
-      coupled_system_dv(throwing_ode, y0_d, theta_v, x, x_int, &msgs);
-    
-    std::vector<double> y(3,0);
-    std::vector<double> dy_dt(3,0);
-    double t = 10;
-    
-    EXPECT_TRUE(stan::agrad::empty_nested());
-    EXPECT_THROW_MSG(coupled_system_dv(y, dy_dt, t),
-                     std::logic_error,
-                     message);
-    EXPECT_TRUE(stan::agrad::empty_nested());
-  }
+  // the base system is evaluated once per call, so the first
+  // evaluation is the only one that can throw
+  mock_throwing_ode_functor<std::logic_error> throwing_ode(message, 1);
+  
+  std::vector<double> y0_d(N, 0.0);
+  std::vector<var> theta_v(M, 0.0);
+  
+  coupled_ode_system<mock_throwing_ode_functor<std::logic_error>, double, var>
+    coupled_system_dv(throwing_ode, y0_d, theta_v, x, x_int, &msgs);
+  
+  std::vector<double> y(3,0);
+  std::vector<double> dy_dt(3,0);
+  double t = 10;
+  
+  EXPECT_TRUE(stan::agrad::empty_nested());
+  EXPECT_THROW_MSG(coupled_system_dv(y, dy_dt, t),
+                   std::logic_error,
+                   message);
+  EXPECT_TRUE(stan::agrad::empty_nested());
+}
+
+TEST_F(StanAgradRevOde, evaluates_base_system_once_dv) {
+  using stan::math::coupled_ode_system;
+  using stan::agrad::var;
+
+  const int N = 3;
+  const int M = 4;
+  mock_throwing_ode_functor<std::logic_error> ode("never thrown", 100);
+
+  std::vector<double> y0_d(N, 0.0);
+  std::vector<var> theta_v(M, 0.0);
+
+  coupled_ode_system<mock_throwing_ode_functor<std::logic_error>, double, var>
+    coupled_system_dv(ode, y0_d, theta_v, x, x_int, &msgs);
+
+  std::vector<double> y(coupled_system_dv.size(), 1.0);
+  std::vector<double> dy_dt;
+  coupled_system_dv(y, dy_dt, 10);
+
+  EXPECT_EQ(1, mock_throwing_ode_functor_count);
+  EXPECT_TRUE(stan::agrad::empty_nested());
+  ASSERT_EQ(coupled_system_dv.size(), dy_dt.size());
+  // the identity system: each sensitivity follows its own state
+  for (int i = 0; i < coupled_system_dv.size(); ++i)
+    EXPECT_FLOAT_EQ(1.0, dy_dt[i]);
 }
 
 // ******************** VD ****************************
@@ -340,28 +363,25 @@ TEST_F(StanAgradRevOde, memory_recovery_exception_vd) {
 
   const int N = 3;
   const int M = 4;
-  for (int n = 0; n < N+1; n++) {
-    std::stringstream scoped_message;
-    scoped_message << "iteration " << n;
-    SCOPED_TRACE(scoped_message.str());
-    mock_throwing_ode_functor<std::logic_error> throwing_ode(message, n+1);
-    
-    std::vector<var> y0_v(N, 0.0);
-    std::vector<double> theta_d(M, 0.0);
-    
-    coupled_ode_system<mock_throwing_ode_functor<std::logic_error>, var, double>
-      coupled_system_vd(throwing_ode, y0_v, theta_d, x, x_int, &msgs);
-    
-    std::vector<double> y(3,0);
-    std::vector<double> dy_dt(3,0);
-    double t = 10;
-    
-    EXPECT_TRUE(stan::agrad::empty_nested());
-    EXPECT_THROW_MSG(coupled_system_vd(y, dy_dt, t),
-                     std::logic_error,
-                     message);
-    EXPECT_TRUE(stan::agrad::empty_nested());
-  }
+  // the base system is evaluated once per call, so the first
+  // evaluation is the only one that can throw
+  mock_throwing_ode_functor<std::logic_error> throwing_ode(message, 1);
+  
+  std::vector<var> y0_v(N, 0.0);
+  std::vector<double> theta_d(M, 0.0);
+  
+  coupled_ode_system<mock_throwing_ode_functor<std::logic_error>, var, double>
+    coupled_system_vd(throwing_ode, y0_v, theta_d, x, x_int, &msgs);
+  
+  std::vector<double> y(3,0);
+  std::vector<double> dy_dt(3,0);
+  double t = 10;
+  
+  EXPECT_TRUE(stan::agrad::empty_nested());
+  EXPECT_THROW_MSG(coupled_system_vd(y, dy_dt, t),
+                   std::logic_error,
+                   message);
+  EXPECT_TRUE(stan::agrad::empty_nested());
 }
 
 
@@ -519,27 +539,24 @@ TEST_F(StanAgradRevOde, memory_recovery_exception_vv) {
 
   const int N = 3;
   const int M = 4;
-  for (int n = 0; n < N+1; n++) {
-    std::stringstream scoped_message;
-    scoped_message << "iteration " << n;
-    SCOPED_TRACE(scoped_message.str());
-    mock_throwing_ode_functor<std::logic_error> throwing_ode(message, n+1);
-    
-    std::vector<var> y0_v(N, 0.0);
-    std::vector<var> theta_v(M, 0.0);
-    
-    coupled_ode_system<mock_throwing_ode_functor<std::logic_error>, var, var>
-      coupled_system_vv(throwing_ode, y0_v, theta_v, x, x_int, &msgs);
-    
-    std::vector<double> y(3,0);
-    std::vector<double> dy_dt(3,0);
-    double t = 10;
-    
-    EXPECT_TRUE(stan::agrad::empty_nested());
-    EXPECT_THROW_MSG(coupled_system_vv(y, dy_dt, t),
-                     std::logic_error,
-                     message);
-    EXPECT_TRUE(stan::agrad::empty_nested());
-  }
+  // the base system is evaluated once per call, so the first
+  // evaluation is the only one that can throw
+  mock_throwing_ode_functor<std::logic_error> throwing_ode(message, 1);
+  
+  std::vector<var> y0_v(N, 0.0);
+  std::vector<var> theta_v(M, 0.0);
+  
+  coupled_ode_system<mock_throwing_ode_functor<std::logic_error>, var, var>
+    coupled_system_vv(throwing_ode, y0_v, theta_v, x, x_int, &msgs);
+  
+  std::vector<double> y(3,0);
+  std::vector<double> dy_dt(3,0);
+  double t = 10;
+  
+  EXPECT_TRUE(stan::agrad::empty_nested());
+  EXPECT_THROW_MSG(coupled_system_vv(y, dy_dt, t),
+                   std::logic_error,
+                   message);
+  EXPECT_TRUE(stan::agrad::empty_nested());
 }
 
@@ -0,0 +1,292 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include <stan/agrad/rev.hpp>
+#include <stan/agrad/rev/ode/integrate_ode_stiff.hpp>
+#include <stan/math/ode/integrate_ode.hpp>
+#include <stan/math/functions/promote_scalar.hpp>
+
+#include <test/unit/math/ode/harmonic_oscillator.hpp>
+
+namespace {
+
+  int num_robertson_calls = 0;
+
+  // Robertson's chemical kinetics, with rate constants spanning nine
+  // orders of magnitude
+  struct robertson_ode_fun {
+    template <typename T0, typename T1, typename T2>
+    std::vector<typename stan::return_type<T1,T2>::type>
+    operator()(const T0& t_in,
+               const std::vector<T1>& y,
+               const std::vector<T2>& theta,
+               const std::vector<double>& x,
+               const std::vector<int>& x_int,
+               std::ostream* msgs) const {
+      ++num_robertson_calls;
+      std::vector<typename stan::return_type<T1,T2>::type> dy_dt(3);
+      dy_dt[0] = -theta[0] * y[0] + theta[1] * y[1] * y[2];
+      dy_dt[1] = theta[0] * y[0] - theta[1] * y[1] * y[2]
+        - theta[2] * y[1] * y[1];
+      dy_dt[2] = theta[2] * y[1] * y[1];
+      return dy_dt;
+    }
+  };
+
+  std::vector<double> robertson_theta() {
+    std::vector<double> theta(3);
+    theta[0] = 0.04;
+    theta[1] = 1e4;
+    theta[2] = 3e7;
+    return theta;
+  }
+
+  std::vector<double> robertson_y0() {
+    std::vector<double> y0(3, 0.0);
+    y0[0] = 1.0;
+    return y0;
+  }
+
+  template <typename T_y0, typename T_theta>
+  void expect_sho_matches_integrate_ode() {
+    using stan::agrad::var;
+    using stan::math::promote_scalar;
+    harm_osc_ode_fun harm_osc;
+    std::vector<double> y0(2, 0.0);
+    y0[0] = 1.0;
+    std::vector<double> theta(1, 0.15);
+    std::vector<double> ts;
+    for (int i = 0; i < 20; i++)
+      ts.push_back(0.5 * (i + 1));
+    std::vector<double> x;
+    std::vector<int> x_int;
+
+    std::vector<T_y0> y0_s = promote_scalar<T_y0>(y0);
+    std::vector<T_theta> theta_s = promote_scalar<T_theta>(theta);
+    std::vector<std::vector<var> > res
+      = stan::math::integrate_ode_stiff(harm_osc, y0_s, 0.0, ts, theta_s,
+                                        x, x_int, 0, 1e-10, 1e-10);
+
+    std::vector<T_y0> y0_r = promote_scalar<T_y0>(y0);
+    std::vector<T_theta> theta_r = promote_scalar<T_theta>(theta);
+    std::vector<std::vector<var> > ref
+      = stan::math::integrate_ode(harm_osc, y0_r, 0.0, ts, theta_r,
+                                  x, x_int, 0);
+
+    ASSERT_EQ(ref.size(), res.size());
+    for (size_t i = 0; i < ts.size(); i++)
+      for (size_t k = 0; k < 2; k++) {
+        EXPECT_NEAR(ref[i][k].val(), res[i][k].val(), 1e-5);
+
+        std::vector<var> vars_s, vars_r;
+        for (size_t n = 0; n < 2; n++)
+          if (!stan::is_constant<T_y0>::value) {
+            vars_s.push_back(y0_s[n]);
+            vars_r.push_back(y0_r[n]);
+          }
+        if (!stan::is_constant<T_theta>::value) {
+          vars_s.push_back(theta_s[0]);
+          vars_r.push_back(theta_r[0]);
+        }
+        std::vector<double> g_s, g_r;
+        res[i][k].grad(vars_s, g_s);
+        stan::agrad::set_zero_all_adjoints();
+        ref[i][k].grad(vars_r, g_r);
+        stan::agrad::set_zero_all_adjoints();
+        ASSERT_EQ(g_r.size(), g_s.size());
+        for (size_t n = 0; n < g_r.size(); n++)
+          EXPECT_NEAR(g_r[n], g_s[n], 1e-5);
+      }
+    stan::agrad::recover_memory();
+  }
+
+}
+
+TEST(StanAgradRevOde_integrate_ode_stiff, harmonic_oscillator) {
+  using stan::agrad::var;
+  expect_sho_matches_integrate_ode<double, var>();
+  expect_sho_matches_integrate_ode<var, double>();
+  expect_sho_matches_integrate_ode<var, var>();
+}
+
+TEST(StanAgradRevOde_integrate_ode_stiff, robertson_values) {
+  robertson_ode_fun robertson;
+  std::vector<double> ts(1, 40.0);
+  std::vector<double> x;
+  std::vector<int> x_int;
+
+  std::vector<std::vector<double> > res
+    = stan::math::integrate_ode_stiff(robertson, robertson_y0(), 0.0, ts,
+                                      robertson_theta(), x, x_int, 0,
+                                      1e-10, 1e-10);
+  EXPECT_NEAR(0.7158271, res[0][0], 1e-6);
+  EXPECT_NEAR(9.185535e-6, res[0][1], 1e-10);
+  EXPECT_NEAR(0.2841637, res[0][2], 1e-6);
+}
+
+TEST(StanAgradRevOde_integrate_ode_stiff, robertson_finite_diff) {
+  using stan::agrad::var;
+  robertson_ode_fun robertson;
+  std::vector<double> ts;
+  ts.push_back(0.4);
+  ts.push_back(4.0);
+  ts.push_back(40.0);
+  std::vector<double> x;
+  std::vector<int> x_int;
+  std::vector<double> theta = robertson_theta();
+  std::vector<double> y0 = robertson_y0();
+
+  std::vector<var> theta_v(theta.begin(), theta.end());
+  std::vector<var> y0_v(y0.begin(), y0.end());
+  std::vector<std::vector<var> > res
+    = stan::math::integrate_ode_stiff(robertson, y0_v, 0.0, ts, theta_v,
+                                      x, x_int, 0, 1e-10, 1e-10);
+
+  std::vector<var> vars(y0_v);
+  vars.insert(vars.end(), theta_v.begin(), theta_v.end());
+  for (size_t p = 0; p < vars.size(); p++) {
+    std::vector<double> y0_h(y0), theta_h(theta);
+    double& z = p < 3 ? y0_h[p] : theta_h[p - 3];
+    double h = 1e-5 * std::max(1.0, z);
+    z += h;
+    std::vector<std::vector<double> > res_ub
+      = stan::math::integrate_ode_stiff(robertson, y0_h, 0.0, ts, theta_h,
+                                        x, x_int, 0, 1e-12, 1e-12);
+    z -= 2 * h;
+    std::vector<std::vector<double> > res_lb
+      = stan::math::integrate_ode_stiff(robertson, y0_h, 0.0, ts, theta_h,
+                                        x, x_int, 0, 1e-12, 1e-12);
+
+    for (size_t i = 0; i < ts.size(); i++)
+      for (size_t k = 0; k < 3; k++) {
+        std::vector<double> g;
+        res[i][k].grad(vars, g);
+        stan::agrad::set_zero_all_adjoints();
+        double fd = (res_ub[i][k] - res_lb[i][k]) / (2 * h);
+        EXPECT_NEAR(fd, g[p], 1e-4 * std::max(1.0, std::fabs(fd)))
+          << "output " << i << ", state " << k << ", unknown " << p;
+      }
+  }
+  stan::agrad::recover_memory();
+}
+
+TEST(StanAgradRevOde_integrate_ode_stiff, jacobian_matches_finite_diff) {
+  using stan::agrad::var;
+  typedef boost::numeric::ublas::vector<double> state_t;
+  robertson_ode_fun robertson;
+  std::vector<double> x;
+  std::vector<int> x_int;
+  std::vector<double> theta = robertson_theta();
+  std::vector<var> theta_v(theta.begin(), theta.end());
+  std::vector<double> y0 = robertson_y0();
+  std::vector<var> y0_v(y0.begin(), y0.end());
+
+  stan::math::coupled_ode_system<robertson_ode_fun, var, var>
+    coupled(robertson, y0_v, theta_v, x, x_int, 0);
+  stan::math::stiff_ode_system<robertson_ode_fun, var, var> system(coupled);
+  stan::math::stiff_ode_jacobian<robertson_ode_fun, var, var>
+    jacobian(robertson, y0_v, theta_v, x, x_int, 0);
+
+  // a state away from the initial one, with nonzero sensitivities
+  int size = coupled.size();
+  state_t y(size);
+  for (int i = 0; i < size; i++)
+    y[i] = 0.1 * std::sin(1.0 + i);
+  y[0] = -0.2;
+  y[1] = 3e-5;
+  y[2] = 0.15;
+
+  boost::numeric::ublas::matrix<double> J(size, size);
+  state_t dfdt(size);
+  jacobian(y, J, 1.0, dfdt);
+
+  for (int k = 0; k < size; k++) {
+    double h = 1e-6 * std::max(1e-3, std::fabs(y[k]));
+    state_t y_ub(y), y_lb(y), dy_ub(size), dy_lb(size);
+    y_ub[k] += h;
+    y_lb[k] -= h;
+    system(y_ub, dy_ub, 1.0);
+    system(y_lb, dy_lb, 1.0);
+    for (int i = 0; i < size; i++) {
+      double fd = (dy_ub[i] - dy_lb[i]) / (2 * h);
+      EXPECT_NEAR(fd, J(i,k), 1e-5 * std::max(1.0, std::fabs(fd)))
+        << "row " << i << ", column " << k;
+    }
+  }
+  for (int i = 0; i < size; i++)
+    EXPECT_FLOAT_EQ(0.0, dfdt[i]);
+  stan::agrad::recover_memory();
+}
+
+TEST(StanAgradRevOde_integrate_ode_stiff, fewer_system_calls_than_integrate_ode) {
+  using stan::agrad::var;
+  robertson_ode_fun robertson;
+  std::vector<double> ts(1, 4.0);
+  std::vector<double> x;
+  std::vector<int> x_int;
+  std::vector<double> theta = robertson_theta();
+  std::vector<var> theta_v(theta.begin(), theta.end());
+
+  num_robertson_calls = 0;
+  std::vector<std::vector<var> > res
+    = stan::math::integrate_ode_stiff(robertson, robertson_y0(), 0.0, ts,
+                                      theta_v, x, x_int, 0);
+  int num_stiff_calls = num_robertson_calls;
+
+  num_robertson_calls = 0;
+  std::vector<std::vector<var> > ref
+    = stan::math::integrate_ode(robertson, robertson_y0(), 0.0, ts,
+                                theta_v, x, x_int, 0);
+  int num_explicit_calls = num_robertson_calls;
+
+  std::cout << "Robertson to t = 4: integrate_ode_stiff " << num_stiff_calls
+            << " system calls, integrate_ode " << num_explicit_calls
+            << " system calls" << std::endl;
+  EXPECT_LT(10 * num_stiff_calls, num_explicit_calls);
+  for (size_t k = 0; k < 3; k++)
+    EXPECT_NEAR(ref[0][k].val(), res[0][k].val(), 1e-5);
+  stan::agrad::recover_memory();
+}
+
+TEST(StanAgradRevOde_integrate_ode_stiff, max_num_steps) {
+  robertson_ode_fun robertson;
+  std::vector<double> ts(1, 40.0);
+  std::vector<double> x;
+  std::vector<int> x_int;
+
+  EXPECT_THROW(stan::math::integrate_ode_stiff(robertson, robertson_y0(),
+                                               0.0, ts, robertson_theta(),
+                                               x, x_int, 0,
+                                               1e-6, 1e-6, 5),
+               std::domain_error);
+  EXPECT_NO_THROW(stan::math::integrate_ode_stiff(robertson, robertson_y0(),
+                                                  0.0, ts, robertson_theta(),
+                                                  x, x_int, 0,
+                                                  1e-6, 1e-6, 1000));
+}
+
+TEST(StanAgradRevOde_integrate_ode_stiff, bad_arguments) {
+  robertson_ode_fun robertson;
+  std::vector<double> ts(1, 40.0);
+  std::vector<double> x;
+  std::vector<int> x_int;
+
+  EXPECT_THROW(stan::math::integrate_ode_stiff(robertson, robertson_y0(),
+                                               0.0, ts, robertson_theta(),
+                                               x, x_int, 0, -1e-6),
+               std::domain_error);
+  EXPECT_THROW(stan::math::integrate_ode_stiff(robertson, robertson_y0(),
+                                               0.0, ts, robertson_theta(),
+                                               x, x_int, 0, 1e-6, 0.0),
+               std::domain_error);
+  EXPECT_THROW(stan::math::integrate_ode_stiff(robertson, robertson_y0(),
+                                               0.0, ts, robertson_theta(),
+                                               x, x_int, 0, 1e-6, 1e-6, 0),
+               std::domain_error);
+  EXPECT_THROW(stan::math::integrate_ode_stiff(robertson, robertson_y0(),
+                                               50.0, ts, robertson_theta(),
+                                               x, x_int, 0),
+               std::domain_error);
+}
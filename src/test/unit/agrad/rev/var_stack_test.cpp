@@ -54,3 +54,24 @@ TEST(AgradRev, recoverMemoryLogicError) {
 TEST(AgradRev, recoverMemoryNestedLogicError) {
   EXPECT_THROW(stan::agrad::recover_memory_nested(), std::logic_error);
 }
+
+TEST(AgradRev, setZeroAllAdjointsNested) {
+  AVAR a = 2.0;
+  a.vi_->adj_ = 5.0;
+
+  stan::agrad::start_nested();
+  AVAR b = 3.0;
+  AVAR f = a * b;
+  stan::agrad::grad(f.vi_);
+  EXPECT_FLOAT_EQ(2.0, b.adj());
+
+  stan::agrad::set_zero_all_adjoints_nested();
+  EXPECT_FLOAT_EQ(0.0, b.adj());
+  EXPECT_FLOAT_EQ(0.0, f.adj());
+  // variables outside the nested stack keep their adjoints
+  EXPECT_FLOAT_EQ(8.0, a.adj());
+  stan::agrad::recover_memory_nested();
+
+  EXPECT_THROW(stan::agrad::set_zero_all_adjoints_nested(), std::logic_error);
+  stan::agrad::recover_memory();
+}
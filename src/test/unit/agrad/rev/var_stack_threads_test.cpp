@@ -0,0 +1,140 @@
+#include <stan/agrad/rev.hpp>
+#include <stan/model/util.hpp>
+#include <stan/prob/distributions/univariate/continuous/normal.hpp>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+class TestModel_threads {
+public:
+  size_t num_params_r() const {
+    return 5;
+  }
+
+  template <bool propto__, bool jacobian__, typename T__>
+  T__ log_prob(std::vector<T__>& params_r__,
+               std::vector<int>& params_i__,
+               std::ostream* pstream__ = 0) const {
+    T__ lp__(0.0);
+    T__ mu = params_r__[0];
+    T__ sigma = exp(params_r__[1]);
+    if (jacobian__)
+      lp__ += params_r__[1];
+    for (size_t n = 2; n < params_r__.size(); ++n) {
+      lp__ += stan::prob::normal_log<propto__>(params_r__[n], mu, sigma);
+      lp__ += stan::prob::normal_log<propto__>(mu * n, params_r__[n], 2.0);
+    }
+    return lp__;
+  }
+};
+
+std::vector<double> thread_test_params(int k) {
+  std::vector<double> params_r(5);
+  for (size_t i = 0; i < params_r.size(); ++i)
+    params_r[i] = 0.1 * k - 0.3 * i;
+  return params_r;
+}
+
+struct grad_worker {
+  const TestModel_threads& model_;
+  int k_;
+  int num_repeats_;
+  std::vector<double>& lp_;
+  std::vector<double>& grad_;
+  bool& stack_empty_;
+
+  grad_worker(const TestModel_threads& model, int k, int num_repeats,
+              std::vector<double>& lp, std::vector<double>& grad,
+              bool& stack_empty)
+    : model_(model), k_(k), num_repeats_(num_repeats),
+      lp_(lp), grad_(grad), stack_empty_(stack_empty) { }
+
+  void operator()() {
+    std::vector<double> params_r = thread_test_params(k_);
+    std::vector<int> params_i;
+    for (int n = 0; n < num_repeats_; ++n)
+      lp_[k_] = stan::model::log_prob_grad<true,true>(model_, params_r,
+                                                      params_i, grad_);
+    stack_empty_ = stan::agrad::ChainableStack::var_stack_.empty();
+  }
+};
+
+TEST(AgradRev, varStackThreadsLogProbGrad) {
+  const int K = 8;
+  TestModel_threads model;
+  std::vector<int> params_i;
+
+  std::vector<double> lp_serial(K);
+  std::vector<std::vector<double> > grad_serial(K);
+  for (int k = 0; k < K; ++k) {
+    std::vector<double> params_r = thread_test_params(k);
+    lp_serial[k] = stan::model::log_prob_grad<true,true>(model, params_r,
+                                                         params_i,
+                                                         grad_serial[k]);
+  }
+
+  std::vector<double> lp_threads(K);
+  std::vector<std::vector<double> > grad_threads(K);
+  bool empty[K];
+  std::vector<std::thread> threads;
+  for (int k = 0; k < K; ++k)
+    threads.push_back(std::thread(grad_worker(model, k, 1000, lp_threads,
+                                              grad_threads[k], empty[k])));
+  for (int k = 0; k < K; ++k)
+    threads[k].join();
+
+  for (int k = 0; k < K; ++k) {
+    EXPECT_TRUE(empty[k]);
+    EXPECT_FLOAT_EQ(lp_serial[k], lp_threads[k]);
+    ASSERT_EQ(grad_serial[k].size(), grad_threads[k].size());
+    for (size_t i = 0; i < grad_serial[k].size(); ++i)
+      EXPECT_FLOAT_EQ(grad_serial[k][i], grad_threads[k][i]);
+  }
+}
+
+void nested_worker(double x, double& grad, double& outer_grad,
+                   size_t& stack_size) {
+  using stan::agrad::var;
+  // an outer expression left on this thread's stack must not be
+  // visible to, or disturbed by, any other thread
+  var a = x;
+  var b = a * a;
+  stan::agrad::start_nested();
+  for (int n = 0; n < 1000; ++n) {
+    var y = x;
+    var f = exp(y) * sin(y);
+    stan::agrad::grad(f.vi_);
+    grad = y.adj();
+    stan::agrad::recover_memory_nested();
+    stan::agrad::start_nested();
+  }
+  stan::agrad::recover_memory_nested();
+  stack_size = stan::agrad::ChainableStack::var_stack_.size();
+  stan::agrad::grad(b.vi_);
+  outer_grad = a.adj();
+  stan::agrad::recover_memory();
+}
+
+TEST(AgradRev, varStackThreadsNested) {
+  const int K = 8;
+  std::vector<double> grad(K);
+  std::vector<double> outer_grad(K);
+  std::vector<size_t> stack_size(K);
+  std::vector<std::thread> threads;
+  for (int k = 0; k < K; ++k)
+    threads.push_back(std::thread(nested_worker, 0.25 * k,
+                                  std::ref(grad[k]),
+                                  std::ref(outer_grad[k]),
+                                  std::ref(stack_size[k])));
+  for (int k = 0; k < K; ++k)
+    threads[k].join();
+
+  for (int k = 0; k < K; ++k) {
+    double x = 0.25 * k;
+    EXPECT_FLOAT_EQ(exp(x) * sin(x) + exp(x) * cos(x), grad[k]);
+    EXPECT_FLOAT_EQ(2.0 * x, outer_grad[k]);
+    EXPECT_EQ(2U, stack_size[k]);
+  }
+  // the main thread's stack is untouched by the workers
+  EXPECT_EQ(0U, stan::agrad::ChainableStack::var_stack_.size());
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <stan/common/do_bfgs_multistart.hpp>
+#include <stan/optimization/bfgs.hpp>
+#include <test/test-models/good/optimization/bimodal.hpp>
+
+typedef bimodal_model_namespace::bimodal_model Model;
+typedef boost::ecuyer1988 rng_t;
+
+void make_start_rngs(std::vector<rng_t>& start_rngs, int num_starts) {
+  static boost::uintmax_t DISCARD_STRIDE = static_cast<boost::uintmax_t>(1) << 50;
+  for (int start = 0; start < num_starts; ++start) {
+    start_rngs.push_back(rng_t(0));
+    start_rngs.back().discard(DISCARD_STRIDE * start);
+  }
+}
+
+TEST(Common, do_bfgs_multistart__bimodal) {
+  typedef stan::optimization::BFGSLineSearch<Model,stan::optimization::LBFGSUpdate<> > Optimizer;
+
+  std::stringstream data_stream("");
+  stan::io::dump dummy_context(data_stream);
+  Model model(dummy_context);
+
+  std::vector<double> cont_vector(1, -1.5);
+  std::vector<int> disc_vector;
+  Optimizer options(model, cont_vector, disc_vector, 0);
+  Eigen::VectorXd cont_params(1);
+  cont_params << -1.5;
+
+  std::vector<rng_t> start_rngs;
+  make_start_rngs(start_rngs, 20);
+  std::vector<stan::common::local_optimum> optima;
+  std::stringstream out;
+  int return_code
+    = stan::common::do_bfgs_multistart(model, options, cont_params, 6,
+                                       start_rngs, 1e-3, optima, &out);
+
+  EXPECT_EQ(stan::gm::error_codes::OK, return_code);
+  ASSERT_EQ(2U, optima.size());
+  EXPECT_NEAR(-2, optima[0].params_r[0], 1e-3);
+  EXPECT_NEAR(3, optima[1].params_r[0], 1e-3);
+  EXPECT_GT(optima[0].lp, optima[1].lp);
+  EXPECT_EQ(20, optima[0].num_runs + optima[1].num_runs);
+  EXPECT_NE(std::string::npos,
+            out.str().find("Found 2 local optima from 20 starts (0 failed)"));
+}
+
+TEST(Common, do_bfgs_multistart__one_basin) {
+  typedef stan::optimization::BFGSLineSearch<Model,stan::optimization::BFGSUpdate_HInv<> > Optimizer;
+
+  std::stringstream data_stream("");
+  stan::io::dump dummy_context(data_stream);
+  Model model(dummy_context);
+
+  std::vector<double> cont_vector(1, -2.5);
+  std::vector<int> disc_vector;
+  Optimizer options(model, cont_vector, disc_vector, 0);
+  Eigen::VectorXd cont_params(1);
+  cont_params << -2.5;
+
+  // every random init within 0.1 of zero is in the basin of 3
+  std::vector<rng_t> start_rngs;
+  make_start_rngs(start_rngs, 8);
+  std::vector<stan::common::local_optimum> optima;
+  int return_code
+    = stan::common::do_bfgs_multistart(model, options, cont_params, 0.1,
+                                       start_rngs, 1e-3, optima, 0);
+
+  EXPECT_EQ(stan::gm::error_codes::OK, return_code);
+  ASSERT_EQ(2U, optima.size());
+  EXPECT_NEAR(-2, optima[0].params_r[0], 1e-3);
+  EXPECT_EQ(1, optima[0].num_runs);
+  EXPECT_NEAR(3, optima[1].params_r[0], 1e-3);
+  EXPECT_EQ(7, optima[1].num_runs);
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <stan/common/recorder/binary.hpp>
+#include <stan/io/stan_binary_reader.hpp>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+class StanCommonRecorderBinary : public ::testing::Test {
+public:
+  StanCommonRecorderBinary()
+    : file_name("stan_common_recorder_binary_test.bin") { }
+
+  void TearDown() {
+    std::remove(file_name.c_str());
+  }
+
+  // writes 5 draws of (lp__, theta.1.1, theta.2.1, theta.1.2, theta.2.2)
+  void write(stan::common::recorder::binary::layout_t layout,
+             size_t chunk_size) {
+    std::fstream out(file_name.c_str(),
+                     std::fstream::out | std::fstream::binary);
+    stan::common::recorder::binary recorder(&out, layout, chunk_size);
+    recorder("model = test");
+    std::vector<std::string> names;
+    names.push_back("lp__");
+    names.push_back("theta.1.1");
+    names.push_back("theta.2.1");
+    names.push_back("theta.1.2");
+    names.push_back("theta.2.2");
+    recorder(names);
+    recorder("Adaptation terminated");
+    for (int draw = 0; draw < 5; ++draw) {
+      std::vector<double> x;
+      for (int col = 0; col < 5; ++col)
+        x.push_back(value(draw, col));
+      recorder(x);
+    }
+    recorder();
+    recorder(" Elapsed Time: 1 seconds (Warm-up)");
+    recorder.flush();
+    out.close();
+  }
+
+  static double value(int draw, int col) {
+    return 10 * draw + col + 0.25;
+  }
+
+  void expect_draws() {
+    stan::io::stan_binary_reader reader(file_name);
+    ASSERT_EQ(5U, reader.names().size());
+    EXPECT_EQ("theta.2.1", reader.names()[2]);
+    ASSERT_EQ(5U, reader.num_draws());
+    for (int draw = 0; draw < 5; ++draw)
+      for (int col = 0; col < 5; ++col)
+        EXPECT_FLOAT_EQ(value(draw, col), reader(draw, col));
+
+    Eigen::VectorXd theta_21 = reader.column(2);
+    ASSERT_EQ(5, theta_21.size());
+    for (int draw = 0; draw < 5; ++draw)
+      EXPECT_FLOAT_EQ(value(draw, 2), theta_21(draw));
+
+    EXPECT_THROW(reader(5, 0), std::out_of_range);
+    EXPECT_THROW(reader(0, 5), std::out_of_range);
+  }
+
+  std::string file_name;
+};
+
+TEST_F(StanCommonRecorderBinary, by_iteration) {
+  write(stan::common::recorder::binary::by_iteration, 1024);
+  expect_draws();
+}
+
+TEST_F(StanCommonRecorderBinary, by_column) {
+  // a full block, then a partial one flushed before the comment
+  write(stan::common::recorder::binary::by_column, 3);
+  expect_draws();
+  write(stan::common::recorder::binary::by_column, 1024);
+  expect_draws();
+}
+
+TEST_F(StanCommonRecorderBinary, variable_dims) {
+  write(stan::common::recorder::binary::by_iteration, 1024);
+  stan::io::stan_binary_reader reader(file_name);
+
+  ASSERT_EQ(2U, reader.variable_names().size());
+  EXPECT_EQ("lp__", reader.variable_names()[0]);
+  EXPECT_EQ(0U, reader.variable_dims()[0].size());
+  EXPECT_EQ("theta", reader.variable_names()[1]);
+  ASSERT_EQ(2U, reader.variable_dims()[1].size());
+  EXPECT_EQ(2U, reader.variable_dims()[1][0]);
+  EXPECT_EQ(2U, reader.variable_dims()[1][1]);
+}
+
+TEST_F(StanCommonRecorderBinary, header) {
+  std::stringstream out;
+  stan::common::recorder::binary recorder(&out);
+  EXPECT_TRUE(recorder.is_recording());
+  recorder("ab");
+  std::string x = out.str();
+  ASSERT_EQ(8U + 9U + 2U, x.size());
+  EXPECT_EQ("STANBIN", x.substr(0, 7));
+  EXPECT_EQ(1, x[7]);
+  EXPECT_EQ('C', x[8]);
+  EXPECT_EQ(2, x[9]);
+  EXPECT_EQ("ab", x.substr(17));
+}
+
+TEST_F(StanCommonRecorderBinary, no_stream) {
+  stan::common::recorder::binary recorder(0);
+  EXPECT_FALSE(recorder.is_recording());
+  std::vector<double> x(3, 1.0);
+  EXPECT_NO_THROW(recorder(x));
+  EXPECT_NO_THROW(recorder("comment"));
+  EXPECT_NO_THROW(recorder.flush());
+}
+
+TEST_F(StanCommonRecorderBinary, wrong_size) {
+  std::stringstream out;
+  stan::common::recorder::binary recorder(&out);
+  std::vector<std::string> names(2, "a");
+  recorder(names);
+  std::vector<double> x(3, 1.0);
+  EXPECT_THROW(recorder(x), std::length_error);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <stan/common/recorder/tee.hpp>
+#include <stan/common/recorder/csv.hpp>
+#include <stan/common/recorder/values.hpp>
+#include <sstream>
+#include <vector>
+
+class StanCommonRecorder : public ::testing::Test {
+public:
+  StanCommonRecorder() :
+    N(3), M(2),
+    csv(&ss, "# "),
+    values(N, M),
+    recorder(csv, values) { }
+
+  void SetUp() {
+    ss.str("");
+  }
+
+  void TearDown() { }
+
+  int N;
+  int M;
+  std::stringstream ss;
+  stan::common::recorder::csv csv;
+  stan::common::recorder::values<std::vector<double> > values;
+  stan::common::recorder::tee<stan::common::recorder::csv,
+                              stan::common::recorder::values<std::vector<double> > >
+  recorder;
+};
+
+TEST_F(StanCommonRecorder, tee_vector_double) {
+  std::vector<double> x;
+  for (int n = 1; n <= N; n++)
+    x.push_back(n);
+  EXPECT_NO_THROW(recorder(x));
+  EXPECT_EQ("1,2,3\n", ss.str());
+  for (int n = 0; n < N; n++)
+    EXPECT_FLOAT_EQ(x[n], values.x()[n][0]);
+
+  EXPECT_NO_THROW(recorder(x));
+  EXPECT_FALSE(values.is_recording());
+
+  // values is full; only the csv recorder sees the third vector
+  ss.str("");
+  EXPECT_NO_THROW(recorder(x));
+  EXPECT_EQ("1,2,3\n", ss.str());
+  EXPECT_TRUE(recorder.is_recording());
+}
+
+TEST_F(StanCommonRecorder, tee_vector_string) {
+  std::vector<std::string> y;
+  y.push_back("abc");
+  y.push_back("def");
+  EXPECT_NO_THROW(recorder(y));
+  EXPECT_EQ("abc,def\n", ss.str());
+  EXPECT_TRUE(values.is_recording());
+}
+
+TEST_F(StanCommonRecorder, tee_string) {
+  EXPECT_NO_THROW(recorder("abcd"));
+  EXPECT_EQ("# abcd\n", ss.str());
+}
+
+TEST_F(StanCommonRecorder, tee_noargs) {
+  EXPECT_NO_THROW(recorder());
+  EXPECT_EQ("\n", ss.str());
+}
+
+TEST_F(StanCommonRecorder, tee_is_recording) {
+  stan::common::recorder::csv no_stream(0, "# ");
+  stan::common::recorder::values<std::vector<double> > empty(N, 0);
+  stan::common::recorder::tee<stan::common::recorder::csv,
+                              stan::common::recorder::values<std::vector<double> > >
+    off(no_stream, empty);
+  EXPECT_TRUE(recorder.is_recording());
+  EXPECT_FALSE(off.is_recording());
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <stan/common/run_markov_chain.hpp>
+#include <stan/mcmc/chains_summary.hpp>
 #include <test/test-models/good/common/test_lp.hpp>
 #include <sstream>
 
@@ -127,3 +128,29 @@ TEST_F(StanCommon, run_markov_chain) {
   EXPECT_EQ("", writer_output.str());
 }
 
+
+TEST_F(StanCommon, run_markov_chain_online_summary) {
+  stan::mcmc::online_summary summary(26);
+  stan::common::recorder::csv diagnostic_recorder(&diagnostic_output, "# ");
+  stan::common::recorder::messages message_recorder(&message_output, "# ");
+  stan::io::mcmc_writer<stan_model,
+                        stan::mcmc::online_summary,
+                        stan::common::recorder::csv,
+                        stan::common::recorder::messages>
+    summary_writer(summary, diagnostic_recorder, message_recorder,
+                   &writer_output);
+
+  Eigen::VectorXd params = Eigen::VectorXd::Zero(model->num_params_r());
+  stan::mcmc::sample s(params, log_prob, stat);
+  std::stringstream ss;
+  mock_callback callback;
+
+  stan::common::run_markov_chain(sampler, 51, 49, 100, 2, 4, true, false,
+                                 summary_writer, s, *model, base_rng,
+                                 "", "\n", ss, callback);
+
+  EXPECT_EQ(26U, summary.num_draws());
+  stan::mcmc::chains_summary s_summary = summary.summarize();
+  ASSERT_LT(0, s_summary.mean.size());
+  EXPECT_FLOAT_EQ(0, s_summary.mean(0));
+}
@@ -0,0 +1,79 @@
+#include <stan/common/run_sampler.hpp>
+#include <gtest/gtest.h>
+#include <test/test-models/good/common/test_lp.hpp>
+#include <sstream>
+
+typedef boost::ecuyer1988 rng_t;
+
+class mock_sampler : public stan::mcmc::base_mcmc {
+public:
+  mock_sampler(std::ostream *output, std::ostream *error)
+    : base_mcmc(output, error), n_transition_called(0) { }
+
+  stan::mcmc::sample transition(stan::mcmc::sample& init_sample) {
+    n_transition_called++;
+    return stan::mcmc::sample(init_sample.cont_params(),
+                              n_transition_called, 0);
+  }
+
+  int n_transition_called;
+};
+
+TEST(StanCommon, chain_file_name) {
+  using stan::common::chain_file_name;
+  EXPECT_EQ("output.csv", chain_file_name("output.csv", 0, 1));
+  EXPECT_EQ("", chain_file_name("", 2, 4));
+  EXPECT_EQ("output_1.csv", chain_file_name("output.csv", 0, 4));
+  EXPECT_EQ("output_4.csv", chain_file_name("output.csv", 3, 4));
+  EXPECT_EQ("output_2", chain_file_name("output", 1, 4));
+  EXPECT_EQ("a.b/output_2", chain_file_name("a.b/output", 1, 4));
+  EXPECT_EQ("a.b/output_2.csv", chain_file_name("a.b/output.csv", 1, 4));
+}
+
+TEST(StanCommon, run_sampler) {
+  std::fstream empty_data_stream(std::string("").c_str());
+  stan::io::dump empty_data_context(empty_data_stream);
+  empty_data_stream.close();
+
+  std::stringstream model_output, output, error, sample_output,
+    diagnostic_output, progress;
+  stan_model model(empty_data_context, &model_output);
+  mock_sampler sampler(&output, &error);
+  rng_t base_rng(123456);
+
+  Eigen::VectorXd q = Eigen::VectorXd::Zero(model.num_params_r());
+  stan::mcmc::sample s(q, 0, 0);
+
+  int num_warmup = 10;
+  int num_samples = 20;
+  int num_thin = 3;
+
+  std::vector<std::string> names;
+  s.get_sample_param_names(names);
+  sampler.get_sampler_param_names(names);
+  model.constrained_param_names(names, true, true);
+
+  stan::mcmc::online_summary summary(7);
+  stan::common::recorder::csv sample_recorder(&sample_output, "# ");
+  stan::common::run_sampler<stan_model, rng_t>(&sampler, false,
+                                               num_warmup, num_samples,
+                                               num_thin, 5, false,
+                                               model, base_rng, s,
+                                               sample_recorder,
+                                               &diagnostic_output,
+                                               summary, "Chain [1] ",
+                                               progress);
+
+  EXPECT_EQ(num_warmup + num_samples, sampler.n_transition_called);
+  // lp__ holds the transition count of the kept sampling iterations,
+  // num_warmup + 1 + m * num_thin for m = 0, ..., 6
+  ASSERT_EQ(7U, summary.num_draws());
+  stan::mcmc::chains_summary s_summary = summary.summarize();
+  ASSERT_EQ(static_cast<int>(names.size()), s_summary.mean.size());
+  EXPECT_FLOAT_EQ(num_warmup + 1 + 3 * num_thin, s_summary.mean(0));
+  EXPECT_FLOAT_EQ(std::sqrt(14.0 / 3.0) * num_thin, s_summary.sd(0));
+
+  EXPECT_EQ(0U, sample_output.str().find("lp__,accept_stat__"));
+  EXPECT_NE(std::string::npos, sample_output.str().find("Elapsed Time"));
+  EXPECT_NE(std::string::npos, progress.str().find("Chain [1] Iteration: 30 / 30"));
+}
@@ -0,0 +1,72 @@
+#include <stan/common/unconstrain_draws.hpp>
+#include <gtest/gtest.h>
+#include <test/test-models/good/common/unconstrain_draws.hpp>
+#include <cmath>
+#include <sstream>
+
+typedef unconstrain_draws_model_namespace::unconstrain_draws_model Model;
+
+class CommonUnconstrainDraws : public testing::Test {
+public:
+  void SetUp() {
+    std::stringstream empty_data_stream("");
+    stan::io::dump empty_data_context(empty_data_stream);
+    model_ptr = new Model(empty_data_context, &model_output);
+
+    // columns as read by stan_csv_reader, not in model order
+    const char* names[] = { "lp__", "s[2]", "a[1,1]", "a[2,1]", "a[1,2]",
+                            "a[2,2]", "a[1,3]", "a[2,3]", "s[1]", "t", "g" };
+    header.resize(11);
+    for (int j = 0; j < 11; ++j)
+      header(j) = names[j];
+    draws.resize(2, 11);
+    draws << -3, 2.0, 1, 2, 3, 4, 5, 6, 0.5, 0.5, 1,
+             -4, 0.1, -1, -2, -3, -4, -5, -6, 3.0, 3.0, 1;
+  }
+  
+  void TearDown() {
+    delete model_ptr;
+  }
+  
+  Model* model_ptr;
+  std::stringstream model_output;
+  Eigen::Matrix<std::string, Eigen::Dynamic, 1> header;
+  Eigen::MatrixXd draws;
+};
+
+TEST_F(CommonUnconstrainDraws, unconstrain) {
+  Eigen::MatrixXd params_r;
+  std::stringstream out;
+  EXPECT_TRUE(stan::common::unconstrain_draws(*model_ptr, header, draws,
+                                              params_r, &out));
+  EXPECT_EQ("", out.str());
+  ASSERT_EQ(8, params_r.rows());
+  ASSERT_EQ(2, params_r.cols());
+  // arrays are unconstrained in row-major order
+  int a_cols[] = { 2, 4, 6, 3, 5, 7 };
+  for (int n = 0; n < 2; ++n) {
+    for (int i = 0; i < 6; ++i)
+      EXPECT_FLOAT_EQ(draws(n, a_cols[i]), params_r(i, n));
+    EXPECT_FLOAT_EQ(std::log(draws(n, 8)), params_r(6, n));
+    EXPECT_FLOAT_EQ(std::log(draws(n, 1)), params_r(7, n));
+  }
+}
+
+TEST_F(CommonUnconstrainDraws, missing_column) {
+  header(3) = "b[2,1]";
+  Eigen::MatrixXd params_r;
+  std::stringstream out;
+  EXPECT_FALSE(stan::common::unconstrain_draws(*model_ptr, header, draws,
+                                               params_r, &out));
+  EXPECT_EQ("Draws have no column a[2,1]\n", out.str());
+}
+
+TEST_F(CommonUnconstrainDraws, out_of_support) {
+  draws(1, 1) = -1;
+  Eigen::MatrixXd params_r;
+  std::stringstream out;
+  EXPECT_FALSE(stan::common::unconstrain_draws(*model_ptr, header, draws,
+                                               params_r, &out));
+  EXPECT_NE(std::string::npos,
+            out.str().find("Draw 2 could not be transformed."));
+}
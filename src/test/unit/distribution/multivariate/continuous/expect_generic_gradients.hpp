@@ -0,0 +1,172 @@
+#ifndef TEST__UNIT__DISTRIBUTION__MULTIVARIATE__CONTINUOUS__EXPECT_GENERIC_GRADIENTS_HPP
+#define TEST__UNIT__DISTRIBUTION__MULTIVARIATE__CONTINUOUS__EXPECT_GENERIC_GRADIENTS_HPP
+
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+#include <stan/agrad/rev.hpp>
+#include <stan/math/matrix/Eigen.hpp>
+
+// Appends the independent variables of a density argument, which
+// is a scalar, a matrix or an array of vectors, to x.
+inline void append_vars(std::vector<stan::agrad::var>& x,
+                        const stan::agrad::var& y) {
+  x.push_back(y);
+}
+
+inline void append_vars(std::vector<stan::agrad::var>& /* x */,
+                        double /* y */) { }
+
+template <int R, int C>
+void append_vars(std::vector<stan::agrad::var>& x,
+                 const Eigen::Matrix<stan::agrad::var,R,C>& m) {
+  for (int i = 0; i < m.size(); ++i)
+    x.push_back(m(i));
+}
+
+template <int R, int C>
+void append_vars(std::vector<stan::agrad::var>& /* x */,
+                 const Eigen::Matrix<double,R,C>& /* m */) { }
+
+template <typename T, int R, int C>
+void append_vars(std::vector<stan::agrad::var>& x,
+                 const std::vector<Eigen::Matrix<T,R,C> >& v) {
+  for (size_t n = 0; n < v.size(); ++n)
+    append_vars(x, v[n]);
+}
+
+// Returns a well-conditioned symmetric, positive-definite matrix.
+inline Eigen::MatrixXd spd_matrix(int K, double shift = 0) {
+  Eigen::MatrixXd B(K, K);
+  for (int j = 0; j < K; ++j)
+    for (int i = 0; i < K; ++i)
+      B(i,j) = std::sin(i + 2.0 * j + shift);
+  Eigen::MatrixXd A = B * B.transpose();
+  A.diagonal().array() += K;
+  return A;
+}
+
+// Returns a vector of size K with distinct elements.
+template <typename T>
+Eigen::Matrix<T,Eigen::Dynamic,1> test_vector(int K, double shift = 0) {
+  Eigen::Matrix<T,Eigen::Dynamic,1> v(K);
+  for (int k = 0; k < K; ++k)
+    v(k) = std::sin(shift + 3.0 * k);
+  return v;
+}
+
+// Returns N vectors of size K with distinct elements.
+template <typename T>
+std::vector<Eigen::Matrix<T,Eigen::Dynamic,1> >
+test_vectors(int N, int K, double shift = 0) {
+  std::vector<Eigen::Matrix<T,Eigen::Dynamic,1> > v;
+  for (int n = 0; n < N; ++n)
+    v.push_back(test_vector<T>(K, shift + 1.7 * n));
+  return v;
+}
+
+// Expects a log density recorded on a single node to have the same
+// value and gradient with respect to x as the generic log density,
+// which is recorded one operation at a time, then recovers the
+// autodiff memory.
+inline void expect_same_gradients(const stan::agrad::var& lp_generic,
+                                  const stan::agrad::var& lp,
+                                  std::vector<stan::agrad::var> x,
+                                  double tol) {
+  EXPECT_FLOAT_EQ(lp_generic.val(), lp.val());
+
+  std::vector<double> grad, grad_generic;
+  stan::agrad::var(lp).grad(x, grad);
+  stan::agrad::set_zero_all_adjoints();
+  stan::agrad::var(lp_generic).grad(x, grad_generic);
+  ASSERT_EQ(grad_generic.size(), grad.size());
+  for (size_t i = 0; i < grad.size(); ++i)
+    EXPECT_NEAR(grad_generic[i], grad[i], tol) << "operand " << i;
+  stan::agrad::recover_memory();
+}
+
+// Expects the log density of a multivariate distribution to be
+// recorded on a single stack node and to match its generic version
+// in value and gradient.  F provides, for the arguments of the
+// density,
+//
+//   template <bool propto, ...> var log_prob(...) const;
+//   template <bool propto, ...> var generic(...) const;
+//
+// and the absolute tolerance of the gradient, tol.
+template <bool propto, class F, typename T1, typename T2>
+void expect_generic_gradients(const F& f, const T1& x1, const T2& x2) {
+  std::vector<stan::agrad::var> x;
+  append_vars(x, x1);
+  append_vars(x, x2);
+
+  size_t stack_size = stan::agrad::ChainableStack::var_stack_.size();
+  stan::agrad::var lp = f.template log_prob<propto>(x1, x2);
+  EXPECT_EQ(stack_size + 1, stan::agrad::ChainableStack::var_stack_.size());
+
+  stan::agrad::var lp_generic = f.template generic<propto>(x1, x2);
+  expect_same_gradients(lp_generic, lp, x, f.tol);
+}
+
+template <bool propto, class F, typename T1, typename T2, typename T3>
+void expect_generic_gradients(const F& f,
+                              const T1& x1, const T2& x2, const T3& x3) {
+  std::vector<stan::agrad::var> x;
+  append_vars(x, x1);
+  append_vars(x, x2);
+  append_vars(x, x3);
+
+  size_t stack_size = stan::agrad::ChainableStack::var_stack_.size();
+  stan::agrad::var lp = f.template log_prob<propto>(x1, x2, x3);
+  EXPECT_EQ(stack_size + 1, stan::agrad::ChainableStack::var_stack_.size());
+
+  stan::agrad::var lp_generic = f.template generic<propto>(x1, x2, x3);
+  expect_same_gradients(lp_generic, lp, x, f.tol);
+}
+
+template <bool propto, class F,
+          typename T1, typename T2, typename T3, typename T4>
+void expect_generic_gradients(const F& f,
+                              const T1& x1, const T2& x2, const T3& x3,
+                              const T4& x4) {
+  std::vector<stan::agrad::var> x;
+  append_vars(x, x1);
+  append_vars(x, x2);
+  append_vars(x, x3);
+  append_vars(x, x4);
+
+  size_t stack_size = stan::agrad::ChainableStack::var_stack_.size();
+  stan::agrad::var lp = f.template log_prob<propto>(x1, x2, x3, x4);
+  EXPECT_EQ(stack_size + 1, stan::agrad::ChainableStack::var_stack_.size());
+
+  stan::agrad::var lp_generic = f.template generic<propto>(x1, x2, x3, x4);
+  expect_same_gradients(lp_generic, lp, x, f.tol);
+}
+
+template <bool propto, class F,
+          typename T1, typename T2, typename T3, typename T4,
+          typename T5, typename T6, typename T7>
+void expect_generic_gradients(const F& f,
+                              const T1& x1, const T2& x2, const T3& x3,
+                              const T4& x4, const T5& x5, const T6& x6,
+                              const T7& x7) {
+  std::vector<stan::agrad::var> x;
+  append_vars(x, x1);
+  append_vars(x, x2);
+  append_vars(x, x3);
+  append_vars(x, x4);
+  append_vars(x, x5);
+  append_vars(x, x6);
+  append_vars(x, x7);
+
+  size_t stack_size = stan::agrad::ChainableStack::var_stack_.size();
+  stan::agrad::var lp
+    = f.template log_prob<propto>(x1, x2, x3, x4, x5, x6, x7);
+  EXPECT_EQ(stack_size + 1, stan::agrad::ChainableStack::var_stack_.size());
+
+  stan::agrad::var lp_generic
+    = f.template generic<propto>(x1, x2, x3, x4, x5, x6, x7);
+  expect_same_gradients(lp_generic, lp, x, f.tol);
+}
+
+#endif
@@ -2,6 +2,7 @@
 #include <stan/agrad/rev/matrix.hpp>
 #include <stan/prob/distributions/multivariate/continuous/inv_wishart.hpp>
 #include <test/unit/distribution/expect_eq_diffs.hpp>
+#include <test/unit/distribution/multivariate/continuous/expect_generic_gradients.hpp>
 
 
 template <typename T_y, typename T_dof, typename T_scale>
@@ -84,3 +85,37 @@ TEST_F(AgradDistributionsInvWishart,ProptoSigma) {
                 "var: sigma");
 }
 
+
+struct inv_wishart_density {
+  double tol;
+  inv_wishart_density() : tol(1e-8) { }
+
+  template <bool propto, typename T_y, typename T_dof, typename T_scale>
+  var log_prob(const Matrix<T_y,Dynamic,Dynamic>& W, const T_dof& nu,
+               const Matrix<T_scale,Dynamic,Dynamic>& S) const {
+    return stan::prob::inv_wishart_log<propto>(W, nu, S);
+  }
+
+  template <bool propto, typename T_y, typename T_dof, typename T_scale>
+  var generic(const Matrix<T_y,Dynamic,Dynamic>& W, const T_dof& nu,
+              const Matrix<T_scale,Dynamic,Dynamic>& S) const {
+    stan::math::LDLT_factor<T_y,Dynamic,Dynamic> ldlt_W(W);
+    stan::math::LDLT_factor<T_scale,Dynamic,Dynamic> ldlt_S(S);
+    return stan::prob::inv_wishart_lp<propto, T_y, T_dof, T_scale, var, true>
+      ::apply(W, nu, S, ldlt_W, ldlt_S, W.rows());
+  }
+};
+
+TEST(InvWishart, GradientsMatchGeneric) {
+  inv_wishart_density f;
+  expect_generic_gradients<false>(f, to_var(spd_matrix(1)), var(2.5),
+                                  to_var(spd_matrix(1, 1.0)));
+  expect_generic_gradients<false>(f, to_var(spd_matrix(4)), var(6.5),
+                                  to_var(spd_matrix(4, 1.0)));
+  expect_generic_gradients<false>(f, spd_matrix(4), var(4.5),
+                                  to_var(spd_matrix(4, 1.0)));
+  expect_generic_gradients<false>(f, to_var(spd_matrix(4)), 7.0,
+                                  spd_matrix(4, 1.0));
+  expect_generic_gradients<true>(f, to_var(spd_matrix(4)), var(6.5),
+                                 spd_matrix(4, 1.0));
+}
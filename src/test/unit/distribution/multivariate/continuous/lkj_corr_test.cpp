@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <stan/agrad/rev/matrix.hpp>
+#include <stan/prob/distributions/multivariate/continuous/lkj_corr.hpp>
+#include <test/unit/distribution/multivariate/continuous/expect_generic_gradients.hpp>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+using stan::agrad::var;
+using stan::agrad::to_var;
+using std::vector;
+
+Eigen::MatrixXd corr_matrix(int K) {
+  Eigen::MatrixXd Sigma = spd_matrix(K);
+  Eigen::VectorXd inv_sd = Sigma.diagonal().array().sqrt().inverse();
+  return inv_sd.asDiagonal() * Sigma * inv_sd.asDiagonal();
+}
+
+struct lkj_corr_density {
+  double tol;
+  lkj_corr_density() : tol(1e-8) { }
+
+  template <bool propto, typename T_y, typename T_shape>
+  var log_prob(const Matrix<T_y,Dynamic,Dynamic>& y,
+               const T_shape& eta) const {
+    return stan::prob::lkj_corr_log<propto>(y, eta);
+  }
+
+  template <bool propto, typename T_y, typename T_shape>
+  var generic(const Matrix<T_y,Dynamic,Dynamic>& y,
+              const T_shape& eta) const {
+    return stan::prob::lkj_corr_lp<propto, T_y, T_shape, var, true>
+      ::apply(y, eta, y.rows());
+  }
+};
+
+struct lkj_corr_cholesky_density {
+  double tol;
+  lkj_corr_cholesky_density() : tol(1e-8) { }
+
+  template <bool propto, typename T_covar, typename T_shape>
+  var log_prob(const Matrix<T_covar,Dynamic,Dynamic>& L,
+               const T_shape& eta) const {
+    return stan::prob::lkj_corr_cholesky_log<propto>(L, eta);
+  }
+
+  template <bool propto, typename T_covar, typename T_shape>
+  var generic(const Matrix<T_covar,Dynamic,Dynamic>& L,
+              const T_shape& eta) const {
+    return stan::prob::lkj_corr_cholesky_lp<propto, T_covar, T_shape, var, true>
+      ::apply(L, eta, L.rows());
+  }
+};
+
+TEST(LkjCorr, GradientsMatchGeneric) {
+  lkj_corr_density f;
+  expect_generic_gradients<false>(f, to_var(corr_matrix(1)), var(2.5));
+  expect_generic_gradients<false>(f, to_var(corr_matrix(4)), var(2.5));
+  expect_generic_gradients<false>(f, to_var(corr_matrix(4)), var(1.0));
+  expect_generic_gradients<false>(f, to_var(corr_matrix(5)), 0.5);
+  expect_generic_gradients<false>(f, corr_matrix(5), var(3.0));
+  expect_generic_gradients<true>(f, to_var(corr_matrix(4)), var(2.5));
+}
+
+TEST(LkjCorrCholesky, GradientsMatchGeneric) {
+  Eigen::MatrixXd L4 = corr_matrix(4).llt().matrixL();
+  Eigen::MatrixXd L5 = corr_matrix(5).llt().matrixL();
+  lkj_corr_cholesky_density f;
+  expect_generic_gradients<false>(f, to_var(L4), var(2.5));
+  expect_generic_gradients<false>(f, to_var(L4), var(1.0));
+  expect_generic_gradients<false>(f, to_var(L5), 0.5);
+  expect_generic_gradients<true>(f, to_var(L4), var(2.5));
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <stan/agrad/rev/matrix.hpp>
+#include <stan/prob/distributions/multivariate/continuous/matrix_normal.hpp>
+#include <test/unit/distribution/multivariate/continuous/expect_generic_gradients.hpp>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+using stan::agrad::var;
+using stan::agrad::to_var;
+using std::vector;
+
+struct matrix_normal_prec_density {
+  double tol;
+  matrix_normal_prec_density() : tol(1e-8) { }
+
+  template <bool propto,
+            typename T_y, typename T_Mu, typename T_Sigma, typename T_D>
+  var log_prob(const Matrix<T_y,Dynamic,Dynamic>& y,
+               const Matrix<T_Mu,Dynamic,Dynamic>& Mu,
+               const Matrix<T_Sigma,Dynamic,Dynamic>& Sigma,
+               const Matrix<T_D,Dynamic,Dynamic>& D) const {
+    return stan::prob::matrix_normal_prec_log<propto>(y, Mu, Sigma, D);
+  }
+
+  template <bool propto,
+            typename T_y, typename T_Mu, typename T_Sigma, typename T_D>
+  var generic(const Matrix<T_y,Dynamic,Dynamic>& y,
+              const Matrix<T_Mu,Dynamic,Dynamic>& Mu,
+              const Matrix<T_Sigma,Dynamic,Dynamic>& Sigma,
+              const Matrix<T_D,Dynamic,Dynamic>& D) const {
+    stan::math::LDLT_factor<T_Sigma,Dynamic,Dynamic> ldlt_Sigma(Sigma);
+    stan::math::LDLT_factor<T_D,Dynamic,Dynamic> ldlt_D(D);
+    return stan::prob::matrix_normal_prec_lp<propto, T_y, T_Mu, T_Sigma, T_D,
+                                             var, true>
+      ::apply(y, Mu, Sigma, D, ldlt_Sigma, ldlt_D);
+  }
+};
+
+TEST(MatrixNormalPrec, GradientsMatchGeneric) {
+  Eigen::MatrixXd y(3, 5);
+  Eigen::MatrixXd Mu(3, 5);
+  for (int i = 0; i < y.size(); ++i) {
+    y(i) = std::cos(1.3 * i);
+    Mu(i) = 0.2 * std::sin(0.7 * i);
+  }
+  Eigen::MatrixXd Sigma = spd_matrix(3);
+  Eigen::MatrixXd D = spd_matrix(5, 1.0);
+
+  matrix_normal_prec_density f;
+  expect_generic_gradients<false>(f, to_var(y), to_var(Mu),
+                                  to_var(Sigma), to_var(D));
+  expect_generic_gradients<false>(f, to_var(y), Mu, Sigma, D);
+  expect_generic_gradients<false>(f, y, to_var(Mu), to_var(Sigma), D);
+  expect_generic_gradients<false>(f, y, Mu, Sigma, to_var(D));
+  expect_generic_gradients<true>(f, to_var(y), to_var(Mu),
+                                 to_var(Sigma), to_var(D));
+}
@@ -7,6 +7,7 @@
 #include <test/unit/distribution/expect_eq_diffs.hpp>
 #include <test/unit/distribution/multivariate/continuous/test_gradients.hpp>
 #include <test/unit/distribution/multivariate/continuous/agrad_distributions_multi_gp.hpp>
+#include <test/unit/distribution/multivariate/continuous/expect_generic_gradients.hpp>
 
 using Eigen::Dynamic;
 using Eigen::Matrix;
@@ -209,3 +210,40 @@ TEST(MultiGP, TestGradFunctional) {
   
   test_grad(multi_gp_fun(1,1), u);
 }
+
+struct multi_gp_density {
+  double tol;
+  multi_gp_density() : tol(1e-8) { }
+
+  template <bool propto, typename T_y, typename T_covar, typename T_w>
+  var log_prob(const Matrix<T_y,Dynamic,Dynamic>& y,
+               const Matrix<T_covar,Dynamic,Dynamic>& Sigma,
+               const Matrix<T_w,Dynamic,1>& w) const {
+    return stan::prob::multi_gp_log<propto>(y, Sigma, w);
+  }
+
+  template <bool propto, typename T_y, typename T_covar, typename T_w>
+  var generic(const Matrix<T_y,Dynamic,Dynamic>& y,
+              const Matrix<T_covar,Dynamic,Dynamic>& Sigma,
+              const Matrix<T_w,Dynamic,1>& w) const {
+    stan::math::LDLT_factor<T_covar,Dynamic,Dynamic> ldlt_Sigma(Sigma);
+    return stan::prob::multi_gp_lp<propto, T_y, T_covar, T_w, var, true>
+      ::apply(y, Sigma, w, ldlt_Sigma);
+  }
+};
+
+TEST(MultiGP, GradientsMatchGeneric) {
+  Eigen::MatrixXd y(3, 5);
+  for (int i = 0; i < y.size(); ++i)
+    y(i) = std::cos(1.3 * i);
+  Eigen::VectorXd w(3);
+  w << 1.5, 0.3, 2.2;
+  multi_gp_density f;
+  expect_generic_gradients<false>(f, to_var(y), to_var(spd_matrix(5)),
+                                  to_var(w));
+  expect_generic_gradients<false>(f, to_var(y), spd_matrix(5), w);
+  expect_generic_gradients<false>(f, y, to_var(spd_matrix(5)), w);
+  expect_generic_gradients<false>(f, y, spd_matrix(5), to_var(w));
+  expect_generic_gradients<true>(f, to_var(y), to_var(spd_matrix(5)),
+                                 to_var(w));
+}
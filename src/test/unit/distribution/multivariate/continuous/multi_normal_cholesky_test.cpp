@@ -7,6 +7,7 @@
 #include <test/unit/distribution/multivariate/continuous/test_gradients.hpp>
 #include <test/unit/distribution/multivariate/continuous/test_gradients_multi_normal.hpp>
 #include <test/unit/distribution/expect_eq_diffs.hpp>
+#include <test/unit/distribution/multivariate/continuous/expect_generic_gradients.hpp>
 
 
 using Eigen::Dynamic;
@@ -249,3 +250,76 @@ TEST(MultiNormal, TestGradFunctionalVectorized) {
   test_all<-1,1>();
   test_all<-1,-1>();
 }
+
+struct multi_normal_cholesky_density {
+  double tol;
+  multi_normal_cholesky_density() : tol(1e-10) { }
+
+  template <bool propto, typename T_y, typename T_loc, typename T_covar>
+  var log_prob(const T_y& y, const T_loc& mu,
+               const Matrix<T_covar,Dynamic,Dynamic>& L) const {
+    return stan::prob::multi_normal_cholesky_log<propto>(y, mu, L);
+  }
+
+  template <bool propto, typename T_y, typename T_loc, typename T_covar>
+  var generic(const T_y& y, const T_loc& mu,
+              const Matrix<T_covar,Dynamic,Dynamic>& L) const {
+    return stan::prob::multi_normal_cholesky_lp<propto, T_y, T_loc, T_covar,
+                                                var, true>
+      ::apply(y, mu, L, stan::max_size_mvt(y, mu), L.rows());
+  }
+};
+
+Eigen::MatrixXd cholesky_factor(int K) {
+  Eigen::MatrixXd L(K, K);
+  for (int j = 0; j < K; ++j)
+    for (int i = 0; i < K; ++i)
+      L(i,j) = i < j ? 0 : (i == j ? 1.5 + 0.1 * i : 0.3 * std::sin(i - j));
+  return L;
+}
+
+TEST(MultiNormalCholesky, GradientsMatchGeneric) {
+  multi_normal_cholesky_density f;
+  expect_generic_gradients<false>(f, test_vectors<var>(1, 1),
+                                  test_vectors<var>(1, 1, 0.5),
+                                  to_var(cholesky_factor(1)));
+  expect_generic_gradients<false>(f, test_vectors<var>(1, 3),
+                                  test_vectors<var>(1, 3, 0.5),
+                                  to_var(cholesky_factor(3)));
+  expect_generic_gradients<false>(f, test_vectors<var>(7, 4),
+                                  test_vectors<var>(7, 4, 0.5),
+                                  to_var(cholesky_factor(4)));
+  expect_generic_gradients<false>(f, test_vectors<double>(7, 4),
+                                  test_vector<var>(4, 0.5),
+                                  cholesky_factor(4));
+  expect_generic_gradients<true>(f, test_vectors<var>(7, 4),
+                                 test_vector<double>(4, 0.5),
+                                 to_var(cholesky_factor(4)));
+}
+
+TEST(MultiNormalCholesky, OneStackEntry) {
+  int K = 5;
+  int N = 20;
+  vector<Matrix<double,Dynamic,1> > y(N, Matrix<double,Dynamic,1>(K));
+  for (int n = 0; n < N; ++n)
+    for (int k = 0; k < K; ++k)
+      y[n](k) = n - k;
+  Matrix<double,Dynamic,1> mu(K);
+  Matrix<var,Dynamic,Dynamic> L(K,K);
+  for (int k = 0; k < K; ++k) {
+    mu(k) = k;
+    for (int j = 0; j < K; ++j)
+      L(k,j) = k == j ? 2 : 0;
+  }
+  size_t stack_size = stan::agrad::ChainableStack::var_stack_.size();
+  var lp = stan::prob::multi_normal_cholesky_log(y, mu, L);
+  EXPECT_EQ(stack_size + 1, stan::agrad::ChainableStack::var_stack_.size());
+
+  // only the lower triangle of L is an operand
+  vector<var> x;
+  x.push_back(L(0,1));
+  vector<double> grad;
+  lp.grad(x, grad);
+  EXPECT_FLOAT_EQ(0.0, grad[0]);
+  stan::agrad::recover_memory();
+}
@@ -9,6 +9,7 @@
 #include <test/unit/distribution/expect_eq_diffs.hpp>
 #include <test/unit/distribution/multivariate/continuous/agrad_distributions_multi_normal_multi_row.hpp>
 #include <test/unit/distribution/multivariate/continuous/agrad_distributions_multi_normal.hpp>
+#include <test/unit/distribution/multivariate/continuous/expect_generic_gradients.hpp>
 
 
 using Eigen::Dynamic;
@@ -335,3 +336,40 @@ TEST(MultiNormal, TestGradFunctionalVectorized) {
   test_all<-1,1>();
   test_all<-1,-1>();
 }
+
+struct multi_normal_prec_density {
+  double tol;
+  multi_normal_prec_density() : tol(1e-8) { }
+
+  template <bool propto, typename T_y, typename T_loc, typename T_covar>
+  var log_prob(const T_y& y, const T_loc& mu,
+               const Matrix<T_covar,Dynamic,Dynamic>& Sigma) const {
+    return stan::prob::multi_normal_prec_log<propto>(y, mu, Sigma);
+  }
+
+  template <bool propto, typename T_y, typename T_loc, typename T_covar>
+  var generic(const T_y& y, const T_loc& mu,
+              const Matrix<T_covar,Dynamic,Dynamic>& Sigma) const {
+    stan::math::LDLT_factor<T_covar,Dynamic,Dynamic> ldlt_Sigma(Sigma);
+    return stan::prob::multi_normal_prec_lp<propto, T_y, T_loc, T_covar,
+                                            var, true>
+      ::apply(y, mu, Sigma, ldlt_Sigma, stan::max_size_mvt(y, mu),
+              Sigma.rows());
+  }
+};
+
+TEST(MultiNormalPrec, GradientsMatchGeneric) {
+  multi_normal_prec_density f;
+  expect_generic_gradients<false>(f, test_vectors<var>(1, 1),
+                                  test_vectors<var>(1, 1, 0.5),
+                                  to_var(spd_matrix(1, 1.0)));
+  expect_generic_gradients<false>(f, test_vectors<var>(7, 4),
+                                  test_vectors<var>(7, 4, 0.5),
+                                  to_var(spd_matrix(4, 1.0)));
+  expect_generic_gradients<false>(f, test_vectors<double>(7, 4),
+                                  test_vector<var>(4, 0.5),
+                                  to_var(spd_matrix(4, 1.0)));
+  expect_generic_gradients<true>(f, test_vectors<var>(7, 4),
+                                 test_vector<double>(4, 0.5),
+                                 to_var(spd_matrix(4, 1.0)));
+}
@@ -8,7 +8,8 @@
 #include <test/unit/distribution/expect_eq_diffs.hpp>
 #include <test/unit/distribution/multivariate/continuous/test_gradients.hpp>
 #include <test/unit/distribution/multivariate/continuous/test_gradients_multi_student_t.hpp>
-#include <test/unit/distribution/multivariate/continuous/agrad_distributions_multi_student_t.hpp>
+#include <test/unit/distribution/multivariate/continuous/agrad_distributions_multi_student_t.hpp>
+#include <test/unit/distribution/multivariate/continuous/expect_generic_gradients.hpp>
 
 using Eigen::Dynamic;
 using Eigen::Matrix;
@@ -439,3 +440,42 @@ TEST(MultiNormal, TestGradFunctionalVectorized) {
   test_all<-1,1>();
   test_all<-1,-1>();
 }
+
+struct multi_student_t_density {
+  double tol;
+  multi_student_t_density() : tol(1e-8) { }
+
+  template <bool propto,
+            typename T_y, typename T_dof, typename T_loc, typename T_scale>
+  var log_prob(const T_y& y, const T_dof& nu, const T_loc& mu,
+               const Matrix<T_scale,Dynamic,Dynamic>& Sigma) const {
+    return stan::prob::multi_student_t_log<propto>(y, nu, mu, Sigma);
+  }
+
+  template <bool propto,
+            typename T_y, typename T_dof, typename T_loc, typename T_scale>
+  var generic(const T_y& y, const T_dof& nu, const T_loc& mu,
+              const Matrix<T_scale,Dynamic,Dynamic>& Sigma) const {
+    stan::math::LDLT_factor<T_scale,Dynamic,Dynamic> ldlt_Sigma(Sigma);
+    return stan::prob::multi_student_t_lp<propto, T_y, T_dof, T_loc, T_scale,
+                                          var, true>
+      ::apply(y, nu, mu, Sigma, ldlt_Sigma, stan::max_size_mvt(y, mu),
+              Sigma.rows());
+  }
+};
+
+TEST(MultiStudentT, GradientsMatchGeneric) {
+  multi_student_t_density f;
+  expect_generic_gradients<false>(f, test_vectors<var>(1, 1), var(3.5),
+                                  test_vectors<var>(1, 1, 0.5),
+                                  to_var(spd_matrix(1, 2.0)));
+  expect_generic_gradients<false>(f, test_vectors<var>(7, 4), var(5.0),
+                                  test_vectors<var>(7, 4, 0.5),
+                                  to_var(spd_matrix(4, 2.0)));
+  expect_generic_gradients<false>(f, test_vectors<double>(7, 4), 2.5,
+                                  test_vector<var>(4, 0.5),
+                                  to_var(spd_matrix(4, 2.0)));
+  expect_generic_gradients<true>(f, test_vectors<var>(7, 4), var(0.5),
+                                 test_vector<double>(4, 0.5),
+                                 to_var(spd_matrix(4, 2.0)));
+}
@@ -0,0 +1,25 @@
+#include <gtest/gtest.h>
+#include <stan/gm/arguments/arg_output_format.hpp>
+
+TEST(StanGmArguments, arg_output_format) {
+  stan::gm::arg_output_format arg;
+
+  EXPECT_EQ("format", arg.name());
+  EXPECT_EQ("Format of the sample output file", arg.description());
+
+  ASSERT_EQ(2, arg.values().size());
+  EXPECT_EQ("csv", arg.values()[0]->name());
+  EXPECT_EQ("binary", arg.values()[1]->name());
+  EXPECT_EQ("csv", arg.value());
+}
+
+TEST(StanGmArguments, arg_binary_layout) {
+  stan::gm::arg_binary_layout arg;
+
+  EXPECT_EQ("layout", arg.name());
+  EXPECT_EQ("iteration", arg.value());
+  EXPECT_TRUE(arg.set_value("column"));
+  EXPECT_EQ("column", arg.value());
+  EXPECT_FALSE(arg.set_value("row"));
+  EXPECT_EQ("column", arg.value());
+}
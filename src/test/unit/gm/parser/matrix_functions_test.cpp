@@ -41,6 +41,10 @@ TEST(gm_parser, crossprod_matrix_function_signatures) {
   test_parsable("function-signatures/math/matrix/crossprod");
 }
 
+TEST(gm_parser, csr_matrix_times_vector_matrix_function_signatures) {
+  test_parsable("function-signatures/math/matrix/csr_matrix_times_vector");
+}
+
 TEST(gm_parser, cumulative_sum_matrix_function_signatures) {
   test_parsable("function-signatures/math/matrix/cumulative_sum");
 }
@@ -30,3 +30,15 @@ TEST(gm_parser, integrate_ode_bad) {
 
 
 }
+
+TEST(gm_parser, integrate_ode_stiff_good) {
+  test_parsable("ode_stiff_good");
+}
+TEST(gm_parser, integrate_ode_stiff_bad) {
+  test_throws("ode_stiff_bad_t0_var_type",
+              "third argument to integrate_ode_stiff (initial times) must be data only");
+  test_throws("ode_stiff_bad_rel_tol_var_type",
+              "eighth argument to integrate_ode_stiff (relative tolerance) must be data only");
+  test_throws("ode_stiff_bad_max_num_steps_type",
+              "tenth argument to integrate_ode_stiff must be type int");
+}
@@ -68,4 +68,12 @@ TEST(unitGm, odeTest) {
   test_pg("ode", expected);
   test_pg_count("ode", expected, 2);
 }
+
+TEST(unitGm, odeStiffTest) {
+  std::string expected;
+  expected = "stan::math::assign(y_hat, "
+    "integrate_ode_stiff(sho_functor__(), y0, t0, ts, theta, x, x_int, "
+    "pstream__, 1e-08, 1e-08, 1000));";
+  test_pg("ode_stiff", expected);
+}
              
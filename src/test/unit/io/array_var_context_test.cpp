@@ -0,0 +1,66 @@
+#include <stan/io/array_var_context.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+TEST(io_array_var_context, values_and_dims) {
+  std::vector<std::string> names;
+  names.push_back("a");
+  names.push_back("b");
+  names.push_back("c");
+  std::vector<std::vector<size_t> > dims(3);
+  dims[1].push_back(2);
+  dims[1].push_back(3);
+  dims[2].push_back(2);
+  std::vector<double> values;
+  for (int i = 0; i < 9; ++i)
+    values.push_back(i);
+
+  stan::io::array_var_context context(names, values, dims);
+
+  EXPECT_TRUE(context.contains_r("a"));
+  EXPECT_TRUE(context.contains_r("b"));
+  EXPECT_FALSE(context.contains_r("d"));
+  EXPECT_FALSE(context.contains_i("a"));
+
+  std::vector<double> a = context.vals_r("a");
+  ASSERT_EQ(1U, a.size());
+  EXPECT_FLOAT_EQ(0, a[0]);
+  EXPECT_EQ(0U, context.dims_r("a").size());
+
+  std::vector<double> b = context.vals_r("b");
+  ASSERT_EQ(6U, b.size());
+  for (int i = 0; i < 6; ++i)
+    EXPECT_FLOAT_EQ(i + 1, b[i]);
+  EXPECT_NO_THROW(context.validate_dims("test", "b", "double",
+                                        context.to_vec(2, 3)));
+
+  std::vector<double> c = context.vals_r("c");
+  ASSERT_EQ(2U, c.size());
+  EXPECT_FLOAT_EQ(7, c[0]);
+  EXPECT_FLOAT_EQ(8, c[1]);
+
+  EXPECT_EQ(0U, context.vals_r("d").size());
+
+  std::vector<std::string> names_r;
+  context.names_r(names_r);
+  EXPECT_EQ(3U, names_r.size());
+  std::vector<std::string> names_i;
+  context.names_i(names_i);
+  EXPECT_EQ(0U, names_i.size());
+}
+
+TEST(io_array_var_context, size_mismatch) {
+  std::vector<std::string> names(1, "b");
+  std::vector<std::vector<size_t> > dims(1, std::vector<size_t>(1, 3));
+
+  EXPECT_THROW(stan::io::array_var_context(names,
+                                           std::vector<double>(2), dims),
+               std::invalid_argument);
+  EXPECT_THROW(stan::io::array_var_context(names,
+                                           std::vector<double>(4), dims),
+               std::invalid_argument);
+  EXPECT_THROW(stan::io::array_var_context(names,
+                                           std::vector<double>(3),
+                                           std::vector<std::vector<size_t> >()),
+               std::invalid_argument);
+}
@@ -0,0 +1,156 @@
+#include <stan/io/stan_binary_reader.hpp>
+#include <stan/common/recorder/binary.hpp>
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+
+// Each test rewrites a CSV file from test_csv_files with the binary
+// recorder and checks that both readers return the same contents.
+
+class StanIoStanBinaryReader : public testing::Test {
+public:
+  StanIoStanBinaryReader()
+    : file_name("stan_io_stan_binary_reader_test.bin") { }
+
+  void TearDown() {
+    std::remove(file_name.c_str());
+  }
+
+  void csv_to_binary(const std::string& csv_file_name,
+                     stan::common::recorder::binary::layout_t layout) {
+    std::ifstream in(csv_file_name.c_str());
+    std::fstream out(file_name.c_str(),
+                     std::fstream::out | std::fstream::binary);
+    stan::common::recorder::binary recorder(&out, layout);
+    bool header = true;
+    std::string line;
+    while (std::getline(in, line)) {
+      if (line.empty()) {
+        recorder();
+      } else if (line[0] == '#') {
+        recorder(line.substr(std::min<size_t>(2, line.size())));
+      } else {
+        std::vector<std::string> cells;
+        std::stringstream ss(line);
+        std::string cell;
+        while (std::getline(ss, cell, ','))
+          cells.push_back(cell);
+        if (header) {
+          recorder(cells);
+          header = false;
+        } else {
+          std::vector<double> x;
+          for (size_t n = 0; n < cells.size(); ++n)
+            x.push_back(std::strtod(cells[n].c_str(), 0));
+          recorder(x);
+        }
+      }
+    }
+    recorder.flush();
+  }
+
+  void expect_same_as_csv(const std::string& csv_file_name,
+                          stan::common::recorder::binary::layout_t layout) {
+    csv_to_binary(csv_file_name, layout);
+
+    std::ifstream in(csv_file_name.c_str());
+    stan::io::stan_csv csv = stan::io::stan_csv_reader::parse(in);
+    stan::io::stan_binary_reader reader(file_name);
+    std::stringstream warnings;
+    stan::io::stan_csv bin = reader.parse(&warnings);
+    EXPECT_EQ("", warnings.str());
+
+    EXPECT_EQ(csv.metadata.stan_version_major, bin.metadata.stan_version_major);
+    EXPECT_EQ(csv.metadata.model, bin.metadata.model);
+    EXPECT_EQ(csv.metadata.data, bin.metadata.data);
+    EXPECT_EQ(csv.metadata.seed, bin.metadata.seed);
+    EXPECT_EQ(csv.metadata.num_samples, bin.metadata.num_samples);
+    EXPECT_EQ(csv.metadata.thin, bin.metadata.thin);
+    EXPECT_EQ(csv.metadata.algorithm, bin.metadata.algorithm);
+    EXPECT_EQ(csv.metadata.engine, bin.metadata.engine);
+
+    ASSERT_EQ(csv.header.size(), bin.header.size());
+    for (int n = 0; n < csv.header.size(); ++n)
+      EXPECT_EQ(csv.header(n), bin.header(n));
+
+    EXPECT_FLOAT_EQ(csv.adaptation.step_size, bin.adaptation.step_size);
+    ASSERT_EQ(csv.adaptation.metric.size(), bin.adaptation.metric.size());
+    for (int n = 0; n < csv.adaptation.metric.size(); ++n)
+      EXPECT_FLOAT_EQ(csv.adaptation.metric(n), bin.adaptation.metric(n));
+
+    ASSERT_EQ(csv.samples.rows(), bin.samples.rows());
+    ASSERT_EQ(csv.samples.cols(), bin.samples.cols());
+    EXPECT_TRUE(csv.samples == bin.samples);
+
+    EXPECT_FLOAT_EQ(csv.timing.warmup, bin.timing.warmup);
+    EXPECT_FLOAT_EQ(csv.timing.sampling, bin.timing.sampling);
+  }
+
+  std::string file_name;
+};
+
+TEST_F(StanIoStanBinaryReader, parse_blocker) {
+  expect_same_as_csv("src/test/unit/io/test_csv_files/blocker.0.csv",
+                     stan::common::recorder::binary::by_iteration);
+  expect_same_as_csv("src/test/unit/io/test_csv_files/blocker.0.csv",
+                     stan::common::recorder::binary::by_column);
+}
+
+TEST_F(StanIoStanBinaryReader, parse_epil) {
+  expect_same_as_csv("src/test/unit/io/test_csv_files/epil.0.csv",
+                     stan::common::recorder::binary::by_iteration);
+  expect_same_as_csv("src/test/unit/io/test_csv_files/epil.0.csv",
+                     stan::common::recorder::binary::by_column);
+}
+
+TEST_F(StanIoStanBinaryReader, not_binary) {
+  EXPECT_THROW(stan::io::stan_binary_reader
+               reader("src/test/unit/io/test_csv_files/blocker.0.csv"),
+               std::invalid_argument);
+}
+
+TEST_F(StanIoStanBinaryReader, truncated) {
+  csv_to_binary("src/test/unit/io/test_csv_files/blocker.0.csv",
+                stan::common::recorder::binary::by_iteration);
+  std::ifstream in(file_name.c_str(), std::ifstream::binary);
+  std::string contents((std::istreambuf_iterator<char>(in)),
+                       std::istreambuf_iterator<char>());
+  in.close();
+  std::ofstream out(file_name.c_str(), std::ofstream::binary);
+  out << contents.substr(0, contents.size() / 2);
+  out.close();
+
+  EXPECT_THROW(stan::io::stan_binary_reader reader(file_name),
+               std::invalid_argument);
+}
+
+TEST_F(StanIoStanBinaryReader, performance) {
+  std::string csv_file_name = "src/test/unit/io/test_csv_files/blocker.0.csv";
+  csv_to_binary(csv_file_name, stan::common::recorder::binary::by_column);
+
+  int num_repeats = 20;
+  clock_t start = clock();
+  for (int n = 0; n < num_repeats; ++n) {
+    std::ifstream in(csv_file_name.c_str());
+    stan::io::stan_csv csv = stan::io::stan_csv_reader::parse(in);
+  }
+  double t_csv = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+
+  start = clock();
+  for (int n = 0; n < num_repeats; ++n) {
+    stan::io::stan_binary_reader reader(file_name);
+    Eigen::MatrixXd samples = reader.samples();
+  }
+  double t_binary = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+
+  std::ifstream csv_in(csv_file_name.c_str(), std::ifstream::ate);
+  std::ifstream bin_in(file_name.c_str(), std::ifstream::ate);
+  std::cout << "blocker.0.csv: csv " << csv_in.tellg() << " bytes, read in "
+            << t_csv / num_repeats << " s; binary " << bin_in.tellg()
+            << " bytes, read in " << t_binary / num_repeats << " s"
+            << std::endl;
+}
@@ -0,0 +1,96 @@
+#include <stan/io/stan_csv_reader.hpp>
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+
+// Compares read_samples, which parses values in place, against the
+// previous implementation, which copied every line and field into a
+// string and converted it with boost::lexical_cast.
+
+namespace {
+
+  void getline_read_samples(std::istream& in, Eigen::MatrixXd& samples) {
+    std::stringstream ss;
+    std::string line;
+    int rows = 0;
+    int cols = -1;
+    while (in.good()) {
+      bool comment_line = (in.peek() == '#');
+      bool empty_line = (in.peek() == '\n');
+      std::getline(in, line);
+      if (empty_line) continue;
+      if (!line.length()) break;
+      if (!comment_line) {
+        ss << line << '\n';
+        cols = std::count(line.begin(), line.end(), ',') + 1;
+        rows++;
+      }
+      in.peek();
+    }
+    ss.seekg(std::ios_base::beg);
+    samples.resize(rows, cols);
+    for (int row = 0; row < rows; row++) {
+      std::getline(ss, line);
+      std::stringstream ls(line);
+      for (int col = 0; col < cols; col++) {
+        std::getline(ls, line, ',');
+        boost::trim(line);
+        samples(row, col) = boost::lexical_cast<double>(line);
+      }
+    }
+  }
+
+}
+
+TEST(StanIoStanCsvReader, read_samples_performance) {
+  // the draws of blocker.0.csv repeated to about 25 MB
+  std::ifstream blocker0_stream("src/test/unit/io/test_csv_files/blocker.0.csv");
+  std::stringstream draws;
+  std::string line;
+  while (std::getline(blocker0_stream, line))
+    if (!line.empty() && line[0] != '#' && line[0] != 'l')
+      draws << line << '\n';
+  std::stringstream csv;
+  for (int n = 0; n < 50; ++n)
+    csv << draws.str();
+  std::string text = csv.str();
+
+  Eigen::MatrixXd samples;
+  stan::io::stan_csv_timing timing;
+  std::stringstream in(text);
+  clock_t start = clock();
+  EXPECT_TRUE(stan::io::stan_csv_reader::read_samples(in, samples, timing));
+  double t_in_place = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+
+  std::vector<size_t> columns(1, 4);
+  Eigen::MatrixXd samples_d;
+  std::stringstream in_d(text);
+  start = clock();
+  EXPECT_TRUE(stan::io::stan_csv_reader::read_samples(in_d, samples_d, timing,
+                                                      columns));
+  double t_one_column = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+
+  Eigen::MatrixXd samples_ref;
+  std::stringstream in_ref(text);
+  start = clock();
+  getline_read_samples(in_ref, samples_ref);
+  double t_getline = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+
+  std::cout << "read_samples " << text.size() << " bytes: "
+            << "in place " << t_in_place << " s, "
+            << "one column " << t_one_column << " s, "
+            << "getline and lexical_cast " << t_getline << " s"
+            << std::endl;
+
+  ASSERT_EQ(samples_ref.rows(), samples.rows());
+  ASSERT_EQ(samples_ref.cols(), samples.cols());
+  // boost::lexical_cast is not always correctly rounded, strtod is
+  for (int i = 0; i < samples.rows(); i++)
+    for (int j = 0; j < samples.cols(); j++)
+      EXPECT_NEAR(samples_ref(i,j), samples(i,j),
+                  1e-15 * std::fabs(samples_ref(i,j)));
+  EXPECT_TRUE(samples.col(4) == samples_d.col(0));
+}
@@ -1,7 +1,9 @@
 #include <stan/io/stan_csv_reader.hpp>
 
 #include <gtest/gtest.h>
+#include <boost/math/special_functions/fpclassify.hpp>
 #include <fstream>
+#include <sstream>
 
 class StanIoStanCsvReader : public testing::Test {
   
@@ -637,3 +639,93 @@ TEST_F(StanIoStanCsvReader,ParseBlockerNondiag) {
   EXPECT_FLOAT_EQ(46.3784, blocker_nondiag.timing.sampling);
   
 }
+
+TEST_F(StanIoStanCsvReader,read_samples_columns) {
+  
+  Eigen::MatrixXd samples;
+  stan::io::stan_csv_timing timing;
+  std::vector<size_t> columns;
+  columns.push_back(51);
+  columns.push_back(0);
+  columns.push_back(4);
+  
+  EXPECT_TRUE(stan::io::stan_csv_reader::read_samples(samples1_stream, samples, timing, columns));
+  
+  ASSERT_EQ(5, samples.rows());
+  ASSERT_EQ(3, samples.cols());
+  
+  EXPECT_FLOAT_EQ(0.0552527, samples(0,0));
+  EXPECT_FLOAT_EQ(-5911.64, samples(0,1));
+  EXPECT_FLOAT_EQ(-0.238118, samples(0,2));
+  EXPECT_FLOAT_EQ(0.0779727, samples(4,0));
+  EXPECT_FLOAT_EQ(-5920.19, samples(4,1));
+  EXPECT_FLOAT_EQ(-0.2313, samples(4,2));
+  
+  EXPECT_FLOAT_EQ(0.307221, timing.warmup);
+  EXPECT_FLOAT_EQ(0.350392, timing.sampling);
+  
+}
+
+TEST_F(StanIoStanCsvReader,ParseBlockerColumns) {
+  
+  stan::io::stan_csv blocker0 = stan::io::stan_csv_reader::parse(blocker0_stream);
+  
+  std::ifstream blocker0_columns_stream("src/test/unit/io/test_csv_files/blocker.0.csv");
+  std::vector<size_t> columns;
+  columns.push_back(4);
+  columns.push_back(0);
+  stan::io::stan_csv blocker0_columns
+    = stan::io::stan_csv_reader::parse(blocker0_columns_stream, columns);
+  
+  ASSERT_EQ(2, blocker0_columns.header.size());
+  EXPECT_EQ("d", blocker0_columns.header(0));
+  EXPECT_EQ("lp__", blocker0_columns.header(1));
+  EXPECT_FLOAT_EQ(blocker0.adaptation.step_size, blocker0_columns.adaptation.step_size);
+  
+  ASSERT_EQ(blocker0.samples.rows(), blocker0_columns.samples.rows());
+  ASSERT_EQ(2, blocker0_columns.samples.cols());
+  for (int i = 0; i < blocker0.samples.rows(); i++) {
+    EXPECT_EQ(blocker0.samples(i,4), blocker0_columns.samples(i,0));
+    EXPECT_EQ(blocker0.samples(i,0), blocker0_columns.samples(i,1));
+  }
+  
+  std::ifstream bad_columns_stream("src/test/unit/io/test_csv_files/blocker.0.csv");
+  columns.push_back(52);
+  EXPECT_THROW(stan::io::stan_csv_reader::parse(bad_columns_stream, columns),
+               std::out_of_range);
+  
+}
+
+TEST_F(StanIoStanCsvReader,read_samples_format) {
+  
+  Eigen::MatrixXd samples;
+  stan::io::stan_csv_timing timing;
+  
+  // no trailing newline, carriage returns, blank lines, padding,
+  // exponents and special values
+  std::stringstream in("1, 2.5 ,-3e-2\r\n\n# comment\n4,nan,inf\n-inf,1E+3,0");
+  EXPECT_TRUE(stan::io::stan_csv_reader::read_samples(in, samples, timing));
+  
+  ASSERT_EQ(3, samples.rows());
+  ASSERT_EQ(3, samples.cols());
+  EXPECT_FLOAT_EQ(1, samples(0,0));
+  EXPECT_FLOAT_EQ(2.5, samples(0,1));
+  EXPECT_FLOAT_EQ(-0.03, samples(0,2));
+  EXPECT_TRUE(boost::math::isnan(samples(1,1)));
+  EXPECT_TRUE(boost::math::isinf(samples(1,2)));
+  EXPECT_TRUE(boost::math::isinf(samples(2,0)));
+  EXPECT_FLOAT_EQ(1000, samples(2,1));
+  EXPECT_FLOAT_EQ(0, samples(2,2));
+  
+  std::stringstream bad_value("1,2,3\n4,x5,6\n");
+  EXPECT_THROW(stan::io::stan_csv_reader::read_samples(bad_value, samples, timing),
+               boost::bad_lexical_cast);
+  
+  std::stringstream trailing("1,2,3\n4,5a,6\n");
+  EXPECT_THROW(stan::io::stan_csv_reader::read_samples(trailing, samples, timing),
+               boost::bad_lexical_cast);
+  
+  std::stringstream ragged("1,2,3\n4,5\n");
+  EXPECT_FALSE(stan::io::stan_csv_reader::read_samples(ragged, samples, timing));
+  
+}
@@ -0,0 +1,17 @@
+#include <stan/math/functions/value_of_rec.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <gtest/gtest.h>
+
+TEST(MathFunctions, value_of_rec) {
+  using stan::math::value_of_rec;
+  double x = 5.0;
+  EXPECT_FLOAT_EQ(5.0,value_of_rec(x));
+  EXPECT_FLOAT_EQ(5.0,value_of_rec(5));
+}
+
+TEST(MathFunctions, value_of_rec_nan) {
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  
+  EXPECT_PRED1(boost::math::isnan<double>,
+               stan::math::value_of_rec(nan));
+}
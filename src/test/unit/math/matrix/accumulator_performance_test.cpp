@@ -0,0 +1,84 @@
+#include <stan/agrad/rev.hpp>
+#include <stan/math/matrix/accumulator.hpp>
+#include <stan/math/matrix/sum.hpp>
+#include <gtest/gtest.h>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+// Compares the arena-backed accumulator used for the log density of
+// reverse-mode models against the previous implementation, which
+// pushed every term onto a std::vector and summed it with +=.
+
+namespace {
+
+  struct vector_accumulator {
+    std::vector<stan::agrad::var> buf_;
+    void add(double x) {
+      buf_.push_back(x);
+    }
+    void add(const stan::agrad::var& x) {
+      buf_.push_back(x);
+    }
+    stan::agrad::var sum() const {
+      return stan::math::sum(buf_);
+    }
+  };
+
+  // Mimics a model block with N sampling statements and N constant
+  // terms, and returns the time per gradient evaluation.
+  template <class A>
+  double time_gradient(int N, int num_repeats, std::vector<double>& grad,
+                       size_t& stack_size) {
+    using stan::agrad::var;
+    clock_t start = clock();
+    for (int n = 0; n < num_repeats; ++n) {
+      std::vector<var> x;
+      for (int i = 0; i < N; ++i)
+        x.push_back(std::sin(0.1 * i));
+      stack_size = stan::agrad::ChainableStack::var_stack_.size();
+      A lp_accum;
+      for (int i = 0; i < N; ++i) {
+        lp_accum.add(-0.5 * x[i] * x[i]);
+        lp_accum.add(-0.9189385332046727);
+      }
+      var lp = lp_accum.sum();
+      stack_size = stan::agrad::ChainableStack::var_stack_.size() - stack_size;
+      lp.grad(x, grad);
+      stan::agrad::recover_memory();
+    }
+    return static_cast<double>(clock() - start) / CLOCKS_PER_SEC / num_repeats;
+  }
+
+}
+
+TEST(MathMatrix, accumulator_performance) {
+  int sizes[] = { 100, 10000, 100000 };
+  for (int k = 0; k < 3; ++k) {
+    int N = sizes[k];
+    int num_repeats = N < 100000 ? 20 : 4;
+    std::vector<double> grad_arena, grad_vector;
+    size_t stack_arena, stack_vector;
+    double t_arena
+      = time_gradient<stan::math::accumulator<stan::agrad::var> >
+      (N, num_repeats, grad_arena, stack_arena);
+    double t_vector
+      = time_gradient<vector_accumulator>(N, num_repeats, grad_vector,
+                                          stack_vector);
+
+    std::cout << "accumulate " << N << " terms: "
+              << "arena " << t_arena << " s, "
+              << stack_arena << " stack entries; "
+              << "vector " << t_vector << " s, "
+              << stack_vector << " stack entries" << std::endl;
+
+    // two nodes per term, -0.5 * x and its product with x, plus
+    // one for the sum; the vector version also adds a node for each
+    // constant and one per term in the running sum
+    EXPECT_EQ(2U * N + 1U, stack_arena);
+    EXPECT_EQ(5U * N - 1U, stack_vector);
+    ASSERT_EQ(grad_vector.size(), grad_arena.size());
+    for (size_t i = 0; i < grad_vector.size(); ++i)
+      EXPECT_FLOAT_EQ(grad_vector[i], grad_arena[i]);
+  }
+}
@@ -0,0 +1,65 @@
+#include <stan/math/matrix/csr_matrix_times_vector.hpp>
+#include <stan/math/matrix/typedefs.hpp>
+#include <gtest/gtest.h>
+
+// 3 x 4 matrix
+//   [ 1 0 2 0 ]
+//   [ 0 0 0 0 ]
+//   [ 0 3 0 4 ]
+struct csr_fixture {
+  stan::math::vector_d w;
+  std::vector<int> v;
+  std::vector<int> u;
+  stan::math::vector_d b;
+
+  csr_fixture() : w(4), v(4), u(4), b(4) {
+    w << 1, 2, 3, 4;
+    v[0] = 1; v[1] = 3; v[2] = 2; v[3] = 4;
+    u[0] = 1; u[1] = 3; u[2] = 3; u[3] = 5;
+    b << 0.5, -1.0, 2.0, 3.0;
+  }
+};
+
+TEST(MathMatrix, csr_matrix_times_vector) {
+  using stan::math::csr_matrix_times_vector;
+  csr_fixture x;
+  stan::math::vector_d y = csr_matrix_times_vector(3, 4, x.w, x.v, x.u, x.b);
+  ASSERT_EQ(3, y.size());
+  EXPECT_FLOAT_EQ(0.5 + 4.0, y(0));
+  EXPECT_FLOAT_EQ(0.0, y(1));
+  EXPECT_FLOAT_EQ(-3.0 + 12.0, y(2));
+}
+
+TEST(MathMatrix, csr_matrix_times_vector_exceptions) {
+  using stan::math::csr_matrix_times_vector;
+  csr_fixture x;
+  EXPECT_THROW(csr_matrix_times_vector(0, 4, x.w, x.v, x.u, x.b),
+               std::domain_error);
+  EXPECT_THROW(csr_matrix_times_vector(3, 3, x.w, x.v, x.u, x.b),
+               std::domain_error);
+  EXPECT_THROW(csr_matrix_times_vector(2, 4, x.w, x.v, x.u, x.b),
+               std::domain_error);
+
+  csr_fixture bad_v;
+  bad_v.v[3] = 5;
+  EXPECT_THROW(csr_matrix_times_vector(3, 4, bad_v.w, bad_v.v, bad_v.u,
+                                       bad_v.b),
+               std::domain_error);
+
+  csr_fixture bad_u;
+  bad_u.u[1] = 4;
+  bad_u.u[2] = 3;
+  EXPECT_THROW(csr_matrix_times_vector(3, 4, bad_u.w, bad_u.v, bad_u.u,
+                                       bad_u.b),
+               std::domain_error);
+  bad_u = csr_fixture();
+  bad_u.u[3] = 4;
+  EXPECT_THROW(csr_matrix_times_vector(3, 4, bad_u.w, bad_u.v, bad_u.u,
+                                       bad_u.b),
+               std::domain_error);
+
+  stan::math::vector_d b(3);
+  b << 1, 2, 3;
+  EXPECT_THROW(csr_matrix_times_vector(3, 4, x.w, x.v, x.u, b),
+               std::domain_error);
+}
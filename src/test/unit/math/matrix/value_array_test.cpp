@@ -0,0 +1,42 @@
+#include <stan/math/matrix/value_array.hpp>
+#include <stan/agrad/rev.hpp>
+#include <stan/agrad/fwd.hpp>
+#include <gtest/gtest.h>
+
+TEST(MathMatrix, value_array) {
+  using stan::agrad::fvar;
+  using stan::agrad::var;
+  using stan::math::value_array;
+  using stan::math::value_array_type;
+
+  value_array_type<double>::type a = value_array<double>(2.5, 10, 3);
+  ASSERT_EQ(3, a.size());
+  for (int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(2.5, a(i));
+
+  std::vector<int> n;
+  n.push_back(1);
+  n.push_back(4);
+  n.push_back(9);
+  value_array_type<double>::type b = value_array<double>(n, 1, 2);
+  ASSERT_EQ(2, b.size());
+  EXPECT_FLOAT_EQ(4, b(0));
+  EXPECT_FLOAT_EQ(9, b(1));
+
+  Eigen::Matrix<var,Eigen::Dynamic,1> c(3);
+  c << 1, 2, 3;
+  size_t stack_size = stan::agrad::ChainableStack::var_stack_.size();
+  value_array_type<double>::type c_d = value_array<double>(c, 0, 3);
+  EXPECT_EQ(stack_size, stan::agrad::ChainableStack::var_stack_.size());
+  for (int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(i + 1, c_d(i));
+  stan::agrad::recover_memory();
+
+  // partials of fvar<fvar<double> > keep the inner tangent
+  std::vector<fvar<fvar<double> > > d;
+  d.push_back(fvar<fvar<double> >(fvar<double>(5, 1), 0));
+  value_array_type<fvar<double> >::type d_d
+    = value_array<fvar<double> >(d, 0, 1);
+  EXPECT_FLOAT_EQ(5, d_d(0).val_);
+  EXPECT_FLOAT_EQ(1, d_d(0).d_);
+}
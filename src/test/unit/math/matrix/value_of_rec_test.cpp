@@ -0,0 +1,31 @@
+#include <stan/math/matrix/value_of_rec.hpp>
+#include <stan/agrad/rev.hpp>
+#include <stan/agrad/fwd.hpp>
+#include <gtest/gtest.h>
+
+TEST(MathMatrix, value_of_rec) {
+  using stan::agrad::fvar;
+  using stan::agrad::var;
+  using stan::math::value_of_rec;
+
+  Eigen::Matrix<double,2,3> a;
+  a << 1, 2, 3, 4, 5, 6;
+  EXPECT_EQ(&a, &value_of_rec(a));
+
+  Eigen::Matrix<var,Eigen::Dynamic,1> b(3);
+  b << 1, 2, 3;
+  Eigen::Matrix<fvar<var>,1,Eigen::Dynamic> c(2);
+  c << 4, 5;
+  size_t stack_size = stan::agrad::ChainableStack::var_stack_.size();
+  Eigen::VectorXd b_d = value_of_rec(b);
+  Eigen::RowVectorXd c_d = value_of_rec(c);
+  EXPECT_EQ(stack_size, stan::agrad::ChainableStack::var_stack_.size());
+
+  ASSERT_EQ(3, b_d.size());
+  for (int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(i + 1, b_d(i));
+  ASSERT_EQ(2, c_d.size());
+  EXPECT_FLOAT_EQ(4, c_d(0));
+  EXPECT_FLOAT_EQ(5, c_d(1));
+  stan::agrad::recover_memory();
+}
@@ -0,0 +1,161 @@
+#include <stan/mcmc/chains_summary.hpp>
+#include <stan/mcmc/chains.hpp>
+#include <stan/io/stan_csv_reader.hpp>
+#include <gtest/gtest.h>
+#include <boost/random/additive_combine.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+class McmcChainsSummary : public testing::Test {
+public:
+  void SetUp() {
+    std::ifstream blocker1_stream("src/test/unit/mcmc/test_csv_files/blocker.1.csv");
+    std::ifstream blocker2_stream("src/test/unit/mcmc/test_csv_files/blocker.2.csv");
+    blocker1 = stan::io::stan_csv_reader::parse(blocker1_stream);
+    blocker2 = stan::io::stan_csv_reader::parse(blocker2_stream);
+  }
+
+  // feeds the draws to the summary as a recorder would see them
+  static void record(const stan::io::stan_csv& csv,
+                     stan::mcmc::online_summary& summary) {
+    std::vector<std::string> names(csv.header.size());
+    for (int i = 0; i < csv.header.size(); i++)
+      names[i] = csv.header(i);
+    summary(names);
+    summary("Adaptation terminated");
+    for (int row = 0; row < csv.samples.rows(); row++) {
+      std::vector<double> draw(csv.samples.cols());
+      for (int col = 0; col < csv.samples.cols(); col++)
+        draw[col] = csv.samples(row, col);
+      summary(draw);
+    }
+    summary();
+  }
+
+  stan::io::stan_csv blocker1, blocker2;
+};
+
+TEST_F(McmcChainsSummary, online_matches_batch) {
+  stan::mcmc::chains<> chains(blocker1);
+  chains.add(blocker2);
+  Eigen::VectorXd probs(3);
+  probs << 0.1, 0.5, 0.9;
+  stan::mcmc::chains_summary batch = chains.summary(probs);
+
+  stan::mcmc::online_summary chain1(1000, probs), chain2(1000, probs);
+  record(blocker1, chain1);
+  record(blocker2, chain2);
+  EXPECT_EQ(1000U, chain1.num_draws());
+
+  std::vector<const stan::mcmc::online_summary*> online_chains;
+  online_chains.push_back(&chain1);
+  online_chains.push_back(&chain2);
+  stan::mcmc::chains_summary online
+    = stan::mcmc::online_summary::summarize(online_chains);
+
+  ASSERT_EQ(chains.num_params(), online.mean.size());
+  for (int index = 4; index < chains.num_params(); index++) {
+    double sd = batch.sd(index);
+    EXPECT_NEAR(batch.mean(index), online.mean(index), 1e-8 * sd);
+    EXPECT_NEAR(batch.sd(index), online.sd(index), 1e-8 * sd);
+    EXPECT_NEAR(batch.r_hat(index), online.r_hat(index), 1e-8);
+    // different estimators of the autocorrelation time, and the
+    // P-square quantiles assume independent draws
+    EXPECT_GT(online.n_eff(index), batch.n_eff(index) / 3);
+    EXPECT_LT(online.n_eff(index), batch.n_eff(index) * 3);
+    for (int k = 0; k < 3; k++)
+      EXPECT_NEAR(batch.quantiles(index, k), online.quantiles(index, k),
+                  0.5 * sd);
+  }
+}
+
+TEST_F(McmcChainsSummary, online_single_chain) {
+  stan::mcmc::chains<> chains(blocker1);
+  stan::mcmc::chains_summary batch = chains.summary();
+
+  stan::mcmc::online_summary chain1(1000);
+  record(blocker1, chain1);
+  stan::mcmc::chains_summary online = chain1.summarize();
+
+  EXPECT_EQ(0, online.quantiles.cols());
+  for (int index = 4; index < chains.num_params(); index++) {
+    EXPECT_NEAR(batch.mean(index), online.mean(index), 1e-8 * batch.sd(index));
+    EXPECT_NEAR(batch.r_hat(index), online.r_hat(index), 1e-8);
+  }
+}
+
+TEST_F(McmcChainsSummary, online_partial) {
+  // before the second half starts there is no split R-hat
+  stan::mcmc::online_summary chain1(1000);
+  std::vector<std::string> names(2, "x");
+  chain1(names);
+  for (int n = 0; n < 100; n++) {
+    std::vector<double> draw(2, n);
+    chain1(draw);
+  }
+  stan::mcmc::chains_summary online = chain1.summarize();
+  EXPECT_FLOAT_EQ(49.5, online.mean(0));
+  EXPECT_TRUE(boost::math::isnan(online.r_hat(0)));
+
+  std::vector<double> draw(3, 0);
+  EXPECT_THROW(chain1(draw), std::length_error);
+}
+
+TEST_F(McmcChainsSummary, summary_performance) {
+  // AR(1) draws from 4 chains
+  int num_params = 2000;
+  int num_chains = 4;
+  int num_draws = 1000;
+  boost::ecuyer1988 rng(1234);
+  boost::random::normal_distribution<double> normal;
+  std::vector<std::string> names;
+  for (int i = 0; i < num_params; i++) {
+    std::stringstream name;
+    name << "theta." << i + 1;
+    names.push_back(name.str());
+  }
+  stan::mcmc::chains<> chains(names);
+  for (int chain = 0; chain < num_chains; chain++) {
+    Eigen::MatrixXd draws(num_draws, num_params);
+    for (int i = 0; i < num_params; i++) {
+      double x = normal(rng);
+      for (int n = 0; n < num_draws; n++) {
+        x = 0.5 * x + normal(rng);
+        draws(n, i) = x;
+      }
+    }
+    chains.add(chain, draws);
+  }
+
+  Eigen::VectorXd probs(3);
+  probs << 0.05, 0.5, 0.95;
+
+  clock_t start = clock();
+  stan::mcmc::chains_summary summary = chains.summary(probs);
+  double t_summary = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+
+  start = clock();
+  Eigen::VectorXd n_eff(num_params);
+  Eigen::MatrixXd quantiles(num_params, probs.size());
+  for (int i = 0; i < num_params; i++) {
+    n_eff(i) = chains.effective_sample_size(i);
+    for (int k = 0; k < probs.size(); k++)
+      quantiles(i, k) = chains.quantile(i, probs(k));
+  }
+  double t_per_call = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+
+  std::cout << "summary of " << num_params << " parameters x " << num_chains
+            << " chains: summary() " << t_summary << " s CPU, "
+            << "one call per statistic " << t_per_call << " s CPU"
+            << std::endl;
+
+  for (int i = 0; i < num_params; i++) {
+    EXPECT_EQ(n_eff(i), summary.n_eff(i));
+    for (int k = 0; k < probs.size(); k++)
+      EXPECT_EQ(quantiles(i, k), summary.quantiles(i, k));
+  }
+}
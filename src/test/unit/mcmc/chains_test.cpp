@@ -2,6 +2,7 @@
 #include <stan/io/stan_csv_reader.hpp>
 #include <gtest/gtest.h>
 #include <boost/random/additive_combine.hpp>
+#include <boost/accumulators/statistics/tail_quantile.hpp>
 #include <set>
 #include <exception>
 #include <utility>
@@ -837,3 +838,67 @@ TEST_F(McmcChains,blocker_split_potential_scale_reduction) {
   }
 
 }
+
+TEST_F(McmcChains,blocker_quantile_matches_tail_quantile) {
+  using boost::accumulators::accumulator_set;
+  using boost::accumulators::left;
+  using boost::accumulators::right;
+  using boost::accumulators::quantile_probability;
+  using boost::accumulators::stats;
+  using boost::accumulators::tag::tail;
+  using boost::accumulators::tag::tail_quantile;
+  stan::io::stan_csv blocker1 = stan::io::stan_csv_reader::parse(blocker1_stream);
+  stan::mcmc::chains<> chains(blocker1);
+
+  for (int index = 4; index < chains.num_params(); index += 7) {
+    Eigen::VectorXd x = chains.samples(index);
+    accumulator_set<double, stats<tail_quantile<left> > > 
+      acc_left(tail<left>::cache_size = x.size());
+    accumulator_set<double, stats<tail_quantile<right> > > 
+      acc_right(tail<right>::cache_size = x.size());
+    for (int i = 0; i < x.size(); i++) {
+      acc_left(x(i));
+      acc_right(x(i));
+    }
+    double probs[] = { 0.025, 0.1, 0.25, 0.4999, 0.5, 0.75, 0.9, 0.975 };
+    for (int k = 0; k < 8; k++) {
+      double expected = probs[k] < 0.5
+        ? boost::accumulators::quantile(acc_left, quantile_probability=probs[k])
+        : boost::accumulators::quantile(acc_right, quantile_probability=probs[k]);
+      EXPECT_EQ(expected, chains.quantile(index, probs[k]))
+        << "index " << index << ", prob " << probs[k];
+    }
+  }
+}
+
+TEST_F(McmcChains,blocker_summary) {
+  stan::io::stan_csv blocker1 = stan::io::stan_csv_reader::parse(blocker1_stream);
+  stan::io::stan_csv blocker2 = stan::io::stan_csv_reader::parse(blocker2_stream);
+  
+  stan::mcmc::chains<> chains(blocker1);
+  chains.add(blocker2);
+  
+  Eigen::VectorXd probs(3);
+  probs << 0.05, 0.5, 0.95;
+  stan::mcmc::chains_summary summary = chains.summary(probs);
+  
+  ASSERT_EQ(chains.num_params(), summary.mean.size());
+  ASSERT_EQ(chains.num_params(), summary.quantiles.rows());
+  ASSERT_EQ(3, summary.quantiles.cols());
+  for (int index = 0; index < chains.num_params(); index++) {
+    EXPECT_EQ(chains.mean(index), summary.mean(index));
+    EXPECT_EQ(chains.sd(index), summary.sd(index));
+    if (index >= 4) {
+      EXPECT_EQ(chains.effective_sample_size(index), summary.n_eff(index));
+      EXPECT_EQ(chains.split_potential_scale_reduction(index), 
+                summary.r_hat(index));
+    }
+    Eigen::VectorXd q = chains.quantiles(index, probs);
+    for (int k = 0; k < 3; k++)
+      EXPECT_EQ(q(k), summary.quantiles(index, k));
+  }
+  
+  summary = chains.summary();
+  EXPECT_EQ(0, summary.quantiles.cols());
+  EXPECT_EQ(chains.num_params(), summary.n_eff.size());
+}
@@ -145,3 +145,45 @@ TEST(McmcDenseEMetric, gradients) {
   EXPECT_EQ("", model_output.str());
   EXPECT_EQ("", metric_output.str());
 }
+
+TEST(McmcDenseEMetric, cached_cholesky_factor) {
+  rng_t base_rng(0);
+  
+  std::stringstream metric_output;
+  
+  stan::mcmc::mock_model model(3);
+  
+  stan::mcmc::dense_e_metric<stan::mcmc::mock_model, rng_t> metric(model, &metric_output);
+  stan::mcmc::dense_e_point z(3);
+  
+  z.p << 1, -2, 0.5;
+  EXPECT_FLOAT_EQ(0.5 * z.p.squaredNorm(), metric.T(z));
+  
+  Eigen::MatrixXd mInv(3, 3);
+  mInv << 4, 1, 0.5,
+          1, 3, -1,
+          0.5, -1, 2;
+  z.set_mInv(mInv);
+  
+  Eigen::MatrixXd L = mInv.llt().matrixL();
+  EXPECT_TRUE(L.isApprox(z.mInv_L()));
+  EXPECT_FLOAT_EQ(0.5 * z.p.transpose() * mInv * z.p, metric.T(z));
+  
+  // copies carry the factor along with the metric
+  stan::mcmc::dense_e_point z_copy(z);
+  EXPECT_TRUE(L.isApprox(z_copy.mInv_L()));
+  
+  // p solves L * p = u for a standard normal u
+  rng_t rng_copy(base_rng);
+  metric.sample_p(z, base_rng);
+  boost::variate_generator<rng_t&, boost::normal_distribution<> >
+    rand_gaus(rng_copy, boost::normal_distribution<>());
+  Eigen::VectorXd u(3);
+  for (int i = 0; i < 3; ++i)
+    u(i) = rand_gaus();
+  Eigen::VectorXd Lp = L * z.p;
+  for (int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(u(i), Lp(i));
+  
+  EXPECT_EQ("", metric_output.str());
+}
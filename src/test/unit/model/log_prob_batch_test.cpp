@@ -0,0 +1,135 @@
+#include <stan/agrad/rev/matrix.hpp>
+#include <stan/model/log_prob_batch.hpp>
+#include <stan/error_handling/scalar/check_positive.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <sstream>
+
+using Eigen::Matrix;
+using Eigen::Dynamic;
+
+// log density with a constant term that is dropped when propto is
+// true and a term standing in for the Jacobian, as in generated
+// models; the first parameter must be positive
+struct batch_model {
+  size_t num_params_r() const {
+    return 2;
+  }
+
+  template <bool propto, bool jacobian, typename T>
+  T log_prob(Matrix<T,Dynamic,1>& x, std::ostream* /* msgs */) const {
+    stan::error_handling::check_positive("batch_model", "x", x(0));
+    stan::math::accumulator<T> lp;
+    lp.add(-0.5 * x(0) * x(0) - x(0) * x(1) * x(1));
+    if (jacobian)
+      lp.add(log(x(0)));
+    if (!propto)
+      lp.add(-1.7);
+    return lp.sum();
+  }
+};
+
+// writes its first parameter to the message stream
+struct print_model {
+  size_t num_params_r() const {
+    return 2;
+  }
+
+  template <bool propto, bool jacobian, typename T>
+  T log_prob(Matrix<T,Dynamic,1>& x, std::ostream* msgs) const {
+    if (msgs)
+      (*msgs) << "x=" << x(0) << std::endl;
+    return -0.5 * x(0) * x(0);
+  }
+};
+
+Matrix<double,Dynamic,Dynamic> batch_draws() {
+  Matrix<double,Dynamic,Dynamic> params_r(2, 4);
+  params_r << 0.5, 1.0, -1.0, 2.0,
+              0.3, -2.0, 1.0, 0.0;
+  return params_r;
+}
+
+TEST(ModelLogProbBatch, log_prob_batch) {
+  batch_model model;
+  Matrix<double,Dynamic,Dynamic> params_r = batch_draws();
+
+  Matrix<double,Dynamic,1> lp;
+  stan::model::log_prob_batch<false, true>(model, params_r, lp);
+  ASSERT_EQ(4, lp.size());
+  for (int n = 0; n < 4; ++n) {
+    Matrix<double,Dynamic,1> x = params_r.col(n);
+    if (n == 2) {
+      EXPECT_EQ(-std::numeric_limits<double>::infinity(), lp(n));
+      continue;
+    }
+    EXPECT_FLOAT_EQ((model.log_prob<false, true>(x, 0)), lp(n));
+  }
+
+  stan::model::log_prob_batch<true, false>(model, params_r, lp);
+  ASSERT_EQ(4, lp.size());
+  for (int n = 0; n < 4; ++n) {
+    Matrix<double,Dynamic,1> x = params_r.col(n);
+    if (n == 2) {
+      EXPECT_EQ(-std::numeric_limits<double>::infinity(), lp(n));
+      continue;
+    }
+    EXPECT_FLOAT_EQ((model.log_prob<false, false>(x, 0)) + 1.7, lp(n));
+  }
+  EXPECT_EQ(0U, stan::agrad::ChainableStack::var_stack_.size());
+}
+
+TEST(ModelLogProbBatch, log_prob_grad_batch) {
+  batch_model model;
+  Matrix<double,Dynamic,Dynamic> params_r = batch_draws();
+
+  Matrix<double,Dynamic,1> lp;
+  Matrix<double,Dynamic,Dynamic> gradients;
+  stan::model::log_prob_grad_batch<true, true>(model, params_r, lp,
+                                                gradients);
+  ASSERT_EQ(4, lp.size());
+  ASSERT_EQ(2, gradients.rows());
+  ASSERT_EQ(4, gradients.cols());
+  for (int n = 0; n < 4; ++n) {
+    Matrix<double,Dynamic,1> x = params_r.col(n);
+    if (n == 2) {
+      EXPECT_EQ(-std::numeric_limits<double>::infinity(), lp(n));
+      EXPECT_TRUE(boost::math::isnan(gradients(0, n)));
+      EXPECT_TRUE(boost::math::isnan(gradients(1, n)));
+      continue;
+    }
+    Matrix<double,Dynamic,1> grad;
+    double f = stan::model::log_prob_grad<true, true>(model, x, grad);
+    stan::agrad::recover_memory();
+    EXPECT_FLOAT_EQ(f, lp(n));
+    EXPECT_FLOAT_EQ(-x(0) - x(1) * x(1) + 1 / x(0), gradients(0, n));
+    EXPECT_FLOAT_EQ(-2 * x(0) * x(1), gradients(1, n));
+  }
+  EXPECT_EQ(0U, stan::agrad::ChainableStack::var_stack_.size());
+}
+
+TEST(ModelLogProbBatch, empty) {
+  batch_model model;
+  Matrix<double,Dynamic,Dynamic> params_r(2, 0);
+  Matrix<double,Dynamic,1> lp;
+  Matrix<double,Dynamic,Dynamic> gradients;
+  stan::model::log_prob_batch<false, true>(model, params_r, lp);
+  EXPECT_EQ(0, lp.size());
+  stan::model::log_prob_grad_batch<false, true>(model, params_r, lp,
+                                                 gradients);
+  EXPECT_EQ(0, lp.size());
+  EXPECT_EQ(2, gradients.rows());
+  EXPECT_EQ(0, gradients.cols());
+}
+
+TEST(ModelLogProbBatch, messagesInDrawOrder) {
+  print_model model;
+  Matrix<double,Dynamic,Dynamic> params_r = batch_draws();
+  Matrix<double,Dynamic,1> lp;
+  std::stringstream msgs;
+  stan::model::log_prob_batch<false, true>(model, params_r, lp, &msgs);
+  EXPECT_EQ("x=0.5\nx=1\nx=-1\nx=2\n", msgs.str());
+
+  stan::model::log_prob_batch<false, true>(model, params_r, lp);
+  EXPECT_EQ(4, lp.size());
+}
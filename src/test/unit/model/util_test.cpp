@@ -14,6 +14,10 @@
 
 class TestModel_uniform_01 {
 public:
+  size_t num_params_r() const {
+    return 1;
+  }
+
   template <bool propto__, bool jacobian__, typename T__>
   T__ log_prob(std::vector<T__>& params_r__,
                std::vector<int>& params_i__,
@@ -262,3 +266,58 @@ TEST(ModelUtil, grad_tr_mat_times_hessian) {
   //             std::domain_error);
   //EXPECT_EQ("", output.str());
 }
+
+TEST(ModelUtil, exact_grad_hess_log_prob) {
+  TestModel_uniform_01 model;
+  std::vector<double> params_r(1);
+  std::vector<int> params_i(0);
+  std::vector<double> gradient;
+  std::vector<double> hessian;
+  std::vector<double> gradient_fd;
+  std::vector<double> hessian_fd;
+
+  for (int i = 0; i < 10; i++) {
+    double x = (i - 5.0) * 0.8;
+    params_r[0] = x;
+
+    double lp
+      = stan::model::exact_grad_hess_log_prob<true,true>(model, params_r,
+                                                         params_i, gradient,
+                                                         hessian);
+    double lp_fd
+      = stan::model::grad_hess_log_prob<true,true>(model, params_r,
+                                                   params_i, gradient_fd,
+                                                   hessian_fd);
+    EXPECT_FLOAT_EQ(lp_fd, lp);
+    ASSERT_EQ(1U, gradient.size());
+    ASSERT_EQ(1U, hessian.size());
+
+    // derivatives of the log Jacobian of the logit transform
+    double y = 1 / (1 + std::exp(-x));
+    EXPECT_FLOAT_EQ(1 - 2 * y, gradient[0]);
+    EXPECT_FLOAT_EQ(-2 * y * (1 - y), hessian[0]);
+    EXPECT_NEAR(hessian_fd[0], hessian[0], 1e-6);
+  }
+  EXPECT_EQ(0U, stan::agrad::ChainableStack::var_stack_.size());
+}
+
+TEST(ModelUtil, grad_hess_vector_log_prob) {
+  TestModel_uniform_01 model;
+  std::vector<double> params_r(1, 0.7);
+  std::vector<int> params_i(0);
+  std::vector<double> v(1, -3.0);
+  std::vector<double> gradient;
+  std::vector<double> hessian_v;
+
+  double lp
+    = stan::model::grad_hess_vector_log_prob<true,true>(model, params_r,
+                                                        params_i, v,
+                                                        gradient, hessian_v);
+  double y = 1 / (1 + std::exp(-0.7));
+  EXPECT_FLOAT_EQ(std::log(y * (1 - y)), lp);
+  ASSERT_EQ(1U, gradient.size());
+  ASSERT_EQ(1U, hessian_v.size());
+  EXPECT_FLOAT_EQ(1 - 2 * y, gradient[0]);
+  EXPECT_FLOAT_EQ(-3.0 * -2 * y * (1 - y), hessian_v[0]);
+  EXPECT_EQ(0U, stan::agrad::ChainableStack::var_stack_.size());
+}
@@ -0,0 +1,87 @@
+#include <stan/model/write_array_batch.hpp>
+#include <gtest/gtest.h>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <boost/random/additive_combine.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <cmath>
+#include <stdexcept>
+
+using Eigen::Matrix;
+using Eigen::Dynamic;
+
+typedef boost::ecuyer1988 rng_t;
+
+// writes the constrained parameter exp(x), a transformed parameter
+// and a random generated quantity; rejects draws with x > 10
+struct batch_model {
+  void constrained_param_names(std::vector<std::string>& names,
+                               bool include_tparams = true,
+                               bool include_gqs = true) const {
+    names.push_back("sigma");
+    if (include_tparams)
+      names.push_back("tau");
+    if (include_gqs)
+      names.push_back("u");
+  }
+
+  template <typename RNG>
+  void write_array(RNG& rng,
+                   std::vector<double>& params_r,
+                   std::vector<int>& /* params_i */,
+                   std::vector<double>& vars,
+                   bool include_tparams = true,
+                   bool include_gqs = true,
+                   std::ostream* /* msgs */ = 0) const {
+    if (params_r[0] > 10)
+      throw std::domain_error("batch_model: x is too large");
+    vars.clear();
+    vars.push_back(std::exp(params_r[0]));
+    if (include_tparams)
+      vars.push_back(2 * std::exp(params_r[0]));
+    if (include_gqs)
+      vars.push_back(boost::random::uniform_real_distribution<double>()(rng));
+  }
+};
+
+TEST(ModelWriteArrayBatch, write_array_batch) {
+  batch_model model;
+  rng_t base_rng(17);
+  Matrix<double,Dynamic,Dynamic> params_r(1, 4);
+  params_r << 0.5, -1.0, 11.0, 2.0;
+
+  Matrix<double,Dynamic,Dynamic> values;
+  std::vector<int> failed = stan::model::write_array_batch(model, base_rng,
+                                                           1000, params_r,
+                                                           values);
+  ASSERT_EQ(1U, failed.size());
+  EXPECT_EQ(2, failed[0]);
+  ASSERT_EQ(3, values.rows());
+  ASSERT_EQ(4, values.cols());
+  for (int n = 0; n < 4; ++n) {
+    if (n == 2) {
+      for (int i = 0; i < 3; ++i)
+        EXPECT_TRUE(boost::math::isnan(values(i, n)));
+      continue;
+    }
+    rng_t rng(base_rng);
+    rng.discard(1000 * n);
+    std::vector<double> x(1, params_r(0, n));
+    std::vector<int> params_i;
+    std::vector<double> vars;
+    model.write_array(rng, x, params_i, vars);
+    for (int i = 0; i < 3; ++i)
+      EXPECT_FLOAT_EQ(vars[i], values(i, n));
+  }
+  EXPECT_NE(values(2, 0), values(2, 1));
+}
+
+TEST(ModelWriteArrayBatch, empty) {
+  batch_model model;
+  rng_t base_rng(17);
+  Matrix<double,Dynamic,Dynamic> params_r(1, 0);
+  Matrix<double,Dynamic,Dynamic> values;
+  EXPECT_EQ(0U, stan::model::write_array_batch(model, base_rng, 1000,
+                                               params_r, values).size());
+  EXPECT_EQ(3, values.rows());
+  EXPECT_EQ(0, values.cols());
+}
@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include <stan/optimization/newton.hpp>
+#include <test/test-models/good/optimization/ode.hpp>
+
+class OptimizationNewtonOde : public testing::Test {
+public:
+  void SetUp() {
+    std::fstream data_stream(std::string("").c_str(), std::fstream::in);
+    stan::io::dump data_var_context(data_stream);
+    data_stream.close();
+    model = new ode_model_namespace::ode_model(data_var_context);
+  }
+
+  void TearDown() {
+    delete model;
+  }
+
+  ode_model_namespace::ode_model* model;
+};
+
+TEST_F(OptimizationNewtonOde, exact_hessian_not_supported) {
+  std::vector<double> params_r(1, 0.5);
+  std::vector<int> params_i;
+  std::vector<double> gradient;
+  std::vector<double> hessian;
+
+  EXPECT_THROW((stan::model::exact_grad_hess_log_prob<true,false>(*model,
+                                                                  params_r,
+                                                                  params_i,
+                                                                  gradient,
+                                                                  hessian)),
+               stan::agrad::fvar_not_supported);
+}
+
+TEST_F(OptimizationNewtonOde, newton_step) {
+  std::vector<double> params_r(1, 0.5);
+  std::vector<int> params_i;
+
+  double lp = stan::model::log_prob_propto<false>(*model, params_r, params_i);
+  for (int n = 0; n < 5; n++) {
+    double lp_new = stan::optimization::newton_step(*model, params_r, params_i);
+    EXPECT_GE(lp_new, lp);
+    lp = lp_new;
+  }
+}
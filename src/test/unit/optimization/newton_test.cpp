@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <stan/optimization/newton.hpp>
+#include <test/test-models/good/optimization/rosenbrock.hpp>
+
+class OptimizationNewton : public testing::Test {
+public:
+  void SetUp() {
+    std::fstream data_stream(std::string("").c_str(), std::fstream::in);
+    stan::io::dump data_var_context(data_stream);
+    data_stream.close();
+    model = new rosenbrock_model_namespace::rosenbrock_model(data_var_context);
+  }
+
+  void TearDown() {
+    delete model;
+  }
+
+  rosenbrock_model_namespace::rosenbrock_model* model;
+};
+
+TEST_F(OptimizationNewton, exact_hessian) {
+  std::vector<double> params_r(2);
+  params_r[0] = -1.2;
+  params_r[1] = 1.0;
+  std::vector<int> params_i;
+  std::vector<double> gradient;
+  std::vector<double> hessian;
+  std::vector<double> gradient_fd;
+  std::vector<double> hessian_fd;
+
+  double lp
+    = stan::model::exact_grad_hess_log_prob<true,false>(*model, params_r,
+                                                        params_i, gradient,
+                                                        hessian);
+  double lp_fd
+    = stan::model::grad_hess_log_prob<true,false>(*model, params_r,
+                                                  params_i, gradient_fd,
+                                                  hessian_fd);
+  EXPECT_FLOAT_EQ(lp_fd, lp);
+
+  // lp = -((1 - x)^2 + 100 (y - x^2)^2)
+  double x = params_r[0];
+  double y = params_r[1];
+  ASSERT_EQ(2U, gradient.size());
+  EXPECT_FLOAT_EQ(2 * (1 - x) + 400 * x * (y - x * x), gradient[0]);
+  EXPECT_FLOAT_EQ(-200 * (y - x * x), gradient[1]);
+  ASSERT_EQ(4U, hessian.size());
+  EXPECT_FLOAT_EQ(-2 + 400 * y - 1200 * x * x, hessian[0]);
+  EXPECT_FLOAT_EQ(400 * x, hessian[1]);
+  EXPECT_FLOAT_EQ(400 * x, hessian[2]);
+  EXPECT_FLOAT_EQ(-200, hessian[3]);
+  for (size_t i = 0; i < hessian.size(); i++)
+    EXPECT_NEAR(hessian_fd[i], hessian[i], 1e-6 * std::fabs(hessian[i]));
+
+  std::vector<double> v(2);
+  v[0] = 0.5;
+  v[1] = -2.0;
+  std::vector<double> hessian_v;
+  stan::model::grad_hess_vector_log_prob<true,false>(*model, params_r,
+                                                     params_i, v,
+                                                     gradient, hessian_v);
+  ASSERT_EQ(2U, hessian_v.size());
+  EXPECT_FLOAT_EQ(hessian[0] * v[0] + hessian[1] * v[1], hessian_v[0]);
+  EXPECT_FLOAT_EQ(hessian[2] * v[0] + hessian[3] * v[1], hessian_v[1]);
+}
+
+TEST_F(OptimizationNewton, newton_step) {
+  std::vector<double> params_r(2);
+  params_r[0] = -1.2;
+  params_r[1] = 1.0;
+  std::vector<int> params_i;
+
+  double lp = stan::model::log_prob_propto<false>(*model, params_r, params_i);
+  for (int n = 0; n < 100 && lp < -1e-20; n++) {
+    double lp_new = stan::optimization::newton_step(*model, params_r, params_i);
+    EXPECT_GE(lp_new, lp);
+    lp = lp_new;
+  }
+  EXPECT_NEAR(1.0, params_r[0], 1e-6);
+  EXPECT_NEAR(1.0, params_r[1], 1e-6);
+}
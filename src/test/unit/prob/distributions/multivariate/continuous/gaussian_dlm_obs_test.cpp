@@ -2,6 +2,7 @@
 #include <stan/agrad/rev/matrix.hpp>
 #include <stan/agrad/fwd/matrix.hpp>
 #include <stan/prob/distributions/multivariate/continuous/gaussian_dlm_obs.hpp>
+#include <test/unit/distribution/multivariate/continuous/expect_generic_gradients.hpp>
 
 using Eigen::Dynamic;
 using Eigen::Matrix;
@@ -718,3 +719,93 @@ TEST(ProbDistributionsGaussianDLM,LoglikeMM_fvar_fvar_var) {
   EXPECT_NEAR(ll_expected,lp_ref.val_.val_.val(), 1e-4);
   EXPECT_NEAR(18.89044287309947,lp_ref.d_.val_.val(), 1e-4);
 }
+
+struct gaussian_dlm_obs_density {
+  double tol;
+  gaussian_dlm_obs_density() : tol(1e-7) { }
+
+  template <bool propto,
+            typename T_y, typename T_F, typename T_G, typename T_V,
+            typename T_W, typename T_m0, typename T_C0, int C_V>
+  stan::agrad::var
+  log_prob(const Matrix<T_y,Dynamic,Dynamic>& y,
+           const Matrix<T_F,Dynamic,Dynamic>& F,
+           const Matrix<T_G,Dynamic,Dynamic>& G,
+           const Matrix<T_V,Dynamic,C_V>& V,
+           const Matrix<T_W,Dynamic,Dynamic>& W,
+           const Matrix<T_m0,Dynamic,1>& m0,
+           const Matrix<T_C0,Dynamic,Dynamic>& C0) const {
+    return gaussian_dlm_obs_log<propto>(y, F, G, V, W, m0, C0);
+  }
+
+  template <bool propto,
+            typename T_y, typename T_F, typename T_G, typename T_V,
+            typename T_W, typename T_m0, typename T_C0, int C_V>
+  stan::agrad::var
+  generic(const Matrix<T_y,Dynamic,Dynamic>& y,
+          const Matrix<T_F,Dynamic,Dynamic>& F,
+          const Matrix<T_G,Dynamic,Dynamic>& G,
+          const Matrix<T_V,Dynamic,C_V>& V,
+          const Matrix<T_W,Dynamic,Dynamic>& W,
+          const Matrix<T_m0,Dynamic,1>& m0,
+          const Matrix<T_C0,Dynamic,Dynamic>& C0) const {
+    return stan::prob::gaussian_dlm_obs_lp<propto, T_y, T_F, T_G, T_V, T_W,
+                                           T_m0, T_C0, stan::agrad::var, true>
+      ::apply(y, F, G, V, W, m0, C0);
+  }
+};
+
+template <bool propto,
+          typename T_y, typename T_F, typename T_G, typename T_V,
+          typename T_W, typename T_m0, typename T_C0, int C_V>
+void expect_gaussian_dlm_obs_generic(const Matrix<double,Dynamic,C_V>& V_d) {
+  MatrixXd F_d(2, 3);
+  F_d << 0.585528817843856, 0.709466017509524, -0.109303314681054,
+    -0.453497173462763, 0.605887455840394, -1.81795596770373;
+  MatrixXd G_d(2, 2);
+  G_d << 0.520216457554957, 0.816899839520583,
+    -0.750531994502331, -0.886357521243213;
+  MatrixXd W_d(2, 2);
+  W_d << 2.24277594357501, -1.65863136283477,
+    -1.65863136283477, 6.69010664813895;
+  MatrixXd C0_d(2, 2);
+  C0_d << 8.2, 0.5, 0.5, 5.6;
+  Matrix<double,Dynamic,1> m0_d(2);
+  m0_d << -0.892071328367409, 3.74785137677115;
+  MatrixXd y_d(3, 10);
+  for (int t = 0; t < 10; ++t)
+    for (int j = 0; j < 3; ++j)
+      y_d(j,t) = 3.0 * std::sin(t + 2.0 * j);
+
+  Matrix<T_y,Dynamic,Dynamic> y = y_d.cast<T_y>();
+  Matrix<T_F,Dynamic,Dynamic> F = F_d.cast<T_F>();
+  Matrix<T_G,Dynamic,Dynamic> G = G_d.cast<T_G>();
+  Matrix<T_V,Dynamic,C_V> V = V_d.template cast<T_V>();
+  Matrix<T_W,Dynamic,Dynamic> W = W_d.cast<T_W>();
+  Matrix<T_m0,Dynamic,1> m0 = m0_d.cast<T_m0>();
+  Matrix<T_C0,Dynamic,Dynamic> C0 = C0_d.cast<T_C0>();
+  expect_generic_gradients<propto>(gaussian_dlm_obs_density(),
+                                   y, F, G, V, W, m0, C0);
+}
+
+TEST(ProbDistributionsGaussianDLM, GradientsMatchGeneric) {
+  using stan::agrad::var;
+  MatrixXd V(3, 3);
+  V << 7.19105866377728, -0.311731853764732, 4.87333111936296,
+    -0.311731853764732, 3.27048576782842, 0.457616661474554,
+    4.87333111936296, 0.457616661474554, 5.86564522448303;
+  expect_gaussian_dlm_obs_generic<false,var,var,var,var,var,var,var>(V);
+  expect_gaussian_dlm_obs_generic<true,var,var,var,var,var,var,var>(V);
+  expect_gaussian_dlm_obs_generic<false,double,var,double,var,double,double,double>(V);
+  expect_gaussian_dlm_obs_generic<true,double,double,var,double,var,var,var>(V);
+}
+
+TEST(ProbDistributionsGaussianDLM, GradientsMatchGenericSeq) {
+  using stan::agrad::var;
+  Matrix<double,Dynamic,1> V(3);
+  V << 7.19105866377728, 3.27048576782842, 5.86564522448303;
+  expect_gaussian_dlm_obs_generic<false,var,var,var,var,var,var,var>(V);
+  expect_gaussian_dlm_obs_generic<true,var,var,var,var,var,var,var>(V);
+  expect_gaussian_dlm_obs_generic<false,double,var,double,var,double,double,double>(V);
+  expect_gaussian_dlm_obs_generic<true,double,double,var,double,var,var,var>(V);
+}